@@ -37,6 +37,7 @@
 #include "core/io/file_access.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
 #include "core/io/resource_uid.h"
 #include "core/object/script_language.h"
 #include "core/templates/rb_set.h"
@@ -888,6 +889,10 @@ Error ProjectSettings::setup(const String &p_path, const String &p_main_pack, bo
 
 	Compression::gzip_level = GLOBAL_GET("compression/formats/gzip/compression_level");
 
+	Compression::parallel_min_blocks = GLOBAL_GET("compression/threading/parallel_min_blocks");
+
+	ResourceLoader::set_dependency_prefetch_budget(uint64_t(int(GLOBAL_GET("threading/resource_loader/dependency_prefetch_budget_mb"))) * 1024 * 1024);
+
 	load_scene_groups_cache();
 
 	project_loaded = err == OK;
@@ -1735,6 +1740,8 @@ ProjectSettings::ProjectSettings() {
 	GLOBAL_DEF("display/window/energy_saving/keep_screen_on", true);
 	GLOBAL_DEF("animation/warnings/check_invalid_track_paths", true);
 	GLOBAL_DEF("animation/warnings/check_angle_interpolation_type_conflicting", true);
+	GLOBAL_DEF("animation/mixers/use_batched_evaluation", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "animation/compression/streamed_page_budget_mb", PROPERTY_HINT_RANGE, "1,4096,1,or_greater,suffix:MB"), 64);
 #ifndef DISABLE_DEPRECATED
 	GLOBAL_DEF_RST("animation/compatibility/default_parent_skeleton_in_mesh_instance_3d", false);
 #endif
@@ -1786,6 +1793,9 @@ ProjectSettings::ProjectSettings() {
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/formats/zstd/window_log_size", PROPERTY_HINT_RANGE, "10,30,1"), Compression::zstd_window_log_size);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/formats/zlib/compression_level", PROPERTY_HINT_RANGE, "-1,9,1"), Compression::zlib_level);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/formats/gzip/compression_level", PROPERTY_HINT_RANGE, "-1,9,1"), Compression::gzip_level);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/threading/parallel_min_blocks", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), Compression::parallel_min_blocks);
+
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/resource_loader/dependency_prefetch_budget_mb", PROPERTY_HINT_RANGE, "0,4096,1,or_greater,suffix:MB"), 64);
 
 	GLOBAL_DEF("debug/settings/crash_handler/message",
 			String("Please include this when reporting the bug to the project developer."));
@@ -1793,6 +1803,7 @@ ProjectSettings::ProjectSettings() {
 			String("Please include this when reporting the bug on: https://github.com/godotengine/godot/issues"));
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/occlusion_culling/bvh_build_quality", PROPERTY_HINT_ENUM, "Low,Medium,High"), 2);
 	GLOBAL_DEF_RST("rendering/occlusion_culling/jitter_projection", true);
+	GLOBAL_DEF_RST("rendering/occlusion_culling/force_software_rasterizer", false);
 
 	GLOBAL_DEF_RST("internationalization/rendering/force_right_to_left_layout_direction", false);
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::INT, "internationalization/rendering/root_node_layout_direction", PROPERTY_HINT_ENUM, "Based on Application Locale,Left-to-Right,Right-to-Left,Based on System Locale"), 0);
@@ -32,6 +32,8 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/zip_io.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 
 #include "thirdparty/misc/fastlz.h"
 
@@ -41,11 +43,32 @@
 #include <brotli/decode.h>
 #endif
 
-// Caches for zstd.
-static BinaryMutex mutex;
-static ZSTD_DCtx *current_zstd_d_ctx = nullptr;
-static bool current_zstd_long_distance_matching;
-static int current_zstd_window_log_size;
+// Cache for zstd, one per thread so concurrent decompression doesn't serialize.
+struct ZstdDecompressionCache {
+	ZSTD_DCtx *ctx = nullptr;
+	bool long_distance_matching = false;
+	int window_log_size = 0;
+
+	~ZstdDecompressionCache() {
+		if (ctx) {
+			ZSTD_freeDCtx(ctx);
+		}
+	}
+};
+
+static thread_local ZstdDecompressionCache zstd_decompression_cache;
+
+struct ZstdCompressionCache {
+	ZSTD_CCtx *ctx = nullptr;
+
+	~ZstdCompressionCache() {
+		if (ctx) {
+			ZSTD_freeCCtx(ctx);
+		}
+	}
+};
+
+static thread_local ZstdCompressionCache zstd_compression_cache;
 
 int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode) {
 	switch (p_mode) {
@@ -91,7 +114,13 @@ int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_sr
 
 		} break;
 		case MODE_ZSTD: {
-			ZSTD_CCtx *cctx = ZSTD_createCCtx();
+			// Reused, as block mode compresses many small buffers per thread.
+			ZSTD_CCtx *&cctx = zstd_compression_cache.ctx;
+			if (!cctx) {
+				cctx = ZSTD_createCCtx();
+				ERR_FAIL_NULL_V(cctx, -1);
+			}
+			ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
 			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
 			if (zstd_long_distance_matching) {
 				ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
@@ -99,7 +128,7 @@ int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_sr
 			}
 			const int64_t max_dst_size = get_max_compressed_buffer_size(p_src_size, MODE_ZSTD);
 			const size_t ret = ZSTD_compressCCtx(cctx, p_dst, max_dst_size, p_src, p_src_size, zstd_level);
-			ZSTD_freeCCtx(cctx);
+			ERR_FAIL_COND_V(ZSTD_isError(ret), -1);
 			return (int64_t)ret;
 		} break;
 	}
@@ -198,22 +227,21 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 			return total;
 		} break;
 		case MODE_ZSTD: {
-			MutexLock lock(mutex);
-
-			if (!current_zstd_d_ctx || current_zstd_long_distance_matching != zstd_long_distance_matching || current_zstd_window_log_size != zstd_window_log_size) {
-				if (current_zstd_d_ctx) {
-					ZSTD_freeDCtx(current_zstd_d_ctx);
+			ZstdDecompressionCache &cache = zstd_decompression_cache;
+			if (!cache.ctx || cache.long_distance_matching != zstd_long_distance_matching || cache.window_log_size != zstd_window_log_size) {
+				if (cache.ctx) {
+					ZSTD_freeDCtx(cache.ctx);
 				}
 
-				current_zstd_d_ctx = ZSTD_createDCtx();
+				cache.ctx = ZSTD_createDCtx();
 				if (zstd_long_distance_matching) {
-					ZSTD_DCtx_setParameter(current_zstd_d_ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
+					ZSTD_DCtx_setParameter(cache.ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
 				}
-				current_zstd_long_distance_matching = zstd_long_distance_matching;
-				current_zstd_window_log_size = zstd_window_log_size;
+				cache.long_distance_matching = zstd_long_distance_matching;
+				cache.window_log_size = zstd_window_log_size;
 			}
 
-			size_t ret = ZSTD_decompressDCtx(current_zstd_d_ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+			size_t ret = ZSTD_decompressDCtx(cache.ctx, p_dst, p_dst_max_size, p_src, p_src_size);
 			return (int64_t)ret;
 		} break;
 	}
@@ -369,3 +397,130 @@ int Compression::decompress_dynamic(Vector<uint8_t> *p_dst_vect, int64_t p_max_d
 		return Z_OK;
 	}
 }
+
+struct CompressBlocksData {
+	const uint8_t *src = nullptr;
+	int64_t src_size = 0;
+	uint32_t block_size = 0;
+	Compression::Mode mode = Compression::MODE_ZSTD;
+	uint32_t first_block = 0;
+	uint8_t *dst = nullptr;
+	int64_t dst_block_capacity = 0;
+	int64_t *dst_sizes = nullptr;
+
+	void compress_block(uint32_t p_index) {
+		const int64_t offset = int64_t(first_block + p_index) * block_size;
+		const int64_t size = MIN(int64_t(block_size), src_size - offset);
+		dst_sizes[p_index] = Compression::compress(dst + p_index * dst_block_capacity, src + offset, size, mode);
+	}
+};
+
+static void _compress_block(void *p_userdata, uint32_t p_index) {
+	((CompressBlocksData *)p_userdata)->compress_block(p_index);
+}
+
+bool Compression::compress_blocks(const uint8_t *p_src, int64_t p_src_size, uint32_t p_block_size, Mode p_mode, BlockWriteFunc p_write, void *p_userdata, int p_tasks) {
+	ERR_FAIL_COND_V(p_block_size == 0, false);
+
+	const uint32_t block_count = get_block_count(p_src_size, p_block_size);
+	const int64_t dst_block_capacity = get_max_compressed_buffer_size(p_block_size, p_mode);
+	ERR_FAIL_COND_V(dst_block_capacity < 0, false);
+
+	// Without a thread pool, e.g. before it's initialized, blocks are compressed serially.
+	const int thread_count = WorkerThreadPool::get_singleton() ? WorkerThreadPool::get_singleton()->get_thread_count() : 1;
+	const bool parallel = parallel_min_blocks > 0 && block_count >= uint32_t(parallel_min_blocks) && thread_count > 1 && p_tasks != 1;
+	// Batches bound the memory used for compressed blocks waiting to be written.
+	const uint32_t batch_size = parallel ? MIN(block_count, uint32_t(thread_count) * 4) : 1;
+
+	LocalVector<uint8_t> dst;
+	dst.resize(batch_size * dst_block_capacity);
+	LocalVector<int64_t> dst_sizes;
+	dst_sizes.resize(batch_size);
+
+	CompressBlocksData data;
+	data.src = p_src;
+	data.src_size = p_src_size;
+	data.block_size = p_block_size;
+	data.mode = p_mode;
+	data.dst = dst.ptr();
+	data.dst_block_capacity = dst_block_capacity;
+	data.dst_sizes = dst_sizes.ptr();
+
+	for (uint32_t first_block = 0; first_block < block_count; first_block += batch_size) {
+		const uint32_t count = MIN(batch_size, block_count - first_block);
+		data.first_block = first_block;
+		if (count == 1) {
+			data.compress_block(0);
+		} else {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_compress_block, &data, count, p_tasks, true, SNAME("CompressBlocks"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		for (uint32_t i = 0; i < count; i++) {
+			ERR_FAIL_COND_V_MSG(dst_sizes[i] < 0, false, "Error compressing data block.");
+			if (!p_write(p_userdata, dst.ptr() + i * dst_block_capacity, dst_sizes[i])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+struct DecompressBlocksData {
+	uint8_t *dst = nullptr;
+	int64_t dst_size = 0;
+	const uint8_t *src = nullptr;
+	const uint32_t *block_sizes = nullptr;
+	const uint64_t *block_offsets = nullptr;
+	uint32_t block_size = 0;
+	Compression::Mode mode = Compression::MODE_ZSTD;
+	SafeFlag failed;
+
+	void decompress_block(uint32_t p_index) {
+		const int64_t offset = int64_t(p_index) * block_size;
+		const int64_t size = MIN(int64_t(block_size), dst_size - offset);
+		if (Compression::decompress(dst + offset, size, src + block_offsets[p_index], block_sizes[p_index], mode) < 0) {
+			failed.set();
+		}
+	}
+};
+
+static void _decompress_block(void *p_userdata, uint32_t p_index) {
+	((DecompressBlocksData *)p_userdata)->decompress_block(p_index);
+}
+
+bool Compression::decompress_blocks(uint8_t *p_dst, int64_t p_dst_size, const uint8_t *p_src, const uint32_t *p_block_sizes, uint32_t p_block_count, uint32_t p_block_size, Mode p_mode, int p_tasks) {
+	ERR_FAIL_COND_V(p_block_size == 0, false);
+	ERR_FAIL_COND_V(p_dst_size > int64_t(p_block_count) * p_block_size, false);
+
+	LocalVector<uint64_t> block_offsets;
+	block_offsets.resize(p_block_count);
+	uint64_t offset = 0;
+	for (uint32_t i = 0; i < p_block_count; i++) {
+		block_offsets[i] = offset;
+		offset += p_block_sizes[i];
+	}
+
+	DecompressBlocksData data;
+	data.dst = p_dst;
+	data.dst_size = p_dst_size;
+	data.src = p_src;
+	data.block_sizes = p_block_sizes;
+	data.block_offsets = block_offsets.ptr();
+	data.block_size = p_block_size;
+	data.mode = p_mode;
+
+	const int thread_count = WorkerThreadPool::get_singleton() ? WorkerThreadPool::get_singleton()->get_thread_count() : 1;
+	const bool parallel = parallel_min_blocks > 0 && p_block_count >= uint32_t(parallel_min_blocks) && thread_count > 1 && p_tasks != 1;
+	if (parallel) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_decompress_block, &data, p_block_count, p_tasks, true, SNAME("DecompressBlocks"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < p_block_count && !data.failed.is_set(); i++) {
+			data.decompress_block(i);
+		}
+	}
+
+	ERR_FAIL_COND_V_MSG(data.failed.is_set(), false, "Compressed data is corrupt.");
+	return true;
+}
@@ -43,6 +43,7 @@ public:
 	static inline bool zstd_long_distance_matching = false;
 	static inline int zstd_window_log_size = 27; // ZSTD_WINDOWLOG_LIMIT_DEFAULT
 	static inline int gzip_chunk = 16384;
+	static inline int parallel_min_blocks = 8; // Fewer blocks are (de)compressed on the calling thread. 0 disables parallel mode.
 
 	enum Mode : int32_t {
 		MODE_FASTLZ,
@@ -56,4 +57,14 @@ public:
 	static int64_t get_max_compressed_buffer_size(int64_t p_src_size, Mode p_mode = MODE_ZSTD);
 	static int64_t decompress(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int64_t p_max_dst_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode);
+
+	// Block mode, as laid out by FileAccessCompressed: the source is split in blocks of p_block_size bytes,
+	// the last one holding the remainder (possibly empty), and every block is compressed independently.
+	// With enough blocks, they are processed on the WorkerThreadPool, at most p_tasks at a time (-1 for the pool size).
+	typedef bool (*BlockWriteFunc)(void *p_userdata, const uint8_t *p_data, int64_t p_size);
+	static uint32_t get_block_count(int64_t p_src_size, uint32_t p_block_size) { return p_src_size / p_block_size + 1; }
+	// Hands the compressed blocks to p_write in order, a batch at a time. Stops and returns false on failure.
+	static bool compress_blocks(const uint8_t *p_src, int64_t p_src_size, uint32_t p_block_size, Mode p_mode, BlockWriteFunc p_write, void *p_userdata, int p_tasks = -1);
+	// Decompresses blocks stored back to back in p_src, with the given compressed sizes, into p_dst.
+	static bool decompress_blocks(uint8_t *p_dst, int64_t p_dst_size, const uint8_t *p_src, const uint32_t *p_block_sizes, uint32_t p_block_count, uint32_t p_block_size, Mode p_mode, int p_tasks = -1);
 };
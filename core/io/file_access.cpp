@@ -691,6 +691,17 @@ uint64_t FileAccess::get_access_time(const String &p_file) {
 	return fa->_get_access_time(p_file);
 }
 
+Error FileAccess::set_modified_time(const String &p_file, uint64_t p_time) {
+	if (PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled() && (PackedData::get_singleton()->has_path(p_file) || PackedData::get_singleton()->has_directory(p_file))) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Ref<FileAccess> fa = create_for_path(p_file);
+	ERR_FAIL_COND_V_MSG(fa.is_null(), ERR_CANT_CREATE, vformat("Cannot create FileAccess for path '%s'.", p_file));
+
+	return fa->_set_modified_time(p_file, p_time);
+}
+
 int64_t FileAccess::get_size(const String &p_file) {
 	if (PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled() && (PackedData::get_singleton()->has_path(p_file) || PackedData::get_singleton()->has_directory(p_file))) {
 		return PackedData::get_singleton()->get_size(p_file);
@@ -919,18 +930,11 @@ bool FileAccess::store_buffer(const uint8_t *p_src, uint64_t p_length) {
 }
 
 bool FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
-
-	Vector<uint8_t> buff;
-	buff.resize(len);
-
-	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	LocalVector<uint8_t> buff;
+	Error err = encode_variant(p_var, buff, p_full_objects);
 	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
 
-	return store_32(uint32_t(len)) && store_buffer(buff);
+	return store_32(buff.size()) && store_buffer(buff.ptr(), buff.size());
 }
 
 Vector<uint8_t> FileAccess::get_file_as_bytes(const String &p_path, Error *r_error) {
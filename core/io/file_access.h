@@ -115,6 +115,7 @@ protected:
 	virtual Error open_internal(const String &p_path, int p_mode_flags) = 0; ///< open a file
 	virtual uint64_t _get_modified_time(const String &p_file) = 0;
 	virtual uint64_t _get_access_time(const String &p_file) = 0;
+	virtual Error _set_modified_time(const String &p_file, uint64_t p_time) { return ERR_UNAVAILABLE; }
 	virtual int64_t _get_size(const String &p_file) = 0;
 	virtual void _set_access_type(AccessType p_access);
 
@@ -192,6 +193,7 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual const uint8_t *map_read_only() { return nullptr; } ///< map the whole file into memory for reading, valid until the file is closed. Returns nullptr if not supported.
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -253,6 +255,7 @@ public:
 	static bool exists(const String &p_name); ///< return true if a file exists
 	static uint64_t get_modified_time(const String &p_file);
 	static uint64_t get_access_time(const String &p_file);
+	static Error set_modified_time(const String &p_file, uint64_t p_time);
 	static int64_t get_size(const String &p_file);
 	static BitField<FileAccess::UnixPermissionFlags> get_unix_permissions(const String &p_file);
 	static Error set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions);
@@ -111,11 +111,23 @@ Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags
 	return OK;
 }
 
-void FileAccessCompressed::_close() {
+struct BlockWriter {
+	FileAccess *f = nullptr;
+	LocalVector<uint32_t> block_sizes;
+};
+
+static bool _store_block(void *p_userdata, const uint8_t *p_data, int64_t p_size) {
+	BlockWriter *writer = (BlockWriter *)p_userdata;
+	writer->block_sizes.push_back(p_size);
+	return writer->f->store_buffer(p_data, p_size);
+}
+
+Error FileAccessCompressed::_close() {
 	if (f.is_null()) {
-		return;
+		return OK;
 	}
 
+	Error err = OK;
 	if (writing) {
 		//save block table and all compressed blocks
 
@@ -130,25 +142,13 @@ void FileAccessCompressed::_close() {
 			f->store_32(0); //compressed sizes, will update later
 		}
 
-		uint32_t last_block_size = write_max % block_size;
-
-		// Temporary buffer for compressed data blocks.
-		LocalVector<uint8_t> temp_cblock;
-		temp_cblock.resize(Compression::get_max_compressed_buffer_size(bc == 1 ? last_block_size : block_size, cmode));
-		uint8_t *temp_cblock_ptr = temp_cblock.ptr();
-
-		// Compress and store the blocks.
-		LocalVector<uint32_t> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? last_block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			const int64_t compressed_size = Compression::compress(temp_cblock_ptr, bp, bl, cmode);
-			ERR_FAIL_COND_MSG(compressed_size < 0, "FileAccessCompressed: Error compressing data.");
-
-			f->store_buffer(temp_cblock_ptr, (uint64_t)compressed_size);
-			block_sizes.push_back(compressed_size);
-		}
+		// Compress and store the blocks, in parallel for large files.
+		BlockWriter writer;
+		writer.f = f.ptr();
+		writer.block_sizes.reserve(bc);
+		const bool compressed = Compression::compress_blocks(write_ptr, write_max, block_size, cmode, &_store_block, &writer);
+		ERR_FAIL_COND_V_MSG(!compressed || writer.block_sizes.size() != bc, ERR_FILE_CANT_WRITE, "FileAccessCompressed: Error compressing data.");
+		const LocalVector<uint32_t> &block_sizes = writer.block_sizes;
 
 		f->seek(16); //ok write block sizes
 		for (uint32_t i = 0; i < bc; i++) {
@@ -156,12 +156,72 @@ void FileAccessCompressed::_close() {
 		}
 		f->seek_end();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		if (f->get_error() != OK && f->get_error() != ERR_FILE_EOF) {
+			err = ERR_FILE_CANT_WRITE;
+		}
 	} else {
 		comp_buffer.clear();
+		bulk_comp_buffer.clear();
+		bulk_block_sizes.clear();
 		read_blocks.clear();
 	}
 	buffer.clear();
 	f.unref();
+	return err;
+}
+
+void FileAccessCompressed::_close_task(void *p_userdata) {
+	FileAccessCompressed *fac = (FileAccessCompressed *)p_userdata;
+	fac->close_error = fac->_close();
+	if (fac->close_error != OK) {
+		ERR_PRINT(vformat("FileAccessCompressed: Error writing file asynchronously: %s.", error_names[fac->close_error]));
+	}
+	if (fac->unreference()) {
+		memdelete(fac);
+	}
+}
+
+WorkerThreadPool::TaskID FileAccessCompressed::close_async() {
+	ERR_FAIL_COND_V_MSG(f.is_null(), WorkerThreadPool::INVALID_TASK_ID, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!writing, WorkerThreadPool::INVALID_TASK_ID, "File has not been opened in write mode.");
+
+	close_error = OK;
+	reference(); // Released by the task, so the file outlives the caller's references.
+	return WorkerThreadPool::get_singleton()->add_native_task(&FileAccessCompressed::_close_task, this, false, SNAME("FileAccessCompressedClose"));
+}
+
+// Decompresses the whole blocks following the current one straight into p_dst, in parallel.
+// Leaves the last of them as the current block. Returns the amount of bytes read.
+uint64_t FileAccessCompressed::_read_blocks_bulk(uint8_t *p_dst, uint64_t p_length) const {
+	if (Compression::parallel_min_blocks <= 0) {
+		return 0;
+	}
+	// The last block can be partial, so only the ones before it are read in bulk.
+	const uint32_t first_block = read_block + 1;
+	const uint32_t full_blocks = read_block_count - 1 > first_block ? read_block_count - 1 - first_block : 0;
+	const uint32_t block_count = MIN(uint64_t(full_blocks), p_length / block_size);
+	if (block_count < uint32_t(Compression::parallel_min_blocks)) {
+		return 0;
+	}
+
+	uint64_t csize = 0;
+	bulk_block_sizes.resize(block_count);
+	for (uint32_t i = 0; i < block_count; i++) {
+		bulk_block_sizes[i] = read_blocks[first_block + i].csize;
+		csize += bulk_block_sizes[i];
+	}
+	bulk_comp_buffer.resize(csize);
+	ERR_FAIL_COND_V(f->get_buffer(bulk_comp_buffer.ptr(), csize) != csize, 0);
+
+	const uint64_t size = uint64_t(block_count) * block_size;
+	ERR_FAIL_COND_V_MSG(!Compression::decompress_blocks(p_dst, size, bulk_comp_buffer.ptr(), bulk_block_sizes.ptr(), block_count, block_size, cmode), 0, "Compressed file is corrupt.");
+
+	// Keep the current block consistent for seeking and the next reads.
+	read_block = first_block + block_count - 1;
+	memcpy(buffer.ptrw(), p_dst + size - block_size, block_size);
+	read_block_size = block_size;
+	read_pos = block_size;
+	return size;
 }
 
 bool FileAccessCompressed::is_open() const {
@@ -277,6 +337,15 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 			return p_length;
 		}
 
+		// Large reads decompress whole blocks in parallel, straight into the destination.
+		const uint64_t bulk_read = _read_blocks_bulk(p_dst + dst_idx, p_length - dst_idx);
+		if (bulk_read) {
+			dst_idx += bulk_read;
+			if (dst_idx == p_length) {
+				return p_length;
+			}
+		}
+
 		// We're not done yet; try reading the next block.
 		read_block++;
 
@@ -408,7 +477,7 @@ Error FileAccessCompressed::_set_read_only_attribute(const String &p_file, bool
 }
 
 void FileAccessCompressed::close() {
-	_close();
+	close_error = _close();
 }
 
 FileAccessCompressed::~FileAccessCompressed() {
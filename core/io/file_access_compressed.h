@@ -32,6 +32,7 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 
 class FileAccessCompressed : public FileAccess {
 	GDSOFTCLASS(FileAccessCompressed, FileAccess);
@@ -51,6 +52,8 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
+	mutable LocalVector<uint8_t> bulk_comp_buffer;
+	mutable LocalVector<uint32_t> bulk_block_sizes;
 	uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
@@ -62,8 +65,11 @@ class FileAccessCompressed : public FileAccess {
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
+	Error close_error = OK;
 
-	void _close();
+	Error _close();
+	uint64_t _read_blocks_bulk(uint8_t *p_dst, uint64_t p_length) const;
+	static void _close_task(void *p_userdata);
 
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
@@ -105,6 +111,10 @@ public:
 	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override;
 
 	virtual void close() override;
+	// Compresses and writes the file on the WorkerThreadPool, then closes it. The file must not be used anymore.
+	WorkerThreadPool::TaskID close_async();
+	// Result of the last close, valid after the task of close_async() completed.
+	Error get_close_error() const { return close_error; }
 
 	virtual ~FileAccessCompressed();
 };
@@ -32,7 +32,9 @@
 
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_patched.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
@@ -46,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, bool p_compressed, Compression::Mode p_compression_mode, uint32_t p_compression_block_size) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -56,6 +58,9 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
 	pf.delta = p_delta;
+	pf.compressed = p_compressed;
+	pf.compression_mode = p_compression_mode;
+	pf.compression_block_size = p_compression_block_size;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -181,6 +186,9 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 }
 
 void PackedData::clear() {
+	for (int i = 0; i < sources.size(); i++) {
+		sources[i]->clear();
+	}
 	files.clear();
 	delta_patches.clear();
 	_free_packed_dirs(root);
@@ -291,21 +299,26 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
-	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3 and later.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
+	const uint64_t pack_length = f->get_length();
+	ERR_FAIL_COND_V_MSG(!sparse_bundle && file_base > pack_length, false, vformat("Invalid file base in pack \"%s\".", p_path));
+
+	// The mapping covers the file the pack is in, so offsets stay absolute.
+	Ref<FileAccess> pack_file = f;
 
-	if (version == PACK_FORMAT_VERSION_V3) {
-		// V3: Read directory offset and skip reserved part of the header.
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		// V3 and later: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
 		f->seek(dir_offset);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
@@ -347,18 +360,63 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
+		bool compressed = false;
+		uint32_t compression_mode = Compression::MODE_ZSTD;
+		uint32_t compression_block_size = 0;
+		if (version >= PACK_FORMAT_VERSION_V4 && (flags & PACK_FILE_COMPRESSED)) {
+			compressed = true;
+			compression_mode = f->get_32();
+			compression_block_size = f->get_32();
+			ERR_CONTINUE_MSG(compression_mode > Compression::MODE_BROTLI || compression_block_size == 0, vformat("Invalid compression for \"%s\" in pack \"%s\".", path, p_path));
+			ERR_CONTINUE_MSG((flags & PACK_FILE_ENCRYPTED) || sparse_bundle, vformat("Compressed file \"%s\" in pack \"%s\" can't be encrypted or part of a sparse bundle.", path, p_path));
+		}
+
+		if (!sparse_bundle && !(flags & PACK_FILE_REMOVAL)) {
+			uint64_t stored_size = size;
+			if (compressed) {
+				// Only the table of block sizes is known to be stored, the blocks are checked when the file is opened.
+				stored_size = MIN(size / compression_block_size + (size % compression_block_size != 0), pack_length) * 4;
+			}
+			ERR_CONTINUE_MSG(ofs > pack_length - file_base || stored_size > pack_length - file_base - ofs, vformat("File \"%s\" is outside of pack \"%s\".", path, p_path));
+		}
+
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA));
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA), compressed, Compression::Mode(compression_mode), compression_block_size);
+		}
+	}
+
+	if (!sparse_bundle) {
+		MutexLock lock(mapped_packs_mutex);
+		if (!mapped_packs.has(p_path) && pack_file->map_read_only()) {
+			mapped_packs.insert(p_path, pack_file);
 		}
 	}
 
 	return true;
 }
 
+Ref<FileAccess> PackedSourcePCK::get_mapped_pack(const String &p_pack_path) const {
+	MutexLock lock(mapped_packs_mutex);
+	HashMap<String, Ref<FileAccess>>::ConstIterator E = mapped_packs.find(p_pack_path);
+	if (!E) {
+		return Ref<FileAccess>();
+	}
+	return E->value;
+}
+
+void PackedSourcePCK::clear() {
+	// Open files keep their own reference, so their mappings outlive this.
+	MutexLock lock(mapped_packs_mutex);
+	mapped_packs.clear();
+}
+
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
 	Ref<FileAccess> file(memnew(FileAccessPack(p_path, *p_file)));
+	if (!file->is_open()) {
+		return Ref<FileAccess>();
+	}
 
 	if (PackedData::get_singleton()->has_delta_patches(p_path)) {
 		Ref<FileAccessPatched> file_patched;
@@ -420,12 +478,12 @@ bool FileAccessPack::is_open() const {
 	if (f.is_valid()) {
 		return f->is_open();
 	} else {
-		return false;
+		return mapped != nullptr;
 	}
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!is_open(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -433,7 +491,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid() && !pf.compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -453,8 +513,103 @@ bool FileAccessPack::eof_reached() const {
 	return eof;
 }
 
+bool FileAccessPack::_decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const {
+	const uint64_t size = _get_block_size(p_block);
+	const uint64_t compressed_size = block_offsets[p_block + 1] - block_offsets[p_block];
+	if (compressed_size == size) {
+		// Blocks that don't shrink are stored as is.
+		memcpy(p_dst, p_src, size);
+		return true;
+	}
+	return Compression::decompress(p_dst, size, p_src, compressed_size, pf.compression_mode) == int64_t(size);
+}
+
+void FileAccessPack::_decompress_block_task(uint32_t p_index, BlockDecompression *p_decompression) const {
+	const uint32_t block = p_decompression->first_block + p_index;
+	const uint8_t *src = p_decompression->src + (block_offsets[block] - block_offsets[p_decompression->first_block]);
+	uint8_t *dst = p_decompression->dst + uint64_t(p_index) * pf.compression_block_size;
+	if (!_decompress_block(block, src, dst)) {
+		p_decompression->failed.set();
+	}
+}
+
+bool FileAccessPack::_decompress_blocks(uint32_t p_first_block, uint32_t p_block_count, uint8_t *p_dst) const {
+	const uint64_t src_offset = blocks_offset + block_offsets[p_first_block];
+	const uint64_t src_size = block_offsets[p_first_block + p_block_count] - block_offsets[p_first_block];
+
+	const uint8_t *src = nullptr;
+	if (mapped) {
+		ERR_FAIL_COND_V(src_offset > data_length || src_size > data_length - src_offset, false);
+		src = mapped + src_offset;
+	} else {
+		compressed_buffer.resize(src_size);
+		f->seek(off + src_offset);
+		ERR_FAIL_COND_V(f->get_buffer(compressed_buffer.ptr(), src_size) != src_size, false);
+		src = compressed_buffer.ptr();
+	}
+
+	BlockDecompression decompression;
+	decompression.src = src;
+	decompression.dst = p_dst;
+	decompression.first_block = p_first_block;
+
+	// Large reads are split across worker threads, one block each.
+	if (p_block_count >= 4 && WorkerThreadPool::get_singleton()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FileAccessPack::_decompress_block_task, &decompression, p_block_count, -1, true, SNAME("FileAccessPackDecompress"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < p_block_count; i++) {
+			_decompress_block_task(i, &decompression);
+		}
+	}
+
+	return !decompression.failed.is_set();
+}
+
+bool FileAccessPack::_get_compressed_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	const uint32_t block_count = block_offsets.size() - 1;
+
+	uint64_t read = 0;
+	while (read < p_length) {
+		const uint64_t position = pos + read;
+		const uint32_t block = position / pf.compression_block_size;
+		const uint64_t block_pos = position % pf.compression_block_size;
+		const uint64_t left = p_length - read;
+
+		if (block_pos == 0) {
+			// Whole blocks are decompressed straight into the caller's buffer.
+			uint32_t count = 0;
+			uint64_t size = 0;
+			while (block + count < block_count && size + _get_block_size(block + count) <= left) {
+				size += _get_block_size(block + count);
+				count++;
+			}
+
+			if (count > 0) {
+				ERR_FAIL_COND_V_MSG(!_decompress_blocks(block, count, p_dst + read), false, vformat(R"(Can't decompress pack-referenced file "%s" from pack "%s".)", path, pf.pack));
+				read += size;
+				continue;
+			}
+		}
+
+		// Partially read blocks go through a cache, so small sequential reads decompress each block once.
+		if (cached_block != block) {
+			block_cache.resize(pf.compression_block_size);
+			cached_block = -1;
+			ERR_FAIL_COND_V_MSG(!_decompress_blocks(block, 1, block_cache.ptr()), false, vformat(R"(Can't decompress pack-referenced file "%s" from pack "%s".)", path, pf.pack));
+			cached_block = block;
+		}
+
+		const uint64_t size = MIN(left, _get_block_size(block) - block_pos);
+		memcpy(p_dst + read, block_cache.ptr() + block_pos, size);
+		read += size;
+	}
+
+	return true;
+}
+
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!is_open(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -467,21 +622,38 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
+		pos += to_read;
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (pf.compressed) {
+		if (!_get_compressed_buffer(p_dst, to_read)) {
+			eof = true;
+			return 0;
+		}
+	} else if (mapped) {
+		if (pos + to_read > data_length) {
+			eof = true;
+			ERR_FAIL_V_MSG(0, vformat(R"(Pack-referenced file "%s" is outside of pack "%s".)", path, pf.pack));
+		}
+		memcpy(p_dst, mapped + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+
+	pos += to_read;
 
 	return to_read;
 }
 
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!is_open(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -505,21 +677,37 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped = nullptr;
+	mapped_pack = Ref<FileAccess>();
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) {
 	path = p_path;
 	pf = p_file;
+	pos = 0;
+	eof = false;
+
 	if (pf.bundle) {
 		String simplified_path = p_path.simplify_path();
 		f = FileAccess::open(simplified_path, FileAccess::READ | FileAccess::SKIP_PACK);
 		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from sparse pack "%s".)", simplified_path, pf.pack));
 		off = 0; // For the sparse pack offset is always zero.
 	} else {
-		f = FileAccess::open(pf.pack, FileAccess::READ);
-		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
-		f->seek(pf.offset);
-		off = pf.offset;
+		if (pf.src && !pf.encrypted) {
+			mapped_pack = pf.src->get_mapped_pack(pf.pack);
+		}
+		if (mapped_pack.is_valid()) {
+			// Read straight from the mapping, no file needs to be opened.
+			const uint64_t pack_length = mapped_pack->get_length();
+			mapped = mapped_pack->map_read_only() + MIN(pf.offset, pack_length);
+			data_length = pack_length - MIN(pf.offset, pack_length);
+			off = 0;
+		} else {
+			f = FileAccess::open(pf.pack, FileAccess::READ);
+			ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
+			f->seek(pf.offset);
+			off = pf.offset;
+		}
 	}
 
 	if (pf.encrypted) {
@@ -538,8 +726,42 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
+
+	if (f.is_valid()) {
+		const uint64_t length = f->get_length();
+		data_length = length - MIN(off, length);
+	}
+
+	// The pack directory isn't trusted, files that don't fit in the pack fail to open.
+	if (!pf.compressed && pf.size > data_length) {
+		close();
+		ERR_FAIL_MSG(vformat(R"(Pack-referenced file "%s" is outside of pack "%s".)", p_path, pf.pack));
+	}
+
+	if (pf.compressed) {
+		// Read the table of compressed block sizes.
+		const uint64_t block_count = pf.size / pf.compression_block_size + (pf.size % pf.compression_block_size != 0);
+		if (block_count > data_length / 4) {
+			close();
+			ERR_FAIL_MSG(vformat(R"(Pack-referenced file "%s" is outside of pack "%s".)", p_path, pf.pack));
+		}
+		blocks_offset = block_count * 4;
+		block_offsets.resize(block_count + 1);
+		block_offsets[0] = 0;
+		for (uint32_t i = 0; i < block_count; i++) {
+			const uint32_t compressed_size = mapped ? decode_uint32(mapped + uint64_t(i) * 4) : f->get_32();
+			// Blocks that don't shrink are stored as is, so none is larger than its uncompressed size.
+			if (compressed_size > _get_block_size(i)) {
+				close();
+				ERR_FAIL_MSG(vformat(R"(Invalid compressed block in pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
+			}
+			block_offsets[i + 1] = block_offsets[i] + compressed_size;
+		}
+		if (block_offsets[block_count] > data_length - blocks_offset) {
+			close();
+			ERR_FAIL_MSG(vformat(R"(Pack-referenced file "%s" is outside of pack "%s".)", p_path, pf.pack));
+		}
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -30,20 +30,28 @@
 
 #pragma once
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+#define PACK_FORMAT_VERSION_V4 4
 
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
+#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V4
+
+// Uncompressed size of each independently compressed block of a file.
+#define PACK_COMPRESSION_BLOCK_SIZE (256 * 1024)
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -55,6 +63,7 @@ enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_COMPRESSED = 1 << 3, // V4 only, the entry stores the compression mode and block size.
 };
 
 class PackSource;
@@ -74,6 +83,9 @@ public:
 		bool encrypted;
 		bool bundle;
 		bool delta;
+		bool compressed = false;
+		Compression::Mode compression_mode = Compression::MODE_ZSTD;
+		uint32_t compression_block_size = 0;
 	};
 
 private:
@@ -119,7 +131,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, bool p_compressed = false, Compression::Mode p_compression_mode = Compression::MODE_ZSTD, uint32_t p_compression_block_size = 0); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
@@ -138,6 +150,7 @@ public:
 	_FORCE_INLINE_ bool has_path(const String &p_path);
 
 	_FORCE_INLINE_ int64_t get_size(const String &p_path);
+	_FORCE_INLINE_ int64_t get_offset(const String &p_path);
 
 	_FORCE_INLINE_ Ref<DirAccess> try_open_directory(const String &p_path);
 	_FORCE_INLINE_ bool has_directory(const String &p_path);
@@ -150,13 +163,23 @@ class PackSource {
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) = 0;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) = 0;
+	// Returns the file holding the whole pack mapped into memory, or a null reference if it must be read through FileAccess.
+	// The mapping stays valid while the returned reference is kept.
+	virtual Ref<FileAccess> get_mapped_pack(const String &p_pack_path) const { return Ref<FileAccess>(); }
+	// Called when all packs are unloaded.
+	virtual void clear() {}
 	virtual ~PackSource() {}
 };
 
 class PackedSourcePCK : public PackSource {
+	HashMap<String, Ref<FileAccess>> mapped_packs;
+	mutable Mutex mapped_packs_mutex;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+	virtual Ref<FileAccess> get_mapped_pack(const String &p_pack_path) const override;
+	virtual void clear() override;
 };
 
 class PackedSourceDirectory : public PackSource {
@@ -177,6 +200,33 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	// Start of the file inside the mapped pack, when the pack could be mapped and the file isn't encrypted.
+	const uint8_t *mapped = nullptr;
+	Ref<FileAccess> mapped_pack; // Keeps the mapping alive, even if the pack source releases it.
+	// Bytes from the start of the file to the end of the pack, reads never go past them.
+	uint64_t data_length = 0;
+
+	// Compressed files are split in blocks of pf.compression_block_size bytes, stored after a table with their compressed sizes.
+	uint64_t blocks_offset = 0;
+	LocalVector<uint64_t> block_offsets;
+	mutable LocalVector<uint8_t> block_cache;
+	mutable int64_t cached_block = -1;
+	mutable LocalVector<uint8_t> compressed_buffer;
+
+	struct BlockDecompression {
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		uint32_t first_block = 0;
+		SafeFlag failed;
+	};
+
+	_FORCE_INLINE_ uint64_t _get_block_size(uint32_t p_block) const {
+		return MIN(uint64_t(pf.compression_block_size), pf.size - uint64_t(p_block) * pf.compression_block_size);
+	}
+	bool _decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const;
+	void _decompress_block_task(uint32_t p_index, BlockDecompression *p_decompression) const;
+	bool _decompress_blocks(uint32_t p_first_block, uint32_t p_block_count, uint8_t *p_dst) const;
+	bool _get_compressed_buffer(uint8_t *p_dst, uint64_t p_length) const;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -232,6 +282,16 @@ int64_t PackedData::get_size(const String &p_path) {
 	return E->value.size;
 }
 
+int64_t PackedData::get_offset(const String &p_path) {
+	String simplified_path = p_path.simplify_path().trim_prefix("res://");
+	PathMD5 pmd5(simplified_path.md5_buffer());
+	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
+	if (!E || E->value.offset == 0) {
+		return -1; // File not found or erased.
+	}
+	return E->value.offset;
+}
+
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
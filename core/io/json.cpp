@@ -48,151 +48,6 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-void JSON::_add_indent(String &r_result, const String &p_indent, int p_size) {
-	for (int i = 0; i < p_size; i++) {
-		r_result += p_indent;
-	}
-}
-
-void JSON::_stringify(String &r_result, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
-	if (p_cur_indent > Variant::MAX_RECURSION_DEPTH) {
-		r_result += "...";
-		ERR_FAIL_MSG("JSON structure is too deep. Bailing.");
-	}
-
-	const char *colon = p_indent.is_empty() ? ":" : ": ";
-	const char *end_statement = p_indent.is_empty() ? "" : "\n";
-
-	switch (p_var.get_type()) {
-		case Variant::NIL:
-			r_result += "null";
-			return;
-		case Variant::BOOL:
-			r_result += p_var.operator bool() ? "true" : "false";
-			return;
-		case Variant::INT:
-			r_result += itos(p_var);
-			return;
-		case Variant::FLOAT: {
-			const double num = p_var;
-
-			// JSON does not support NaN or Infinity, so use extremely large numbers for infinity.
-			if (!Math::is_finite(num)) {
-				if (num == Math::INF) {
-					r_result += "1e99999";
-				} else if (num == -Math::INF) {
-					r_result += "-1e99999";
-				} else {
-					WARN_PRINT_ONCE("`NaN` (\"Not a Number\") found in argument passed to JSON.stringify(). `NaN` cannot be represented in JSON, so the value has been replaced with `null`. This warning will not be printed for any later NaN occurrences.");
-					r_result += "null";
-				}
-				return;
-			}
-			// Only for exactly 0. If we have approximately 0 let the user decide how much
-			// precision they want.
-			if (num == double(0.0)) {
-				r_result += "0.0";
-				return;
-			}
-
-			if (p_full_precision) {
-				const String num_sci = String::num_scientific(num);
-				if (num_sci.contains_char('.') || num_sci.contains_char('e')) {
-					r_result += num_sci;
-				} else {
-					r_result += num_sci + ".0";
-				}
-			} else {
-				const double magnitude = std::log10(Math::abs(num));
-				const int precision = MAX(1, 14 - (int)Math::floor(magnitude));
-				r_result += String::num(num, precision);
-			}
-			return;
-		}
-		case Variant::PACKED_INT32_ARRAY:
-		case Variant::PACKED_INT64_ARRAY:
-		case Variant::PACKED_FLOAT32_ARRAY:
-		case Variant::PACKED_FLOAT64_ARRAY:
-		case Variant::PACKED_STRING_ARRAY:
-		case Variant::ARRAY: {
-			Array a = p_var;
-			if (p_markers.has(a.id())) {
-				r_result += "\"[...]\"";
-				ERR_FAIL_MSG("Converting circular structure to JSON.");
-			}
-
-			if (a.is_empty()) {
-				r_result += "[]";
-				return;
-			}
-
-			r_result += '[';
-			r_result += end_statement;
-
-			p_markers.insert(a.id());
-
-			bool first = true;
-			for (const Variant &var : a) {
-				if (first) {
-					first = false;
-				} else {
-					r_result += ',';
-					r_result += end_statement;
-				}
-				_add_indent(r_result, p_indent, p_cur_indent + 1);
-				_stringify(r_result, var, p_indent, p_cur_indent + 1, p_sort_keys, p_markers, p_full_precision);
-			}
-			r_result += end_statement;
-			_add_indent(r_result, p_indent, p_cur_indent);
-			r_result += ']';
-			p_markers.erase(a.id());
-			return;
-		}
-		case Variant::DICTIONARY: {
-			Dictionary d = p_var;
-			if (p_markers.has(d.id())) {
-				r_result += "\"{...}\"";
-				ERR_FAIL_MSG("Converting circular structure to JSON.");
-			}
-
-			r_result += '{';
-			r_result += end_statement;
-			p_markers.insert(d.id());
-
-			LocalVector<Variant> keys = d.get_key_list();
-
-			if (p_sort_keys) {
-				keys.sort_custom<StringLikeVariantOrder>();
-			}
-
-			bool first_key = true;
-			for (const Variant &key : keys) {
-				if (first_key) {
-					first_key = false;
-				} else {
-					r_result += ',';
-					r_result += end_statement;
-				}
-				_add_indent(r_result, p_indent, p_cur_indent + 1);
-				_stringify(r_result, String(key), p_indent, p_cur_indent + 1, p_sort_keys, p_markers, p_full_precision);
-				r_result += colon;
-				_stringify(r_result, d[key], p_indent, p_cur_indent + 1, p_sort_keys, p_markers, p_full_precision);
-			}
-
-			r_result += end_statement;
-			_add_indent(r_result, p_indent, p_cur_indent);
-			r_result += '}';
-			p_markers.erase(d.id());
-			return;
-		}
-		default:
-			r_result += '"';
-			r_result += String(p_var).json_escape();
-			r_result += '"';
-			return;
-	}
-}
-
 Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
 	while (p_len > 0) {
 		switch (p_str[index]) {
@@ -606,15 +461,50 @@ Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	return err;
 }
 
+Error JSON::parse_utf8(const uint8_t *p_data, int64_t p_len) {
+	JSONStreamParser parser;
+	JSONVariantBuilder builder;
+	Error err = parser.parse(p_data, p_len, &builder);
+	data = err == OK ? builder.get_result() : Variant();
+	err_str = parser.get_error_message();
+	err_line = err == OK ? 0 : parser.get_error_line();
+	text.clear();
+	return err;
+}
+
+Error JSON::parse_file(const Ref<FileAccess> &p_file) {
+	JSONStreamParser parser;
+	JSONVariantBuilder builder;
+	Error err = parser.parse_file(p_file, &builder);
+	data = err == OK ? builder.get_result() : Variant();
+	err_str = parser.get_error_message();
+	err_line = err == OK ? 0 : parser.get_error_line();
+	text.clear();
+	return err;
+}
+
 String JSON::get_parsed_text() const {
 	return text;
 }
 
 String JSON::stringify(const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
-	String result;
-	HashSet<const void *> markers;
-	_stringify(result, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
-	return result;
+	LocalVector<uint8_t> buffer;
+	JSONStreamWriter writer(buffer, p_indent, p_sort_keys, p_full_precision);
+	writer.write(p_var);
+	return String::utf8((const char *)buffer.ptr(), buffer.size());
+}
+
+Error JSON::stringify_to_buffer(const Variant &p_var, LocalVector<uint8_t> &r_buffer, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	JSONStreamWriter writer(r_buffer, p_indent, p_sort_keys, p_full_precision);
+	return writer.write(p_var);
+}
+
+Error JSON::stringify_to_file(const Variant &p_var, const Ref<FileAccess> &p_file, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	LocalVector<uint8_t> buffer;
+	JSONStreamWriter writer(buffer, p_indent, p_sort_keys, p_full_precision);
+	writer.set_file(p_file);
+	return writer.write(p_var);
 }
 
 Variant JSON::parse_string(const String &p_json_string) {
@@ -1563,7 +1453,20 @@ Ref<Resource> ResourceFormatLoaderJSON::load(const String &p_path, const String
 	Ref<JSON> json;
 	json.instantiate();
 
-	Error err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	Error err;
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// Keep the text, so the code editor can show it as written.
+		err = json->parse(FileAccess::get_file_as_string(p_path), true);
+	} else {
+		Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ, &err);
+		if (file.is_null()) {
+			if (r_error) {
+				*r_error = err;
+			}
+			return Ref<Resource>();
+		}
+		err = json->parse_file(file);
+	}
 	if (err != OK) {
 		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(json->get_error_line()) + ": " + json->get_error_message();
 
@@ -1605,14 +1508,17 @@ Error ResourceFormatSaverJSON::save(const Ref<Resource> &p_resource, const Strin
 	Ref<JSON> json = p_resource;
 	ERR_FAIL_COND_V(json.is_null(), ERR_INVALID_PARAMETER);
 
-	String source = json->get_parsed_text().is_empty() ? JSON::stringify(json->get_data(), "\t", false, true) : json->get_parsed_text();
-
 	Error err;
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
 
 	ERR_FAIL_COND_V_MSG(err, err, vformat("Cannot save json '%s'.", p_path));
 
-	file->store_string(source);
+	if (json->get_parsed_text().is_empty()) {
+		err = JSON::stringify_to_file(json->get_data(), file, "\t", false, true);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot save json '%s'.", p_path));
+	} else {
+		file->store_string(json->get_parsed_text());
+	}
 	if (file->get_error() != OK && file->get_error() != ERR_FILE_EOF) {
 		return ERR_CANT_CREATE;
 	}
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/io/json_stream.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -71,8 +72,6 @@ class JSON : public Resource {
 
 	static const char *tk_name[];
 
-	static void _add_indent(String &r_result, const String &p_indent, int p_size);
-	static void _stringify(String &r_result, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision);
 	static Error _get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
 	static Error _parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
 	static Error _parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
@@ -87,9 +86,17 @@ protected:
 
 public:
 	Error parse(const String &p_json_string, bool p_keep_text = false);
+	// Parses UTF-8 text directly, without converting it to a String first. The text isn't kept.
+	Error parse_utf8(const uint8_t *p_data, int64_t p_len);
+	// Parses the file from its current position, reading it in chunks.
+	Error parse_file(const Ref<FileAccess> &p_file);
 	String get_parsed_text() const;
 
 	static String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	// Appends the UTF-8 JSON text to `r_buffer`, which can be reused between calls.
+	static Error stringify_to_buffer(const Variant &p_var, LocalVector<uint8_t> &r_buffer, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	// Writes the UTF-8 JSON text to the file as it's generated.
+	static Error stringify_to_file(const Variant &p_var, const Ref<FileAccess> &p_file, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
 	static Variant parse_string(const String &p_json_string);
 
 	_FORCE_INLINE_ static Variant from_native(const Variant &p_variant, bool p_full_objects = false) {
@@ -0,0 +1,1006 @@
+/**************************************************************************/
+/*  json_stream.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_stream.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON_STREAM_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JSON_STREAM_NEON
+#include <arm_neon.h>
+#endif
+
+// Returns the index of the first byte in [p_from, p_to) that ends a plain run of string
+// characters (a quote, a backslash, a line break or a null byte), or `p_to` if there is none.
+static _FORCE_INLINE_ int64_t _find_string_special(const uint8_t *p_data, int64_t p_from, int64_t p_to) {
+	int64_t i = p_from;
+#if defined(JSON_STREAM_SSE2)
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i newline = _mm_set1_epi8('\n');
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_to; i += 16) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i *)(p_data + i));
+		const __m128i special = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, zero)));
+		if (_mm_movemask_epi8(special) != 0) {
+			break;
+		}
+	}
+#elif defined(JSON_STREAM_NEON)
+	const uint8x16_t quote = vdupq_n_u8('"');
+	const uint8x16_t backslash = vdupq_n_u8('\\');
+	const uint8x16_t newline = vdupq_n_u8('\n');
+	for (; i + 16 <= p_to; i += 16) {
+		const uint8x16_t chunk = vld1q_u8(p_data + i);
+		const uint8x16_t special = vorrq_u8(
+				vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)),
+				vorrq_u8(vceqq_u8(chunk, newline), vceqzq_u8(chunk)));
+		if (vmaxvq_u8(special) != 0) {
+			break;
+		}
+	}
+#else
+	// Test eight bytes at a time for a zero byte after XORing with each special character.
+#define JSON_HAS_ZERO_BYTE(m_v) (((m_v) - 0x0101010101010101ULL) & ~(m_v) & 0x8080808080808080ULL)
+	for (; i + 8 <= p_to; i += 8) {
+		uint64_t word;
+		memcpy(&word, p_data + i, 8);
+		if (JSON_HAS_ZERO_BYTE(word ^ 0x2222222222222222ULL) || JSON_HAS_ZERO_BYTE(word ^ 0x5c5c5c5c5c5c5c5cULL) ||
+				JSON_HAS_ZERO_BYTE(word ^ 0x0a0a0a0a0a0a0a0aULL) || JSON_HAS_ZERO_BYTE(word)) {
+			break;
+		}
+	}
+#undef JSON_HAS_ZERO_BYTE
+#endif
+	// Find the exact byte within the block that matched, and handle the tail.
+	for (; i < p_to; i++) {
+		const uint8_t c = p_data[i];
+		if (c == '"' || c == '\\' || c == '\n' || c == 0) {
+			return i;
+		}
+	}
+	return p_to;
+}
+
+static _FORCE_INLINE_ void _append_utf8(LocalVector<char> &r_buffer, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_buffer.push_back(char(p_char));
+	} else if (p_char < 0x800) {
+		r_buffer.push_back(char(0xc0 | (p_char >> 6)));
+		r_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	} else if (p_char < 0x10000) {
+		r_buffer.push_back(char(0xe0 | (p_char >> 12)));
+		r_buffer.push_back(char(0x80 | ((p_char >> 6) & 0x3f)));
+		r_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	} else {
+		r_buffer.push_back(char(0xf0 | (p_char >> 18)));
+		r_buffer.push_back(char(0x80 | ((p_char >> 12) & 0x3f)));
+		r_buffer.push_back(char(0x80 | ((p_char >> 6) & 0x3f)));
+		r_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	}
+}
+
+/// JSONVariantBuilder
+
+void JSONVariantBuilder::_add(const Variant &p_value) {
+	if (stack.is_empty()) {
+		result = p_value;
+		return;
+	}
+	Container &container = stack[stack.size() - 1];
+	if (container.is_object) {
+		container.object[container.key] = p_value;
+	} else {
+		container.array.push_back(p_value);
+	}
+}
+
+bool JSONVariantBuilder::begin_object() {
+	Container container;
+	container.is_object = true;
+	stack.push_back(container);
+	return true;
+}
+
+bool JSONVariantBuilder::end_object() {
+	const Dictionary object = stack[stack.size() - 1].object;
+	stack.resize(stack.size() - 1);
+	_add(object);
+	return true;
+}
+
+bool JSONVariantBuilder::begin_array() {
+	stack.push_back(Container());
+	return true;
+}
+
+bool JSONVariantBuilder::end_array() {
+	const Array array = stack[stack.size() - 1].array;
+	stack.resize(stack.size() - 1);
+	_add(array);
+	return true;
+}
+
+bool JSONVariantBuilder::key(const String &p_key) {
+	stack[stack.size() - 1].key = p_key;
+	return true;
+}
+
+bool JSONVariantBuilder::value(const Variant &p_value) {
+	_add(p_value);
+	return true;
+}
+
+void JSONVariantBuilder::clear() {
+	stack.clear();
+	result = Variant();
+}
+
+/// JSONStreamParser
+
+const char *JSONStreamParser::tk_name[TK_MAX] = {
+	"'{'",
+	"'}'",
+	"'['",
+	"']'",
+	"identifier",
+	"string",
+	"number",
+	"':'",
+	"','",
+	"EOF",
+};
+
+bool JSONStreamParser::_refill(int64_t p_keep_from) {
+	if (file.is_null()) {
+		return false;
+	}
+
+	// Keep the unread part of the current token, if any, at the start of the buffer.
+	const int64_t kept = len - p_keep_from;
+	if (kept > 0 && p_keep_from > 0) {
+		memmove(buffer.ptr(), buffer.ptr() + p_keep_from, kept);
+	}
+	if (buffer.size() < kept + READ_CHUNK_SIZE) {
+		buffer.resize(kept + READ_CHUNK_SIZE);
+	}
+	const uint64_t read = file->get_buffer(buffer.ptr() + kept, READ_CHUNK_SIZE);
+
+	data = buffer.ptr();
+	pos -= p_keep_from;
+	len = kept + read;
+	return read > 0;
+}
+
+int JSONStreamParser::_next_byte() {
+	if (pos == len && !_refill(pos)) {
+		return -1;
+	}
+	return data[pos++];
+}
+
+Error JSONStreamParser::_parse_hex(char32_t &r_value) {
+	r_value = 0;
+	for (int j = 0; j < 4; j++) {
+		const int c = _next_byte();
+		if (c <= 0) {
+			err_str = "Unterminated string";
+			return ERR_PARSE_ERROR;
+		}
+		if (!is_hex_digit(c)) {
+			err_str = "Malformed hex constant in string";
+			return ERR_PARSE_ERROR;
+		}
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else {
+			v = c - 'A' + 10;
+		}
+		r_value = (r_value << 4) | v;
+	}
+	return OK;
+}
+
+Error JSONStreamParser::_parse_escape() {
+	const int next = _next_byte();
+	if (next <= 0) {
+		err_str = "Unterminated string";
+		return ERR_PARSE_ERROR;
+	}
+
+	switch (next) {
+		case 'b':
+			string_buffer.push_back('\b');
+			break;
+		case 't':
+			string_buffer.push_back('\t');
+			break;
+		case 'n':
+			string_buffer.push_back('\n');
+			break;
+		case 'f':
+			string_buffer.push_back('\f');
+			break;
+		case 'r':
+			string_buffer.push_back('\r');
+			break;
+		case '"':
+		case '\\':
+		case '/':
+			string_buffer.push_back(char(next));
+			break;
+		case 'u': {
+			char32_t res;
+			Error err = _parse_hex(res);
+			if (err != OK) {
+				return err;
+			}
+
+			if ((res & 0xfffffc00) == 0xd800) {
+				if (_next_byte() != '\\' || _next_byte() != 'u') {
+					err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+					return ERR_PARSE_ERROR;
+				}
+				char32_t trail;
+				err = _parse_hex(trail);
+				if (err != OK) {
+					return err;
+				}
+				if ((trail & 0xfffffc00) != 0xdc00) {
+					err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+					return ERR_PARSE_ERROR;
+				}
+				res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+			} else if ((res & 0xfffffc00) == 0xdc00) {
+				err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+				return ERR_PARSE_ERROR;
+			}
+
+			_append_utf8(string_buffer, res);
+		} break;
+		default: {
+			err_str = "Invalid escape sequence";
+			return ERR_PARSE_ERROR;
+		}
+	}
+	return OK;
+}
+
+void JSONStreamParser::_buffer_string_run(int64_t p_from) {
+	const int64_t run_length = pos - p_from;
+	if (run_length > 0) {
+		const uint32_t size = string_buffer.size();
+		string_buffer.resize(size + run_length);
+		memcpy(string_buffer.ptr() + size, data + p_from, run_length);
+	}
+}
+
+Error JSONStreamParser::_parse_string() {
+	// Plain runs are decoded straight from the input. Only strings with escapes, or split
+	// across reads, are gathered in `string_buffer` first.
+	bool buffered = false;
+	string_buffer.clear();
+
+	int64_t run_start = pos;
+	while (true) {
+		pos = _find_string_special(data, pos, len);
+
+		if (pos == len) {
+			_buffer_string_run(run_start);
+			buffered = true;
+			if (!_refill(pos)) {
+				err_str = "Unterminated string";
+				return ERR_PARSE_ERROR;
+			}
+			run_start = pos;
+			continue;
+		}
+
+		const uint8_t c = data[pos];
+		if (c == '\n') {
+			line++;
+			pos++;
+			continue;
+		}
+		if (c == 0) {
+			err_str = "Unterminated string";
+			return ERR_PARSE_ERROR;
+		}
+
+		if (!buffered && c == '"') {
+			token_string = String::utf8((const char *)data + run_start, pos - run_start);
+			pos++;
+			return OK;
+		}
+
+		_buffer_string_run(run_start);
+		buffered = true;
+		pos++;
+
+		if (c == '"') {
+			token_string = String::utf8(string_buffer.ptr(), string_buffer.size());
+			return OK;
+		}
+
+		Error err = _parse_escape();
+		if (err != OK) {
+			return err;
+		}
+		run_start = pos;
+	}
+}
+
+Error JSONStreamParser::_get_token(TokenType &r_type) {
+	while (true) {
+		if (pos == len && !_refill(pos)) {
+			r_type = TK_EOF;
+			return OK;
+		}
+
+		const uint8_t c = data[pos];
+		switch (c) {
+			case '\n': {
+				line++;
+				pos++;
+			} break;
+			case 0: {
+				r_type = TK_EOF;
+				return OK;
+			}
+			case '{': {
+				r_type = TK_CURLY_BRACKET_OPEN;
+				pos++;
+				return OK;
+			}
+			case '}': {
+				r_type = TK_CURLY_BRACKET_CLOSE;
+				pos++;
+				return OK;
+			}
+			case '[': {
+				r_type = TK_BRACKET_OPEN;
+				pos++;
+				return OK;
+			}
+			case ']': {
+				r_type = TK_BRACKET_CLOSE;
+				pos++;
+				return OK;
+			}
+			case ':': {
+				r_type = TK_COLON;
+				pos++;
+				return OK;
+			}
+			case ',': {
+				r_type = TK_COMMA;
+				pos++;
+				return OK;
+			}
+			case '"': {
+				pos++;
+				r_type = TK_STRING;
+				return _parse_string();
+			}
+			default: {
+				if (c <= 32) {
+					pos++;
+					break;
+				}
+
+				if (c == '-' || is_digit(c)) {
+					// Find the characters the number can span, so it can be parsed from a null-terminated copy.
+					int64_t start = pos;
+					while (true) {
+						while (pos < len && (is_digit(data[pos]) || data[pos] == '-' || data[pos] == '+' || data[pos] == '.' || data[pos] == 'e' || data[pos] == 'E')) {
+							pos++;
+						}
+						if (pos < len) {
+							break;
+						}
+						// Reached the end of the buffer, keep the token and read more.
+						const int64_t scanned = pos - start;
+						const bool more = _refill(start);
+						start = pos - scanned;
+						if (!more) {
+							break;
+						}
+					}
+
+					number_buffer.resize(pos - start + 1);
+					memcpy(number_buffer.ptr(), data + start, pos - start);
+					number_buffer[pos - start] = 0;
+
+					const char *end = nullptr;
+					token_number = String::to_float(number_buffer.ptr(), &end);
+					pos = start + (end - number_buffer.ptr());
+					r_type = TK_NUMBER;
+					return OK;
+				} else if (is_ascii_alphabet_char(c)) {
+					int64_t start = pos;
+					while (true) {
+						while (pos < len && is_ascii_alphabet_char(data[pos])) {
+							pos++;
+						}
+						if (pos < len) {
+							break;
+						}
+						// Reached the end of the buffer, keep the token and read more.
+						const int64_t scanned = pos - start;
+						const bool more = _refill(start);
+						start = pos - scanned;
+						if (!more) {
+							break;
+						}
+					}
+
+					token_string = String::utf8((const char *)data + start, pos - start);
+					r_type = TK_IDENTIFIER;
+					return OK;
+				} else {
+					err_str = "Unexpected character";
+					return ERR_PARSE_ERROR;
+				}
+			}
+		}
+	}
+}
+
+Error JSONStreamParser::_parse_document(JSONStreamHandler *p_handler) {
+	enum State {
+		STATE_VALUE,
+		STATE_AFTER_VALUE,
+		STATE_ARRAY_ELEMENT,
+		STATE_OBJECT_KEY,
+	};
+
+	// Containers are tracked on an explicit stack, so deep documents don't use the call stack.
+	LocalVector<bool> is_object;
+	State state = STATE_VALUE;
+	bool need_comma = false;
+	TokenType token;
+
+	Error err = _get_token(token);
+	if (err != OK) {
+		return err;
+	}
+
+#define JSON_HANDLER_CALL(m_call)                   \
+	if (unlikely(!(m_call))) {                      \
+		err_str = "Parsing stopped by the handler"; \
+		return ERR_SKIP;                            \
+	}
+
+	while (true) {
+		switch (state) {
+			case STATE_VALUE: {
+				if ((int)is_object.size() > Variant::MAX_RECURSION_DEPTH) {
+					err_str = "JSON structure is too deep";
+					return ERR_OUT_OF_MEMORY;
+				}
+
+				state = STATE_AFTER_VALUE;
+				if (token == TK_CURLY_BRACKET_OPEN) {
+					JSON_HANDLER_CALL(p_handler->begin_object());
+					is_object.push_back(true);
+					state = STATE_OBJECT_KEY;
+					need_comma = false;
+				} else if (token == TK_BRACKET_OPEN) {
+					JSON_HANDLER_CALL(p_handler->begin_array());
+					is_object.push_back(false);
+					state = STATE_ARRAY_ELEMENT;
+					need_comma = false;
+				} else if (token == TK_IDENTIFIER) {
+					if (token_string == "true") {
+						JSON_HANDLER_CALL(p_handler->value(true));
+					} else if (token_string == "false") {
+						JSON_HANDLER_CALL(p_handler->value(false));
+					} else if (token_string == "null") {
+						JSON_HANDLER_CALL(p_handler->value(Variant()));
+					} else {
+						err_str = vformat("Expected 'true', 'false', or 'null', got '%s'", token_string);
+						return ERR_PARSE_ERROR;
+					}
+				} else if (token == TK_NUMBER) {
+					JSON_HANDLER_CALL(p_handler->value(token_number));
+				} else if (token == TK_STRING) {
+					JSON_HANDLER_CALL(p_handler->value(token_string));
+				} else {
+					err_str = vformat("Expected value, got '%s'", String(tk_name[token]));
+					return ERR_PARSE_ERROR;
+				}
+			} break;
+
+			case STATE_AFTER_VALUE: {
+				if (is_object.is_empty()) {
+					err = _get_token(token);
+					if (err != OK || token != TK_EOF) {
+						err_str = "Expected 'EOF'";
+						return ERR_PARSE_ERROR;
+					}
+					return OK;
+				}
+				state = is_object[is_object.size() - 1] ? STATE_OBJECT_KEY : STATE_ARRAY_ELEMENT;
+				need_comma = true;
+			} break;
+
+			case STATE_ARRAY_ELEMENT: {
+				err = _get_token(token);
+				if (err != OK) {
+					return err;
+				}
+
+				if (token == TK_BRACKET_CLOSE) {
+					JSON_HANDLER_CALL(p_handler->end_array());
+					is_object.resize(is_object.size() - 1);
+					state = STATE_AFTER_VALUE;
+				} else if (token == TK_EOF) {
+					err_str = "Expected ']'";
+					return ERR_PARSE_ERROR;
+				} else if (need_comma) {
+					if (token != TK_COMMA) {
+						err_str = "Expected ','";
+						return ERR_PARSE_ERROR;
+					}
+					need_comma = false;
+				} else {
+					state = STATE_VALUE;
+				}
+			} break;
+
+			case STATE_OBJECT_KEY: {
+				err = _get_token(token);
+				if (err != OK) {
+					return err;
+				}
+
+				if (token == TK_CURLY_BRACKET_CLOSE) {
+					JSON_HANDLER_CALL(p_handler->end_object());
+					is_object.resize(is_object.size() - 1);
+					state = STATE_AFTER_VALUE;
+					break;
+				}
+				if (token == TK_EOF) {
+					err_str = "Expected '}'";
+					return ERR_PARSE_ERROR;
+				}
+				if (need_comma) {
+					if (token != TK_COMMA) {
+						err_str = "Expected '}' or ','";
+						return ERR_PARSE_ERROR;
+					}
+					need_comma = false;
+					break;
+				}
+
+				if (token != TK_STRING) {
+					err_str = "Expected key";
+					return ERR_PARSE_ERROR;
+				}
+				JSON_HANDLER_CALL(p_handler->key(token_string));
+
+				err = _get_token(token);
+				if (err != OK) {
+					return err;
+				}
+				if (token != TK_COLON) {
+					err_str = "Expected ':'";
+					return ERR_PARSE_ERROR;
+				}
+
+				err = _get_token(token);
+				if (err != OK) {
+					return err;
+				}
+				state = STATE_VALUE;
+			} break;
+		}
+	}
+
+#undef JSON_HANDLER_CALL
+}
+
+Error JSONStreamParser::parse(const uint8_t *p_data, int64_t p_len, JSONStreamHandler *p_handler) {
+	ERR_FAIL_NULL_V(p_handler, ERR_INVALID_PARAMETER);
+
+	file.unref();
+	data = p_data;
+	pos = 0;
+	len = p_len;
+	line = 0;
+	err_str = String();
+
+	// Skip the UTF-8 byte order mark, if any.
+	if (len >= 3 && data[0] == 0xef && data[1] == 0xbb && data[2] == 0xbf) {
+		pos = 3;
+	}
+
+	Error err = _parse_document(p_handler);
+	data = nullptr;
+	return err;
+}
+
+Error JSONStreamParser::parse_file(const Ref<FileAccess> &p_file, JSONStreamHandler *p_handler) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_NULL_V(p_handler, ERR_INVALID_PARAMETER);
+
+	file = p_file;
+	data = buffer.ptr();
+	pos = 0;
+	len = 0;
+	line = 0;
+	err_str = String();
+
+	// Skip the UTF-8 byte order mark, if any.
+	if (_refill(0) && len >= 3 && data[0] == 0xef && data[1] == 0xbb && data[2] == 0xbf) {
+		pos = 3;
+	}
+
+	Error err = _parse_document(p_handler);
+	file.unref();
+	data = nullptr;
+	return err;
+}
+
+/// JSONStreamWriter
+
+JSONStreamWriter::JSONStreamWriter(LocalVector<uint8_t> &r_buffer, const String &p_indent, bool p_sort_keys, bool p_full_precision) :
+		buffer(r_buffer),
+		indent(p_indent.utf8()),
+		sort_keys(p_sort_keys),
+		full_precision(p_full_precision) {
+}
+
+void JSONStreamWriter::_flush() {
+	if (file.is_valid() && !buffer.is_empty()) {
+		if (!file->store_buffer(buffer.ptr(), buffer.size())) {
+			error = ERR_FILE_CANT_WRITE;
+		}
+		buffer.clear();
+	}
+}
+
+void JSONStreamWriter::_write(const char *p_str, uint32_t p_len) {
+	const uint32_t size = buffer.size();
+	buffer.resize(size + p_len);
+	memcpy(buffer.ptr() + size, p_str, p_len);
+}
+
+void JSONStreamWriter::_write_ascii(const String &p_str) {
+	const char32_t *str = p_str.ptr();
+	const int length = p_str.length();
+	const uint32_t size = buffer.size();
+	buffer.resize(size + length);
+	for (int i = 0; i < length; i++) {
+		buffer[size + i] = uint8_t(str[i]);
+	}
+}
+
+void JSONStreamWriter::_write_indent(int p_level) {
+	for (int i = 0; i < p_level; i++) {
+		_write(indent.get_data(), indent.length());
+	}
+}
+
+void JSONStreamWriter::_write_string(const String &p_str) {
+	// Same escaping as String::json_escape(), encoded as UTF-8 in the same pass.
+	buffer.push_back('"');
+	const char32_t *str = p_str.ptr();
+	const int length = p_str.length();
+	for (int i = 0; i < length; i++) {
+		char32_t c = str[i];
+		switch (c) {
+			case '\\':
+				_write("\\\\", 2);
+				break;
+			case '\b':
+				_write("\\b", 2);
+				break;
+			case '\f':
+				_write("\\f", 2);
+				break;
+			case '\n':
+				_write("\\n", 2);
+				break;
+			case '\r':
+				_write("\\r", 2);
+				break;
+			case '\t':
+				_write("\\t", 2);
+				break;
+			case '\v':
+				_write("\\v", 2);
+				break;
+			case '"':
+				_write("\\\"", 2);
+				break;
+			default: {
+				if (c < 0x80) {
+					buffer.push_back(uint8_t(c));
+				} else {
+					if ((c >= 0xd800 && c <= 0xdfff) || c > 0x10ffff) {
+						c = 0xfffd;
+					}
+					char encoded[4];
+					uint32_t count;
+					if (c < 0x800) {
+						encoded[0] = char(0xc0 | (c >> 6));
+						encoded[1] = char(0x80 | (c & 0x3f));
+						count = 2;
+					} else if (c < 0x10000) {
+						encoded[0] = char(0xe0 | (c >> 12));
+						encoded[1] = char(0x80 | ((c >> 6) & 0x3f));
+						encoded[2] = char(0x80 | (c & 0x3f));
+						count = 3;
+					} else {
+						encoded[0] = char(0xf0 | (c >> 18));
+						encoded[1] = char(0x80 | ((c >> 12) & 0x3f));
+						encoded[2] = char(0x80 | ((c >> 6) & 0x3f));
+						encoded[3] = char(0x80 | (c & 0x3f));
+						count = 4;
+					}
+					_write(encoded, count);
+				}
+			} break;
+		}
+	}
+	buffer.push_back('"');
+}
+
+void JSONStreamWriter::_write_int(int64_t p_value) {
+	char digits[24];
+	int count = 0;
+	uint64_t value = p_value < 0 ? uint64_t(0) - uint64_t(p_value) : uint64_t(p_value);
+	do {
+		digits[count++] = char('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	if (p_value < 0) {
+		digits[count++] = '-';
+	}
+	for (int i = count - 1; i >= 0; i--) {
+		buffer.push_back(digits[i]);
+	}
+}
+
+void JSONStreamWriter::_write_float(double p_value) {
+	// JSON does not support NaN or Infinity, so use extremely large numbers for infinity.
+	if (!Math::is_finite(p_value)) {
+		if (p_value == Math::INF) {
+			_write("1e99999", 7);
+		} else if (p_value == -Math::INF) {
+			_write("-1e99999", 8);
+		} else {
+			WARN_PRINT_ONCE("`NaN` (\"Not a Number\") found in argument passed to JSON.stringify(). `NaN` cannot be represented in JSON, so the value has been replaced with `null`. This warning will not be printed for any later NaN occurrences.");
+			_write("null", 4);
+		}
+		return;
+	}
+	// Only for exactly 0. If we have approximately 0 let the user decide how much
+	// precision they want.
+	if (p_value == double(0.0)) {
+		_write("0.0", 3);
+		return;
+	}
+
+	if (full_precision) {
+		const String num_sci = String::num_scientific(p_value);
+		_write_ascii(num_sci);
+		if (!num_sci.contains_char('.') && !num_sci.contains_char('e')) {
+			_write(".0", 2);
+		}
+	} else {
+		const double magnitude = std::log10(Math::abs(p_value));
+		const int precision = MAX(1, 14 - (int)Math::floor(magnitude));
+		_write_ascii(String::num(p_value, precision));
+	}
+}
+
+template <typename T>
+void JSONStreamWriter::_write_packed_array(const Vector<T> &p_array, int p_cur_indent) {
+	if (p_array.is_empty()) {
+		_write("[]", 2);
+		return;
+	}
+
+	buffer.push_back('[');
+	if (indent.length()) {
+		buffer.push_back('\n');
+	}
+	for (int i = 0; i < p_array.size(); i++) {
+		if (i > 0) {
+			buffer.push_back(',');
+			if (indent.length()) {
+				buffer.push_back('\n');
+			}
+		}
+		_write_indent(p_cur_indent + 1);
+		_write_value(p_array[i], p_cur_indent + 1);
+	}
+	if (indent.length()) {
+		buffer.push_back('\n');
+	}
+	_write_indent(p_cur_indent);
+	buffer.push_back(']');
+}
+
+void JSONStreamWriter::_write_value(const Variant &p_var, int p_cur_indent) {
+	if (p_cur_indent > Variant::MAX_RECURSION_DEPTH) {
+		_write("...", 3);
+		error = ERR_OUT_OF_MEMORY;
+		ERR_FAIL_MSG("JSON structure is too deep. Bailing.");
+	}
+
+	if (file.is_valid() && buffer.size() >= FLUSH_SIZE) {
+		_flush();
+	}
+
+	const bool pretty = indent.length() > 0;
+
+	switch (p_var.get_type()) {
+		case Variant::NIL:
+			_write("null", 4);
+			return;
+		case Variant::BOOL:
+			if (p_var.operator bool()) {
+				_write("true", 4);
+			} else {
+				_write("false", 5);
+			}
+			return;
+		case Variant::INT:
+			_write_int(p_var);
+			return;
+		case Variant::FLOAT:
+			_write_float(p_var);
+			return;
+		case Variant::PACKED_INT32_ARRAY:
+			_write_packed_array(PackedInt32Array(p_var), p_cur_indent);
+			return;
+		case Variant::PACKED_INT64_ARRAY:
+			_write_packed_array(PackedInt64Array(p_var), p_cur_indent);
+			return;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			_write_packed_array(PackedFloat32Array(p_var), p_cur_indent);
+			return;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			_write_packed_array(PackedFloat64Array(p_var), p_cur_indent);
+			return;
+		case Variant::PACKED_STRING_ARRAY:
+			_write_packed_array(PackedStringArray(p_var), p_cur_indent);
+			return;
+		case Variant::ARRAY: {
+			const Array a = p_var;
+			if (markers.has(a.id())) {
+				_write("\"[...]\"", 7);
+				error = ERR_INVALID_DATA;
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+
+			if (a.is_empty()) {
+				_write("[]", 2);
+				return;
+			}
+
+			buffer.push_back('[');
+			if (pretty) {
+				buffer.push_back('\n');
+			}
+
+			markers.insert(a.id());
+
+			bool first = true;
+			for (const Variant &var : a) {
+				if (first) {
+					first = false;
+				} else {
+					buffer.push_back(',');
+					if (pretty) {
+						buffer.push_back('\n');
+					}
+				}
+				_write_indent(p_cur_indent + 1);
+				_write_value(var, p_cur_indent + 1);
+			}
+			if (pretty) {
+				buffer.push_back('\n');
+			}
+			_write_indent(p_cur_indent);
+			buffer.push_back(']');
+			markers.erase(a.id());
+			return;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary d = p_var;
+			if (markers.has(d.id())) {
+				_write("\"{...}\"", 7);
+				error = ERR_INVALID_DATA;
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+
+			buffer.push_back('{');
+			if (pretty) {
+				buffer.push_back('\n');
+			}
+			markers.insert(d.id());
+
+			LocalVector<Variant> keys = d.get_key_list();
+
+			if (sort_keys) {
+				keys.sort_custom<StringLikeVariantOrder>();
+			}
+
+			bool first_key = true;
+			for (const Variant &key : keys) {
+				if (first_key) {
+					first_key = false;
+				} else {
+					buffer.push_back(',');
+					if (pretty) {
+						buffer.push_back('\n');
+					}
+				}
+				_write_indent(p_cur_indent + 1);
+				_write_value(String(key), p_cur_indent + 1);
+				if (pretty) {
+					_write(": ", 2);
+				} else {
+					buffer.push_back(':');
+				}
+				_write_value(d[key], p_cur_indent + 1);
+			}
+
+			if (pretty) {
+				buffer.push_back('\n');
+			}
+			_write_indent(p_cur_indent);
+			buffer.push_back('}');
+			markers.erase(d.id());
+			return;
+		}
+		default:
+			_write_string(p_var);
+			return;
+	}
+}
+
+Error JSONStreamWriter::write(const Variant &p_var) {
+	error = OK;
+	markers.clear();
+	_write_value(p_var, 0);
+	_flush();
+	return error;
+}
@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  json_stream.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Receives the contents of a JSON document while JSONStreamParser reads it.
+// Numbers are reported as floats, like JSON::parse() does. Return `false` to stop parsing.
+class JSONStreamHandler {
+public:
+	virtual bool begin_object() { return true; }
+	virtual bool end_object() { return true; }
+	virtual bool begin_array() { return true; }
+	virtual bool end_array() { return true; }
+	virtual bool key(const String &p_key) { return true; }
+	virtual bool value(const Variant &p_value) { return true; }
+
+	virtual ~JSONStreamHandler() {}
+};
+
+// Builds the Variant described by a JSON document, like JSON::parse() does.
+class JSONVariantBuilder : public JSONStreamHandler {
+	struct Container {
+		Dictionary object;
+		Array array;
+		String key;
+		bool is_object = false;
+	};
+
+	LocalVector<Container> stack;
+	Variant result;
+
+	void _add(const Variant &p_value);
+
+public:
+	virtual bool begin_object() override;
+	virtual bool end_object() override;
+	virtual bool begin_array() override;
+	virtual bool end_array() override;
+	virtual bool key(const String &p_key) override;
+	virtual bool value(const Variant &p_value) override;
+
+	const Variant &get_result() const { return result; }
+	void clear();
+};
+
+// Parses UTF-8 JSON without converting it to a String first, either from memory or
+// by reading a file in chunks. It accepts the same documents as JSON::parse().
+class JSONStreamParser {
+	enum TokenType {
+		TK_CURLY_BRACKET_OPEN,
+		TK_CURLY_BRACKET_CLOSE,
+		TK_BRACKET_OPEN,
+		TK_BRACKET_CLOSE,
+		TK_IDENTIFIER,
+		TK_STRING,
+		TK_NUMBER,
+		TK_COLON,
+		TK_COMMA,
+		TK_EOF,
+		TK_MAX
+	};
+
+	static const char *tk_name[];
+	static constexpr int64_t READ_CHUNK_SIZE = 65536;
+
+	Ref<FileAccess> file;
+	LocalVector<uint8_t> buffer;
+	const uint8_t *data = nullptr;
+	int64_t pos = 0;
+	int64_t len = 0;
+
+	LocalVector<char> string_buffer;
+	LocalVector<char> number_buffer;
+	String token_string;
+	double token_number = 0.0;
+
+	int line = 0;
+	String err_str;
+
+	bool _refill(int64_t p_keep_from);
+	int _next_byte();
+	void _buffer_string_run(int64_t p_from);
+	Error _get_token(TokenType &r_type);
+	Error _parse_string();
+	Error _parse_escape();
+	Error _parse_hex(char32_t &r_value);
+	Error _parse_document(JSONStreamHandler *p_handler);
+
+public:
+	Error parse(const uint8_t *p_data, int64_t p_len, JSONStreamHandler *p_handler);
+	// Reads from the current position of `p_file` to the end of the document.
+	Error parse_file(const Ref<FileAccess> &p_file, JSONStreamHandler *p_handler);
+
+	int get_error_line() const { return line; }
+	String get_error_message() const { return err_str; }
+};
+
+// Writes JSON as UTF-8 into a reusable buffer, and optionally streams it to a file.
+// The output is the same as JSON::stringify().
+class JSONStreamWriter {
+	static constexpr uint32_t FLUSH_SIZE = 65536;
+
+	LocalVector<uint8_t> &buffer;
+	Ref<FileAccess> file;
+	CharString indent;
+	bool sort_keys = true;
+	bool full_precision = false;
+	HashSet<const void *> markers;
+	Error error = OK;
+
+	void _flush();
+	void _write(const char *p_str, uint32_t p_len);
+	void _write_ascii(const String &p_str);
+	void _write_indent(int p_level);
+	void _write_string(const String &p_str);
+	void _write_int(int64_t p_value);
+	void _write_float(double p_value);
+	template <typename T>
+	void _write_packed_array(const Vector<T> &p_array, int p_cur_indent);
+	void _write_value(const Variant &p_var, int p_cur_indent);
+
+public:
+	// Appends to `r_buffer`. When a file is set, the buffer is flushed to it as it fills up and
+	// once writing is done, and is left empty.
+	Error write(const Variant &p_var);
+	void set_file(const Ref<FileAccess> &p_file) { file = p_file; }
+
+	JSONStreamWriter(LocalVector<uint8_t> &r_buffer, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+};
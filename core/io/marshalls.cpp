@@ -182,7 +182,18 @@ static Error _decode_container_type(const uint8_t *&buf, int &len, int *r_len, b
 	ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Invalid container type kind."); // Future proofing.
 }
 
-Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+// Takes the value held by `r_variant` when it can be decoded into, leaving `r_variant` empty so the value is not shared.
+template <typename T>
+static T _take_reusable(Variant &r_variant, Variant::Type p_type, bool p_reuse) {
+	T value;
+	if (p_reuse && r_variant.get_type() == p_type) {
+		value = r_variant;
+		r_variant = Variant();
+	}
+	return value;
+}
+
+static Error _decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth, bool p_reuse) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
@@ -837,16 +848,38 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				(*r_len) += 4; // Size of count number.
 			}
 
+			// Each entry takes at least 8 bytes.
+			ERR_FAIL_COND_V(count > len / 8, ERR_INVALID_DATA);
+
+			// A dictionary with the same type and entry count is decoded in place, reusing the values of matching keys.
+			// The entries are then inserted again, so they follow the decoded order and stale keys are dropped.
 			Dictionary dict;
-			if (key_type.builtin_type != Variant::NIL || value_type.builtin_type != Variant::NIL) {
-				dict.set_typed(key_type, value_type);
+			bool reuse = false;
+			if (p_reuse && r_variant.get_type() == Variant::DICTIONARY) {
+				dict = r_variant;
+				reuse = !dict.is_read_only() && dict.size() == count &&
+						dict.get_typed_key_builtin() == key_type.builtin_type && dict.get_typed_key_class_name() == key_type.class_name && dict.get_typed_key_script() == Variant(key_type.script) &&
+						dict.get_typed_value_builtin() == value_type.builtin_type && dict.get_typed_value_class_name() == value_type.class_name && dict.get_typed_value_script() == Variant(value_type.script);
+			}
+			if (!reuse) {
+				dict = Dictionary();
+				if (key_type.builtin_type != Variant::NIL || value_type.builtin_type != Variant::NIL) {
+					dict.set_typed(key_type, value_type);
+				}
+			}
+
+			LocalVector<Variant> decoded_keys;
+			LocalVector<Variant> decoded_values;
+			if (reuse) {
+				decoded_keys.reserve(count);
+				decoded_values.reserve(count);
 			}
 
 			for (int i = 0; i < count; i++) {
 				Variant key, value;
 
 				int used;
-				Error err = decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1);
+				Error err = _decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1, false);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -855,7 +888,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += used;
 				}
 
-				err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
+				if (reuse) {
+					// Take the value out, so a reused packed array isn't copied on write.
+					Variant *existing = dict.getptr(key);
+					if (existing) {
+						value = std::move(*existing);
+					}
+				}
+				err = _decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1, reuse);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -864,7 +904,19 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += used;
 				}
 
-				dict[key] = value;
+				if (reuse) {
+					decoded_keys.push_back(std::move(key));
+					decoded_values.push_back(std::move(value));
+				} else {
+					dict[key] = value;
+				}
+			}
+
+			if (reuse) {
+				dict.clear();
+				for (uint32_t i = 0; i < decoded_keys.size(); i++) {
+					dict[decoded_keys[i]] = std::move(decoded_values[i]);
+				}
 			}
 
 			r_variant = dict;
@@ -894,19 +946,36 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				(*r_len) += 4; // Size of count number.
 			}
 
+			// Each element takes at least 4 bytes.
+			ERR_FAIL_COND_V(count > len / 4, ERR_INVALID_DATA);
+
+			// An array with the same type is decoded in place, elements included.
 			Array array;
-			if (type.builtin_type != Variant::NIL) {
-				array.set_typed(type);
+			bool reuse = false;
+			if (p_reuse && r_variant.get_type() == Variant::ARRAY) {
+				array = r_variant;
+				reuse = !array.is_read_only() && array.get_typed_builtin() == type.builtin_type && array.get_typed_class_name() == type.class_name && array.get_typed_script() == Variant(type.script);
+			}
+			if (!reuse) {
+				array = Array();
+				if (type.builtin_type != Variant::NIL) {
+					array.set_typed(type);
+				}
 			}
+			array.resize(count);
 
 			for (int i = 0; i < count; i++) {
 				int used = 0;
 				Variant elem;
-				Error err = decode_variant(elem, buf, len, &used, p_allow_objects, p_depth + 1);
+				if (reuse) {
+					// Take the element out, so a reused packed array isn't copied on write.
+					elem = std::move(array[i]);
+				}
+				Error err = _decode_variant(elem, buf, len, &used, p_allow_objects, p_depth + 1, reuse);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 				buf += used;
 				len -= used;
-				array.push_back(elem);
+				array.set(i, elem);
 				if (r_len) {
 					(*r_len) += used;
 				}
@@ -924,14 +993,10 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			len -= 4;
 			ERR_FAIL_COND_V(count < 0 || count > len, ERR_INVALID_DATA);
 
-			Vector<uint8_t> data;
-
+			Vector<uint8_t> data = _take_reusable<Vector<uint8_t>>(r_variant, Variant::PACKED_BYTE_ARRAY, p_reuse);
+			data.resize(count);
 			if (count) {
-				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -952,15 +1017,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<int32_t> data;
-
+			Vector<int32_t> data = _take_reusable<Vector<int32_t>>(r_variant, Variant::PACKED_INT32_ARRAY, p_reuse);
+			data.resize(count);
 			if (count) {
-				//const int *rbuf = (const int *)buf;
-				data.resize(count);
 				int32_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#else
+				memcpy(w, buf, count * sizeof(int32_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -976,15 +1043,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<int64_t> data;
-
+			Vector<int64_t> data = _take_reusable<Vector<int64_t>>(r_variant, Variant::PACKED_INT64_ARRAY, p_reuse);
+			data.resize(count);
 			if (count) {
-				//const int *rbuf = (const int *)buf;
-				data.resize(count);
 				int64_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#else
+				memcpy(w, buf, count * sizeof(int64_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -1000,15 +1069,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<float> data;
-
+			Vector<float> data = _take_reusable<Vector<float>>(r_variant, Variant::PACKED_FLOAT32_ARRAY, p_reuse);
+			data.resize(count);
 			if (count) {
-				//const float *rbuf = (const float *)buf;
-				data.resize(count);
 				float *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#else
+				memcpy(w, buf, count * sizeof(float));
+#endif
 			}
 			r_variant = data;
 
@@ -1025,14 +1096,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<double> data;
-
+			Vector<double> data = _take_reusable<Vector<double>>(r_variant, Variant::PACKED_FLOAT64_ARRAY, p_reuse);
+			data.resize(count);
 			if (count) {
-				data.resize(count);
 				double *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#else
+				memcpy(w, buf, count * sizeof(double));
+#endif
 			}
 			r_variant = data;
 
@@ -1045,22 +1119,23 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 			int32_t count = decode_uint32(buf);
 
-			Vector<String> strings;
 			buf += 4;
 			len -= 4;
+			// Each string takes at least 4 bytes.
+			ERR_FAIL_COND_V(count < 0 || count > len / 4, ERR_INVALID_DATA);
 
 			if (r_len) {
 				(*r_len) += 4; // Size of count number.
 			}
 
+			Vector<String> strings = _take_reusable<Vector<String>>(r_variant, Variant::PACKED_STRING_ARRAY, p_reuse);
+			strings.resize(count);
+			String *w = strings.ptrw();
 			for (int32_t i = 0; i < count; i++) {
-				String str;
-				Error err = _decode_string(buf, len, r_len, str);
+				Error err = _decode_string(buf, len, r_len, w[i]);
 				if (err) {
 					return err;
 				}
-
-				strings.push_back(str);
 			}
 
 			r_variant = strings;
@@ -1072,7 +1147,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector2> varray;
+			Vector<Vector2> varray = _take_reusable<Vector<Vector2>>(r_variant, Variant::PACKED_VECTOR2_ARRAY, p_reuse);
 
 			if (header & HEADER_DATA_FLAG_64) {
 				ERR_FAIL_MUL_OF(count, sizeof(double) * 2, ERR_INVALID_DATA);
@@ -1082,14 +1157,18 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
+#if defined(REAL_T_IS_DOUBLE) && !defined(BIG_ENDIAN_ENABLED)
+					memcpy(w, buf, sizeof(double) * 2 * count);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
 					}
+#endif
 
 					int adv = sizeof(double) * 2 * count;
 
@@ -1107,14 +1186,18 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
+#if !defined(REAL_T_IS_DOUBLE) && !defined(BIG_ENDIAN_ENABLED)
+					memcpy(w, buf, sizeof(float) * 2 * count);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
 					}
+#endif
 
 					int adv = sizeof(float) * 2 * count;
 
@@ -1132,7 +1215,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector3> varray;
+			Vector<Vector3> varray = _take_reusable<Vector<Vector3>>(r_variant, Variant::PACKED_VECTOR3_ARRAY, p_reuse);
 
 			if (header & HEADER_DATA_FLAG_64) {
 				ERR_FAIL_MUL_OF(count, sizeof(double) * 3, ERR_INVALID_DATA);
@@ -1142,15 +1225,19 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
+#if defined(REAL_T_IS_DOUBLE) && !defined(BIG_ENDIAN_ENABLED)
+					memcpy(w, buf, sizeof(double) * 3 * count);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
 						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
 					}
+#endif
 
 					int adv = sizeof(double) * 3 * count;
 
@@ -1168,15 +1255,19 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
+#if !defined(REAL_T_IS_DOUBLE) && !defined(BIG_ENDIAN_ENABLED)
+					memcpy(w, buf, sizeof(float) * 3 * count);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
 						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
 					}
+#endif
 
 					int adv = sizeof(float) * 3 * count;
 
@@ -1199,16 +1290,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4 * 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 * 4 > len, ERR_INVALID_DATA);
 
-			Vector<Color> carray;
+			Vector<Color> carray = _take_reusable<Vector<Color>>(r_variant, Variant::PACKED_COLOR_ARRAY, p_reuse);
 
 			if (r_len) {
 				(*r_len) += 4; // Size of count number.
 			}
 
+			carray.resize(count);
 			if (count) {
-				carray.resize(count);
 				Color *w = carray.ptrw();
 
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					// Colors should always be in single-precision.
 					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
@@ -1216,6 +1308,9 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
 					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
 				}
+#else
+				memcpy(w, buf, 4 * 4 * count);
+#endif
 
 				int adv = 4 * 4 * count;
 
@@ -1234,7 +1329,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector4> varray;
+			Vector<Vector4> varray = _take_reusable<Vector<Vector4>>(r_variant, Variant::PACKED_VECTOR4_ARRAY, p_reuse);
 
 			if (header & HEADER_DATA_FLAG_64) {
 				ERR_FAIL_MUL_OF(count, sizeof(double) * 4, ERR_INVALID_DATA);
@@ -1244,16 +1339,20 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
+#if defined(REAL_T_IS_DOUBLE) && !defined(BIG_ENDIAN_ENABLED)
+					memcpy(w, buf, sizeof(double) * 4 * count);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 1);
 						w[i].z = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 2);
 						w[i].w = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 3);
 					}
+#endif
 
 					int adv = sizeof(double) * 4 * count;
 
@@ -1271,16 +1370,20 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
+#if !defined(REAL_T_IS_DOUBLE) && !defined(BIG_ENDIAN_ENABLED)
+					memcpy(w, buf, sizeof(float) * 4 * count);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 1);
 						w[i].z = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 2);
 						w[i].w = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 3);
 					}
+#endif
 
 					int adv = sizeof(float) * 4 * count;
 
@@ -1302,6 +1405,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+	return _decode_variant(r_variant, p_buffer, p_len, r_len, p_allow_objects, p_depth, false);
+}
+
+Error decode_variant_reusing(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+	return _decode_variant(r_variant, p_buffer, p_len, r_len, p_allow_objects, p_depth, true);
+}
+
 static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
 	CharString utf8 = p_string.utf8();
 
@@ -1930,10 +2041,14 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
+#ifdef BIG_ENDIAN_ENABLED
 				const int32_t *r = data.ptr();
 				for (int32_t i = 0; i < datalen; i++) {
 					encode_uint32(r[i], &buf[i * datasize]);
 				}
+#else
+				memcpy(buf, data.ptr(), datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1947,10 +2062,14 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
+#ifdef BIG_ENDIAN_ENABLED
 				const int64_t *r = data.ptr();
 				for (int64_t i = 0; i < datalen; i++) {
 					encode_uint64(r[i], &buf[i * datasize]);
 				}
+#else
+				memcpy(buf, data.ptr(), datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1964,10 +2083,14 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
+#ifdef BIG_ENDIAN_ENABLED
 				const float *r = data.ptr();
 				for (int i = 0; i < datalen; i++) {
 					encode_float(r[i], &buf[i * datasize]);
 				}
+#else
+				memcpy(buf, data.ptr(), datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1981,10 +2104,14 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
+#ifdef BIG_ENDIAN_ENABLED
 				const double *r = data.ptr();
 				for (int i = 0; i < datalen; i++) {
 					encode_double(r[i], &buf[i * datasize]);
 				}
+#else
+				memcpy(buf, data.ptr(), datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -2033,6 +2160,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < len; i++) {
 					Vector2 v = data.get(i);
 
@@ -2040,6 +2168,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					encode_real(v.y, &buf[sizeof(real_t)]);
 					buf += sizeof(real_t) * 2;
 				}
+#else
+				memcpy(buf, data.ptr(), sizeof(real_t) * 2 * len);
+				buf += sizeof(real_t) * 2 * len;
+#endif
 			}
 
 			r_len += sizeof(real_t) * 2 * len;
@@ -2057,6 +2189,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < len; i++) {
 					Vector3 v = data.get(i);
 
@@ -2065,6 +2198,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					encode_real(v.z, &buf[sizeof(real_t) * 2]);
 					buf += sizeof(real_t) * 3;
 				}
+#else
+				memcpy(buf, data.ptr(), sizeof(real_t) * 3 * len);
+				buf += sizeof(real_t) * 3 * len;
+#endif
 			}
 
 			r_len += sizeof(real_t) * 3 * len;
@@ -2082,6 +2219,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < len; i++) {
 					Color c = data.get(i);
 
@@ -2091,6 +2229,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					encode_float(c.a, &buf[12]);
 					buf += 4 * 4; // Colors should always be in single-precision.
 				}
+#else
+				memcpy(buf, data.ptr(), 4 * 4 * len);
+				buf += 4 * 4 * len;
+#endif
 			}
 
 			r_len += 4 * 4 * len;
@@ -2108,6 +2250,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < len; i++) {
 					Vector4 v = data.get(i);
 
@@ -2117,6 +2260,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					encode_real(v.w, &buf[sizeof(real_t) * 3]);
 					buf += sizeof(real_t) * 4;
 				}
+#else
+				memcpy(buf, data.ptr(), sizeof(real_t) * 4 * len);
+				buf += sizeof(real_t) * 4 * len;
+#endif
 			}
 
 			r_len += sizeof(real_t) * 4 * len;
@@ -2130,6 +2277,244 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+// Encoded size of the types that don't depend on the value, header included. -1 for the others.
+static int _get_fixed_encoded_size(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::NIL:
+		case Variant::CALLABLE:
+			return 4;
+		case Variant::BOOL:
+			return 4 + 4;
+		case Variant::VECTOR2:
+			return 4 + 2 * sizeof(real_t);
+		case Variant::VECTOR2I:
+			return 4 + 2 * 4;
+		case Variant::RECT2:
+			return 4 + 4 * sizeof(real_t);
+		case Variant::RECT2I:
+			return 4 + 4 * 4;
+		case Variant::VECTOR3:
+			return 4 + 3 * sizeof(real_t);
+		case Variant::VECTOR3I:
+			return 4 + 3 * 4;
+		case Variant::TRANSFORM2D:
+		case Variant::AABB:
+			return 4 + 6 * sizeof(real_t);
+		case Variant::VECTOR4:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+			return 4 + 4 * sizeof(real_t);
+		case Variant::VECTOR4I:
+		case Variant::COLOR:
+			return 4 + 4 * 4;
+		case Variant::BASIS:
+			return 4 + 9 * sizeof(real_t);
+		case Variant::TRANSFORM3D:
+			return 4 + 12 * sizeof(real_t);
+		case Variant::PROJECTION:
+			return 4 + 16 * sizeof(real_t);
+		case Variant::RID:
+			return 4 + 8;
+		default:
+			return -1;
+	}
+}
+
+static _FORCE_INLINE_ uint8_t *_append(LocalVector<uint8_t> &r_buffer, uint32_t p_size) {
+	const uint32_t ofs = r_buffer.size();
+	r_buffer.resize(ofs + p_size);
+	return r_buffer.ptr() + ofs;
+}
+
+static _FORCE_INLINE_ void _append_uint32(LocalVector<uint8_t> &r_buffer, uint32_t p_value) {
+	encode_uint32(p_value, _append(r_buffer, 4));
+}
+
+// Appends `p_size` bytes and the padding to the next multiple of 4.
+static void _append_padded(LocalVector<uint8_t> &r_buffer, const void *p_data, uint32_t p_size) {
+	const uint32_t pad = (4 - p_size % 4) % 4;
+	uint8_t *w = _append(r_buffer, p_size + pad);
+	if (p_size) {
+		memcpy(w, p_data, p_size);
+	}
+	memset(w + p_size, 0, pad);
+}
+
+static void _append_string(LocalVector<uint8_t> &r_buffer, const String &p_string) {
+	const CharString utf8 = p_string.utf8();
+	_append_uint32(r_buffer, utf8.length());
+	_append_padded(r_buffer, utf8.get_data(), utf8.length());
+}
+
+// Falls back to the measuring encoder, for the values without a dedicated path.
+static Error _append_measured(LocalVector<uint8_t> &r_buffer, const Variant &p_variant, bool p_full_objects, int p_depth) {
+	int len;
+	Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+	ERR_FAIL_COND_V(err, err);
+	const uint32_t ofs = r_buffer.size();
+	err = encode_variant(p_variant, _append(r_buffer, len), len, p_full_objects, p_depth);
+	if (err) {
+		r_buffer.resize(ofs);
+	}
+	return err;
+}
+
+static Error _append_container_type(LocalVector<uint8_t> &r_buffer, const ContainerType &p_type, bool p_full_objects) {
+	uint8_t *buf = nullptr;
+	int len = 0;
+	Error err = _encode_container_type(p_type, buf, len, p_full_objects);
+	if (err || len == 0) {
+		return err;
+	}
+	buf = _append(r_buffer, len);
+	len = 0;
+	return _encode_container_type(p_type, buf, len, p_full_objects);
+}
+
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+	const Variant::Type type = p_variant.get_type();
+	const int fixed_size = _get_fixed_encoded_size(type);
+	if (fixed_size > 0) {
+		int len;
+		return encode_variant(p_variant, _append(r_buffer, fixed_size), len, p_full_objects, p_depth);
+	}
+
+	switch (type) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			_append_uint32(r_buffer, type);
+			_append_string(r_buffer, p_variant);
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dict = p_variant;
+			uint32_t header = type;
+			_encode_container_type_header(dict.get_key_type(), header, HEADER_DATA_FIELD_TYPED_DICTIONARY_KEY_SHIFT, p_full_objects);
+			_encode_container_type_header(dict.get_value_type(), header, HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_SHIFT, p_full_objects);
+			_append_uint32(r_buffer, header);
+			Error err = _append_container_type(r_buffer, dict.get_key_type(), p_full_objects);
+			ERR_FAIL_COND_V(err, err);
+			err = _append_container_type(r_buffer, dict.get_value_type(), p_full_objects);
+			ERR_FAIL_COND_V(err, err);
+			_append_uint32(r_buffer, dict.size());
+
+			for (const KeyValue<Variant, Variant> &kv : dict) {
+				err = encode_variant(kv.key, r_buffer, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+				err = encode_variant(kv.value, r_buffer, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_variant;
+			const ContainerType element_type = array.get_element_type();
+			uint32_t header = type;
+			_encode_container_type_header(element_type, header, HEADER_DATA_FIELD_TYPED_ARRAY_SHIFT, p_full_objects);
+			_append_uint32(r_buffer, header);
+			Error err = _append_container_type(r_buffer, element_type, p_full_objects);
+			ERR_FAIL_COND_V(err, err);
+			const int count = array.size();
+			_append_uint32(r_buffer, count);
+
+			// Elements of typed arrays of math types all have the same size, so the space is reserved at once.
+			const int element_size = element_type.builtin_type != Variant::NIL ? _get_fixed_encoded_size(element_type.builtin_type) : -1;
+			if (element_size > 0) {
+				uint8_t *w = _append(r_buffer, element_size * count);
+				for (int i = 0; i < count; i++) {
+					int len;
+					err = encode_variant(array[i], w + i * element_size, len, p_full_objects, p_depth + 1);
+					ERR_FAIL_COND_V(err, err);
+				}
+				break;
+			}
+
+			for (const Variant &elem : array) {
+				err = encode_variant(elem, r_buffer, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+			}
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			const Vector<String> data = p_variant;
+			_append_uint32(r_buffer, type);
+			_append_uint32(r_buffer, data.size());
+			for (const String &str : data) {
+				// Unlike other strings, these keep the null terminator.
+				const CharString utf8 = str.utf8();
+				_append_uint32(r_buffer, utf8.length() + 1);
+				_append_padded(r_buffer, utf8.get_data(), utf8.length() + 1);
+			}
+		} break;
+#ifndef BIG_ENDIAN_ENABLED
+		// Packed arrays are stored in the same layout as on little-endian hosts.
+		case Variant::PACKED_BYTE_ARRAY: {
+			const Vector<uint8_t> data = p_variant;
+			_append_uint32(r_buffer, type);
+			_append_uint32(r_buffer, data.size());
+			_append_padded(r_buffer, data.ptr(), data.size());
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			const Vector<int32_t> data = p_variant;
+			_append_uint32(r_buffer, type);
+			_append_uint32(r_buffer, data.size());
+			_append_padded(r_buffer, data.ptr(), data.size() * sizeof(int32_t));
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			const Vector<int64_t> data = p_variant;
+			_append_uint32(r_buffer, type);
+			_append_uint32(r_buffer, data.size());
+			_append_padded(r_buffer, data.ptr(), data.size() * sizeof(int64_t));
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			const Vector<float> data = p_variant;
+			_append_uint32(r_buffer, type);
+			_append_uint32(r_buffer, data.size());
+			_append_padded(r_buffer, data.ptr(), data.size() * sizeof(float));
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			const Vector<double> data = p_variant;
+			_append_uint32(r_buffer, type);
+			_append_uint32(r_buffer, data.size());
+			_append_padded(r_buffer, data.ptr(), data.size() * sizeof(double));
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			// Colors should always be in single-precision.
+			const Vector<Color> data = p_variant;
+			_append_uint32(r_buffer, type);
+			_append_uint32(r_buffer, data.size());
+			_append_padded(r_buffer, data.ptr(), data.size() * 4 * 4);
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY:
+		case Variant::PACKED_VECTOR3_ARRAY:
+		case Variant::PACKED_VECTOR4_ARRAY: {
+			uint32_t header = type;
+#ifdef REAL_T_IS_DOUBLE
+			header |= HEADER_DATA_FLAG_64;
+#endif
+			_append_uint32(r_buffer, header);
+			if (type == Variant::PACKED_VECTOR2_ARRAY) {
+				const Vector<Vector2> data = p_variant;
+				_append_uint32(r_buffer, data.size());
+				_append_padded(r_buffer, data.ptr(), data.size() * 2 * sizeof(real_t));
+			} else if (type == Variant::PACKED_VECTOR3_ARRAY) {
+				const Vector<Vector3> data = p_variant;
+				_append_uint32(r_buffer, data.size());
+				_append_padded(r_buffer, data.ptr(), data.size() * 3 * sizeof(real_t));
+			} else {
+				const Vector<Vector4> data = p_variant;
+				_append_uint32(r_buffer, data.size());
+				_append_padded(r_buffer, data.ptr(), data.size() * 4 * sizeof(real_t));
+			}
+		} break;
+#endif // BIG_ENDIAN_ENABLED
+		default: {
+			return _append_measured(r_buffer, p_variant, p_full_objects, p_depth);
+		}
+	}
+
+	return OK;
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't `memcpy()`.
 	// We also don't consider returning a pointer to the passed vectors when `sizeof(real_t) == 4`.
@@ -33,7 +33,7 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION_*
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -49,6 +49,7 @@ static int _get_pad(int p_alignment, int p_n) {
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file_compressed", "target_path", "source_path", "compression_mode"), &PCKPacker::add_file_compressed, DEFVAL(FileAccess::COMPRESSION_ZSTD));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
@@ -90,7 +91,8 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	version_ofs = file->get_position();
+	file->store_32(PACK_FORMAT_VERSION_V3); // Raised to V4 by flush() when an entry is compressed.
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
 	file->store_32(GODOT_VERSION_PATCH);
@@ -201,6 +203,79 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	return OK;
 }
 
+Error PCKPacker::add_file_compressed(const String &p_target_path, const String &p_source_path, FileAccess::CompressionMode p_compression_mode) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(p_compression_mode == FileAccess::COMPRESSION_BROTLI, ERR_INVALID_PARAMETER, "Brotli can only be used for decompression.");
+
+	Error err;
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_source_path, &err);
+	if (err != OK) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	File pf;
+	// Simplify path here and on every 'files' access so that paths that have extra '/'
+	// symbols or 'res://' in them still match the MD5 hash for the saved path.
+	pf.path = p_target_path.simplify_path().trim_prefix("res://");
+	pf.src_path = p_source_path;
+	pf.ofs = file->get_position();
+	pf.size = data.size();
+	{
+		unsigned char hash[16];
+		CryptoCore::md5(data.ptr(), data.size(), hash);
+		pf.md5.resize(16);
+		for (int i = 0; i < 16; i++) {
+			pf.md5.write[i] = hash[i];
+		}
+	}
+
+	// Blocks are compressed independently, so they can be read at random and decompressed in parallel.
+	const Compression::Mode mode = Compression::Mode(p_compression_mode);
+	const uint32_t block_count = (data.size() + PACK_COMPRESSION_BLOCK_SIZE - 1) / PACK_COMPRESSION_BLOCK_SIZE;
+
+	Vector<uint32_t> block_sizes;
+	block_sizes.resize(block_count);
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(PACK_COMPRESSION_BLOCK_SIZE, mode) * block_count);
+	uint64_t compressed_size = 0;
+
+	for (uint32_t i = 0; i < block_count; i++) {
+		const uint8_t *src = data.ptr() + uint64_t(i) * PACK_COMPRESSION_BLOCK_SIZE;
+		const int64_t src_size = MIN(int64_t(PACK_COMPRESSION_BLOCK_SIZE), data.size() - int64_t(i) * PACK_COMPRESSION_BLOCK_SIZE);
+		uint8_t *dst = compressed.ptrw() + compressed_size;
+
+		int64_t dst_size = Compression::compress(dst, src, src_size, mode);
+		if (dst_size <= 0 || dst_size >= src_size) {
+			// Store blocks that don't shrink as is, the reader detects them by their size.
+			memcpy(dst, src, src_size);
+			dst_size = src_size;
+		}
+		block_sizes.write[i] = dst_size;
+		compressed_size += dst_size;
+	}
+
+	if (compressed_size + block_count * 4 < uint64_t(data.size())) {
+		pf.compressed = true;
+		pf.compression_mode = mode;
+		for (uint32_t i = 0; i < block_count; i++) {
+			file->store_32(block_sizes[i]);
+		}
+		file->store_buffer(compressed.ptr(), compressed_size);
+	} else {
+		// Not worth it, keep the file uncompressed.
+		file->store_buffer(data);
+	}
+
+	int pad = _get_pad(alignment, file->get_position());
+	for (int j = 0; j < pad; j++) {
+		file->store_8(0);
+	}
+
+	files.push_back(pf);
+
+	return OK;
+}
+
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
@@ -211,6 +286,14 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	// Write directory.
 	uint64_t dir_offset = file->get_position();
+	for (const File &E : files) {
+		if (E.compressed) {
+			// Compressed entries need V4, other packs stay readable by older runtimes.
+			file->seek(version_ofs);
+			file->store_32(PACK_FORMAT_VERSION_V4);
+			break;
+		}
+	}
 	file->seek(dir_base_ofs);
 	file->store_64(dir_offset);
 	file->seek(dir_offset);
@@ -253,8 +336,16 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 
+		if (files[i].compressed) {
+			fhead->store_32(files[i].compression_mode);
+			fhead->store_32(PACK_COMPRESSION_BLOCK_SIZE);
+		}
+
 		if (p_verbose) {
 			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", i, file_num, float(i) / file_num * 100, files[i].src_path, files[i].path));
 		}
@@ -30,10 +30,9 @@
 
 #pragma once
 
+#include "core/io/file_access.h"
 #include "core/object/ref_counted.h"
 
-class FileAccess;
-
 class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
 
@@ -44,6 +43,7 @@ class PCKPacker : public RefCounted {
 	bool enc_dir = false;
 
 	uint64_t file_base = 0;
+	uint64_t version_ofs = 0;
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
 
@@ -56,6 +56,8 @@ class PCKPacker : public RefCounted {
 		uint64_t size = 0;
 		bool encrypted = false;
 		bool removal = false;
+		bool compressed = false;
+		uint32_t compression_mode = 0;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
@@ -63,6 +65,7 @@ class PCKPacker : public RefCounted {
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
+	Error add_file_compressed(const String &p_target_path, const String &p_source_path, FileAccess::CompressionMode p_compression_mode = FileAccess::COMPRESSION_ZSTD);
 	Error add_file_removal(const String &p_target_path);
 	Error flush(bool p_verbose = false);
 
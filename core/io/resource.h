@@ -183,6 +183,8 @@ public:
 	void set_as_translation_remapped(bool p_remapped);
 
 	virtual RID get_rid() const; // Some resources may offer conversion to RID.
+	virtual bool set_streamed_buffer(const StringName &p_property, const String &p_file, uint64_t p_offset, uint64_t p_length) { return false; } // Offered by the binary loader for PackedByteArray properties. Return true to read the bytes from the file on demand instead of loading them.
+	virtual void make_streamed_buffers_resident(const String &p_file) {} // Called by savers before overwriting p_file. Buffers streamed from it must be loaded into memory.
 
 	// Helps keep IDs the same when loading/saving scenes. An empty ID clears the entry, and an empty ID is returned when not found.
 	static void set_resource_id_for_path(const String &p_referrer_path, const String &p_resource_path, const String &p_id);
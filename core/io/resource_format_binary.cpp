@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
 #include "core/version.h"
@@ -109,50 +110,86 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
-static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
-	if (f->real_is_double) {
-		if constexpr (sizeof(real_t) == 8) {
-			// Ideal case with double-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(double));
+// Packed array payloads are read and written with single buffer transfers. Elements are only
+// decoded when the file endianness differs from the host's, or when reals change precision.
+static constexpr size_t ARRAY_CHUNK_ELEMENTS = 1024;
+
+static _FORCE_INLINE_ bool _is_endian_swapped(const Ref<FileAccess> &p_f) {
 #ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *dst = (uint64_t *)dst;
-				for (size_t i = 0; i < count; i++) {
-					dst[i] = BSWAP64(dst[i]);
-				}
-			}
+	return !p_f->is_big_endian();
+#else
+	return p_f->is_big_endian();
 #endif
-		} else if constexpr (sizeof(real_t) == 4) {
-			// May be slower, but this is for compatibility. Eventually the data should be converted.
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_double();
-			}
-		} else {
-			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
+}
+
+template <typename T>
+static void _swap_elements(T *p_data, size_t p_count) {
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+	if constexpr (sizeof(T) == 4) {
+		uint32_t *ptr = reinterpret_cast<uint32_t *>(p_data);
+		for (size_t i = 0; i < p_count; i++) {
+			ptr[i] = BSWAP32(ptr[i]);
 		}
 	} else {
-		if constexpr (sizeof(real_t) == 4) {
-			// Ideal case with float-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(float));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *dst = (uint32_t *)dst;
-				for (size_t i = 0; i < count; i++) {
-					dst[i] = BSWAP32(dst[i]);
-				}
-			}
-#endif
-		} else if constexpr (sizeof(real_t) == 8) {
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_float();
-			}
-		} else {
-			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
+		uint64_t *ptr = reinterpret_cast<uint64_t *>(p_data);
+		for (size_t i = 0; i < p_count; i++) {
+			ptr[i] = BSWAP64(ptr[i]);
 		}
 	}
+}
+
+template <typename T>
+static Error read_array(T *p_dst, Ref<FileAccess> &f, size_t p_count) {
+	const uint64_t size = p_count * sizeof(T);
+	ERR_FAIL_COND_V(f->get_buffer(reinterpret_cast<uint8_t *>(p_dst), size) != size, ERR_FILE_CORRUPT);
+	if (_is_endian_swapped(f)) {
+		_swap_elements(p_dst, p_count);
+	}
 	return OK;
 }
 
+template <typename T>
+static void store_array(Ref<FileAccess> &f, const T *p_src, size_t p_count) {
+	if (!_is_endian_swapped(f)) {
+		f->store_buffer(reinterpret_cast<const uint8_t *>(p_src), p_count * sizeof(T));
+		return;
+	}
+	T chunk[ARRAY_CHUNK_ELEMENTS];
+	for (size_t offset = 0; offset < p_count; offset += ARRAY_CHUNK_ELEMENTS) {
+		const size_t count = MIN(ARRAY_CHUNK_ELEMENTS, p_count - offset);
+		memcpy(chunk, p_src + offset, count * sizeof(T));
+		_swap_elements(chunk, count);
+		f->store_buffer(reinterpret_cast<const uint8_t *>(chunk), count * sizeof(T));
+	}
+}
+
+template <typename T>
+static Error read_reals_as(real_t *dst, Ref<FileAccess> &f, size_t count) {
+	if constexpr (sizeof(T) == sizeof(real_t)) {
+		return read_array(reinterpret_cast<T *>(dst), f, count);
+	} else {
+		// May be slower, but this is for compatibility. Eventually the data should be converted.
+		T chunk[ARRAY_CHUNK_ELEMENTS];
+		for (size_t offset = 0; offset < count; offset += ARRAY_CHUNK_ELEMENTS) {
+			const size_t chunk_count = MIN(ARRAY_CHUNK_ELEMENTS, count - offset);
+			const Error err = read_array(chunk, f, chunk_count);
+			ERR_FAIL_COND_V(err != OK, err);
+			for (size_t i = 0; i < chunk_count; i++) {
+				dst[offset + i] = real_t(chunk[i]);
+			}
+		}
+		return OK;
+	}
+}
+
+static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
+	if (f->real_is_double) {
+		return read_reals_as<double>(dst, f, count);
+	} else {
+		return read_reals_as<float>(dst, f, count);
+	}
+}
+
 StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
@@ -171,7 +208,11 @@ StringName ResourceLoaderBinary::_get_string() {
 }
 
 Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
-	uint32_t prop_type = f->get_32();
+	return parse_variant_of_type(f->get_32(), r_v);
+}
+
+Error ResourceLoaderBinary::parse_variant_of_type(uint32_t p_type, Variant &r_v) {
+	uint32_t prop_type = p_type;
 	print_bl("find property of type: " + itos(prop_type));
 
 	switch (prop_type) {
@@ -524,16 +565,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<int32_t> array;
 			array.resize(len);
 			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
-				}
-			}
-
-#endif
+			const Error err = read_array(w, f, len);
+			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 		} break;
@@ -543,16 +576,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<int64_t> array;
 			array.resize(len);
 			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *ptr = (uint64_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP64(ptr[i]);
-				}
-			}
-
-#endif
+			const Error err = read_array(w, f, len);
+			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 		} break;
@@ -562,16 +587,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<float> array;
 			array.resize(len);
 			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
-				}
-			}
-
-#endif
+			const Error err = read_array(w, f, len);
+			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 		} break;
@@ -581,16 +598,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Vector<double> array;
 			array.resize(len);
 			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *ptr = (uint64_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP64(ptr[i]);
-				}
-			}
-
-#endif
+			const Error err = read_array(w, f, len);
+			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 		} break;
@@ -640,16 +649,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len * 4; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
-				}
-			}
-
-#endif
+			const Error err = read_array(reinterpret_cast<float *>(w), f, len * 4);
+			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
 		} break;
@@ -823,9 +824,22 @@ Error ResourceLoaderBinary::load() {
 				ERR_FAIL_V(ERR_FILE_CORRUPT);
 			}
 
+			uint32_t value_type = f->get_32();
+			if (value_type == VARIANT_PACKED_BYTE_ARRAY && !stream_path.is_empty()) {
+				// The resource may keep large byte arrays on disk and read them on demand.
+				uint32_t len = f->get_32();
+				uint64_t data_ofs = f->get_position();
+				if (res->set_streamed_buffer(name, stream_path, data_ofs, len)) {
+					f->seek(data_ofs + len);
+					_advance_padding(len);
+					continue;
+				}
+				f->seek(data_ofs - 4);
+			}
+
 			Variant value;
 
-			error = parse_variant(value);
+			error = parse_variant_of_type(value_type, value);
 			if (error) {
 				return error;
 			}
@@ -983,10 +997,12 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 	error = OK;
 
 	f = p_f;
+	stream_path = source_path.is_empty() ? f->get_path() : source_path;
 	uint8_t header[4];
 	f->get_buffer(header, 4);
 	if (header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C') {
 		// Compressed.
+		stream_path = String(); // Offsets inside a compressed file can't be read back directly.
 		Ref<FileAccessCompressed> fac;
 		fac.instantiate();
 		error = fac->open_after_magic(f);
@@ -1121,10 +1137,12 @@ String ResourceLoaderBinary::recognize(Ref<FileAccess> p_f) {
 	error = OK;
 
 	f = p_f;
+	stream_path = f->get_path();
 	uint8_t header[4];
 	f->get_buffer(header, 4);
 	if (header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C') {
 		// Compressed.
+		stream_path = String(); // Offsets inside a compressed file can't be read back directly.
 		Ref<FileAccessCompressed> fac;
 		fac.instantiate();
 		error = fac->open_after_magic(f);
@@ -1162,10 +1180,12 @@ String ResourceLoaderBinary::recognize_script_class(Ref<FileAccess> p_f) {
 	error = OK;
 
 	f = p_f;
+	stream_path = f->get_path();
 	uint8_t header[4];
 	f->get_buffer(header, 4);
 	if (header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C') {
 		// Compressed.
+		stream_path = String(); // Offsets inside a compressed file can't be read back directly.
 		Ref<FileAccessCompressed> fac;
 		fac.instantiate();
 		error = fac->open_after_magic(f);
@@ -1215,11 +1235,24 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	}
 
 	Error err;
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	Ref<FileAccess> f;
+	// Must outlive the loader's file, which reads from it directly.
+	const Vector<uint8_t> prefetched = ResourceLoader::take_prefetched_file(p_path);
+	if (!prefetched.is_empty()) {
+		Ref<FileAccessMemory> memfile;
+		memfile.instantiate();
+		err = memfile->open_custom(prefetched.ptr(), prefetched.size());
+		f = memfile;
+	} else {
+		f = FileAccess::open(p_path, FileAccess::READ, &err);
+	}
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), vformat("Cannot open file '%s'.", p_path));
 
 	ResourceLoaderBinary loader;
+	if (!prefetched.is_empty()) {
+		loader.source_path = p_path;
+	}
 	switch (p_cache_mode) {
 		case CACHE_MODE_IGNORE:
 		case CACHE_MODE_REUSE:
@@ -1302,6 +1335,29 @@ void ResourceFormatLoaderBinary::get_dependencies(const String &p_path, List<Str
 	loader.get_dependencies(f, p_dependencies, p_add_types);
 }
 
+void ResourceFormatLoaderBinary::get_dependencies_from_buffer(const String &p_path, const Vector<uint8_t> &p_buffer, List<String> *r_dependencies) {
+	Ref<FileAccessMemory> f;
+	f.instantiate();
+	ERR_FAIL_COND(f->open_custom(p_buffer.ptr(), p_buffer.size()) != OK);
+
+	ResourceLoaderBinary loader;
+	loader.local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	loader.res_path = loader.local_path;
+	loader.open(f);
+	if (loader.error != OK) {
+		return;
+	}
+
+	// Same paths ResourceLoaderBinary::load() will request.
+	for (const ResourceLoaderBinary::ExtResource &er : loader.external_resources) {
+		String path = er.path;
+		if (!path.contains("://") && path.is_relative_path()) {
+			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(er.path));
+		}
+		r_dependencies->push_back(path);
+	}
+}
+
 Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, const HashMap<String, String> &p_map) {
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
 	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_OPEN, vformat("Cannot open file '%s'.", p_path));
@@ -1930,9 +1986,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			int len = arr.size();
 			f->store_32(uint32_t(len));
 			const int32_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_32(uint32_t(r[i]));
-			}
+			store_array(f, r, len);
 
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
@@ -1941,9 +1995,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			int len = arr.size();
 			f->store_32(uint32_t(len));
 			const int64_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_64(uint64_t(r[i]));
-			}
+			store_array(f, r, len);
 
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
@@ -1952,9 +2004,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			int len = arr.size();
 			f->store_32(uint32_t(len));
 			const float *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i]);
-			}
+			store_array(f, r, len);
 
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
@@ -1963,9 +2013,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			int len = arr.size();
 			f->store_32(uint32_t(len));
 			const double *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_double(r[i]);
-			}
+			store_array(f, r, len);
 
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
@@ -1985,10 +2033,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			int len = arr.size();
 			f->store_32(uint32_t(len));
 			const Vector2 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-			}
+			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
+			store_array(f, reinterpret_cast<const real_t *>(r), len * 2);
 		} break;
 
 		case Variant::PACKED_VECTOR3_ARRAY: {
@@ -1997,11 +2043,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			int len = arr.size();
 			f->store_32(uint32_t(len));
 			const Vector3 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-			}
+			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
+			store_array(f, reinterpret_cast<const real_t *>(r), len * 3);
 		} break;
 
 		case Variant::PACKED_COLOR_ARRAY: {
@@ -2010,12 +2053,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			int len = arr.size();
 			f->store_32(uint32_t(len));
 			const Color *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i].r);
-				f->store_float(r[i].g);
-				f->store_float(r[i].b);
-				f->store_float(r[i].a);
-			}
+			static_assert(sizeof(Color) == 4 * sizeof(float));
+			store_array(f, reinterpret_cast<const float *>(r), len * 4);
 
 		} break;
 		case Variant::PACKED_VECTOR4_ARRAY: {
@@ -2024,12 +2063,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			int len = arr.size();
 			f->store_32(uint32_t(len));
 			const Vector4 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-				f->store_real(r[i].w);
-			}
+			static_assert(sizeof(Vector4) == 4 * sizeof(real_t));
+			store_array(f, reinterpret_cast<const real_t *>(r), len * 4);
 
 		} break;
 		default: {
@@ -2160,20 +2195,6 @@ static String _resource_get_class(Ref<Resource> p_resource) {
 Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags) {
 	Resource::seed_scene_unique_id(p_path.hash());
 
-	Error err;
-	Ref<FileAccess> f;
-	if (p_flags & ResourceSaver::FLAG_COMPRESS) {
-		Ref<FileAccessCompressed> fac;
-		fac.instantiate();
-		fac->configure("RSCC");
-		f = fac;
-		err = fac->open_internal(p_path, FileAccess::WRITE);
-	} else {
-		f = FileAccess::open(p_path, FileAccess::WRITE, &err);
-	}
-
-	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot create file '%s'.", p_path));
-
 	relative_paths = p_flags & ResourceSaver::FLAG_RELATIVE_PATHS;
 	skip_editor = p_flags & ResourceSaver::FLAG_OMIT_EDITOR_PROPERTIES;
 	bundle_resources = p_flags & ResourceSaver::FLAG_BUNDLE_RESOURCES;
@@ -2189,6 +2210,25 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 
 	_find_resources(p_resource, true);
 
+	// Opening the file truncates it, so data streamed from it must be read first.
+	for (const Ref<Resource> &E : saved_resources) {
+		E->make_streamed_buffers_resident(p_path);
+	}
+
+	Error err;
+	Ref<FileAccess> f;
+	if (p_flags & ResourceSaver::FLAG_COMPRESS) {
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("RSCC");
+		f = fac;
+		err = fac->open_internal(p_path, FileAccess::WRITE);
+	} else {
+		f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	}
+
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot create file '%s'.", p_path));
+
 	if (!(p_flags & ResourceSaver::FLAG_COMPRESS)) {
 		//save header compressed
 		static const uint8_t header[4] = { 'R', 'S', 'R', 'C' };
@@ -44,6 +44,8 @@ class ResourceLoaderBinary {
 	uint32_t ver_format = 0;
 
 	Ref<FileAccess> f;
+	String stream_path; // Path of the uncompressed file being read, for resources that stream their data from it.
+	String source_path; // File on disk when reading from a prefetched buffer.
 
 	uint64_t importmd_ofs = 0;
 
@@ -90,6 +92,7 @@ class ResourceLoaderBinary {
 	friend class ResourceFormatLoaderBinary;
 
 	Error parse_variant(Variant &r_v);
+	Error parse_variant_of_type(uint32_t p_type, Variant &r_v);
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
@@ -121,6 +124,8 @@ public:
 	virtual bool has_custom_uid_support() const override;
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false) override;
 	virtual Error rename_dependencies(const String &p_path, const HashMap<String, String> &p_map) override;
+	virtual bool can_prefetch(const String &p_path) const override { return true; }
+	virtual void get_dependencies_from_buffer(const String &p_path, const Vector<uint8_t> &p_buffer, List<String> *r_dependencies) override;
 };
 
 class ResourceFormatSaverBinaryInstance {
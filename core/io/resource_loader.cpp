@@ -34,6 +34,7 @@
 #include "core/core_bind.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -303,6 +304,18 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 
 	print_verbose(vformat("Loading resource: %s", p_path));
 
+	const bool record_timing = load_timings_enabled;
+	uint64_t timing_start = 0;
+	uint64_t nested_usec_backup = 0;
+	bool prefetched = false;
+	if (record_timing) {
+		timing_start = OS::get_singleton()->get_ticks_usec();
+		nested_usec_backup = load_timing_nested_usec;
+		load_timing_nested_usec = 0;
+		MutexLock prefetch_lock(prefetch_mutex);
+		prefetched = prefetched_files.has(p_path);
+	}
+
 	// Try all loaders and pick the first match for the type hint
 	bool found = false;
 	Ref<Resource> res;
@@ -317,6 +330,23 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 		}
 	}
 
+	if (record_timing) {
+		LoadTiming timing;
+		timing.path = original_path;
+		timing.type = res.is_valid() ? res->get_class() : p_type_hint;
+		timing.thread_id = Thread::get_caller_id();
+		timing.start_usec = timing_start;
+		timing.total_usec = OS::get_singleton()->get_ticks_usec() - timing_start;
+		timing.self_usec = timing.total_usec - MIN(timing.total_usec, load_timing_nested_usec);
+		timing.depth = load_nesting - 1;
+		timing.prefetched = prefetched;
+		timing.failed = res.is_null();
+		load_timing_nested_usec = nested_usec_backup + timing.total_usec;
+
+		MutexLock timings_lock(load_timings_mutex);
+		load_timings.push_back(timing);
+	}
+
 	load_paths_stack.resize(load_paths_stack.size() - 1);
 	res_ref_overrides.erase(load_nesting);
 	load_nesting--;
@@ -392,8 +422,25 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	bool xl_remapped = false;
 	const String &remapped_path = _path_remap(load_task.local_path, &xl_remapped);
 
+	if (load_task.prefetch) {
+		_prefetch_dependencies(load_task, load_task.local_path);
+	}
+
 	Error load_err = OK;
 	Ref<Resource> res = _load(remapped_path, remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_err, load_task.use_sub_threads, &load_task.progress);
+
+	if (!load_task.prefetched_paths.is_empty()) {
+		// Whatever the loaders didn't take (e.g., failed or skipped dependencies) is not needed anymore.
+		MutexLock prefetch_lock(prefetch_mutex);
+		for (const String &path : load_task.prefetched_paths) {
+			HashMap<String, Vector<uint8_t>>::Iterator E = prefetched_files.find(path);
+			if (E) {
+				prefetched_bytes -= E->value.size();
+				prefetched_files.remove(E);
+			}
+		}
+		load_task.prefetched_paths.clear();
+	}
 	if (MessageQueue::get_singleton() != MessageQueue::get_main_singleton()) {
 		MessageQueue::get_singleton()->flush();
 	}
@@ -502,6 +549,145 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	curr_load_task = curr_load_task_backup;
 }
 
+String ResourceLoader::_get_prefetch_path(const String &p_path) {
+	String path = _path_remap(_validate_local_path(p_path));
+	if (ResourceFormatImporter::get_singleton()->recognize_path(path)) {
+		path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(path);
+	}
+	return path;
+}
+
+void ResourceLoader::_prefetch_read(void *p_userdata, uint32_t p_index) {
+	PrefetchRequest &request = ((PrefetchRequest *)p_userdata)[p_index];
+
+	Error err = OK;
+	request.data = FileAccess::get_file_as_bytes(request.path, &err);
+	if (err != OK) {
+		request.data.clear();
+		return;
+	}
+	request.format_loader->get_dependencies_from_buffer(request.path, request.data, &request.dependencies);
+}
+
+// Reads the dependency graph of a threaded load before the loaders walk it, one dependency level at a time.
+// The reads of a level are issued together and in pack order. Each buffer stays in the prefetch cache until
+// the loader of that path takes it, or the load task ends.
+void ResourceLoader::_prefetch_dependencies(ThreadLoadTask &p_load_task, const String &p_path) {
+	const bool deep = p_load_task.cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP || p_load_task.cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE_DEEP;
+	PackedData *packed_data = PackedData::get_singleton();
+	const bool use_pack = packed_data && !packed_data->is_disabled();
+
+	HashSet<String> visited;
+	LocalVector<String> pending;
+	visited.insert(p_path);
+	pending.push_back(p_path);
+
+	while (!pending.is_empty()) {
+		LocalVector<PrefetchRequest> requests;
+		for (const String &local_path : pending) {
+			if (local_path != p_path && !deep && ResourceCache::has(local_path)) {
+				continue;
+			}
+
+			PrefetchRequest request;
+			request.path = _get_prefetch_path(local_path);
+			if (request.path.is_empty()) {
+				continue;
+			}
+			for (int i = 0; i < loader_count; i++) {
+				if (loader[i]->recognize_path(request.path)) {
+					if (loader[i]->can_prefetch(request.path)) {
+						request.format_loader = loader[i];
+					}
+					break;
+				}
+			}
+			if (request.format_loader.is_null()) {
+				continue;
+			}
+			{
+				MutexLock prefetch_lock(prefetch_mutex);
+				if (prefetched_files.has(request.path)) {
+					continue; // Another load is prefetching it already.
+				}
+			}
+			if (use_pack) {
+				request.pack_offset = packed_data->get_offset(request.path);
+			}
+			requests.push_back(request);
+		}
+		pending.clear();
+
+		if (requests.is_empty()) {
+			break;
+		}
+		requests.sort();
+
+		if (requests.size() == 1) {
+			_prefetch_read(requests.ptr(), 0);
+		} else {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&ResourceLoader::_prefetch_read, requests.ptr(), requests.size(), -1, true, SNAME("ResourceLoaderPrefetch"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		MutexLock prefetch_lock(prefetch_mutex);
+		for (PrefetchRequest &request : requests) {
+			if (request.data.is_empty()) {
+				continue;
+			}
+			if (prefetched_bytes + request.data.size() > dependency_prefetch_budget) {
+				// Out of budget; the loaders read the rest of the graph themselves.
+				pending.clear();
+				break;
+			}
+			if (prefetched_files.has(request.path)) {
+				continue;
+			}
+			prefetched_bytes += request.data.size();
+			prefetched_files.insert(request.path, request.data);
+			p_load_task.prefetched_paths.push_back(request.path);
+
+			for (const String &dependency : request.dependencies) {
+				if (!visited.has(dependency)) {
+					visited.insert(dependency);
+					pending.push_back(dependency);
+				}
+			}
+		}
+	}
+}
+
+Vector<uint8_t> ResourceLoader::take_prefetched_file(const String &p_path) {
+	MutexLock prefetch_lock(prefetch_mutex);
+	HashMap<String, Vector<uint8_t>>::Iterator E = prefetched_files.find(p_path);
+	if (!E) {
+		return Vector<uint8_t>();
+	}
+	Vector<uint8_t> data = E->value;
+	prefetched_bytes -= data.size();
+	prefetched_files.remove(E);
+	return data;
+}
+
+void ResourceLoader::set_load_timings_enabled(bool p_enabled) {
+	load_timings_enabled = p_enabled;
+}
+
+Vector<ResourceLoader::LoadTiming> ResourceLoader::get_load_timings() {
+	MutexLock timings_lock(load_timings_mutex);
+	Vector<LoadTiming> timings;
+	timings.resize(load_timings.size());
+	for (uint32_t i = 0; i < load_timings.size(); i++) {
+		timings.write[i] = load_timings[i];
+	}
+	return timings;
+}
+
+void ResourceLoader::clear_load_timings() {
+	MutexLock timings_lock(load_timings_mutex);
+	load_timings.clear();
+}
+
 String ResourceLoader::_validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -613,6 +799,8 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			// Only requests from outside any load; dependencies are covered by the prefetch of their root.
+			load_task.prefetch = p_thread_mode != LOAD_THREAD_FROM_CURRENT && load_nesting == 0 && dependency_prefetch_budget > 0;
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
@@ -1419,6 +1607,12 @@ void ResourceLoader::clear_thread_load_tasks() {
 
 	thread_load_tasks.clear();
 
+	{
+		MutexLock prefetch_lock(prefetch_mutex);
+		prefetched_files.clear();
+		prefetched_bytes = 0;
+	}
+
 	cleaning_tasks = false;
 }
 
@@ -1557,7 +1751,14 @@ Vector<String> ResourceLoader::list_directory(const String &p_directory) {
 
 void ResourceLoader::initialize() {}
 
-void ResourceLoader::finalize() {}
+void ResourceLoader::finalize() {
+	{
+		MutexLock prefetch_lock(prefetch_mutex);
+		prefetched_files.clear();
+		prefetched_bytes = 0;
+	}
+	clear_load_timings();
+}
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = nullptr;
 DependencyErrorNotify ResourceLoader::dep_err_notify = nullptr;
@@ -1571,6 +1772,16 @@ thread_local int ResourceLoader::load_nesting = 0;
 thread_local Vector<String> ResourceLoader::load_paths_stack;
 thread_local HashMap<int, HashMap<String, Ref<Resource>>> ResourceLoader::res_ref_overrides;
 thread_local ResourceLoader::ThreadLoadTask *ResourceLoader::curr_load_task = nullptr;
+thread_local uint64_t ResourceLoader::load_timing_nested_usec = 0;
+
+uint64_t ResourceLoader::dependency_prefetch_budget = 64 * 1024 * 1024;
+Mutex ResourceLoader::prefetch_mutex;
+HashMap<String, Vector<uint8_t>> ResourceLoader::prefetched_files;
+uint64_t ResourceLoader::prefetched_bytes = 0;
+
+bool ResourceLoader::load_timings_enabled = false;
+Mutex ResourceLoader::load_timings_mutex;
+LocalVector<ResourceLoader::LoadTiming> ResourceLoader::load_timings;
 
 SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG> &_get_res_loader_mutex() {
 	return ResourceLoader::thread_load_mutex;
@@ -91,6 +91,11 @@ public:
 	virtual int get_import_order(const String &p_path) const { return 0; }
 	virtual String get_import_group_file(const String &p_path) const { return ""; } //no group
 
+	// Dependency prefetching for threaded loads. Formats that read their files through FileAccess can list
+	// the dependencies of a file already read into memory, then load it from ResourceLoader::take_prefetched_file().
+	virtual bool can_prefetch(const String &p_path) const { return false; }
+	virtual void get_dependencies_from_buffer(const String &p_path, const Vector<uint8_t> &p_buffer, List<String> *r_dependencies) {}
+
 	virtual ~ResourceFormatLoader() {}
 };
 
@@ -126,6 +131,18 @@ public:
 		LOAD_THREAD_DISTRIBUTE,
 	};
 
+	struct LoadTiming {
+		String path;
+		String type;
+		Thread::ID thread_id = 0;
+		uint64_t start_usec = 0;
+		uint64_t total_usec = 0; // Includes the dependencies loaded on the same thread.
+		uint64_t self_usec = 0;
+		int depth = 0; // Load nesting level on the loading thread.
+		bool prefetched = false; // The file was read by the dependency prefetch pass.
+		bool failed = false;
+	};
+
 	struct LoadToken : public RefCounted {
 		String local_path;
 		String user_path;
@@ -194,6 +211,7 @@ private:
 		bool need_wait : 1;
 		bool in_progress_check : 1; // Measure against recursion cycles in progress reporting. Cycles are not expected, but can happen due to how it's currently implemented.
 		bool use_sub_threads : 1;
+		bool prefetch : 1; // Top-level threaded request, reads its dependency graph ahead.
 
 		struct ResourceChangedConnection {
 			Resource *source = nullptr;
@@ -202,14 +220,49 @@ private:
 		};
 		LocalVector<ResourceChangedConnection> resource_changed_connections;
 
+		LocalVector<String> prefetched_paths; // Left in the prefetch cache until a loader takes them.
+
 		ThreadLoadTask() :
 				awaited(false),
 				need_wait(true),
 				in_progress_check(false),
-				use_sub_threads(false) {}
+				use_sub_threads(false),
+				prefetch(false) {}
 	};
 	static void _run_load_task(void *p_userdata);
 
+	struct PrefetchRequest {
+		String path; // As requested by the loaders.
+		int64_t pack_offset = -1;
+		Vector<uint8_t> data;
+		List<String> dependencies;
+		Ref<ResourceFormatLoader> format_loader;
+
+		// Packed files first, in pack order, so a level is read sequentially from the pack.
+		bool operator<(const PrefetchRequest &p_other) const {
+			if ((pack_offset < 0) != (p_other.pack_offset < 0)) {
+				return pack_offset >= 0;
+			}
+			if (pack_offset != p_other.pack_offset) {
+				return pack_offset < p_other.pack_offset;
+			}
+			return path < p_other.path;
+		}
+	};
+	static void _prefetch_read(void *p_userdata, uint32_t p_index);
+	static void _prefetch_dependencies(ThreadLoadTask &p_load_task, const String &p_path);
+	static String _get_prefetch_path(const String &p_path);
+
+	static uint64_t dependency_prefetch_budget;
+	static Mutex prefetch_mutex;
+	static HashMap<String, Vector<uint8_t>> prefetched_files;
+	static uint64_t prefetched_bytes;
+
+	static thread_local uint64_t load_timing_nested_usec;
+	static bool load_timings_enabled;
+	static Mutex load_timings_mutex;
+	static LocalVector<LoadTiming> load_timings;
+
 	static thread_local bool import_thread;
 	static thread_local int load_nesting;
 	static thread_local HashMap<int, HashMap<String, Ref<Resource>>> res_ref_overrides; // Outermost key is nesting level.
@@ -314,6 +367,15 @@ public:
 
 	static bool is_cleaning_tasks();
 
+	static void set_dependency_prefetch_budget(uint64_t p_bytes) { dependency_prefetch_budget = p_bytes; }
+	static uint64_t get_dependency_prefetch_budget() { return dependency_prefetch_budget; }
+	static Vector<uint8_t> take_prefetched_file(const String &p_path);
+
+	static void set_load_timings_enabled(bool p_enabled);
+	static bool is_load_timings_enabled() { return load_timings_enabled; }
+	static Vector<LoadTiming> get_load_timings();
+	static void clear_load_timings();
+
 	static Vector<String> list_directory(const String &p_directory);
 
 	static void initialize();
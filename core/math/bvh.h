@@ -53,6 +53,7 @@
 #include "bvh_tree.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -89,6 +90,15 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// When at least this many items changed since the last pairing check, the
+	// tree queries for pairing are spread across the WorkerThreadPool. Pair and
+	// unpair callbacks are still sent from the calling thread, in the same order
+	// as the serial path. Zero disables threaded pairing.
+	void params_set_threaded_pairing_threshold(uint32_t p_threshold) {
+		BVH_LOCKED_FUNCTION
+		_threaded_pairing_threshold = p_threshold;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -436,6 +446,12 @@ private:
 			return;
 		}
 
+		// The full check is only requested for single items (e.g. in set_tree), not worth threading.
+		if (!p_full_check && _threaded_pairing_threshold && changed_items.size() >= _threaded_pairing_threshold) {
+			_check_for_collisions_threaded();
+			return;
+		}
+
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -479,6 +495,58 @@ private:
 		_reset();
 	}
 
+	// Culls the tree for one changed item. Run on worker threads, so it must only read the tree.
+	void _gather_pairing_hits(uint32_t p_index, void *p_userdata) {
+		const BVHHandle h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_to_hits(params, _pairing_hits[p_index]);
+	}
+
+	void _check_for_collisions_threaded() {
+		uint32_t changed_count = changed_items.size();
+
+		// Only grow, so the per item lists keep their capacity between ticks.
+		if (_pairing_hits.size() < changed_count) {
+			_pairing_hits.resize(changed_count);
+		}
+
+		// The tree isn't modified while pairing, only the pair lists are,
+		// so all the culling can happen in parallel up front.
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_gather_pairing_hits, nullptr, changed_count, -1, true, SNAME("BVHPairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Merge in changed item order, so the callbacks match the serial path.
+		for (uint32_t n = 0; n < changed_count; n++) {
+			const BVHHandle h = changed_items[n];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+			_find_leavers(h, abb, false);
+
+			uint32_t changed_item_ref_id = h.id();
+			for (const uint32_t ref_id : _pairing_hits[n]) {
+				// don't collide against ourself
+				if (ref_id == changed_item_ref_id) {
+					continue;
+				}
+
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -772,6 +840,10 @@ private:
 	LocalVector<BVHHandle> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Tree query results per changed item, filled on worker threads when pairing is threaded.
+	LocalVector<LocalVector<uint32_t>> _pairing_hits;
+	uint32_t _threaded_pairing_threshold = 0;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
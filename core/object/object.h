@@ -1137,3 +1137,15 @@ public:
 	static void debug_objects(DebugFunc p_func, void *p_user_data);
 	static int get_object_count();
 };
+
+#ifdef DEBUG_ENABLED
+// Held while a method of the object runs, so freeing it from that method fails instead of
+// leaving the method running on a deleted object. Taken by `Object::callp()`, and by callers
+// that dispatch to methods directly.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj);
+	~_ObjectDebugLock();
+};
+#endif // DEBUG_ENABLED
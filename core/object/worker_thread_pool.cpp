@@ -92,25 +92,16 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// Handling a group
 		bool do_post = false;
 
-		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
-
-			if (work_index >= p_task->group->max) {
-				break;
-			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
-			}
-
-			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+		if (p_task->group->steal_ranges) {
+			_process_group_work_stealing(p_task, do_post);
+		} else {
+			while (true) {
+				uint32_t work_index = p_task->group->index.postincrement();
 
-			if (completed_amount == p_task->group->max) {
-				do_post = true;
+				if (work_index >= p_task->group->max) {
+					break;
+				}
+				_process_group_element(p_task, work_index, do_post);
 			}
 		}
 
@@ -128,7 +119,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
 			MutexLock task_lock(task_mutex);
-			group_allocator.free(p_task->group);
+			_free_group(p_task->group);
 		}
 
 		// For groups, tasks get rid of themselves.
@@ -181,6 +172,98 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #endif
 }
 
+void WorkerThreadPool::_process_group_element(Task *p_task, uint32_t p_work_index, bool &r_do_post) {
+	if (p_task->native_group_func) {
+		p_task->native_group_func(p_task->native_func_userdata, p_work_index);
+	} else if (p_task->template_userdata) {
+		p_task->template_userdata->callback_indexed(p_work_index);
+	} else {
+		p_task->callable.call(p_work_index);
+	}
+
+	// This is the only way to ensure posting is done when all tasks are really complete.
+	uint32_t completed_amount = p_task->group->completed_index.increment();
+
+	if (completed_amount == p_task->group->max) {
+		r_do_post = true;
+	}
+}
+
+void WorkerThreadPool::_process_group_work_stealing(Task *p_task, bool &r_do_post) {
+	Group *group = p_task->group;
+
+	// Every task of the group claims one range, which it then consumes from the front.
+	const uint32_t slot = group->steal_slot.postincrement();
+	DEV_ASSERT(slot < group->tasks_used);
+	std::atomic<uint64_t> &own_bounds = group->steal_ranges[slot].bounds;
+	uint32_t seed = ((slot + 1) * 2654435761u) | 1;
+
+	while (true) {
+		uint64_t bounds = own_bounds.load(std::memory_order_acquire);
+		const uint32_t begin = StealRange::get_begin(bounds);
+		const uint32_t end = StealRange::get_end(bounds);
+
+		if (begin >= end) {
+			if (_steal_group_work(group, slot, seed)) {
+				continue;
+			}
+			// Nothing left anywhere. Elements stolen by others are processed by them.
+			break;
+		}
+
+		if (!own_bounds.compare_exchange_weak(bounds, StealRange::pack(begin + 1, end), std::memory_order_acq_rel, std::memory_order_acquire)) {
+			// A thief took the back of the range in the meantime, retry.
+			continue;
+		}
+
+		_process_group_element(p_task, begin, r_do_post);
+	}
+}
+
+bool WorkerThreadPool::_steal_group_work(Group *p_group, uint32_t p_slot, uint32_t &r_seed) {
+	const uint32_t slot_count = p_group->tasks_used;
+
+	// Start probing at a random victim, so thieves spread across the ranges.
+	r_seed ^= r_seed << 13;
+	r_seed ^= r_seed >> 17;
+	r_seed ^= r_seed << 5;
+	const uint32_t first_victim = r_seed % slot_count;
+
+	for (uint32_t i = 0; i < slot_count; i++) {
+		const uint32_t victim = (first_victim + i) % slot_count;
+		if (victim == p_slot) {
+			continue;
+		}
+
+		std::atomic<uint64_t> &victim_bounds = p_group->steal_ranges[victim].bounds;
+		uint64_t bounds = victim_bounds.load(std::memory_order_acquire);
+		while (true) {
+			const uint32_t begin = StealRange::get_begin(bounds);
+			const uint32_t end = StealRange::get_end(bounds);
+			if (begin >= end) {
+				break;
+			}
+
+			// Take the back half, rounding up so a single remaining element can be stolen too.
+			const uint32_t steal_begin = end - (end - begin + 1) / 2;
+			if (victim_bounds.compare_exchange_weak(bounds, StealRange::pack(begin, steal_begin), std::memory_order_acq_rel, std::memory_order_acquire)) {
+				// The own range is empty at this point, so no thief can be racing on it.
+				p_group->steal_ranges[p_slot].bounds.store(StealRange::pack(steal_begin, end), std::memory_order_release);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void WorkerThreadPool::_free_group(Group *p_group) {
+	if (p_group->steal_ranges) {
+		Memory::free_aligned_static(p_group->steal_ranges);
+	}
+	group_allocator.free(p_group);
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
@@ -688,6 +771,17 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
+
+		if (work_stealing && p_tasks > 1) {
+			// Split the elements evenly, tasks that run out will steal from the others.
+			group->steal_ranges = (StealRange *)Memory::alloc_aligned_static(sizeof(StealRange) * p_tasks, alignof(StealRange));
+			for (int i = 0; i < p_tasks; i++) {
+				const uint32_t begin = uint64_t(p_elements) * i / p_tasks;
+				const uint32_t end = uint64_t(p_elements) * (i + 1) / p_tasks;
+				memnew_placement(&group->steal_ranges[i], StealRange);
+				group->steal_ranges[i].bounds.store(StealRange::pack(begin, end), std::memory_order_relaxed);
+			}
+		}
 	}
 
 	groups[id] = group;
@@ -748,7 +842,7 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		if (finished_users == max_users) {
 			// All tasks using this group are gone (finished before the group), so clear the group too.
 			MutexLock task_lock(task_mutex);
-			group_allocator.free(group);
+			_free_group(group);
 		}
 	}
 
@@ -806,10 +900,11 @@ void WorkerThreadPool::thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {
 }
 #endif
 
-void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio, bool p_work_stealing) {
 	ERR_FAIL_COND(threads.size() > 0);
 
 	runlevel = RUNLEVEL_NORMAL;
+	work_stealing = p_work_stealing;
 
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
@@ -817,7 +912,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
 
-	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority.", p_thread_count, max_low_priority_threads));
+	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority%s.", p_thread_count, max_low_priority_threads, work_stealing ? ", work stealing" : ""));
 
 #ifdef THREADS_ENABLED
 	// Reserve 5 threads in case we need separate threads for 1) 2D physics 2) 3D physics 3) rendering 4) GPU texture compression, 5) all other tasks.
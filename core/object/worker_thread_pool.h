@@ -60,6 +60,17 @@ private:
 		virtual ~BaseTemplateUserdata() {}
 	};
 
+	// Range of group elements owned by a task in work-stealing mode.
+	// The owner pops from the front and thieves steal from the back. Both bounds
+	// are packed in a single word so either side can update them with one CAS.
+	struct alignas(Thread::CACHE_LINE_BYTES) StealRange {
+		std::atomic<uint64_t> bounds; // Begin in the low 32 bits, end in the high 32 bits.
+
+		_FORCE_INLINE_ static uint64_t pack(uint32_t p_begin, uint32_t p_end) { return uint64_t(p_begin) | (uint64_t(p_end) << 32); }
+		_FORCE_INLINE_ static uint32_t get_begin(uint64_t p_bounds) { return uint32_t(p_bounds); }
+		_FORCE_INLINE_ static uint32_t get_end(uint64_t p_bounds) { return uint32_t(p_bounds >> 32); }
+	};
+
 	struct Group {
 		GroupID self = -1;
 		SafeNumeric<uint32_t> index;
@@ -69,6 +80,8 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		StealRange *steal_ranges = nullptr; // One per task, only in work-stealing mode.
+		SafeNumeric<uint32_t> steal_slot;
 	};
 
 	struct Task {
@@ -165,6 +178,7 @@ private:
 			PagedAllocator<HashMapElement<GroupID, Group *>, false, GROUPS_PAGE_SIZE>>
 			groups;
 
+	bool work_stealing = false;
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
@@ -177,6 +191,10 @@ private:
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	void _process_group_element(Task *p_task, uint32_t p_work_index, bool &r_do_post);
+	void _process_group_work_stealing(Task *p_task, bool &r_do_post);
+	bool _steal_group_work(Group *p_group, uint32_t p_slot, uint32_t &r_seed);
+	void _free_group(Group *p_group);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
@@ -295,7 +313,7 @@ public:
 	static void thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {}
 #endif
 
-	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3);
+	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3, bool p_work_stealing = false);
 	void exit_languages_threads();
 	void finish();
 	WorkerThreadPool(bool p_singleton = true);
@@ -36,6 +36,9 @@
 #include "core/string/print_string.h"
 
 #include <fcntl.h>
+#if !defined(WEB_ENABLED)
+#include <sys/mman.h>
+#endif
 #include <sys/stat.h>
 #include <sys/types.h>
 #if !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(WEB_ENABLED)
@@ -204,6 +207,14 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+#if !defined(WEB_ENABLED)
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+#endif
+
 	fclose(f);
 	f = nullptr;
 
@@ -309,6 +320,35 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::map_read_only() {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+#if defined(WEB_ENABLED)
+	return nullptr;
+#else
+	if (mapped) {
+		return (const uint8_t *)mapped;
+	}
+	if (flags != READ) {
+		return nullptr;
+	}
+
+	uint64_t size = get_length();
+	if (size == 0 || size > SIZE_MAX) {
+		return nullptr;
+	}
+
+	void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fileno(f), 0);
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped = data;
+	mapped_size = size;
+	return (const uint8_t *)mapped;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -405,6 +445,17 @@ uint64_t FileAccessUnix::_get_access_time(const String &p_file) {
 	ERR_FAIL_V_MSG(0, "Failed to get access time for: " + p_file + "");
 }
 
+Error FileAccessUnix::_set_modified_time(const String &p_file, uint64_t p_time) {
+	String file = fix_path(p_file);
+	// Keep the access time.
+	struct timespec times[2] = {};
+	times[0].tv_nsec = UTIME_OMIT;
+	times[1].tv_sec = p_time;
+	int err = utimensat(AT_FDCWD, file.utf8().get_data(), times, 0);
+	ERR_FAIL_COND_V_MSG(err != 0, FAILED, "Failed to set modified time for: " + p_file + "");
+	return OK;
+}
+
 int64_t FileAccessUnix::_get_size(const String &p_file) {
 	String file = fix_path(p_file);
 	struct stat st = {};
@@ -47,6 +47,9 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	void *mapped = nullptr;
+	uint64_t mapped_size = 0;
+
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -71,6 +74,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_read_only() override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -82,6 +86,7 @@ public:
 
 	virtual uint64_t _get_modified_time(const String &p_file) override;
 	virtual uint64_t _get_access_time(const String &p_file) override;
+	virtual Error _set_modified_time(const String &p_file, uint64_t p_time) override;
 	virtual int64_t _get_size(const String &p_file) override;
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override;
 	virtual Error _set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) override;
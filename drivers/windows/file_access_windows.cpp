@@ -238,6 +238,13 @@ void FileAccessWindows::_close() {
 		return;
 	}
 
+	if (mapped) {
+		UnmapViewOfFile(mapped);
+		CloseHandle((HANDLE)mapping_handle);
+		mapped = nullptr;
+		mapping_handle = nullptr;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -349,6 +356,38 @@ uint64_t FileAccessWindows::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 	return read;
 }
 
+const uint8_t *FileAccessWindows::map_read_only() {
+	ERR_FAIL_NULL_V(f, nullptr);
+
+	if (mapped) {
+		return mapped;
+	}
+	if (flags != READ) {
+		return nullptr;
+	}
+
+	HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(f));
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+
+	// Fails for empty files, which have nothing to map anyway.
+	HANDLE mapping = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		return nullptr;
+	}
+
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data) {
+		CloseHandle(mapping);
+		return nullptr;
+	}
+
+	mapping_handle = mapping;
+	mapped = (const uint8_t *)data;
+	return mapped;
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
@@ -498,6 +537,32 @@ uint64_t FileAccessWindows::_get_access_time(const String &p_file) {
 	ERR_FAIL_V_MSG(0, "Failed to get access time for: " + p_file + "");
 }
 
+Error FileAccessWindows::_set_modified_time(const String &p_file, uint64_t p_time) {
+	ERR_FAIL_COND_V(is_path_invalid(p_file), ERR_INVALID_PARAMETER);
+
+	String file = fix_path(p_file);
+	if (file.ends_with("\\") && file != "\\") {
+		file = file.substr(0, file.length() - 1);
+	}
+
+	HANDLE handle = CreateFileW((LPCWSTR)(file.utf16().get_data()), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+	ERR_FAIL_COND_V_MSG(handle == INVALID_HANDLE_VALUE, ERR_FILE_CANT_OPEN, "Failed to set modified time for: " + p_file + "");
+
+	const uint64_t WINDOWS_TICKS_PER_SECOND = 10000000;
+	const uint64_t TICKS_TO_UNIX_EPOCH = 116444736000000000LL;
+	const uint64_t ticks = p_time * WINDOWS_TICKS_PER_SECOND + TICKS_TO_UNIX_EPOCH;
+
+	FILETIME ft_write;
+	ft_write.dwLowDateTime = (DWORD)(ticks & 0xFFFFFFFF);
+	ft_write.dwHighDateTime = (DWORD)(ticks >> 32);
+	bool status = SetFileTime(handle, nullptr, nullptr, &ft_write);
+
+	CloseHandle(handle);
+
+	ERR_FAIL_COND_V_MSG(!status, FAILED, "Failed to set modified time for: " + p_file + "");
+	return OK;
+}
+
 int64_t FileAccessWindows::_get_size(const String &p_file) {
 	if (is_path_invalid(p_file)) {
 		return 0;
@@ -48,6 +48,9 @@ class FileAccessWindows : public FileAccess {
 	String path_src;
 	String save_path;
 
+	void *mapping_handle = nullptr;
+	const uint8_t *mapped = nullptr;
+
 	void _close();
 
 	static HashSet<String> invalid_files;
@@ -70,6 +73,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_read_only() override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -81,6 +85,7 @@ public:
 
 	uint64_t _get_modified_time(const String &p_file) override;
 	uint64_t _get_access_time(const String &p_file) override;
+	Error _set_modified_time(const String &p_file, uint64_t p_time) override;
 	int64_t _get_size(const String &p_file) override;
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override;
 	virtual Error _set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) override;
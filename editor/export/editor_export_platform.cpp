@@ -1961,7 +1961,7 @@ Dictionary EditorExportPlatform::_save_zip_patch(const Ref<EditorExportPreset> &
 
 bool EditorExportPlatform::_store_header(Ref<FileAccess> p_fd, bool p_enc, bool p_sparse, uint64_t &r_file_base_ofs, uint64_t &r_dir_base_ofs) {
 	p_fd->store_32(PACK_HEADER_MAGIC);
-	p_fd->store_32(PACK_FORMAT_VERSION);
+	p_fd->store_32(PACK_FORMAT_VERSION_V3); // Exported entries are never compressed, so older runtimes can still read the pack.
 	p_fd->store_32(GODOT_VERSION_MAJOR);
 	p_fd->store_32(GODOT_VERSION_MINOR);
 	p_fd->store_32(GODOT_VERSION_PATCH);
@@ -1296,9 +1296,10 @@ Node *ResourceImporterScene::_post_fix_animations(Node *p_node, Node *p_root, co
 
 		bool use_compression = node_settings["compression/enabled"];
 		int anim_compression_page_size = node_settings["compression/page_size"];
+		bool anim_compression_streamed = node_settings["compression/streamed"];
 
 		if (use_compression) {
-			_compress_animations(ap, anim_compression_page_size);
+			_compress_animations(ap, anim_compression_page_size, anim_compression_streamed);
 		}
 
 		for (const StringName &name : anims) {
@@ -2105,12 +2106,13 @@ void ResourceImporterScene::_optimize_animations(AnimationPlayer *anim, float p_
 	}
 }
 
-void ResourceImporterScene::_compress_animations(AnimationPlayer *anim, int p_page_size_kb) {
+void ResourceImporterScene::_compress_animations(AnimationPlayer *anim, int p_page_size_kb, bool p_streamed) {
 	List<StringName> anim_names;
 	anim->get_animation_list(&anim_names);
 	for (const StringName &E : anim_names) {
 		Ref<Animation> a = anim->get_animation(E);
 		a->compress(p_page_size_kb * 1024);
+		a->set_compression_streamed(p_streamed);
 	}
 }
 
@@ -2211,6 +2213,7 @@ void ResourceImporterScene::get_internal_import_options(InternalImportCategory p
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "optimizer/max_precision_error", PROPERTY_HINT_NONE, "1,6,1"), 3));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "compression/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), false));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "compression/page_size", PROPERTY_HINT_RANGE, "4,512,1,suffix:kb"), 8));
+			r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "compression/streamed"), false));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "import_tracks/position", PROPERTY_HINT_ENUM, "IfPresent,IfPresentForAll,Never"), 1));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "import_tracks/rotation", PROPERTY_HINT_ENUM, "IfPresent,IfPresentForAll,Never"), 1));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "import_tracks/scale", PROPERTY_HINT_ENUM, "IfPresent,IfPresentForAll,Never"), 1));
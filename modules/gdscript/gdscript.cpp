@@ -742,6 +742,9 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 	reloading = true;
 
+	// Member layouts and functions are about to change.
+	invalidate_inline_caches();
+
 	bool has_instances;
 	{
 		MutexLock lock(GDScriptLanguage::singleton->mutex);
@@ -774,6 +777,9 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	// Parsed and possibly analyzed ahead of time by `GDScriptCache::warm_up()`.
+	Ref<GDScriptParserRef> prepared_parser;
+
 	{
 		String source_path = path;
 		if (source_path.is_empty()) {
@@ -784,18 +790,25 @@ Error GDScript::reload(bool p_keep_state) {
 				MutexLock lock(GDScriptCache::singleton->mutex);
 				GDScriptCache::singleton->shallow_gdscript_cache[source_path] = Ref<GDScript>(this);
 			}
-			if (GDScriptCache::has_parser(source_path)) {
-				Error err = OK;
-				Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(source_path, GDScriptParserRef::EMPTY, err);
-				if (parser_ref.is_valid()) {
-					uint32_t source_hash;
-					if (!binary_tokens.is_empty()) {
-						source_hash = hash_djb2_buffer(binary_tokens.ptr(), binary_tokens.size());
-					} else {
-						source_hash = source.hash();
-					}
-					if (parser_ref->get_source_hash() != source_hash) {
-						GDScriptCache::remove_parser(source_path);
+			prepared_parser = GDScriptCache::take_prepared_parser(source_path);
+			const bool has_parser = GDScriptCache::has_parser(source_path);
+			if (has_parser || prepared_parser.is_valid()) {
+				uint32_t source_hash;
+				if (!binary_tokens.is_empty()) {
+					source_hash = hash_djb2_buffer(binary_tokens.ptr(), binary_tokens.size());
+				} else {
+					source_hash = source.hash();
+				}
+				if (prepared_parser.is_valid() && prepared_parser->get_source_hash() != source_hash) {
+					prepared_parser.unref();
+				}
+				if (has_parser) {
+					Error err = OK;
+					Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(source_path, GDScriptParserRef::EMPTY, err);
+					if (parser_ref.is_valid()) {
+						if (parser_ref->get_source_hash() != source_hash) {
+							GDScriptCache::remove_parser(source_path);
+						}
 					}
 				}
 			}
@@ -811,9 +824,13 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
-	GDScriptParser parser;
+	GDScriptParser local_parser;
+	GDScriptParser &parser = prepared_parser.is_valid() ? *prepared_parser->get_parser() : local_parser;
 	Error err;
-	if (!binary_tokens.is_empty()) {
+	if (prepared_parser.is_valid()) {
+		// A parse error leaves the tree unanalyzed.
+		err = prepared_parser->get_status() == GDScriptParserRef::PARSED ? prepared_parser->result : OK;
+	} else if (!binary_tokens.is_empty()) {
 		err = parser.parse_binary(binary_tokens, path);
 	} else {
 		err = parser.parse(source, path, false);
@@ -828,8 +845,12 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
-	GDScriptAnalyzer analyzer(&parser);
-	err = analyzer.analyze();
+	if (prepared_parser.is_valid() && prepared_parser->get_status() == GDScriptParserRef::FULLY_SOLVED) {
+		err = prepared_parser->result;
+	} else {
+		GDScriptAnalyzer analyzer(&parser);
+		err = analyzer.analyze();
+	}
 
 	if (err) {
 		if (EngineDebugger::is_active()) {
@@ -1432,6 +1453,7 @@ GDScript::GDScript() :
 	}
 
 	path = vformat("gdscript://%d.gd", get_instance_id());
+	invalidate_inline_caches();
 }
 
 void GDScript::_save_orphaned_subclasses(ClearData *p_clear_data) {
@@ -2986,6 +3008,8 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	GLOBAL_DEF("debug/settings/gdscript/optimize_bytecode", true);
+	GLOBAL_DEF_RST("debug/settings/gdscript/parallel_warm_up", false);
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
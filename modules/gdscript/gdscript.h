@@ -63,6 +63,8 @@ class GDScript : public Script {
 	bool valid = false;
 	bool reloading = false;
 	bool _is_abstract = false;
+	// Inline caches keep what they resolved on the script along with this version.
+	SafeNumeric<uint32_t> inline_cache_version;
 
 	struct MemberInfo {
 		int index = 0;
@@ -84,6 +86,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -245,6 +248,10 @@ public:
 	// Cancels all functions of the script that are are waiting to be resumed after using await.
 	void cancel_pending_functions(bool warn);
 
+	// Makes the inline caches resolve names on this script again, since its members and functions
+	// may have moved or been freed. Caches of other scripts keep their entries.
+	void invalidate_inline_caches() { inline_cache_version.set(GDScriptFunction::get_new_inline_cache_version()); }
+
 	virtual bool is_valid() const override { return valid; }
 
 	bool inherits_script(const Ref<Script> &p_script) const override;
@@ -30,6 +30,7 @@
 
 #include "gdscript_byte_codegen.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
 
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
@@ -45,6 +46,7 @@ uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool
 uint32_t GDScriptByteCodeGenerator::add_local(const StringName &p_name, const GDScriptDataType &p_type) {
 	int stack_pos = locals.size() + GDScriptFunction::FIXED_ADDRESSES_MAX;
 	locals.push_back(StackSlot(p_type.builtin_type, p_type.can_contain_object()));
+	initialized_locals.erase(stack_pos);
 	add_stack_identifier(p_name, stack_pos);
 	return stack_pos;
 }
@@ -150,6 +152,7 @@ void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
+		mark_jump_target();
 	}
 }
 
@@ -173,6 +176,8 @@ void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName
 	function->return_type = p_return_type;
 	function->rpc_config = p_rpc_config;
 	function->_argument_count = 0;
+
+	optimize_bytecode = GLOBAL_GET_CACHED(bool, "debug/settings/gdscript/optimize_bytecode");
 }
 
 GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
@@ -183,8 +188,12 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #endif
 	append_opcode(GDScriptFunction::OPCODE_END);
 
+	int temporary_count = 0;
 	for (int i = 0; i < temporaries.size(); i++) {
-		int stack_index = i + max_locals + GDScriptFunction::FIXED_ADDRESSES_MAX;
+		if (optimize_bytecode && temporaries[i].bytecode_indices.is_empty()) {
+			continue; // All uses were optimized away, don't reserve stack space for it.
+		}
+		int stack_index = temporary_count++ + max_locals + GDScriptFunction::FIXED_ADDRESSES_MAX;
 		for (int j = 0; j < temporaries[i].bytecode_indices.size(); j++) {
 			opcodes.write[temporaries[i].bytecode_indices[j]] = stack_index | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
 		}
@@ -392,10 +401,12 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
-	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
+	function->_allocate_inline_caches(inline_cache_count);
+
+	if (track_locals) {
 		function->stack_debug = stack_debug;
 	}
-	function->_stack_size = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals + temporaries.size();
+	function->_stack_size = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals + temporary_count;
 	function->_instruction_args_size = instr_args_max;
 
 #ifdef DEBUG_ENABLED
@@ -407,6 +418,9 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	function->utilities_names = utilities_names;
 	function->gds_utilities_names = gds_utilities_names;
 #endif
+#ifdef TOOLS_ENABLED
+	function->link_info = link_info;
+#endif
 
 	ended = true;
 	return function;
@@ -563,6 +577,9 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		append(op_func);
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
+#endif
+#ifdef TOOLS_ENABLED
+		add_link_key(link_info.operators, get_operation_pos(op_func), p_left_operand.type.builtin_type, StringName(), p_operator);
 #endif
 		return;
 	}
@@ -573,6 +590,9 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	append(Address());
 	append(p_target);
 	append(p_operator);
+#ifdef TOOLS_ENABLED
+	link_info.operator_cache_positions.push_back(opcodes.size());
+#endif
 	append(0); // Signature storage.
 	append(0); // Return type storage.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
@@ -581,6 +601,199 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+bool GDScriptByteCodeGenerator::is_last_operation_result(const Address &p_address) const {
+	// Nothing may have been written after the operation, nor jump between it and the next instruction.
+	if (last_operation.position < 0 || last_operation.end != opcodes.size() || last_jump_target == opcodes.size()) {
+		return false;
+	}
+	if (p_address.mode != Address::TEMPORARY || last_operation.target.mode != Address::TEMPORARY || p_address.address != last_operation.target.address) {
+		return false;
+	}
+	// The consumer is expected to pop the temporary right after, so it must be the last one pushed.
+	return !used_temporaries.is_empty() && used_temporaries.back()->get() == (int)p_address.address;
+}
+
+void GDScriptByteCodeGenerator::retract_last_operation() {
+	const Address *operands[] = { &last_operation.left, &last_operation.right, &last_operation.target };
+	for (const Address *operand : operands) {
+		if (operand->mode != Address::TEMPORARY) {
+			continue;
+		}
+		Vector<int> &indices = temporaries.write[operand->address].bytecode_indices;
+		while (!indices.is_empty() && indices[indices.size() - 1] >= last_operation.position) {
+			indices.resize(indices.size() - 1);
+		}
+	}
+	opcodes.resize(last_operation.position);
+	last_operation = FusableOperation();
+}
+
+// Typed int and float arithmetic with a constant operand that fits in the instruction.
+bool GDScriptByteCodeGenerator::write_immediate_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
+	if (p_target.mode != Address::TEMPORARY) {
+		return false;
+	}
+
+	Address operand = p_left_operand;
+	Address constant = p_right_operand;
+	if (constant.mode != Address::CONSTANT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+			case Variant::OP_MULTIPLY:
+			case Variant::OP_BIT_AND:
+			case Variant::OP_BIT_OR:
+			case Variant::OP_BIT_XOR:
+				SWAP(operand, constant);
+				break;
+			default:
+				return false;
+		}
+	}
+	if (constant.mode != Address::CONSTANT || operand.mode == Address::CONSTANT) {
+		return false;
+	}
+
+	const Variant &value = constant_values[constant.address];
+	GDScriptFunction::Opcode opcode;
+	Variant::Type result_type;
+	int32_t immediate;
+
+	if (operand.type.builtin_type == Variant::INT && value.get_type() == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+			case Variant::OP_SUBTRACT:
+			case Variant::OP_MULTIPLY:
+			case Variant::OP_BIT_AND:
+			case Variant::OP_BIT_OR:
+			case Variant::OP_BIT_XOR:
+				break;
+			default:
+				return false;
+		}
+		int64_t int_value = value;
+		if (int_value < INT32_MIN || int_value > INT32_MAX) {
+			return false;
+		}
+		opcode = GDScriptFunction::OPCODE_OPERATOR_INT_IMMEDIATE;
+		result_type = Variant::INT;
+		immediate = int_value;
+	} else if (operand.type.builtin_type == Variant::FLOAT && (value.get_type() == Variant::INT || value.get_type() == Variant::FLOAT)) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+			case Variant::OP_SUBTRACT:
+			case Variant::OP_MULTIPLY:
+			case Variant::OP_DIVIDE:
+				break;
+			default:
+				return false;
+		}
+		// Only values that survive the round trip through the instruction, which excludes NaN and negative zero.
+		double float_value = value;
+		if (!(float_value >= INT32_MIN && float_value <= INT32_MAX) || float_value != (double)(int32_t)float_value || (float_value == 0.0 && std::signbit(float_value))) {
+			return false;
+		}
+		opcode = GDScriptFunction::OPCODE_OPERATOR_FLOAT_IMMEDIATE;
+		result_type = Variant::FLOAT;
+		immediate = (int32_t)float_value;
+	} else {
+		return false;
+	}
+
+	if (temporaries[p_target.address].type != result_type) {
+		return false;
+	}
+
+	int position = opcodes.size();
+	append_opcode(opcode);
+	append(operand);
+	append(p_target);
+	append(p_operator);
+	append(immediate);
+
+	last_operation = FusableOperation();
+	last_operation.position = position;
+	last_operation.end = opcodes.size();
+	last_operation.target_index = position + 2;
+	last_operation.left = operand;
+	last_operation.target = p_target;
+	last_operation.op = p_operator;
+	last_operation.result_type = result_type;
+	last_operation.sets_target_type = true;
+	return true;
+}
+
+// Makes the last operation write to the assigned address, instead of copying its result from a temporary.
+bool GDScriptByteCodeGenerator::fold_assign(const Address &p_target, const Address &p_source) {
+	if (!optimize_bytecode || !is_last_operation_result(p_source)) {
+		return false;
+	}
+
+	switch (p_target.mode) {
+		case Address::LOCAL_VARIABLE:
+		case Address::FUNCTION_PARAMETER:
+			break;
+		case Address::MEMBER:
+			if (!last_operation.sets_target_type) {
+				return false;
+			}
+			break;
+		default:
+			return false;
+	}
+
+	if (p_target.type.kind == GDScriptDataType::BUILTIN) {
+		if (p_target.type.builtin_type != last_operation.result_type) {
+			return false;
+		}
+	} else if (p_target.type.has_type() || !last_operation.sets_target_type) {
+		return false;
+	}
+
+	if (!last_operation.sets_target_type) {
+		// Validated operators write the result in place, so the local must already hold a value of that type.
+		if (!initialized_locals.has(p_target.address)) {
+			return false;
+		}
+		switch (last_operation.result_type) {
+			case Variant::BOOL:
+			case Variant::INT:
+			case Variant::FLOAT:
+			case Variant::VECTOR2:
+			case Variant::VECTOR2I:
+			case Variant::VECTOR3:
+			case Variant::VECTOR3I:
+				break;
+			default:
+				return false;
+		}
+	}
+
+	temporaries.write[p_source.address].bytecode_indices.erase(last_operation.target_index);
+	opcodes.write[last_operation.target_index] = address_of(p_target);
+	last_operation = FusableOperation();
+	return true;
+}
+
+// Appends a conditional jump without its destination, fusing it with the comparison that computed the condition if possible.
+void GDScriptByteCodeGenerator::append_jump_if_not(const Address &p_condition) {
+	if (optimize_bytecode && is_last_operation_result(p_condition) && last_operation.comparison_type != Variant::NIL) {
+		Address left = last_operation.left;
+		Address right = last_operation.right;
+		Variant::Operator op = last_operation.op;
+		bool is_int = last_operation.comparison_type == Variant::INT;
+		retract_last_operation();
+
+		append_opcode(is_int ? GDScriptFunction::OPCODE_JUMP_IF_NOT_COMPARE_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_COMPARE_FLOAT);
+		append(left);
+		append(right);
+		append(op);
+		return;
+	}
+
+	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+	append(p_condition);
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	bool valid = HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand);
 
@@ -601,6 +814,10 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		}
 	}
 
+	if (valid && optimize_bytecode && write_immediate_operator(p_target, p_operator, p_left_operand, p_right_operand)) {
+		return;
+	}
+
 	if (valid) {
 		if (p_target.mode == Address::TEMPORARY) {
 			Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
@@ -613,13 +830,43 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		int position = opcodes.size();
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
 		append(p_target);
 		append(op_func);
+
+		if (optimize_bytecode) {
+			last_operation = FusableOperation();
+			last_operation.position = position;
+			last_operation.end = opcodes.size();
+			last_operation.target_index = position + 3;
+			last_operation.left = p_left_operand;
+			last_operation.right = p_right_operand;
+			last_operation.target = p_target;
+			last_operation.op = p_operator;
+			last_operation.result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+			switch (p_operator) {
+				case Variant::OP_EQUAL:
+				case Variant::OP_NOT_EQUAL:
+				case Variant::OP_LESS:
+				case Variant::OP_LESS_EQUAL:
+				case Variant::OP_GREATER:
+				case Variant::OP_GREATER_EQUAL:
+					if (p_left_operand.type.builtin_type == p_right_operand.type.builtin_type && (p_left_operand.type.builtin_type == Variant::INT || p_left_operand.type.builtin_type == Variant::FLOAT)) {
+						last_operation.comparison_type = p_left_operand.type.builtin_type;
+					}
+					break;
+				default:
+					break;
+			}
+		}
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
+#endif
+#ifdef TOOLS_ENABLED
+		add_link_key(link_info.operators, get_operation_pos(op_func), p_left_operand.type.builtin_type, StringName(), p_operator, p_right_operand.type.builtin_type);
 #endif
 		return;
 	}
@@ -630,6 +877,9 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	append(p_right_operand);
 	append(p_target);
 	append(p_operator);
+#ifdef TOOLS_ENABLED
+	link_info.operator_cache_positions.push_back(opcodes.size());
+#endif
 	append(0); // Signature storage.
 	append(0); // Return type storage.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
@@ -797,6 +1047,9 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 			append(p_index);
 			append(p_source);
 			append(setter);
+#ifdef TOOLS_ENABLED
+			add_link_key(link_info.indexed_setters, get_indexed_setter_pos(setter), p_target.type.builtin_type);
+#endif
 			return;
 		} else if (Variant::get_member_validated_keyed_setter(p_target.type.builtin_type)) {
 			Variant::ValidatedKeyedSetter setter = Variant::get_member_validated_keyed_setter(p_target.type.builtin_type);
@@ -805,6 +1058,9 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 			append(p_index);
 			append(p_source);
 			append(setter);
+#ifdef TOOLS_ENABLED
+			add_link_key(link_info.keyed_setters, get_keyed_setter_pos(setter), p_target.type.builtin_type);
+#endif
 			return;
 		}
 	}
@@ -825,6 +1081,9 @@ void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address
 			append(p_index);
 			append(p_target);
 			append(getter);
+#ifdef TOOLS_ENABLED
+			add_link_key(link_info.indexed_getters, get_indexed_getter_pos(getter), p_source.type.builtin_type);
+#endif
 			return;
 		} else if (Variant::get_member_validated_keyed_getter(p_source.type.builtin_type)) {
 			Variant::ValidatedKeyedGetter getter = Variant::get_member_validated_keyed_getter(p_source.type.builtin_type);
@@ -833,6 +1092,9 @@ void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address
 			append(p_index);
 			append(p_target);
 			append(getter);
+#ifdef TOOLS_ENABLED
+			add_link_key(link_info.keyed_getters, get_keyed_getter_pos(getter), p_source.type.builtin_type);
+#endif
 			return;
 		}
 	}
@@ -852,6 +1114,9 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 		append(setter);
 #ifdef DEBUG_ENABLED
 		add_debug_name(setter_names, get_setter_pos(setter), p_name);
+#endif
+#ifdef TOOLS_ENABLED
+		add_link_key(link_info.setters, get_setter_pos(setter), p_target.type.builtin_type, p_name);
 #endif
 		return;
 	}
@@ -870,6 +1135,9 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 		append(getter);
 #ifdef DEBUG_ENABLED
 		add_debug_name(getter_names, get_getter_pos(getter), p_name);
+#endif
+#ifdef TOOLS_ENABLED
+		add_link_key(link_info.getters, get_getter_pos(getter), p_source.type.builtin_type, p_name);
 #endif
 		return;
 	}
@@ -877,6 +1145,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append(inline_cache_count++);
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -906,6 +1175,11 @@ void GDScriptByteCodeGenerator::write_get_static_variable(const Address &p_targe
 }
 
 void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_target, const Address &p_source) {
+	if (fold_assign(p_target, p_source)) {
+		mark_local_initialized(p_target);
+		return;
+	}
+
 	switch (p_target.type.kind) {
 		case GDScriptDataType::BUILTIN: {
 			if (p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
@@ -963,9 +1237,16 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 			append(p_source);
 		}
 	}
+
+	mark_local_initialized(p_target);
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (fold_assign(p_target, p_source)) {
+		mark_local_initialized(p_target);
+		return;
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type(0);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -997,6 +1278,8 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_target);
 		append(p_source);
 	}
+
+	mark_local_initialized(p_target);
 }
 
 void GDScriptByteCodeGenerator::write_assign_null(const Address &p_target) {
@@ -1021,11 +1304,15 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	mark_jump_target();
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+#ifdef TOOLS_ENABLED
+	link_info.global_positions.push_back(opcodes.size());
+#endif
 	append(p_global_index);
 }
 
@@ -1033,6 +1320,9 @@ void GDScriptByteCodeGenerator::write_store_named_global(const Address &p_dst, c
 	append_opcode(GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL);
 	append(p_dst);
 	append(p_global);
+#ifdef TOOLS_ENABLED
+	link_info.uses_named_globals = true;
+#endif
 }
 
 void GDScriptByteCodeGenerator::write_cast(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
@@ -1090,6 +1380,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1115,6 +1406,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1132,6 +1424,9 @@ void GDScriptByteCodeGenerator::write_call_gdscript_utility(const Address &p_tar
 #ifdef DEBUG_ENABLED
 	add_debug_name(gds_utilities_names, get_gds_utility_pos(gds_function), p_function);
 #endif
+#ifdef TOOLS_ENABLED
+	add_link_key(link_info.gds_utilities, get_gds_utility_pos(gds_function), Variant::NIL, p_function);
+#endif
 }
 
 void GDScriptByteCodeGenerator::write_call_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) {
@@ -1167,6 +1462,9 @@ void GDScriptByteCodeGenerator::write_call_utility(const Address &p_target, cons
 		ct.cleanup();
 #ifdef DEBUG_ENABLED
 		add_debug_name(utilities_names, get_utility_pos(Variant::get_validated_utility_function(p_function)), p_function);
+#endif
+#ifdef TOOLS_ENABLED
+		add_link_key(link_info.utilities, get_utility_pos(Variant::get_validated_utility_function(p_function)), Variant::NIL, p_function);
 #endif
 	} else {
 		append_opcode_and_argcount(GDScriptFunction::OPCODE_CALL_UTILITY, 1 + p_arguments.size());
@@ -1239,6 +1537,9 @@ void GDScriptByteCodeGenerator::write_call_builtin_type(const Address &p_target,
 #ifdef DEBUG_ENABLED
 	add_debug_name(builtin_methods_names, get_builtin_method_pos(Variant::get_validated_builtin_method(p_type, p_method)), p_method);
 #endif
+#ifdef TOOLS_ENABLED
+	add_link_key(link_info.builtin_methods, get_builtin_method_pos(Variant::get_validated_builtin_method(p_type, p_method)), p_type, p_method);
+#endif
 }
 
 void GDScriptByteCodeGenerator::write_call_builtin_type(const Address &p_target, const Address &p_base, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) {
@@ -1349,6 +1650,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1362,6 +1664,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1375,6 +1678,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1432,6 +1736,9 @@ void GDScriptByteCodeGenerator::write_construct(const Address &p_target, Variant
 			ct.cleanup();
 #ifdef DEBUG_ENABLED
 			add_debug_name(constructors_names, get_constructor_pos(Variant::get_validated_constructor(p_type, valid_constructor)), Variant::get_type_name(p_type));
+#endif
+#ifdef TOOLS_ENABLED
+			add_link_key(link_info.constructors, get_constructor_pos(Variant::get_validated_constructor(p_type, valid_constructor)), p_type, StringName(), valid_constructor);
 #endif
 			return;
 		}
@@ -1509,8 +1816,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_jump_if_not(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1780,12 +2086,12 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	mark_jump_target();
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_jump_if_not(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
@@ -1823,7 +2129,7 @@ void GDScriptByteCodeGenerator::write_breakpoint() {
 }
 
 void GDScriptByteCodeGenerator::write_newline(int p_line) {
-	if (GDScriptLanguage::get_singleton()->should_track_call_stack()) {
+	if (track_call_stack) {
 		// Add newline for debugger and stack tracking if enabled in the project settings.
 		append_opcode(GDScriptFunction::OPCODE_LINE);
 		append(p_line);
@@ -1990,6 +2296,7 @@ void GDScriptByteCodeGenerator::clear_address(const Address &p_address) {
 	if (p_address.mode == Address::LOCAL_VARIABLE) {
 		dirty_locals.erase(p_address.address);
 	}
+	mark_local_initialized(p_address);
 }
 
 // Returns `true` if the local has been reused and not cleaned up with `clear_address()`.
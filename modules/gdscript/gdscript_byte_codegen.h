@@ -99,6 +99,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
+
+	// What the function keeps for the debugger. Follows the running build, unless the compiler
+	// exports bytecode for another kind of build.
+	bool track_call_stack = GDScriptLanguage::get_singleton()->should_track_call_stack();
+	bool track_locals = GDScriptLanguage::get_singleton()->should_track_locals();
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -141,6 +147,21 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 #endif
 
+#ifdef TOOLS_ENABLED
+	// Keep what the pointer tables were resolved from, to relink cached bytecode.
+	GDScriptFunction::LinkInfo link_info;
+	void add_link_key(Vector<GDScriptFunction::LinkKey> &r_keys, int p_pos, Variant::Type p_type, const StringName &p_name = StringName(), int p_index = 0, Variant::Type p_right_type = Variant::NIL) {
+		if (p_pos >= r_keys.size()) {
+			r_keys.resize(p_pos + 1);
+		}
+		GDScriptFunction::LinkKey &key = r_keys.write[p_pos];
+		key.type = p_type;
+		key.right_type = p_right_type;
+		key.index = p_index;
+		key.name = p_name;
+	}
+#endif
+
 	// Lists since these can be nested.
 	List<int> if_jmp_addrs;
 	List<int> for_jmp_addrs;
@@ -162,12 +183,33 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Peephole optimizer, enabled with the `debug/settings/gdscript/optimize_bytecode` project setting.
+	// It fuses the last emitted operation with the instruction that consumes its temporary result.
+	struct FusableOperation {
+		int position = -1; // Start of the instruction, `-1` if there is nothing to fuse.
+		int end = -1;
+		int target_index = -1; // Where the address of the result is in the instruction.
+		Address left;
+		Address right;
+		Address target;
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type result_type = Variant::NIL;
+		Variant::Type comparison_type = Variant::NIL; // `INT` or `FLOAT` if it can be fused with a conditional jump.
+		bool sets_target_type = false; // Fused opcodes change the type of their target, validated operators expect it to match.
+	};
+
+	bool optimize_bytecode = false;
+	FusableOperation last_operation;
+	int last_jump_target = -1;
+	HashSet<int> initialized_locals; // Typed locals known to hold a value of their type.
+	Vector<Variant> constant_values;
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
 		}
 		stack_identifiers[p_id] = p_stackpos;
-		if (GDScriptLanguage::get_singleton()->should_track_locals()) {
+		if (track_locals) {
 			block_identifiers[p_id] = p_stackpos;
 			GDScriptFunction::StackDebug sd;
 			sd.added = true;
@@ -181,7 +223,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	void push_stack_identifiers() {
 		stack_identifiers_counts.push_back(locals.size());
 		stack_id_stack.push_back(stack_identifiers);
-		if (GDScriptLanguage::get_singleton()->should_track_locals()) {
+		if (track_locals) {
 			RBMap<StringName, int> block_ids(block_identifiers);
 			block_identifier_stack.push_back(block_ids);
 			block_identifiers.clear();
@@ -202,7 +244,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 			dirty_locals.insert(i + GDScriptFunction::FIXED_ADDRESSES_MAX);
 		}
 		locals.resize(current_locals);
-		if (GDScriptLanguage::get_singleton()->should_track_locals()) {
+		if (track_locals) {
 			for (const KeyValue<StringName, int> &E : block_identifiers) {
 				GDScriptFunction::StackDebug sd;
 				sd.added = false;
@@ -233,6 +275,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		}
 		int pos = constant_map.size();
 		constant_map[p_constant] = pos;
+		constant_values.push_back(p_constant);
 		return pos;
 	}
 
@@ -451,10 +494,27 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void mark_jump_target() {
+		last_jump_target = opcodes.size();
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		mark_jump_target();
 	}
 
+	void mark_local_initialized(const Address &p_address) {
+		if ((p_address.mode == Address::LOCAL_VARIABLE || p_address.mode == Address::FUNCTION_PARAMETER) && p_address.type.kind == GDScriptDataType::BUILTIN) {
+			initialized_locals.insert(p_address.address);
+		}
+	}
+
+	bool is_last_operation_result(const Address &p_address) const;
+	void retract_last_operation();
+	bool write_immediate_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand);
+	bool fold_assign(const Address &p_target, const Address &p_source);
+	void append_jump_if_not(const Address &p_condition);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -555,5 +615,10 @@ public:
 	virtual void write_return(const Address &p_return_value) override;
 	virtual void write_assert(const Address &p_test, const Address &p_message) override;
 
+	void set_tracking(bool p_call_stack, bool p_locals) {
+		track_call_stack = p_call_stack;
+		track_locals = p_locals;
+	}
+
 	virtual ~GDScriptByteCodeGenerator();
 };
@@ -0,0 +1,1185 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_analyzer.h"
+#include "gdscript_cache.h"
+#include "gdscript_compiler.h"
+#include "gdscript_function.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/version.h"
+
+static constexpr uint8_t BYTECODE_CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+
+// How a constant or script type is stored, since objects can't be encoded as variants.
+enum ConstantKind {
+	CONSTANT_VARIANT,
+	CONSTANT_SELF, // The cached script itself.
+	CONSTANT_GLOBAL, // Native class or singleton, by global name.
+	CONSTANT_SCRIPT, // Another GDScript, by path.
+	CONSTANT_RESOURCE, // Any other resource, by path.
+};
+
+class GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	bool failed = false;
+
+	bool _check(int p_bytes) {
+		if (failed || p_bytes < 0 || pos + p_bytes > size) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+public:
+	struct Header {
+		uint32_t source_hash = 0;
+		StringName global_name;
+		StringName local_name;
+		String fully_qualified_name;
+		String simplified_icon_path;
+
+		void apply_names(GDScript *p_script) const {
+			p_script->fully_qualified_name = fully_qualified_name;
+			p_script->local_name = local_name;
+			p_script->global_name = global_name;
+			p_script->simplified_icon_path = simplified_icon_path;
+		}
+	};
+
+	bool has_failed() const { return failed; }
+
+	uint8_t get_8() {
+		if (!_check(1)) {
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_32() {
+		if (!_check(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(&data[pos]);
+		pos += 4;
+		return value;
+	}
+
+	int get_s32() {
+		return int32_t(get_32());
+	}
+
+	String get_string() {
+		int length = get_s32();
+		if (!_check(length)) {
+			return String();
+		}
+		String string = String::utf8(reinterpret_cast<const char *>(&data[pos]), length);
+		pos += length;
+		return string;
+	}
+
+	Variant get_variant() {
+		Variant variant;
+		int length = 0;
+		if (failed || decode_variant(variant, &data[pos], size - pos, &length) != OK) {
+			failed = true;
+			return Variant();
+		}
+		pos += length;
+		return variant;
+	}
+
+	// Element counts are checked against the remaining bytes, so corrupt data can't request huge allocations.
+	int get_count() {
+		int count = get_s32();
+		if (failed || count < 0 || count > size - pos) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	Error get_header(Header &r_header) {
+		for (int i = 0; i < 4; i++) {
+			if (get_8() != BYTECODE_CACHE_MAGIC[i]) {
+				return ERR_FILE_UNRECOGNIZED;
+			}
+		}
+		if (get_32() != FORMAT_VERSION || get_32() != get_engine_hash() || bool(get_8()) != is_debug_build()) {
+			return ERR_FILE_UNRECOGNIZED;
+		}
+		r_header.source_hash = get_32();
+		r_header.global_name = get_string();
+		r_header.local_name = get_string();
+		r_header.fully_qualified_name = get_string();
+		r_header.simplified_icon_path = get_string();
+		return failed ? ERR_FILE_CORRUPT : OK;
+	}
+
+	Reader(const Vector<uint8_t> &p_buffer) :
+			data(p_buffer.ptr()), size(p_buffer.size()) {}
+};
+
+#ifdef TOOLS_ENABLED
+
+class GDScriptBytecodeCache::Writer {
+	LocalVector<uint8_t> buffer;
+
+public:
+	void put_8(uint8_t p_value) {
+		buffer.push_back(p_value);
+	}
+
+	void put_32(uint32_t p_value) {
+		uint32_t pos = buffer.size();
+		buffer.resize(pos + 4);
+		encode_uint32(p_value, &buffer[pos]);
+	}
+
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_32(utf8.length());
+		uint32_t pos = buffer.size();
+		buffer.resize(pos + utf8.length());
+		memcpy(&buffer[pos], utf8.get_data(), utf8.length());
+	}
+
+	Error put_variant(const Variant &p_variant) {
+		return encode_variant(p_variant, buffer);
+	}
+
+	Vector<uint8_t> get_data() const {
+		Vector<uint8_t> data;
+		data.resize(buffer.size());
+		memcpy(data.ptrw(), buffer.ptr(), buffer.size());
+		return data;
+	}
+};
+
+class GDScriptBytecodeCache::Serializer {
+	const GDScript *script = nullptr;
+	Writer &writer;
+	bool debug = false;
+	HashMap<ObjectID, StringName> global_objects;
+	bool global_objects_built = false;
+
+	const StringName *_find_global(const Object *p_object) {
+		if (!global_objects_built) {
+			GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+			for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+				const Variant &global = language->get_global_array()[E.value];
+				Object *object = global.get_type() == Variant::OBJECT ? global.get_validated_object() : nullptr;
+				if (object) {
+					global_objects[object->get_instance_id()] = E.key;
+				}
+			}
+			global_objects_built = true;
+		}
+		HashMap<ObjectID, StringName>::ConstIterator E = global_objects.find(p_object->get_instance_id());
+		return E ? &E->value : nullptr;
+	}
+
+	static StringName _find_global_name(int p_index) {
+		for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+			if (E.value == p_index) {
+				return E.key;
+			}
+		}
+		return StringName();
+	}
+
+	// Variants without objects, which are encoded as-is.
+	static bool _is_plain(const Variant &p_value) {
+		switch (p_value.get_type()) {
+			case Variant::OBJECT:
+			case Variant::CALLABLE:
+			case Variant::SIGNAL:
+				return false;
+			case Variant::ARRAY: {
+				const Array array = p_value;
+				if (array.get_typed_script() != Variant()) {
+					return false;
+				}
+				for (int i = 0; i < array.size(); i++) {
+					if (!_is_plain(array[i])) {
+						return false;
+					}
+				}
+			} break;
+			case Variant::DICTIONARY: {
+				const Dictionary dictionary = p_value;
+				if (dictionary.get_typed_key_script() != Variant() || dictionary.get_typed_value_script() != Variant()) {
+					return false;
+				}
+				for (const KeyValue<Variant, Variant> &kv : dictionary) {
+					if (!_is_plain(kv.key) || !_is_plain(kv.value)) {
+						return false;
+					}
+				}
+			} break;
+			default:
+				break;
+		}
+		return true;
+	}
+
+	bool _put_plain(const Variant &p_value) {
+		return _is_plain(p_value) && writer.put_variant(p_value) == OK;
+	}
+
+	bool _put_script_ref(const Script *p_script) {
+		if (p_script == script) {
+			writer.put_8(CONSTANT_SELF);
+			return true;
+		}
+		const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+		if (gdscript) {
+			// Inner classes of other scripts would need their owner compiled first.
+			if (!gdscript->is_root_script() || gdscript->path.is_empty() || gdscript->path.contains("::")) {
+				return false;
+			}
+			writer.put_8(CONSTANT_SCRIPT);
+			writer.put_string(gdscript->path);
+			return true;
+		}
+		if (p_script->get_path().is_empty() || p_script->is_built_in()) {
+			return false;
+		}
+		writer.put_8(CONSTANT_RESOURCE);
+		writer.put_string(p_script->get_path());
+		return true;
+	}
+
+	bool _put_constant(const Variant &p_value) {
+		if (p_value.get_type() != Variant::OBJECT) {
+			writer.put_8(CONSTANT_VARIANT);
+			return _put_plain(p_value);
+		}
+
+		const Object *object = p_value.get_validated_object();
+		if (!object) {
+			return false;
+		}
+		if (object == script) {
+			writer.put_8(CONSTANT_SELF);
+			return true;
+		}
+		const StringName *global = _find_global(object);
+		if (global) {
+			writer.put_8(CONSTANT_GLOBAL);
+			writer.put_string(*global);
+			return true;
+		}
+		const Script *other_script = Object::cast_to<Script>(object);
+		if (other_script) {
+			return _put_script_ref(other_script);
+		}
+		const Resource *resource = Object::cast_to<Resource>(object);
+		if (resource && !resource->get_path().is_empty() && !resource->is_built_in()) {
+			writer.put_8(CONSTANT_RESOURCE);
+			writer.put_string(resource->get_path());
+			return true;
+		}
+		return false;
+	}
+
+	bool _put_type(const GDScriptDataType &p_type) {
+		writer.put_8(p_type.kind);
+		writer.put_32(p_type.builtin_type);
+		writer.put_string(p_type.native_type);
+		writer.put_8(p_type.script_type != nullptr);
+		if (p_type.script_type) {
+			writer.put_8(p_type.script_type_ref.is_valid());
+			if (!_put_script_ref(p_type.script_type)) {
+				return false;
+			}
+		}
+		writer.put_32(p_type.container_element_types.size());
+		for (const GDScriptDataType &element_type : p_type.container_element_types) {
+			if (!_put_type(element_type)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool _put_member(const StringName &p_name, const GDScript::MemberInfo &p_member) {
+		writer.put_string(p_name);
+		writer.put_32(p_member.index);
+		writer.put_string(p_member.setter);
+		writer.put_string(p_member.getter);
+		return _put_type(p_member.data_type) && _put_plain(Dictionary(p_member.property_info));
+	}
+
+	void _put_link_keys(const Vector<GDScriptFunction::LinkKey> &p_keys, bool p_type, bool p_name, bool p_index) {
+		writer.put_32(p_keys.size());
+		for (const GDScriptFunction::LinkKey &key : p_keys) {
+			if (p_type) {
+				writer.put_32(key.type);
+			}
+			if (p_name) {
+				writer.put_string(key.name);
+			}
+			if (p_index) {
+				writer.put_32(key.index);
+			}
+		}
+	}
+
+	bool _put_function(const GDScriptFunction *p_function) {
+		const GDScriptFunction::LinkInfo &link = p_function->link_info;
+		if (!p_function->lambdas.is_empty() || link.uses_named_globals) {
+			return false;
+		}
+		// Functions compiled before the link information existed can't be relinked.
+		if (link.operators.size() != p_function->operator_funcs.size() ||
+				link.setters.size() != p_function->setters.size() ||
+				link.getters.size() != p_function->getters.size() ||
+				link.keyed_setters.size() != p_function->keyed_setters.size() ||
+				link.keyed_getters.size() != p_function->keyed_getters.size() ||
+				link.indexed_setters.size() != p_function->indexed_setters.size() ||
+				link.indexed_getters.size() != p_function->indexed_getters.size() ||
+				link.builtin_methods.size() != p_function->builtin_methods.size() ||
+				link.constructors.size() != p_function->constructors.size() ||
+				link.utilities.size() != p_function->utilities.size() ||
+				link.gds_utilities.size() != p_function->gds_utilities.size()) {
+			return false;
+		}
+
+		writer.put_string(p_function->name);
+		writer.put_8(p_function->_static);
+		if (!_put_plain(p_function->rpc_config) || !_put_plain(Dictionary(p_function->method_info))) {
+			return false;
+		}
+		writer.put_32(p_function->_initial_line);
+		writer.put_32(p_function->_argument_count);
+		writer.put_32(p_function->_vararg_index);
+		writer.put_32(p_function->_stack_size);
+		writer.put_32(p_function->_instruction_args_size);
+		writer.put_32(p_function->_inline_caches_count);
+
+		writer.put_32(p_function->argument_types.size());
+		for (const GDScriptDataType &type : p_function->argument_types) {
+			if (!_put_type(type)) {
+				return false;
+			}
+		}
+		if (!_put_type(p_function->return_type)) {
+			return false;
+		}
+
+		writer.put_32(p_function->temporary_slots.size());
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			writer.put_32(E.key);
+			writer.put_32(E.value);
+		}
+
+		// Names of the arguments and locals by stack position, for the debugger.
+		writer.put_32(p_function->stack_debug.size());
+		for (const GDScriptFunction::StackDebug &sd : p_function->stack_debug) {
+			writer.put_32(sd.line);
+			writer.put_32(sd.pos);
+			writer.put_8(sd.added);
+			writer.put_string(sd.identifier);
+		}
+
+		// Clear what the VM cached while running the function in the editor.
+		Vector<int> code = p_function->code;
+		constexpr int operator_cache_size = 2 + sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+		for (int pos : link.operator_cache_positions) {
+			ERR_FAIL_COND_V(pos + operator_cache_size > code.size(), false);
+			for (int i = 0; i < operator_cache_size; i++) {
+				code.write[pos + i] = 0;
+			}
+		}
+		writer.put_32(code.size());
+		for (int value : code) {
+			writer.put_32(value);
+		}
+
+		// Global indices depend on what is registered in the engine, so they are relinked by name.
+		writer.put_32(link.global_positions.size());
+		for (int pos : link.global_positions) {
+			ERR_FAIL_INDEX_V(pos, code.size(), false);
+			const StringName global = _find_global_name(code[pos]);
+			if (global == StringName()) {
+				return false;
+			}
+			writer.put_32(pos);
+			writer.put_string(global);
+		}
+
+		writer.put_32(p_function->default_arguments.size());
+		for (int address : p_function->default_arguments) {
+			writer.put_32(address);
+		}
+
+		writer.put_32(p_function->constants.size());
+		for (const Variant &constant : p_function->constants) {
+			if (!_put_constant(constant)) {
+				return false;
+			}
+		}
+
+		writer.put_32(p_function->global_names.size());
+		for (const StringName &name : p_function->global_names) {
+			writer.put_string(name);
+		}
+
+		writer.put_32(link.operators.size());
+		for (const GDScriptFunction::LinkKey &key : link.operators) {
+			writer.put_32(key.index);
+			writer.put_32(key.type);
+			writer.put_32(key.right_type);
+		}
+		_put_link_keys(link.setters, true, true, false);
+		_put_link_keys(link.getters, true, true, false);
+		_put_link_keys(link.keyed_setters, true, false, false);
+		_put_link_keys(link.keyed_getters, true, false, false);
+		_put_link_keys(link.indexed_setters, true, false, false);
+		_put_link_keys(link.indexed_getters, true, false, false);
+		writer.put_32(link.builtin_methods.size());
+		for (const GDScriptFunction::LinkKey &key : link.builtin_methods) {
+			writer.put_32(key.type);
+			writer.put_string(key.name);
+			writer.put_32(Variant::get_builtin_method_hash(key.type, key.name));
+		}
+		_put_link_keys(link.constructors, true, false, true);
+		writer.put_32(link.utilities.size());
+		for (const GDScriptFunction::LinkKey &key : link.utilities) {
+			writer.put_string(key.name);
+			writer.put_32(Variant::get_utility_function_hash(key.name));
+		}
+		_put_link_keys(link.gds_utilities, false, true, false);
+
+		writer.put_32(p_function->methods.size());
+		for (const MethodBind *method : p_function->methods) {
+			writer.put_string(method->get_instance_class());
+			writer.put_string(method->get_name());
+			writer.put_32(method->get_hash());
+		}
+		return true;
+	}
+
+	bool _put_optional_function(const GDScriptFunction *p_function) {
+		writer.put_8(p_function != nullptr);
+		return !p_function || _put_function(p_function);
+	}
+
+public:
+	Error serialize(uint32_t p_source_hash) {
+		// Inner classes and lambdas are compiled as separate objects, which the format doesn't describe.
+		if (!script->is_root_script() || !script->subclasses.is_empty() || !script->lambda_info.is_empty() || script->native.is_null()) {
+			return ERR_UNAVAILABLE;
+		}
+		if (script->base.is_valid() && (!script->base->is_root_script() || script->base->path.is_empty())) {
+			return ERR_UNAVAILABLE;
+		}
+
+		for (int i = 0; i < 4; i++) {
+			writer.put_8(BYTECODE_CACHE_MAGIC[i]);
+		}
+		writer.put_32(GDScriptBytecodeCache::FORMAT_VERSION);
+		writer.put_32(GDScriptBytecodeCache::get_engine_hash());
+		writer.put_8(debug);
+		writer.put_32(p_source_hash);
+		writer.put_string(script->global_name);
+		writer.put_string(script->local_name);
+		writer.put_string(script->fully_qualified_name);
+		writer.put_string(script->simplified_icon_path);
+
+		writer.put_8(script->tool);
+		writer.put_8(script->_is_abstract);
+		writer.put_8(GDScriptCache::singleton->static_gdscript_cache.has(script->fully_qualified_name));
+		writer.put_string(script->native->get_name());
+		writer.put_string(script->base.is_valid() ? script->base->path : String());
+
+		writer.put_32(script->member_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : script->member_indices) {
+			if (!_put_member(E.key, E.value)) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+		writer.put_32(script->members.size());
+		for (const StringName &name : script->members) {
+			writer.put_string(name);
+		}
+		writer.put_32(script->static_variables_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : script->static_variables_indices) {
+			if (!_put_member(E.key, E.value)) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+
+		writer.put_32(script->constants.size());
+		for (const KeyValue<StringName, Variant> &E : script->constants) {
+			writer.put_string(E.key);
+			if (!_put_constant(E.value)) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+		writer.put_32(script->_signals.size());
+		for (const KeyValue<StringName, MethodInfo> &E : script->_signals) {
+			writer.put_string(E.key);
+			if (!_put_plain(Dictionary(E.value))) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+		if (!_put_plain(script->rpc_config)) {
+			return ERR_UNAVAILABLE;
+		}
+
+		writer.put_32(script->member_functions.size());
+		for (const KeyValue<StringName, GDScriptFunction *> &E : script->member_functions) {
+			if (!_put_function(E.value)) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+		if (!_put_optional_function(script->implicit_initializer) || !_put_optional_function(script->implicit_ready) || !_put_optional_function(script->static_initializer)) {
+			return ERR_UNAVAILABLE;
+		}
+		return OK;
+	}
+
+	Serializer(const GDScript *p_script, Writer &r_writer, bool p_debug) :
+			script(p_script), writer(r_writer), debug(p_debug) {}
+};
+
+#endif // TOOLS_ENABLED
+
+// The VM names failing calls with the debug name tables of a function. They are indexed
+// like the pointer tables, so the loader rebuilds them from the link keys.
+#ifdef DEBUG_ENABLED
+#define ADD_DEBUG_NAME(m_names, m_name) p_function->m_names.push_back(m_name)
+#else
+#define ADD_DEBUG_NAME(m_names, m_name)
+#endif
+
+class GDScriptBytecodeCache::Loader {
+	GDScript *script = nullptr;
+	Reader &reader;
+
+	bool _read_script_ref(uint8_t p_kind, Ref<Script> &r_script) {
+		switch (p_kind) {
+			case CONSTANT_SELF: {
+				r_script = Ref<Script>(script);
+			} break;
+			case CONSTANT_SCRIPT: {
+				// Like the compiler, only take a shallow reference, which `GDScriptCache::finish_compiling()` completes.
+				Error err = OK;
+				r_script = GDScriptCache::get_shallow_script(reader.get_string(), err, script->path);
+			} break;
+			case CONSTANT_RESOURCE: {
+				r_script = ResourceLoader::load(reader.get_string());
+			} break;
+			default:
+				return false;
+		}
+		return r_script.is_valid();
+	}
+
+	bool _read_constant(Variant &r_value) {
+		uint8_t kind = reader.get_8();
+		switch (kind) {
+			case CONSTANT_VARIANT: {
+				r_value = reader.get_variant();
+			} break;
+			case CONSTANT_GLOBAL: {
+				GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+				HashMap<StringName, int>::ConstIterator E = language->get_global_map().find(reader.get_string());
+				if (!E) {
+					return false;
+				}
+				r_value = language->get_global_array()[E->value];
+			} break;
+			case CONSTANT_RESOURCE: {
+				Ref<Resource> resource = ResourceLoader::load(reader.get_string());
+				if (resource.is_null()) {
+					return false;
+				}
+				r_value = resource;
+			} break;
+			default: {
+				Ref<Script> other_script;
+				if (!_read_script_ref(kind, other_script)) {
+					return false;
+				}
+				r_value = other_script;
+			} break;
+		}
+		return !reader.has_failed();
+	}
+
+	bool _read_type(GDScriptDataType &r_type) {
+		r_type.kind = GDScriptDataType::Kind(reader.get_8());
+		r_type.builtin_type = Variant::Type(reader.get_32());
+		r_type.native_type = reader.get_string();
+		if (reader.get_8()) {
+			bool hold_reference = reader.get_8();
+			Ref<Script> type_script;
+			if (!_read_script_ref(reader.get_8(), type_script)) {
+				return false;
+			}
+			r_type.script_type = type_script.ptr();
+			if (hold_reference) {
+				r_type.script_type_ref = type_script;
+			}
+		}
+		int element_count = reader.get_count();
+		for (int i = 0; i < element_count; i++) {
+			GDScriptDataType element_type;
+			if (!_read_type(element_type)) {
+				return false;
+			}
+			r_type.set_container_element_type(i, element_type);
+		}
+		return r_type.kind <= GDScriptDataType::GDSCRIPT && r_type.builtin_type < Variant::VARIANT_MAX && !reader.has_failed();
+	}
+
+	bool _read_member(HashMap<StringName, GDScript::MemberInfo> &r_members) {
+		StringName name = reader.get_string();
+		GDScript::MemberInfo &member = r_members[name];
+		member.index = reader.get_s32();
+		member.setter = reader.get_string();
+		member.getter = reader.get_string();
+		if (!_read_type(member.data_type)) {
+			return false;
+		}
+		member.property_info = PropertyInfo::from_dict(reader.get_variant());
+		return !reader.has_failed();
+	}
+
+	template <typename T, typename F>
+	bool _link_table(Vector<T> &r_table, F p_resolve) {
+		int count = reader.get_count();
+		r_table.resize(count);
+		for (int i = 0; i < count; i++) {
+			T entry = p_resolve();
+			if (!entry || reader.has_failed()) {
+				return false;
+			}
+			r_table.write[i] = entry;
+		}
+		return true;
+	}
+
+	Variant::Type _get_type() {
+		uint32_t type = reader.get_32();
+		return type < Variant::VARIANT_MAX ? Variant::Type(type) : Variant::NIL;
+	}
+
+	bool _read_tables(GDScriptFunction *p_function) {
+		GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+		int global_count = reader.get_count();
+		for (int i = 0; i < global_count; i++) {
+			int pos = reader.get_s32();
+			HashMap<StringName, int>::ConstIterator E = language->get_global_map().find(reader.get_string());
+			if (!E || pos < 0 || pos >= p_function->code.size()) {
+				return false;
+			}
+			p_function->code.write[pos] = E->value;
+		}
+
+		int default_count = reader.get_count();
+		p_function->default_arguments.resize(default_count);
+		for (int i = 0; i < default_count; i++) {
+			p_function->default_arguments.write[i] = reader.get_s32();
+		}
+
+		int constant_count = reader.get_count();
+		p_function->constants.resize(constant_count);
+		for (int i = 0; i < constant_count; i++) {
+			if (!_read_constant(p_function->constants.write[i])) {
+				return false;
+			}
+		}
+
+		int name_count = reader.get_count();
+		p_function->global_names.resize(name_count);
+		for (int i = 0; i < name_count; i++) {
+			p_function->global_names.write[i] = reader.get_string();
+		}
+
+		return _link_table(p_function->operator_funcs, [&]() {
+			Variant::Operator op = Variant::Operator(reader.get_32());
+			Variant::Type left = _get_type();
+			Variant::Type right = _get_type();
+			if (op >= Variant::OP_MAX) {
+				return Variant::ValidatedOperatorEvaluator(nullptr);
+			}
+			ADD_DEBUG_NAME(operator_names, Variant::get_operator_name(op));
+			return Variant::get_validated_operator_evaluator(op, left, right);
+		}) && _link_table(p_function->setters, [&]() {
+			Variant::Type type = _get_type();
+			StringName name = reader.get_string();
+			ADD_DEBUG_NAME(setter_names, name);
+			return Variant::get_member_validated_setter(type, name);
+		}) && _link_table(p_function->getters, [&]() {
+			Variant::Type type = _get_type();
+			StringName name = reader.get_string();
+			ADD_DEBUG_NAME(getter_names, name);
+			return Variant::get_member_validated_getter(type, name);
+		}) && _link_table(p_function->keyed_setters, [&]() {
+			return Variant::get_member_validated_keyed_setter(_get_type());
+		}) && _link_table(p_function->keyed_getters, [&]() {
+			return Variant::get_member_validated_keyed_getter(_get_type());
+		}) && _link_table(p_function->indexed_setters, [&]() {
+			return Variant::get_member_validated_indexed_setter(_get_type());
+		}) && _link_table(p_function->indexed_getters, [&]() {
+			return Variant::get_member_validated_indexed_getter(_get_type());
+		}) && _link_table(p_function->builtin_methods, [&]() {
+			Variant::Type type = _get_type();
+			StringName method = reader.get_string();
+			uint32_t hash = reader.get_32();
+			if (!Variant::has_builtin_method(type, method) || Variant::get_builtin_method_hash(type, method) != hash) {
+				return Variant::ValidatedBuiltInMethod(nullptr);
+			}
+			ADD_DEBUG_NAME(builtin_methods_names, method);
+			return Variant::get_validated_builtin_method(type, method);
+		}) && _link_table(p_function->constructors, [&]() {
+			Variant::Type type = _get_type();
+			int index = reader.get_s32();
+			if (index < 0 || index >= Variant::get_constructor_count(type)) {
+				return Variant::ValidatedConstructor(nullptr);
+			}
+			ADD_DEBUG_NAME(constructors_names, Variant::get_type_name(type));
+			return Variant::get_validated_constructor(type, index);
+		}) && _link_table(p_function->utilities, [&]() {
+			StringName function = reader.get_string();
+			uint32_t hash = reader.get_32();
+			if (!Variant::has_utility_function(function) || Variant::get_utility_function_hash(function) != hash) {
+				return Variant::ValidatedUtilityFunction(nullptr);
+			}
+			ADD_DEBUG_NAME(utilities_names, function);
+			return Variant::get_validated_utility_function(function);
+		}) && _link_table(p_function->gds_utilities, [&]() {
+			StringName function = reader.get_string();
+			ADD_DEBUG_NAME(gds_utilities_names, function);
+			return GDScriptUtilityFunctions::get_function(function);
+		}) && _link_table(p_function->methods, [&]() {
+			StringName class_name = reader.get_string();
+			StringName method = reader.get_string();
+			uint32_t hash = reader.get_32();
+			return ClassDB::get_method_with_compatibility(class_name, method, hash);
+		});
+	}
+
+#undef ADD_DEBUG_NAME
+
+	// Mirrors `GDScriptByteCodeGenerator::write_end()`.
+	static void _update_pointers(GDScriptFunction *p_function) {
+		p_function->_code_ptr = p_function->code.is_empty() ? nullptr : p_function->code.ptrw();
+		p_function->_code_size = p_function->code.size();
+		p_function->_default_arg_ptr = p_function->default_arguments.is_empty() ? nullptr : p_function->default_arguments.ptr();
+		p_function->_default_arg_count = MAX(0, p_function->default_arguments.size() - 1);
+		p_function->_constants_ptr = p_function->constants.is_empty() ? nullptr : p_function->constants.ptrw();
+		p_function->_constant_count = p_function->constants.size();
+		p_function->_global_names_ptr = p_function->global_names.is_empty() ? nullptr : p_function->global_names.ptr();
+		p_function->_global_names_count = p_function->global_names.size();
+		p_function->_operator_funcs_ptr = p_function->operator_funcs.is_empty() ? nullptr : p_function->operator_funcs.ptr();
+		p_function->_operator_funcs_count = p_function->operator_funcs.size();
+		p_function->_setters_ptr = p_function->setters.is_empty() ? nullptr : p_function->setters.ptr();
+		p_function->_setters_count = p_function->setters.size();
+		p_function->_getters_ptr = p_function->getters.is_empty() ? nullptr : p_function->getters.ptr();
+		p_function->_getters_count = p_function->getters.size();
+		p_function->_keyed_setters_ptr = p_function->keyed_setters.is_empty() ? nullptr : p_function->keyed_setters.ptr();
+		p_function->_keyed_setters_count = p_function->keyed_setters.size();
+		p_function->_keyed_getters_ptr = p_function->keyed_getters.is_empty() ? nullptr : p_function->keyed_getters.ptr();
+		p_function->_keyed_getters_count = p_function->keyed_getters.size();
+		p_function->_indexed_setters_ptr = p_function->indexed_setters.is_empty() ? nullptr : p_function->indexed_setters.ptr();
+		p_function->_indexed_setters_count = p_function->indexed_setters.size();
+		p_function->_indexed_getters_ptr = p_function->indexed_getters.is_empty() ? nullptr : p_function->indexed_getters.ptr();
+		p_function->_indexed_getters_count = p_function->indexed_getters.size();
+		p_function->_builtin_methods_ptr = p_function->builtin_methods.is_empty() ? nullptr : p_function->builtin_methods.ptr();
+		p_function->_builtin_methods_count = p_function->builtin_methods.size();
+		p_function->_constructors_ptr = p_function->constructors.is_empty() ? nullptr : p_function->constructors.ptr();
+		p_function->_constructors_count = p_function->constructors.size();
+		p_function->_utilities_ptr = p_function->utilities.is_empty() ? nullptr : p_function->utilities.ptr();
+		p_function->_utilities_count = p_function->utilities.size();
+		p_function->_gds_utilities_ptr = p_function->gds_utilities.is_empty() ? nullptr : p_function->gds_utilities.ptr();
+		p_function->_gds_utilities_count = p_function->gds_utilities.size();
+		p_function->_methods_ptr = p_function->methods.is_empty() ? nullptr : p_function->methods.ptrw();
+		p_function->_methods_count = p_function->methods.size();
+		p_function->_lambdas_ptr = nullptr;
+		p_function->_lambdas_count = 0;
+	}
+
+	GDScriptFunction *_read_function() {
+		GDScriptFunction *function = memnew(GDScriptFunction);
+		function->_script = script;
+		function->source = script->get_script_path();
+		function->name = reader.get_string();
+#ifdef DEBUG_ENABLED
+		function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+		function->_func_cname = function->func_cname.get_data();
+#endif
+		function->_static = reader.get_8();
+		function->rpc_config = reader.get_variant();
+		function->method_info = MethodInfo::from_dict(reader.get_variant());
+		function->_initial_line = reader.get_s32();
+		function->_argument_count = reader.get_s32();
+		function->_vararg_index = reader.get_s32();
+		function->_stack_size = reader.get_s32();
+		function->_instruction_args_size = reader.get_s32();
+		int inline_cache_count = reader.get_s32();
+
+		bool valid = true;
+		int argument_count = reader.get_count();
+		function->argument_types.resize(argument_count);
+		for (int i = 0; valid && i < argument_count; i++) {
+			valid = _read_type(function->argument_types.write[i]);
+		}
+		valid = valid && _read_type(function->return_type);
+
+		int slot_count = valid ? reader.get_count() : 0;
+		for (int i = 0; i < slot_count; i++) {
+			int slot = reader.get_s32();
+			function->temporary_slots[slot] = _get_type();
+		}
+
+		// Like the compiler, only kept when locals are tracked.
+		const bool track_locals = GDScriptLanguage::get_singleton()->should_track_locals();
+		int stack_debug_count = valid ? reader.get_count() : 0;
+		for (int i = 0; i < stack_debug_count; i++) {
+			GDScriptFunction::StackDebug sd;
+			sd.line = reader.get_s32();
+			sd.pos = reader.get_s32();
+			sd.added = reader.get_8();
+			sd.identifier = reader.get_string();
+			if (track_locals) {
+				function->stack_debug.push_back(sd);
+			}
+		}
+
+		int code_size = valid ? reader.get_count() : 0;
+		function->code.resize(code_size);
+		for (int i = 0; i < code_size; i++) {
+			function->code.write[i] = reader.get_s32();
+		}
+
+		valid = valid && _read_tables(function) && !reader.has_failed() && inline_cache_count >= 0;
+		if (!valid) {
+			memdelete(function);
+			return nullptr;
+		}
+		_update_pointers(function);
+		function->_allocate_inline_caches(inline_cache_count);
+		return function;
+	}
+
+	bool _read_optional_function(GDScriptFunction *&r_function) {
+		if (!reader.get_8()) {
+			r_function = nullptr;
+			return !reader.has_failed();
+		}
+		r_function = _read_function();
+		return r_function != nullptr;
+	}
+
+public:
+	Error load(bool &r_static_cached) {
+		GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+		bool tool = reader.get_8();
+		bool is_abstract = reader.get_8();
+		r_static_cached = reader.get_8();
+
+		HashMap<StringName, int>::ConstIterator native_idx = language->get_global_map().find(reader.get_string());
+		if (!native_idx) {
+			return ERR_UNAVAILABLE;
+		}
+		Ref<GDScriptNativeClass> native = language->get_global_array()[native_idx->value];
+		if (native.is_null()) {
+			return ERR_UNAVAILABLE;
+		}
+
+		Ref<GDScript> base;
+		String base_path = reader.get_string();
+		if (!base_path.is_empty()) {
+			Error err = OK;
+			base = GDScriptCache::get_shallow_script(base_path, err, script->path);
+			if (base.is_null()) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+
+		HashMap<StringName, GDScript::MemberInfo> member_indices;
+		int member_count = reader.get_count();
+		for (int i = 0; i < member_count; i++) {
+			if (!_read_member(member_indices)) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+		HashSet<StringName> members;
+		int own_member_count = reader.get_count();
+		for (int i = 0; i < own_member_count; i++) {
+			members.insert(reader.get_string());
+		}
+		HashMap<StringName, GDScript::MemberInfo> static_variables_indices;
+		int static_count = reader.get_count();
+		for (int i = 0; i < static_count; i++) {
+			if (!_read_member(static_variables_indices)) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+
+		HashMap<StringName, Variant> constants;
+		int constant_count = reader.get_count();
+		for (int i = 0; i < constant_count; i++) {
+			StringName name = reader.get_string();
+			if (!_read_constant(constants[name])) {
+				return ERR_UNAVAILABLE;
+			}
+		}
+		HashMap<StringName, MethodInfo> signals;
+		int signal_count = reader.get_count();
+		for (int i = 0; i < signal_count; i++) {
+			StringName name = reader.get_string();
+			signals[name] = MethodInfo::from_dict(reader.get_variant());
+		}
+		Dictionary rpc_config = reader.get_variant();
+		if (reader.has_failed()) {
+			return ERR_FILE_CORRUPT;
+		}
+
+		HashMap<StringName, GDScriptFunction *> functions;
+		GDScriptFunction *implicit_functions[3] = {};
+		bool valid = true;
+		int function_count = reader.get_count();
+		for (int i = 0; valid && i < function_count; i++) {
+			GDScriptFunction *function = _read_function();
+			if (function) {
+				functions[function->name] = function;
+			}
+			valid = function != nullptr;
+		}
+		for (int i = 0; valid && i < 3; i++) {
+			valid = _read_optional_function(implicit_functions[i]);
+		}
+		if (!valid) {
+			for (const KeyValue<StringName, GDScriptFunction *> &E : functions) {
+				memdelete(E.value);
+			}
+			for (GDScriptFunction *function : implicit_functions) {
+				if (function) {
+					memdelete(function);
+				}
+			}
+			return ERR_UNAVAILABLE;
+		}
+
+		script->tool = tool;
+		script->_is_abstract = is_abstract;
+		script->native = native;
+		script->base = base;
+		script->member_indices = member_indices;
+		script->members = members;
+		script->static_variables_indices = static_variables_indices;
+		script->static_variables.resize(static_variables_indices.size());
+		script->constants = constants;
+		script->_signals = signals;
+		script->rpc_config = rpc_config;
+		script->member_functions = functions;
+		HashMap<StringName, GDScriptFunction *>::Iterator initializer = functions.find(language->strings._init);
+		script->initializer = initializer ? initializer->value : nullptr;
+		script->implicit_initializer = implicit_functions[0];
+		script->implicit_ready = implicit_functions[1];
+		script->static_initializer = implicit_functions[2];
+		return OK;
+	}
+
+	Loader(GDScript *p_script, Reader &r_reader) :
+			script(p_script), reader(r_reader) {}
+};
+
+#undef ADD_DEBUG_NAME
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_binary_tokens_path) {
+	return p_binary_tokens_path.get_basename() + ".gdbc";
+}
+
+uint32_t GDScriptBytecodeCache::get_engine_hash() {
+	// Bytecode is only valid for the engine build it was compiled with,
+	// since opcodes and the validated calls it chose may change between versions.
+	uint32_t hash = String(GODOT_VERSION_FULL_BUILD).hash();
+	hash = hash_murmur3_one_32(String(GODOT_VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(sizeof(real_t), hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	return hash_fmix32(hash);
+}
+
+uint32_t GDScriptBytecodeCache::get_source_hash(const Vector<uint8_t> &p_binary_tokens) {
+	// Same hash as `GDScriptParserRef` uses for binary tokens.
+	return hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size());
+}
+
+#ifdef TOOLS_ENABLED
+Error GDScriptBytecodeCache::serialize(const GDScript *p_script, uint32_t p_source_hash, Vector<uint8_t> &r_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(!p_script->valid, ERR_INVALID_PARAMETER, "Only compiled scripts can be cached.");
+
+	Writer writer;
+	Serializer serializer(p_script, writer, is_debug_build());
+	Error err = serializer.serialize(p_source_hash);
+	if (err == OK) {
+		r_buffer = writer.get_data();
+	}
+	return err;
+}
+
+Error GDScriptBytecodeCache::serialize_for_export(const String &p_path, const String &p_source, bool p_debug, uint32_t p_source_hash, Vector<uint8_t> &r_buffer) {
+	// Loaded first, so the scripts it depends on are compiled and cached like at runtime.
+	Ref<GDScript> loaded = ResourceLoader::load(p_path, "GDScript");
+	if (loaded.is_null() || !loaded->is_valid()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	GDScriptParser parser;
+	Error err = parser.parse(p_source, p_path, false);
+	if (err == OK) {
+		GDScriptAnalyzer analyzer(&parser);
+		err = analyzer.analyze();
+	}
+	if (err != OK) {
+		return ERR_UNAVAILABLE;
+	}
+
+	// Compiled separately from the loaded script, which the editor keeps using.
+	Ref<GDScript> script;
+	script.instantiate();
+	script->path = p_path;
+	GDScriptCompiler compiler;
+	// Release builds only track call stacks and locals when the project settings ask for it.
+	const bool track_call_stack = p_debug || bool(GLOBAL_GET("debug/settings/gdscript/always_track_call_stacks"));
+	const bool track_locals = p_debug || bool(GLOBAL_GET("debug/settings/gdscript/always_track_local_variables"));
+	compiler.set_bytecode_options(p_debug, track_call_stack, track_locals);
+	err = compiler.compile(&parser, script.ptr(), false);
+
+	// The compiler registers scripts with static variables by class name, which has to remain the loaded one.
+	HashMap<String, Ref<GDScript>>::Iterator E = GDScriptCache::singleton->static_gdscript_cache.find(script->fully_qualified_name);
+	if (E && E->value == script) {
+		E->value = loaded;
+	}
+	if (err != OK) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Writer writer;
+	Serializer serializer(script.ptr(), writer, p_debug);
+	err = serializer.serialize(p_source_hash);
+	if (err == OK) {
+		r_buffer = writer.get_data();
+	}
+	return err;
+}
+#endif
+
+bool GDScriptBytecodeCache::is_debug_build() {
+#ifdef DEBUG_ENABLED
+	return true;
+#else
+	return false;
+#endif
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::read_cache(GDScript *p_script, const String &p_binary_tokens_path) {
+	ERR_FAIL_NULL_V(p_script, Vector<uint8_t>());
+
+	const String cache_path = get_cache_path(p_binary_tokens_path);
+	if (!FileAccess::exists(cache_path)) {
+		return Vector<uint8_t>();
+	}
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(cache_path);
+
+	Reader reader(buffer);
+	Reader::Header header;
+	if (reader.get_header(header) != OK || header.source_hash != get_source_hash(p_script->get_binary_tokens_source())) {
+		print_verbose(vformat(R"(GDScript: Bytecode cache "%s" doesn't match the engine or the script, loading from tokens.)", cache_path));
+		return Vector<uint8_t>();
+	}
+
+	header.apply_names(p_script);
+	return buffer;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_script->valid, ERR_ALREADY_IN_USE);
+
+	Reader reader(p_buffer);
+	Reader::Header header;
+	Error err = reader.get_header(header);
+	if (err != OK) {
+		return err;
+	}
+	header.apply_names(p_script);
+
+	bool static_cached = false;
+	Loader loader(p_script, reader);
+	err = loader.load(static_cached);
+	if (err != OK) {
+		print_verbose(vformat(R"(GDScript: Bytecode cache of "%s" links to engine methods that changed, loading from tokens.)", p_script->path));
+		return err;
+	}
+
+	// Same steps as the end of `GDScriptCompiler::compile()` and `GDScript::reload()`.
+	p_script->_static_default_init();
+	p_script->valid = true;
+
+	if (static_cached) {
+		GDScriptCache::add_static_script(Ref<GDScript>(p_script));
+	}
+	if (!p_script->path.is_empty()) {
+		err = GDScriptCache::finish_compiling(p_script->path);
+		if (err != OK) {
+			return err;
+		}
+	}
+	if (ScriptServer::is_scripting_enabled() || p_script->tool) {
+		return p_script->_static_init();
+	}
+	return OK;
+}
@@ -0,0 +1,76 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/vector.h"
+
+class GDScript;
+
+// Compiled bytecode of a GDScript class, so exported projects can load scripts
+// without parsing, analyzing and compiling them.
+// The cache is stored as a `.gdbc` file next to the binary tokens (`.gdc`) of
+// the script, which remain the fallback when the cache doesn't match the engine
+// or the tokens, or when one of the engine methods it links to changed.
+class GDScriptBytecodeCache {
+	class Reader;
+	class Loader;
+#ifdef TOOLS_ENABLED
+	class Writer;
+	class Serializer;
+#endif
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 4;
+
+	static String get_cache_path(const String &p_binary_tokens_path);
+	static uint32_t get_engine_hash();
+	// Debug builds compile extra code, like assertions, so a cache only loads in builds of the same kind.
+	static bool is_debug_build();
+	static uint32_t get_source_hash(const Vector<uint8_t> &p_binary_tokens);
+
+#ifdef TOOLS_ENABLED
+	// Fails with `ERR_UNAVAILABLE` for scripts that can't be cached, like the ones
+	// with inner classes or lambdas. They are loaded from their tokens instead.
+	static Error serialize(const GDScript *p_script, uint32_t p_source_hash, Vector<uint8_t> &r_buffer);
+	// Compiles the script again like a debug or a release build would, and serializes that for an export.
+	// Release bytecode leaves out assertions and breakpoints, and only tracks lines and locals
+	// when the project settings ask for it.
+	static Error serialize_for_export(const String &p_path, const String &p_source, bool p_debug, uint32_t p_source_hash, Vector<uint8_t> &r_buffer);
+#endif
+
+	// Reads the cache of a script loaded from binary tokens. Returns an empty buffer
+	// when there is no compatible cache. Otherwise it sets the class names of the
+	// script, so it can be used as a shallow script until `load()` is called.
+	static Vector<uint8_t> read_cache(GDScript *p_script, const String &p_binary_tokens_path);
+	// Links the cached bytecode into the script and finishes it like `GDScript::reload()` does.
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+};
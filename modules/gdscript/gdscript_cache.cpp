@@ -32,10 +32,19 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
 #include "core/io/file_access.h"
+#include "core/io/resource_uid.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/profiling/profiling.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -205,6 +214,8 @@ void GDScriptCache::remove_script(const String &p_path) {
 	remove_parser(p_path);
 
 	singleton->dependencies.erase(p_path);
+	singleton->bytecode_caches.erase(p_path);
+	singleton->prepared_parsers.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
 }
@@ -328,9 +339,19 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	// Exported scripts may come with their compiled bytecode, which replaces parsing them.
+	Vector<uint8_t> bytecode_cache;
+	if (remapped_path.has_extension("gdc")) {
+		bytecode_cache = GDScriptBytecodeCache::read_cache(script.ptr(), remapped_path);
+	}
+
+	if (!bytecode_cache.is_empty()) {
+		singleton->bytecode_caches[p_path] = bytecode_cache;
+	} else {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -380,10 +401,24 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	Vector<uint8_t> bytecode_cache;
+	if (HashMap<String, Vector<uint8_t>>::Iterator E = singleton->bytecode_caches.find(p_path)) {
+		if (!p_update_from_disk) {
+			bytecode_cache = E->value;
+		}
+		singleton->bytecode_caches.remove(E);
+	}
+
 	// Allowing lifting the lock might cause a script to be reloaded multiple times,
 	// which, as a last resort deadlock prevention strategy, is a good tradeoff.
 	uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
-	r_error = script->reload(true);
+	if (!bytecode_cache.is_empty()) {
+		r_error = GDScriptBytecodeCache::load(script.ptr(), bytecode_cache);
+	}
+	if (bytecode_cache.is_empty() || (r_error != OK && !script->is_valid())) {
+		// Compile from the tokens when there is no cache or it no longer links to the engine.
+		r_error = script->reload(true);
+	}
 	WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
 	if (r_error) {
 		return script;
@@ -441,6 +476,294 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 	return err;
 }
 
+// Loads a set of scripts with their dependencies in three phases:
+// - Parsing runs on the worker threads, in waves: each wave parses the dependencies found by the
+//   previous one, from the paths given to `preload()` and `extends` or the `class_name` extended.
+//   The scripts other scripts depend on are parsed once more for the parser map.
+// - Analysis runs on the calling thread in dependency order, since analyzers resolve the shared
+//   parser references of their dependencies, which can't be done concurrently. The cache mutex
+//   isn't held meanwhile, as analyzers go through the cache to get those references.
+// - Compilation loads each script through the cache in the same order, using the analyzed trees.
+class GDScriptWarmUp {
+	struct Script {
+		String path;
+		String remapped_path;
+		Ref<GDScriptParserRef> parser_ref; // For `GDScript::reload()`.
+		Ref<GDScriptParserRef> interface_ref; // For the scripts depending on this one.
+		LocalVector<uint32_t> dependencies;
+		bool depended = false;
+		bool sorted = false;
+	};
+
+	LocalVector<Script> scripts;
+	HashMap<String, uint32_t> indices;
+	HashMap<StringName, String> class_paths;
+
+	static Ref<GDScriptParserRef> _parse(const String &p_path, const String &p_remapped_path);
+	void _parse_task(uint32_t p_index, uint32_t p_first);
+	void _parse_interface_task(uint32_t p_index, const LocalVector<uint32_t> *p_depended);
+
+	int64_t _add_script(const String &p_path);
+	void _add_dependency(uint32_t p_index, const String &p_path);
+	void _sort(uint32_t p_index, LocalVector<uint32_t> &r_order);
+
+public:
+	void run(const Vector<String> &p_paths);
+};
+
+Ref<GDScriptParserRef> GDScriptWarmUp::_parse(const String &p_path, const String &p_remapped_path) {
+	Ref<GDScriptParserRef> ref;
+	ref.instantiate();
+	ref->path = p_path;
+	ref->abandoned = true; // Not in the parser map.
+	ref->status = GDScriptParserRef::PARSED;
+	if (p_remapped_path.has_extension("gdc")) {
+		Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(p_remapped_path);
+		ref->source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		ref->result = ref->get_parser()->parse_binary(tokens, p_path);
+	} else {
+		String source = GDScriptCache::get_source_code(p_remapped_path);
+		ref->source_hash = source.hash();
+		ref->result = ref->get_parser()->parse(source, p_path, false);
+	}
+	return ref;
+}
+
+void GDScriptWarmUp::_parse_task(uint32_t p_index, uint32_t p_first) {
+	Script &script = scripts[p_first + p_index];
+	script.parser_ref = _parse(script.path, script.remapped_path);
+}
+
+void GDScriptWarmUp::_parse_interface_task(uint32_t p_index, const LocalVector<uint32_t> *p_depended) {
+	Script &script = scripts[(*p_depended)[p_index]];
+	script.interface_ref = _parse(script.path, script.remapped_path);
+}
+
+int64_t GDScriptWarmUp::_add_script(const String &p_path) {
+	if (HashMap<String, uint32_t>::Iterator E = indices.find(p_path)) {
+		return E->value;
+	}
+
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (!FileAccess::exists(remapped_path) || GDScriptCache::get_cached_script(p_path).is_valid()) {
+		return -1;
+	}
+	if (remapped_path.has_extension("gdc") && FileAccess::exists(GDScriptBytecodeCache::get_cache_path(remapped_path))) {
+		return -1; // Loaded from its compiled bytecode, without parsing.
+	}
+
+	Script script;
+	script.path = p_path;
+	script.remapped_path = remapped_path;
+	indices[p_path] = scripts.size();
+	scripts.push_back(script);
+	return scripts.size() - 1;
+}
+
+void GDScriptWarmUp::_add_dependency(uint32_t p_index, const String &p_path) {
+	String path = ResourceUID::ensure_path(p_path);
+	if (path.is_relative_path()) {
+		path = scripts[p_index].path.get_base_dir().path_join(path);
+	}
+	path = path.simplify_path();
+	if (!path.has_extension("gd") && !path.has_extension("gdc")) {
+		return;
+	}
+
+	// Adding the script may grow the list, so don't keep references to its elements.
+	int64_t index = _add_script(path);
+	if (index >= 0) {
+		scripts[p_index].dependencies.push_back(index);
+	}
+}
+
+void GDScriptWarmUp::_sort(uint32_t p_index, LocalVector<uint32_t> &r_order) {
+	if (scripts[p_index].sorted) {
+		return; // Already sorted or in a cycle, which the analyzer resolves on its own.
+	}
+	scripts[p_index].sorted = true;
+
+	for (uint32_t dependency : scripts[p_index].dependencies) {
+		_sort(dependency, r_order);
+	}
+	r_order.push_back(p_index);
+}
+
+void GDScriptWarmUp::run(const Vector<String> &p_paths) {
+	GodotProfileZone("GDScriptWarmUp::run");
+	GodotProfileZoneGroupedFirst(_profile_zone, "parse");
+	uint64_t time = OS::get_singleton()->get_ticks_usec();
+
+	// Lazily initialized statics of the parser.
+	{
+		GDScriptParser parser;
+		GDScriptParser::get_builtin_type(StringName());
+	}
+
+	for (const String &path : p_paths) {
+		_add_script(path);
+	}
+
+	uint32_t first = 0;
+	while (first < scripts.size()) {
+		const uint32_t count = scripts.size() - first;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GDScriptWarmUp::_parse_task, first, count, -1, true, SNAME("GDScriptWarmUpParse"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = first; i < first + count; i++) {
+			const GDScriptParser::ClassNode *tree = scripts[i].parser_ref->get_parser()->get_tree();
+			if (tree != nullptr && tree->identifier != nullptr) {
+				class_paths[tree->identifier->name] = scripts[i].path;
+			}
+		}
+
+		for (uint32_t i = first; i < first + count; i++) {
+			const GDScriptParser *parser = scripts[i].parser_ref->get_parser();
+			const GDScriptParser::ClassNode *tree = parser->get_tree();
+			if (tree == nullptr) {
+				continue;
+			}
+
+			if (!tree->extends_path.is_empty()) {
+				_add_dependency(i, tree->extends_path);
+			} else if (!tree->extends.is_empty()) {
+				const StringName base = tree->extends[0]->name;
+				if (HashMap<StringName, String>::Iterator E = class_paths.find(base)) {
+					_add_dependency(i, E->value);
+				} else if (ScriptServer::is_global_class(base)) {
+					_add_dependency(i, ScriptServer::get_global_class_path(base));
+				}
+			}
+			for (const String &path : parser->get_preloaded_paths()) {
+				_add_dependency(i, path);
+			}
+		}
+
+		first += count;
+	}
+
+	LocalVector<uint32_t> depended;
+	for (const Script &script : scripts) {
+		for (uint32_t dependency : script.dependencies) {
+			if (!scripts[dependency].depended && !GDScriptCache::has_parser(scripts[dependency].path)) {
+				scripts[dependency].depended = true;
+				depended.push_back(dependency);
+			}
+		}
+	}
+	if (!depended.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GDScriptWarmUp::_parse_interface_task, (const LocalVector<uint32_t> *)&depended, depended.size(), -1, true, SNAME("GDScriptWarmUpParseInterface"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	const uint64_t parse_time = OS::get_singleton()->get_ticks_usec() - time;
+	GodotProfileZoneGrouped(_profile_zone, "analyze");
+	time = OS::get_singleton()->get_ticks_usec();
+
+	LocalVector<uint32_t> order;
+	for (uint32_t i = 0; i < scripts.size(); i++) {
+		_sort(i, order);
+	}
+
+	{
+		MutexLock lock(GDScriptCache::singleton->mutex);
+
+		for (uint32_t index : depended) {
+			Script &script = scripts[index];
+			if (!GDScriptCache::singleton->parser_map.has(script.path)) {
+				script.interface_ref->abandoned = false;
+				GDScriptCache::singleton->parser_map[script.path] = script.interface_ref.ptr();
+			}
+		}
+	}
+
+	for (uint32_t index : order) {
+		Ref<GDScriptParserRef> parser_ref = scripts[index].parser_ref;
+		scripts[index].parser_ref.unref(); // `GDScript::reload()` takes ownership.
+		if (parser_ref->result == OK) {
+			parser_ref->status = GDScriptParserRef::FULLY_SOLVED;
+			parser_ref->result = parser_ref->get_analyzer()->analyze();
+		}
+
+		MutexLock lock(GDScriptCache::singleton->mutex);
+		GDScriptCache::singleton->prepared_parsers[scripts[index].path] = parser_ref;
+	}
+
+	const uint64_t analyze_time = OS::get_singleton()->get_ticks_usec() - time;
+	GodotProfileZoneGrouped(_profile_zone, "compile");
+	time = OS::get_singleton()->get_ticks_usec();
+
+	for (uint32_t index : order) {
+		Error err = OK;
+		GDScriptCache::get_full_script(scripts[index].path, err);
+	}
+
+	{
+		// Scripts loaded while analyzing others didn't use their prepared trees.
+		MutexLock lock(GDScriptCache::singleton->mutex);
+		GDScriptCache::singleton->prepared_parsers.clear();
+	}
+
+	const uint64_t compile_time = OS::get_singleton()->get_ticks_usec() - time;
+	print_verbose(vformat("GDScript: Warmed up %d scripts (parse: %.2f ms, analyze: %.2f ms, compile: %.2f ms).", scripts.size(), parse_time / 1000.0, analyze_time / 1000.0, compile_time / 1000.0));
+}
+
+void GDScriptCache::warm_up(const Vector<String> &p_paths) {
+	{
+		MutexLock lock(singleton->mutex);
+		if (singleton->cleared) {
+			return;
+		}
+	}
+
+	GDScriptWarmUp script_warm_up;
+	script_warm_up.run(p_paths);
+}
+
+void GDScriptCache::warm_up_project() {
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The project warm-up must be started from the main thread.");
+
+	{
+		MutexLock lock(singleton->mutex);
+		if (singleton->warmed_up) {
+			return;
+		}
+		singleton->warmed_up = true;
+	}
+
+	if (Engine::get_singleton()->is_editor_hint() || !GLOBAL_GET("debug/settings/gdscript/parallel_warm_up")) {
+		return;
+	}
+
+	Vector<String> paths;
+	LocalVector<StringName> global_classes;
+	ScriptServer::get_global_class_list(global_classes);
+	for (const StringName &global_class : global_classes) {
+		if (ScriptServer::get_global_class_language(global_class) == GDScriptLanguage::get_singleton()->get_name()) {
+			paths.push_back(ScriptServer::get_global_class_path(global_class));
+		}
+	}
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		const String path = ResourceUID::ensure_path(E.value.path);
+		if (path.has_extension("gd")) {
+			paths.push_back(path);
+		}
+	}
+
+	warm_up(paths);
+}
+
+Ref<GDScriptParserRef> GDScriptCache::take_prepared_parser(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+
+	Ref<GDScriptParserRef> parser_ref;
+	if (HashMap<String, Ref<GDScriptParserRef>>::Iterator E = singleton->prepared_parsers.find(p_path)) {
+		parser_ref = E->value;
+		singleton->prepared_parsers.remove(E);
+	}
+	return parser_ref;
+}
+
 void GDScriptCache::add_static_script(Ref<GDScript> p_script) {
 	ERR_FAIL_COND_MSG(p_script.is_null(), "Trying to cache empty script as static.");
 	ERR_FAIL_COND_MSG(!p_script->is_valid(), "Trying to cache non-compiled script as static.");
@@ -493,6 +816,8 @@ void GDScriptCache::clear() {
 	singleton->shallow_gdscript_cache.clear();
 	singleton->full_gdscript_cache.clear();
 	singleton->static_gdscript_cache.clear();
+	singleton->bytecode_caches.clear();
+	singleton->prepared_parsers.clear();
 }
 
 GDScriptCache::GDScriptCache() {
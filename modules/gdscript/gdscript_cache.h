@@ -63,6 +63,7 @@ private:
 	bool abandoned = false;
 
 	friend class GDScriptCache;
+	friend class GDScriptWarmUp;
 	friend class GDScript;
 
 public:
@@ -93,8 +94,12 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
+	HashMap<String, Vector<uint8_t>> bytecode_caches; // Compiled bytecode of shallow scripts, loaded by `get_full_script()`.
+	HashMap<String, Ref<GDScriptParserRef>> prepared_parsers; // Trees analyzed by `warm_up()`, used by `GDScript::reload()`.
 
 	friend class GDScript;
+	friend class GDScriptWarmUp;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 #ifdef TESTS_ENABLED
@@ -104,6 +109,7 @@ class GDScriptCache {
 	static GDScriptCache *singleton;
 
 	bool cleared = false;
+	bool warmed_up = false;
 
 public:
 	static const int BINARY_MUTEX_TAG = 2;
@@ -129,6 +135,14 @@ public:
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
 	static Error finish_compiling(const String &p_owner);
+	// Loads the given scripts and everything they preload, extend or whose `class_name` they extend,
+	// parsing them in parallel before analyzing and compiling them in dependency order.
+	static void warm_up(const Vector<String> &p_paths);
+	// Warms up the global classes and autoloads of the project the first time it's called,
+	// if enabled in the project settings. Called on the main thread before the autoloads load.
+	static void warm_up_project();
+	// Returns the tree prepared by `warm_up()` for the script, if any. The caller must check its source hash.
+	static Ref<GDScriptParserRef> take_prepared_parser(const String &p_path);
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
@@ -2180,6 +2180,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::ASSERT: {
 #ifdef DEBUG_ENABLED
+				if (!debug_bytecode) {
+					break;
+				}
 				const GDScriptParser::AssertNode *as = static_cast<const GDScriptParser::AssertNode *>(s);
 
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, as->condition);
@@ -2207,7 +2210,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::BREAKPOINT: {
 #ifdef DEBUG_ENABLED
-				gen->write_breakpoint();
+				if (debug_bytecode) {
+					gen->write_breakpoint();
+				}
 #endif
 			} break;
 			case GDScriptParser::Node::VARIABLE: {
@@ -2287,7 +2292,7 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_script, const GDScriptParser::ClassNode *p_class, const GDScriptParser::FunctionNode *p_func, bool p_for_ready, bool p_for_lambda) {
 	r_error = OK;
 	CodeGen codegen;
-	codegen.generator = memnew(GDScriptByteCodeGenerator);
+	codegen.generator = _create_generator();
 
 	codegen.class_node = p_class;
 	codegen.script = p_script;
@@ -2539,7 +2544,7 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 GDScriptFunction *GDScriptCompiler::_make_static_initializer(Error &r_error, GDScript *p_script, const GDScriptParser::ClassNode *p_class) {
 	r_error = OK;
 	CodeGen codegen;
-	codegen.generator = memnew(GDScriptByteCodeGenerator);
+	codegen.generator = _create_generator();
 
 	codegen.class_node = p_class;
 	codegen.script = p_script;
@@ -3352,5 +3357,19 @@ int GDScriptCompiler::get_error_column() const {
 	return err_column;
 }
 
+GDScriptCodeGenerator *GDScriptCompiler::_create_generator() const {
+	GDScriptByteCodeGenerator *generator = memnew(GDScriptByteCodeGenerator);
+	generator->set_tracking(track_call_stack, track_locals);
+	return generator;
+}
+
+void GDScriptCompiler::set_bytecode_options(bool p_debug, bool p_track_call_stack, bool p_track_locals) {
+	debug_bytecode = p_debug;
+	track_call_stack = p_track_call_stack;
+	track_locals = p_track_locals;
+}
+
 GDScriptCompiler::GDScriptCompiler() {
+	track_call_stack = GDScriptLanguage::get_singleton()->should_track_call_stack();
+	track_locals = GDScriptLanguage::get_singleton()->should_track_locals();
 }
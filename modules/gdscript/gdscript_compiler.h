@@ -173,10 +173,19 @@ class GDScriptCompiler {
 	GDScriptParser::ExpressionNode *awaited_node = nullptr;
 	bool has_static_data = false;
 
+	// See `set_bytecode_options()`, they follow the running build by default.
+	bool debug_bytecode = true;
+	bool track_call_stack = false;
+	bool track_locals = false;
+	GDScriptCodeGenerator *_create_generator() const;
+
 public:
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
 	static void make_scripts(GDScript *p_script, const GDScriptParser::ClassNode *p_class, bool p_keep_state);
 	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false);
+	// Compiles assertions and breakpoints, and tracks lines and locals, like a debug or a release
+	// build would instead of like the running one. Used by the editor to export bytecode.
+	void set_bytecode_options(bool p_debug, bool p_track_call_stack, bool p_track_locals);
 
 	String get_error() const;
 	int get_error_line() const;
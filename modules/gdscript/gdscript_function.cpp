@@ -32,6 +32,12 @@
 
 #include "gdscript.h"
 
+#include "core/object/class_db.h"
+#include "scene/scene_string_names.h"
+
+SafeNumeric<uint32_t> GDScriptFunction::last_inline_cache_version;
+BinaryMutex GDScriptFunction::inline_cache_mutex;
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -104,6 +110,144 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+void GDScriptFunction::_allocate_inline_caches(int p_count) {
+	ERR_FAIL_COND(_inline_caches_ptr != nullptr);
+	_inline_caches_count = p_count;
+	if (p_count > 0) {
+		_inline_caches_ptr = memnew_arr(InlineCache, p_count);
+	}
+}
+
+// Native getters can only be cached when nothing else can answer for the property first,
+// following the lookup order of `Object::get()` and `ClassDB::get_property()`.
+static MethodBind *_get_cacheable_native_getter(const StringName &p_class, const StringName &p_property) {
+	const ClassDB::ClassInfo *check = ClassDB::classes.getptr(p_class);
+	if (!check || check->gdextension) {
+		return nullptr; // Extension instances may implement their own getter.
+	}
+	while (check) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg->index < 0 ? psg->_getptr : nullptr;
+		}
+		if (check->constant_map.has(p_property) || check->method_map.has(p_property) || check->signal_map.has(p_property)) {
+			return nullptr;
+		}
+		check = check->inherits_ptr;
+	}
+	return nullptr;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_update_inline_cache(int p_cache, const InlineCacheKey &p_key, const StringName &p_name, bool p_call) {
+	MutexLock lock(inline_cache_mutex);
+
+	InlineCache &cache = _inline_caches_ptr[p_cache];
+	if (cache.generic.load(std::memory_order_relaxed)) {
+		return nullptr;
+	}
+	// Another thread may have added the receiver meanwhile.
+	const InlineCacheEntry *found = _find_inline_cache_entry(p_cache, p_key);
+	if (found) {
+		return found;
+	}
+
+	const InlineCacheState *old_state = cache.state.load(std::memory_order_acquire);
+	InlineCacheEntry valid_entries[INLINE_CACHE_SIZE];
+	int valid_count = 0;
+	if (old_state) {
+		for (int i = 0; i < old_state->count; i++) {
+			if (_is_inline_cache_entry_valid(old_state->entries[i])) {
+				valid_entries[valid_count++] = old_state->entries[i];
+			}
+		}
+	}
+	if (valid_count == INLINE_CACHE_SIZE || (old_state && retired_inline_cache_states.size() >= uint32_t(_inline_caches_count) * INLINE_CACHE_MAX_RETIRED_STATES)) {
+		// Megamorphic, or readers may still hold the old state, so it can't be freed or replaced anymore.
+		cache.generic.store(true, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	InlineCacheEntry entry;
+	entry.type = p_key.type;
+	entry.script = p_key.script;
+	if (p_key.script) {
+		entry.script_version = p_key.script->inline_cache_version.get();
+	}
+
+	if (p_key.type != Variant::OBJECT) {
+		if (!p_call) {
+			entry.getter = Variant::get_member_validated_getter(p_key.type, p_name);
+			if (entry.getter) {
+				entry.kind = INLINE_CACHE_BUILTIN_GETTER;
+				entry.value_type = Variant::get_member_type(p_key.type, p_name);
+			}
+		}
+	} else if (Object::cast_to<Script>(p_key.object) || Object::cast_to<GDScriptNativeClass>(p_key.object)) {
+		// Their `callp()` and `_get()` resolve names before the class does.
+		entry.native_class = p_key.object->get_class_name();
+	} else if (p_call) {
+		entry.native_class = p_key.object->get_class_name();
+		GDScriptFunction *function = nullptr;
+		// `_ready` also runs the implicit initializers, and `free` deletes the receiver.
+		if (p_name != SceneStringName(_ready) && p_name != CoreStringName(free_)) {
+			for (const GDScript *script = p_key.script; script && !function; script = script->base.ptr()) {
+				if (script->valid) {
+					HashMap<StringName, GDScriptFunction *>::ConstIterator E = script->member_functions.find(p_name);
+					if (E) {
+						function = E->value;
+						entry.function_script = script;
+						entry.function_script_version = script->inline_cache_version.get();
+					}
+				}
+			}
+			if (function) {
+				entry.kind = INLINE_CACHE_SCRIPT_FUNCTION;
+				entry.function = function;
+			} else {
+				entry.method = ClassDB::get_method(entry.native_class, p_name);
+				if (entry.method) {
+					entry.kind = INLINE_CACHE_NATIVE_METHOD;
+					entry.value_type = entry.method->get_argument_type(-1);
+					entry.validated = !entry.method->is_vararg();
+					for (int i = 0; i < entry.method->get_argument_count() && entry.validated; i++) {
+						Variant::Type argument_type = entry.method->get_argument_type(i);
+						entry.validated = argument_type != Variant::NIL && argument_type != Variant::OBJECT;
+					}
+				}
+			}
+		}
+	} else {
+		entry.native_class = p_key.object->get_class_name();
+		if (p_key.instance) {
+			// Members with getters run script code, everything else is looked up by `GDScriptInstance::get()`.
+			HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = p_key.script->member_indices.find(p_name);
+			if (E && E->value.getter == StringName()) {
+				entry.kind = INLINE_CACHE_MEMBER;
+				entry.member_index = E->value.index;
+			}
+		} else {
+			entry.method = _get_cacheable_native_getter(entry.native_class, p_name);
+			if (entry.method) {
+				entry.kind = INLINE_CACHE_NATIVE_GETTER;
+			}
+		}
+	}
+
+	InlineCacheState *state = memnew(InlineCacheState);
+	for (int i = 0; i < valid_count; i++) {
+		state->entries[i] = valid_entries[i];
+	}
+	state->count = valid_count;
+	state->entries[state->count++] = entry;
+
+	cache.state.store(state, std::memory_order_release);
+	if (old_state) {
+		// Other threads may still be reading it.
+		retired_inline_cache_states.push_back(old_state);
+	}
+	return &state->entries[state->count - 1];
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -121,6 +265,21 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	// Caches of other functions may point to this one.
+	get_script()->invalidate_inline_caches();
+	for (int i = 0; i < _inline_caches_count; i++) {
+		const InlineCacheState *state = _inline_caches_ptr[i].state.load(std::memory_order_acquire);
+		if (state) {
+			memdelete(const_cast<InlineCacheState *>(state));
+		}
+	}
+	for (const InlineCacheState *state : retired_inline_cache_states) {
+		memdelete(const_cast<InlineCacheState *>(state));
+	}
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
@@ -34,8 +34,10 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
@@ -265,6 +267,8 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_INT_IMMEDIATE,
+		OPCODE_OPERATOR_FLOAT_IMMEDIATE,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -325,6 +329,8 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_NOT_COMPARE_INT,
+		OPCODE_JUMP_IF_NOT_COMPARE_FLOAT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
 		OPCODE_RETURN,
@@ -454,6 +460,7 @@ private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptLanguage;
 
 	StringName name;
@@ -530,6 +537,98 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Untyped `OPCODE_CALL` and `OPCODE_GET_NAMED` instructions hold the index of an inline cache,
+	// which remembers what the name resolved to for the last few receiver types.
+	static constexpr int INLINE_CACHE_SIZE = 4;
+	// Retired states are kept until the function is freed. Past this many per cache, sites turn
+	// generic, so invalidations can't grow memory unbounded.
+	static constexpr int INLINE_CACHE_MAX_RETIRED_STATES = 16;
+
+	enum InlineCacheKind : uint8_t {
+		INLINE_CACHE_GENERIC, // The receiver has to go through `Variant::callp()` or `Variant::get_named()`.
+		INLINE_CACHE_SCRIPT_FUNCTION,
+		INLINE_CACHE_NATIVE_METHOD,
+		INLINE_CACHE_MEMBER,
+		INLINE_CACHE_NATIVE_GETTER,
+		INLINE_CACHE_BUILTIN_GETTER,
+	};
+
+	struct InlineCacheKey {
+		Variant::Type type = Variant::NIL;
+		Object *object = nullptr;
+		GDScriptInstance *instance = nullptr;
+		const GDScript *script = nullptr;
+	};
+
+	struct InlineCacheEntry {
+		// Receiver the entry applies to.
+		Variant::Type type = Variant::NIL;
+		const GDScript *script = nullptr;
+		uint32_t script_version = 0; // The entry is stale once `script` has another version.
+		StringName native_class;
+
+		InlineCacheKind kind = INLINE_CACHE_GENERIC;
+		GDScriptFunction *function = nullptr;
+		const GDScript *function_script = nullptr; // The base of `script` declaring `function`.
+		uint32_t function_script_version = 0;
+		MethodBind *method = nullptr;
+		bool validated = false; // The method can be called without conversions when argument types match.
+		int member_index = -1;
+		Variant::ValidatedGetter getter = nullptr;
+		Variant::Type value_type = Variant::NIL; // Return type of `method` or `getter`.
+	};
+
+	// Published states are never modified, so the VM reads them without locking.
+	// Adding an entry publishes a new state without the stale entries and retires the old one
+	// until the function is freed, up to `INLINE_CACHE_MAX_RETIRED_STATES` per cache.
+	struct InlineCacheState {
+		int count = 0;
+		InlineCacheEntry entries[INLINE_CACHE_SIZE];
+	};
+
+	struct InlineCache {
+		std::atomic<const InlineCacheState *> state = nullptr;
+		// Set for good once the site sees more receivers than fit or runs out of retired states,
+		// so the VM goes straight to the generic path without looking up or locking anything.
+		std::atomic<bool> generic = false;
+	};
+
+	static SafeNumeric<uint32_t> last_inline_cache_version;
+	static BinaryMutex inline_cache_mutex;
+
+	int _inline_caches_count = 0;
+	InlineCache *_inline_caches_ptr = nullptr;
+	LocalVector<const InlineCacheState *> retired_inline_cache_states;
+
+#ifdef TOOLS_ENABLED
+	// What each entry of the pointer tables was resolved from, and where the
+	// bytecode holds engine-specific values. Used to store the function in a
+	// `GDScriptBytecodeCache` and relink it when the cache is loaded.
+	struct LinkKey {
+		Variant::Type type = Variant::NIL;
+		Variant::Type right_type = Variant::NIL;
+		int index = 0; // Operator or constructor index.
+		StringName name;
+	};
+
+	struct LinkInfo {
+		Vector<LinkKey> operators;
+		Vector<LinkKey> setters;
+		Vector<LinkKey> getters;
+		Vector<LinkKey> keyed_setters;
+		Vector<LinkKey> keyed_getters;
+		Vector<LinkKey> indexed_setters;
+		Vector<LinkKey> indexed_getters;
+		Vector<LinkKey> builtin_methods;
+		Vector<LinkKey> constructors;
+		Vector<LinkKey> utilities;
+		Vector<LinkKey> gds_utilities;
+		Vector<int> global_positions; // Bytecode positions of global array indices.
+		Vector<int> operator_cache_positions; // Bytecode positions of the `OPCODE_OPERATOR` runtime caches.
+		bool uses_named_globals = false;
+	} link_info;
+#endif
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -567,6 +666,14 @@ private:
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	void _allocate_inline_caches(int p_count);
+	static bool _get_inline_cache_key(const Variant *p_base, InlineCacheKey &r_key);
+	static bool _is_inline_cache_entry_valid(const InlineCacheEntry &p_entry);
+	const InlineCacheEntry *_find_inline_cache_entry(int p_cache, const InlineCacheKey &p_key) const;
+	const InlineCacheEntry *_update_inline_cache(int p_cache, const InlineCacheKey &p_key, const StringName &p_name, bool p_call);
+	void _inline_cache_call(int p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	void _inline_cache_get_named(int p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret, bool &r_valid);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
@@ -602,6 +709,9 @@ public:
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
+	// Returns a version no script had before, see `GDScript::invalidate_inline_caches()`.
+	static uint32_t get_new_inline_cache_version() { return last_inline_cache_version.increment(); }
+
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
@@ -1343,6 +1343,7 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	Vector<String> preloaded_paths;
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1635,6 +1636,8 @@ public:
 		// TODO: Keep track of deps.
 		return List<String>();
 	}
+	// Paths given as literals to `preload()`, as written in the source.
+	const Vector<String> &get_preloaded_paths() const { return preloaded_paths; }
 
 #ifdef DEBUG_ENABLED
 	static void update_project_settings();
@@ -208,6 +208,175 @@ String GDScriptFunction::_get_callable_call_error(const String &p_where, const C
 	}
 }
 
+bool GDScriptFunction::_get_inline_cache_key(const Variant *p_base, InlineCacheKey &r_key) {
+	r_key.type = p_base->get_type();
+	if (r_key.type != Variant::OBJECT) {
+		return true;
+	}
+	r_key.object = p_base->get_validated_object();
+	if (unlikely(!r_key.object)) {
+		return false; // Let `Variant` report the error.
+	}
+	ScriptInstance *script_instance = r_key.object->get_script_instance();
+	if (script_instance) {
+		// Instances of other languages and placeholders resolve names their own way.
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+			return false;
+		}
+		r_key.instance = static_cast<GDScriptInstance *>(script_instance);
+		r_key.script = r_key.instance->script.ptr();
+	}
+	return true;
+}
+
+bool GDScriptFunction::_is_inline_cache_entry_valid(const InlineCacheEntry &p_entry) {
+	// A freed script can't match, since a script allocated at its address starts with a new version.
+	// While `script` is the same, its bases are kept alive by it, so `function_script` can be read.
+	if (p_entry.script && p_entry.script->inline_cache_version.get() != p_entry.script_version) {
+		return false;
+	}
+	return !p_entry.function_script || p_entry.function_script->inline_cache_version.get() == p_entry.function_script_version;
+}
+
+const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_find_inline_cache_entry(int p_cache, const InlineCacheKey &p_key) const {
+	const InlineCacheState *state = _inline_caches_ptr[p_cache].state.load(std::memory_order_acquire);
+	if (!state) {
+		return nullptr;
+	}
+	for (int i = 0; i < state->count; i++) {
+		const InlineCacheEntry &entry = state->entries[i];
+		if (entry.type == p_key.type && entry.script == p_key.script && (p_key.type != Variant::OBJECT || entry.native_class == p_key.object->get_class_name())) {
+			return _is_inline_cache_entry_valid(entry) ? &entry : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+void GDScriptFunction::_inline_cache_call(int p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	InlineCacheKey key;
+	if (p_base->get_type() == Variant::OBJECT && !_inline_caches_ptr[p_cache].generic.load(std::memory_order_relaxed) && _get_inline_cache_key(p_base, key)) {
+		const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, key);
+		if (!entry) {
+			entry = _update_inline_cache(p_cache, key, p_method, true);
+		}
+		if (entry && entry->kind == INLINE_CACHE_SCRIPT_FUNCTION) {
+#ifdef DEBUG_ENABLED
+			// `Object::callp()` is skipped, so lock the receiver like it would.
+			_ObjectDebugLock debug_lock(key.object);
+#endif
+			r_ret = entry->function->call(key.instance, p_args, p_argcount, r_err);
+			return;
+		}
+		if (entry && entry->kind == INLINE_CACHE_NATIVE_METHOD) {
+#ifdef DEBUG_ENABLED
+			_ObjectDebugLock debug_lock(key.object);
+#endif
+			bool validated = entry->validated && p_argcount == entry->method->get_argument_count();
+			for (int i = 0; validated && i < p_argcount; i++) {
+				validated = p_args[i]->get_type() == entry->method->get_argument_type(i);
+			}
+			if (validated) {
+				r_err.error = Callable::CallError::CALL_OK;
+				if (entry->value_type == Variant::NIL) {
+					r_ret = Variant();
+				} else {
+					VariantInternal::initialize(&r_ret, entry->value_type);
+				}
+				entry->method->validated_call(key.object, p_args, &r_ret);
+			} else {
+				r_ret = entry->method->call(key.object, p_args, p_argcount, r_err);
+			}
+			return;
+		}
+	}
+	p_base->callp(p_method, p_args, p_argcount, r_ret, r_err);
+}
+
+void GDScriptFunction::_inline_cache_get_named(int p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret, bool &r_valid) {
+	InlineCacheKey key;
+	if (!_inline_caches_ptr[p_cache].generic.load(std::memory_order_relaxed) && _get_inline_cache_key(p_base, key)) {
+		const InlineCacheEntry *entry = _find_inline_cache_entry(p_cache, key);
+		if (!entry) {
+			entry = _update_inline_cache(p_cache, key, p_name, false);
+		}
+		if (entry && entry->kind == INLINE_CACHE_MEMBER) {
+			r_ret = key.instance->members[entry->member_index];
+			r_valid = true;
+			return;
+		}
+		if (entry && entry->kind == INLINE_CACHE_NATIVE_GETTER) {
+			Callable::CallError ce;
+			r_ret = entry->method->call(key.object, nullptr, 0, ce);
+			r_valid = true;
+			return;
+		}
+		if (entry && entry->kind == INLINE_CACHE_BUILTIN_GETTER) {
+			Variant value;
+			VariantInternal::initialize(&value, entry->value_type);
+			entry->getter(p_base, &value);
+			r_ret = value;
+			r_valid = true;
+			return;
+		}
+	}
+	r_ret = p_base->get_named(p_name, r_valid);
+}
+
+// Operations of the fused opcodes. The bytecode generator only fuses the operators handled here.
+static _FORCE_INLINE_ int64_t _evaluate_int_immediate(Variant::Operator p_operator, int64_t p_left, int64_t p_right) {
+	switch (p_operator) {
+		case Variant::OP_ADD:
+			return p_left + p_right;
+		case Variant::OP_SUBTRACT:
+			return p_left - p_right;
+		case Variant::OP_MULTIPLY:
+			return p_left * p_right;
+		case Variant::OP_BIT_AND:
+			return p_left & p_right;
+		case Variant::OP_BIT_OR:
+			return p_left | p_right;
+		case Variant::OP_BIT_XOR:
+			return p_left ^ p_right;
+		default:
+			return 0;
+	}
+}
+
+static _FORCE_INLINE_ double _evaluate_float_immediate(Variant::Operator p_operator, double p_left, double p_right) {
+	switch (p_operator) {
+		case Variant::OP_ADD:
+			return p_left + p_right;
+		case Variant::OP_SUBTRACT:
+			return p_left - p_right;
+		case Variant::OP_MULTIPLY:
+			return p_left * p_right;
+		case Variant::OP_DIVIDE:
+			return p_left / p_right;
+		default:
+			return 0.0;
+	}
+}
+
+template <typename T>
+static _FORCE_INLINE_ bool _evaluate_comparison(Variant::Operator p_operator, T p_left, T p_right) {
+	switch (p_operator) {
+		case Variant::OP_EQUAL:
+			return p_left == p_right;
+		case Variant::OP_NOT_EQUAL:
+			return p_left != p_right;
+		case Variant::OP_LESS:
+			return p_left < p_right;
+		case Variant::OP_LESS_EQUAL:
+			return p_left <= p_right;
+		case Variant::OP_GREATER:
+			return p_left > p_right;
+		case Variant::OP_GREATER_EQUAL:
+			return p_left >= p_right;
+		default:
+			return false;
+	}
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -255,6 +424,8 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_INT_IMMEDIATE,                 \
+		&&OPCODE_OPERATOR_FLOAT_IMMEDIATE,               \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -315,6 +486,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP,                                   \
 		&&OPCODE_JUMP_IF,                                \
 		&&OPCODE_JUMP_IF_NOT,                            \
+		&&OPCODE_JUMP_IF_NOT_COMPARE_INT,                \
+		&&OPCODE_JUMP_IF_NOT_COMPARE_FLOAT,              \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
 		&&OPCODE_JUMP_IF_SHARED,                         \
 		&&OPCODE_RETURN,                                 \
@@ -852,6 +1025,38 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_INT_IMMEDIATE) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(dst, 1);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 3];
+				int64_t result = _evaluate_int_immediate(op, *VariantInternal::get_int(a), _code_ptr[ip + 4]);
+
+				VariantTypeChanger<int64_t>::change(dst);
+				*VariantInternal::get_int(dst) = result;
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_FLOAT_IMMEDIATE) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(dst, 1);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 3];
+				double result = _evaluate_float_immediate(op, *VariantInternal::get_float(a), _code_ptr[ip + 4]);
+
+				VariantTypeChanger<double>::change(dst);
+				*VariantInternal::get_float(dst) = result;
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1248,7 +1453,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1258,13 +1463,17 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_caches_count);
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret;
+				_inline_cache_get_named(inline_cache, src, *index, ret, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+				_inline_cache_get_named(inline_cache, src, *index, *dst, valid);
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1273,7 +1482,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1896,7 +2105,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1907,6 +2116,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int inline_cache = _code_ptr[ip + 3];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_caches_count);
+
 				GodotProfileZoneScriptSystemCall(methodname, source, name, *methodname, line);
 
 				GET_INSTRUCTION_ARG(base, argc);
@@ -1927,7 +2139,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1957,7 +2169,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -2012,7 +2224,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2768,6 +2980,42 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_NOT_COMPARE_INT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 3];
+
+				if (!_evaluate_comparison(op, *VariantInternal::get_int(a), *VariantInternal::get_int(b))) {
+					int to = _code_ptr[ip + 4];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 5;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_JUMP_IF_NOT_COMPARE_FLOAT) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 3];
+
+				if (!_evaluate_comparison(op, *VariantInternal::get_float(a), *VariantInternal::get_float(b))) {
+					int to = _code_ptr[ip + 4];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 5;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
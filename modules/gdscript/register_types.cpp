@@ -31,6 +31,7 @@
 #include "register_types.h"
 
 #include "gdscript.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -80,14 +81,35 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr EditorExportPreset::ScriptExportMode DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	EditorExportPreset::ScriptExportMode script_mode = DEFAULT_SCRIPT_MODE;
+	bool export_bytecode_cache = false;
+	bool export_debug = false;
+
+	void _export_bytecode_cache(const String &p_path, const String &p_source, const Vector<uint8_t> &p_binary_tokens) {
+		Vector<uint8_t> cache;
+		Error err = GDScriptBytecodeCache::serialize_for_export(p_path, p_source, export_debug, GDScriptBytecodeCache::get_source_hash(p_binary_tokens), cache);
+		if (err != OK) {
+			print_verbose(vformat(R"(GDScript: "%s" can't be exported as bytecode, it will be compiled from its tokens at runtime.)", p_path));
+			return;
+		}
+
+		add_file(GDScriptBytecodeCache::get_cache_path(p_path), cache, false);
+	}
 
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/export_bytecode_cache"), false));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		export_bytecode_cache = false;
+		// The cache is compiled for the kind of build being exported, which only loads caches of its kind.
+		export_debug = p_debug;
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			export_bytecode_cache = get_option("gdscript/export_bytecode_cache");
 		}
 	}
 
@@ -109,6 +131,11 @@ protected:
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (export_bytecode_cache) {
+			// Stored next to the tokens, which stay the fallback when the cache can't be used.
+			_export_bytecode_cache(p_path, source, file);
+		}
 	}
 
 public:
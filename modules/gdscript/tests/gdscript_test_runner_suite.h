@@ -47,6 +47,10 @@ public:
 	static bool has_full(String p_path) {
 		return GDScriptCache::singleton->full_gdscript_cache.has(p_path);
 	}
+
+	static bool has_prepared_parsers() {
+		return !GDScriptCache::singleton->prepared_parsers.is_empty();
+	}
 };
 
 // TODO: Handle some cases failing on release builds. See: https://github.com/godotengine/godot/pull/88452
@@ -105,6 +109,39 @@ TEST_CASE("[Modules][GDScript] Loading keeps ResourceCache and GDScriptCache in
 	CHECK(TestGDScriptCacheAccessor::has_full(path));
 }
 
+TEST_CASE("[Modules][GDScript] Warm-up loads scripts with their dependencies") {
+	const String base_path = TestUtils::get_temp_path("gdscript_warm_up_base.gd");
+	const String constants_path = TestUtils::get_temp_path("gdscript_warm_up_constants.gd");
+	const String path = TestUtils::get_temp_path("gdscript_warm_up_test.gd");
+
+	const String sources[3][2] = {
+		{ base_path, "extends RefCounted\n\nfunc get_value() -> int:\n\treturn 1\n" },
+		{ constants_path, "const VALUE = 41\n" },
+		{ path, vformat("extends \"%s\"\n\nconst Constants = preload(\"%s\")\n\nfunc get_value() -> int:\n\treturn super() + Constants.VALUE\n", base_path.get_file(), constants_path.get_file()) },
+	};
+	for (const String(&source)[2] : sources) {
+		Ref<FileAccess> fa = FileAccess::open(source[0], FileAccess::ModeFlags::WRITE);
+		fa->store_string(source[1]);
+		fa->close();
+	}
+
+	// Relative paths are resolved from the script depending on them.
+	GDScriptCache::warm_up({ path });
+
+	CHECK(TestGDScriptCacheAccessor::has_full(path));
+	CHECK(TestGDScriptCacheAccessor::has_full(base_path));
+	CHECK(TestGDScriptCacheAccessor::has_full(constants_path));
+	CHECK(!TestGDScriptCacheAccessor::has_prepared_parsers());
+
+	Ref<GDScript> loaded = ResourceLoader::load(path);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->is_valid());
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(loaded);
+	CHECK_MESSAGE(int(ref_counted->call("get_value")) == 42, "The warmed-up script should call its base class and use its preloaded constants.");
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,310 @@
+/**************************************************************************/
+/*  test_bytecode_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_bytecode_cache.h"
+#include "modules/gdscript/gdscript_cache.h"
+#include "modules/gdscript/gdscript_tokenizer_buffer.h"
+
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+// Caches are only written by the editor when exporting.
+#ifdef TOOLS_ENABLED
+
+namespace TestGDScriptBytecodeCache {
+
+static Ref<GDScript> compile_script(const String &p_source) {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_binary_tokens_source(GDScriptTokenizerBuffer::parse_code_string(p_source, GDScriptTokenizerBuffer::COMPRESS_NONE));
+	ERR_PRINT_OFF;
+	script->reload();
+	ERR_PRINT_ON;
+	return script;
+}
+
+// Stores the tokens and the cache next to each other, like an export does, then loads them through `GDScriptCache`.
+static Ref<GDScript> load_exported_script(const String &p_name, const Vector<uint8_t> &p_tokens, const Vector<uint8_t> &p_cache) {
+	const String path = TestUtils::get_temp_path(p_name + ".gdc");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		f->store_buffer(p_tokens);
+		f = FileAccess::open(GDScriptBytecodeCache::get_cache_path(path), FileAccess::WRITE);
+		f->store_buffer(p_cache);
+	}
+
+	Error err = OK;
+	Ref<GDScript> script = GDScriptCache::get_shallow_script(path, err);
+	REQUIRE(err == OK);
+	REQUIRE(script.is_valid());
+	script = GDScriptCache::get_full_script(path, err);
+	CHECK(err == OK);
+	GDScriptCache::remove_script(path);
+	return script;
+}
+
+// Position of the length prefixed string in a cache buffer, or -1.
+static int find_cache_string(const Vector<uint8_t> &p_cache, const String &p_string) {
+	const CharString utf8 = p_string.utf8();
+	for (int i = 0; i + 4 + utf8.length() <= p_cache.size(); i++) {
+		if (decode_uint32(&p_cache[i]) == uint32_t(utf8.length()) && memcmp(&p_cache[i + 4], utf8.get_data(), utf8.length()) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static String make_benchmark_script(int p_index, int p_function_count) {
+	String source = vformat("extends RefCounted\n\nconst ID = %d\nvar values: Array[int] = []\n", p_index);
+	for (int i = 0; i < p_function_count; i++) {
+		source += vformat(R"(
+func step_%d(amount: int, position := Vector2(1, 2)) -> int:
+	var total := amount * ID + %d
+	for value in values:
+		total += value %% (amount + 1)
+	values.push_back(total)
+	return total + int(position.length()) + len(values)
+)",
+				i, i);
+	}
+	return source;
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache runs like the compiled script") {
+	Ref<GDScript> compiled = compile_script(R"(
+extends RefCounted
+
+const OFFSET = 3
+static var counter := 0
+var values: Array[int] = [1, 2, 3]
+
+func sum(scale := 2) -> int:
+	var total := 0
+	for value in values:
+		total += value * scale
+	return total + OFFSET
+
+func describe(position: Vector2) -> String:
+	counter += 1
+	return str(position.x + position.length(), " ", len(values), " ", counter)
+
+func _init():
+	set_meta("initialized", true)
+)");
+	REQUIRE(compiled->is_valid());
+
+	Vector<uint8_t> cache;
+	REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), 0, cache) == OK);
+
+	Ref<GDScript> cached;
+	cached.instantiate();
+	REQUIRE(GDScriptBytecodeCache::load(cached.ptr(), cache) == OK);
+	CHECK(cached->is_valid());
+	CHECK(cached->has_method("sum"));
+
+	Ref<RefCounted> compiled_object = memnew(RefCounted);
+	compiled_object->set_script(compiled);
+	Ref<RefCounted> cached_object = memnew(RefCounted);
+	cached_object->set_script(cached);
+
+	CHECK(bool(cached_object->get_meta("initialized", false)));
+	CHECK(int(cached_object->call("sum")) == 15);
+	CHECK(cached_object->call("sum", 3) == compiled_object->call("sum", 3));
+	CHECK(cached_object->call("describe", Vector2(3, 4)) == compiled_object->call("describe", Vector2(3, 4)));
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache falls back for other engine builds and unsupported scripts") {
+	Ref<GDScript> compiled = compile_script("extends RefCounted\n\nfunc value():\n\treturn 1\n");
+	Vector<uint8_t> cache;
+	REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), 0, cache) == OK);
+
+	// The engine hash follows the magic and the format version.
+	cache.write[8] ^= 0xff;
+	Ref<GDScript> cached;
+	cached.instantiate();
+	CHECK(GDScriptBytecodeCache::load(cached.ptr(), cache) == ERR_FILE_UNRECOGNIZED);
+	CHECK_FALSE(cached->is_valid());
+
+	Ref<GDScript> with_lambda = compile_script("extends RefCounted\n\nfunc value():\n\treturn func(): return 1\n");
+	REQUIRE(with_lambda->is_valid());
+	CHECK(GDScriptBytecodeCache::serialize(with_lambda.ptr(), 0, cache) == ERR_UNAVAILABLE);
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache is loaded through GDScriptCache, or skipped for the tokens") {
+	const String cached_source = R"(
+extends RefCounted
+
+func value(amount: int) -> int:
+	return absi(amount) + 1
+
+func fail():
+	var value = 5
+	return len(value)
+)";
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(cached_source.replace("+ 1", "+ 2"), GDScriptTokenizerBuffer::COMPRESS_NONE);
+	const uint32_t tokens_hash = GDScriptBytecodeCache::get_source_hash(tokens);
+
+	// The cache is compiled from a slightly different source, so the tests can tell which one ran.
+	Ref<GDScript> compiled = compile_script(cached_source);
+	REQUIRE(compiled->is_valid());
+
+	SUBCASE("Matching tokens use the cache") {
+		Vector<uint8_t> cache;
+		REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), tokens_hash, cache) == OK);
+		Ref<GDScript> script = load_exported_script("bytecode_cache_match", tokens, cache);
+		REQUIRE(script.is_valid());
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(script);
+		CHECK(int(object->call("value", -3)) == 4);
+
+		// Runtime errors are named after the relinked calls.
+		ERR_PRINT_OFF;
+		CHECK(object->call("fail") == Variant());
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Other tokens use the tokens") {
+		Vector<uint8_t> cache;
+		REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), tokens_hash + 1, cache) == OK);
+		Ref<GDScript> script = load_exported_script("bytecode_cache_mismatch", tokens, cache);
+		REQUIRE(script.is_valid());
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(script);
+		CHECK(int(object->call("value", -3)) == 5);
+	}
+
+	SUBCASE("Caches that can't be relinked use the tokens") {
+		Vector<uint8_t> cache;
+		REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), tokens_hash, cache) == OK);
+		// Utility functions are stored by name, followed by their hash.
+		const int absi_pos = find_cache_string(cache, "absi");
+		REQUIRE(absi_pos >= 0);
+		cache.write[absi_pos + 8] ^= 0xff;
+		Ref<GDScript> script = load_exported_script("bytecode_cache_relink", tokens, cache);
+		REQUIRE(script.is_valid());
+		CHECK(script->is_valid());
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(script);
+		CHECK(int(object->call("value", -3)) == 5);
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache is exported for debug and release builds") {
+	const String source = R"(
+extends RefCounted
+
+func value(amount: int) -> int:
+	var doubled_amount := amount * 2
+	assert(doubled_amount >= 0, "negative amount")
+	return doubled_amount
+)";
+	const String path = TestUtils::get_temp_path("bytecode_cache_export.gd");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		f->store_string(source);
+	}
+	GDScriptLanguage::get_singleton()->init();
+
+	Vector<uint8_t> debug_cache;
+	Vector<uint8_t> release_cache;
+	REQUIRE(GDScriptBytecodeCache::serialize_for_export(path, source, true, 0, debug_cache) == OK);
+	REQUIRE(GDScriptBytecodeCache::serialize_for_export(path, source, false, 0, release_cache) == OK);
+
+	// The build kind follows the magic, the format version and the engine hash.
+	CHECK(debug_cache[12] == 1);
+	CHECK(release_cache[12] == 0);
+
+	// Debug bytecode keeps the locals for the debugger, and the assertion with its message.
+	CHECK(find_cache_string(debug_cache, "doubled_amount") >= 0);
+	CHECK(find_cache_string(release_cache, "doubled_amount") < 0);
+	CHECK(release_cache.size() < debug_cache.size());
+
+	// Only caches of the running kind of build are loaded.
+	Ref<GDScript> debug_script;
+	debug_script.instantiate();
+	Ref<GDScript> release_script;
+	release_script.instantiate();
+	if (GDScriptBytecodeCache::is_debug_build()) {
+		REQUIRE(GDScriptBytecodeCache::load(debug_script.ptr(), debug_cache) == OK);
+		CHECK(GDScriptBytecodeCache::load(release_script.ptr(), release_cache) == ERR_FILE_UNRECOGNIZED);
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(debug_script);
+		CHECK(int(object->call("value", 4)) == 8);
+	} else {
+		REQUIRE(GDScriptBytecodeCache::load(release_script.ptr(), release_cache) == OK);
+		CHECK(GDScriptBytecodeCache::load(debug_script.ptr(), debug_cache) == ERR_FILE_UNRECOGNIZED);
+	}
+
+	GDScriptCache::remove_script(path);
+}
+
+TEST_CASE_BENCHMARK("[Modules][GDScript][Benchmark] Startup from binary tokens and from bytecode cache") {
+	for (int script_count : { 10, 100, 500 }) {
+		LocalVector<Vector<uint8_t>> tokens;
+		LocalVector<Vector<uint8_t>> caches;
+		for (int i = 0; i < script_count; i++) {
+			tokens.push_back(GDScriptTokenizerBuffer::parse_code_string(make_benchmark_script(i, 20), GDScriptTokenizerBuffer::COMPRESS_NONE));
+			Ref<GDScript> compiled = compile_script(make_benchmark_script(i, 20));
+			Vector<uint8_t> cache;
+			REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), 0, cache) == OK);
+			caches.push_back(cache);
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (const Vector<uint8_t> &script_tokens : tokens) {
+			Ref<GDScript> script;
+			script.instantiate();
+			script->set_binary_tokens_source(script_tokens);
+			CHECK(script->reload() == OK);
+		}
+		uint64_t tokens_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (const Vector<uint8_t> &cache : caches) {
+			Ref<GDScript> script;
+			script.instantiate();
+			CHECK(GDScriptBytecodeCache::load(script.ptr(), cache) == OK);
+		}
+		uint64_t cache_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("GDScript: %d scripts, %.2f msec from binary tokens, %.2f msec from bytecode cache",
+				script_count, tokens_time / 1000.0, cache_time / 1000.0));
+	}
+}
+
+} // namespace TestGDScriptBytecodeCache
+
+#endif // TOOLS_ENABLED
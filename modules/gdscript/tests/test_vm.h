@@ -0,0 +1,333 @@
+/**************************************************************************/
+/*  test_vm.h                                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "modules/gdscript/gdscript.h"
+
+#include "core/config/project_settings.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGDScriptVM {
+
+static Ref<GDScript> make_script(const String &p_source) {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	script->reload();
+	ERR_PRINT_ON;
+	return script;
+}
+
+static Ref<RefCounted> make_instance(const Ref<GDScript> &p_script) {
+	Ref<RefCounted> instance;
+	instance.instantiate();
+	instance->set_script(p_script);
+	return instance;
+}
+
+const String DRIVER_SOURCE = R"(
+extends RefCounted
+
+func call_value(target):
+	return target.value()
+
+func read_amount(target):
+	return target.amount
+
+func read_x(target):
+	return target.x
+
+func read_name(target):
+	return target.resource_name
+)";
+
+TEST_CASE("[Modules][GDScript] Inline caches follow the receiver type") {
+	Ref<GDScript> driver_script = make_script(DRIVER_SOURCE);
+	REQUIRE(driver_script->is_valid());
+	Ref<RefCounted> driver = make_instance(driver_script);
+
+	Ref<GDScript> first_script = make_script("extends RefCounted\nvar amount = 10\nfunc value():\n\treturn 1\n");
+	Ref<GDScript> second_script = make_script("extends RefCounted\nvar amount: int:\n\tget:\n\t\treturn 20\nfunc value():\n\treturn 2\n");
+	REQUIRE(first_script->is_valid());
+	REQUIRE(second_script->is_valid());
+	Ref<RefCounted> first = make_instance(first_script);
+	Ref<RefCounted> second = make_instance(second_script);
+
+	// Alternate receivers, so every site becomes polymorphic.
+	for (int i = 0; i < 3; i++) {
+		CHECK(int(driver->call("call_value", first)) == 1);
+		CHECK(int(driver->call("call_value", second)) == 2);
+		CHECK(int(driver->call("read_amount", first)) == 10);
+		CHECK(int(driver->call("read_amount", second)) == 20);
+		CHECK(double(driver->call("read_x", Vector2(3, 4))) == 3.0);
+		CHECK(double(driver->call("read_x", Vector3(5, 6, 7))) == 5.0);
+	}
+
+	Dictionary dictionary;
+	dictionary["amount"] = 30;
+	CHECK(int(driver->call("read_amount", dictionary)) == 30);
+
+	Ref<Resource> resource;
+	resource.instantiate();
+	resource->set_name("cached");
+	CHECK(String(driver->call("read_name", resource)) == "cached");
+	resource->set_name("changed");
+	CHECK(String(driver->call("read_name", resource)) == "changed");
+
+	first->set("amount", 11);
+	CHECK(int(driver->call("read_amount", first)) == 11);
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches are invalidated when a script is reloaded") {
+	Ref<GDScript> driver_script = make_script(DRIVER_SOURCE);
+	Ref<RefCounted> driver = make_instance(driver_script);
+
+	Ref<GDScript> target_script = make_script("extends RefCounted\nvar amount = 1\nfunc value():\n\treturn 1\n");
+	{
+		Ref<RefCounted> target = make_instance(target_script);
+		CHECK(int(driver->call("call_value", target)) == 1);
+		CHECK(int(driver->call("read_amount", target)) == 1);
+	}
+
+	// The new source moves the member and replaces the function.
+	target_script->set_source_code("extends RefCounted\nvar padding = 0\nvar amount = 2\nfunc value():\n\treturn 2\n");
+	ERR_PRINT_OFF;
+	const Error error = target_script->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> target = make_instance(target_script);
+	CHECK(int(driver->call("call_value", target)) == 2);
+	CHECK(int(driver->call("read_amount", target)) == 2);
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches keep working after many invalidations") {
+	Ref<GDScript> driver_script = make_script(DRIVER_SOURCE);
+	Ref<RefCounted> driver = make_instance(driver_script);
+
+	Ref<GDScript> first_script = make_script("extends RefCounted\nvar amount = 10\nfunc value():\n\treturn 1\n");
+	Ref<GDScript> second_script = make_script("extends RefCounted\nvar amount = 20\nfunc value():\n\treturn 2\n");
+	Ref<RefCounted> first = make_instance(first_script);
+	Ref<RefCounted> second = make_instance(second_script);
+
+	// Each invalidation retires the states of the sites, until they fall back to the generic path.
+	bool values_match = true;
+	for (int i = 0; i < 100; i++) {
+		first_script->invalidate_inline_caches();
+		second_script->invalidate_inline_caches();
+		values_match = values_match && int(driver->call("call_value", first)) == 1;
+		values_match = values_match && int(driver->call("call_value", second)) == 2;
+		values_match = values_match && int(driver->call("read_amount", first)) == 10;
+		values_match = values_match && int(driver->call("read_amount", second)) == 20;
+	}
+	CHECK(values_match);
+}
+
+TEST_CASE("[Modules][GDScript] Megamorphic inline caches use the generic path") {
+	Ref<GDScript> driver_script = make_script(DRIVER_SOURCE);
+	Ref<RefCounted> driver = make_instance(driver_script);
+
+	// More receiver types than a cache holds.
+	LocalVector<Ref<GDScript>> scripts;
+	LocalVector<Ref<RefCounted>> targets;
+	for (int i = 0; i < 8; i++) {
+		scripts.push_back(make_script(vformat("extends RefCounted\nvar amount = %d\nfunc value():\n\treturn %d\n", i * 10, i)));
+		targets.push_back(make_instance(scripts[i]));
+	}
+
+	bool values_match = true;
+	for (int pass = 0; pass < 2; pass++) {
+		for (uint32_t i = 0; i < targets.size(); i++) {
+			values_match = values_match && int(driver->call("call_value", targets[i])) == int(i);
+			values_match = values_match && int(driver->call("read_amount", targets[i])) == int(i) * 10;
+		}
+	}
+	CHECK(values_match);
+
+	// Reloading one of the receivers doesn't affect the generic sites.
+	scripts[0]->set_source_code("extends RefCounted\nvar amount = 5\nfunc value():\n\treturn 50\n");
+	ERR_PRINT_OFF;
+	const Error error = scripts[0]->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+	Ref<RefCounted> reloaded = make_instance(scripts[0]);
+	CHECK(int(driver->call("call_value", reloaded)) == 50);
+	CHECK(int(driver->call("read_amount", reloaded)) == 5);
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Inline caches lock the receiver while calling it") {
+	Ref<GDScript> driver_script = make_script(DRIVER_SOURCE);
+	Ref<RefCounted> driver = make_instance(driver_script);
+
+	Ref<GDScript> target_script = make_script("extends Object\nfunc value():\n\tget_meta(\"self\").free()\n\treturn 1\n");
+	REQUIRE(target_script->is_valid());
+	Object *target = memnew(Object);
+	target->set_script(target_script);
+	target->set_meta("self", target);
+	const ObjectID target_id = target->get_instance_id();
+
+	// Freeing the receiver while one of its methods runs fails, like it does through `Object::callp()`.
+	ERR_PRINT_OFF;
+	driver->call("call_value", target);
+	ERR_PRINT_ON;
+	CHECK(ObjectDB::get_instance(target_id) == target);
+
+	memdelete(target);
+}
+#endif // DEBUG_ENABLED
+
+const String OPTIMIZER_SOURCE = R"(
+extends RefCounted
+
+var counter: int = 0
+var untyped_member = 0
+
+func ints(n: int) -> Array:
+	var total: int = 0
+	var i: int = 0
+	while i < n:
+		total += i * 3
+		if total > 100:
+			total -= 7
+		if i == 5:
+			total ^= 0xff
+		i += 1
+		counter += 2
+	for j: int in n:
+		total = total + j
+	var big: int = total + 5000000000
+	var masked: int = (total | 16) & 255
+	var untyped = n + 1
+	untyped = "text"
+	untyped = n * 2
+	untyped_member = 4 * n
+	return [total, big, masked, counter, untyped, untyped_member]
+
+func floats(x: float) -> Array:
+	var y: float = x * 2 + 1
+	y /= 4
+	var z: float = y - 1
+	var w: float = 1.5 * y
+	var negative_zero: float = y * -0.0
+	var nan := NAN
+	var comparisons := 0
+	if nan < 1.0:
+		comparisons += 1
+	if nan != nan:
+		comparisons += 2
+	if y >= z:
+		comparisons += 4
+	return [y, z, w, str(negative_zero), comparisons]
+)";
+
+TEST_CASE("[Modules][GDScript] Optimized bytecode behaves like unoptimized bytecode") {
+	const String setting = "debug/settings/gdscript/optimize_bytecode";
+	const Variant previous = ProjectSettings::get_singleton()->get_setting(setting);
+
+	ProjectSettings::get_singleton()->set_setting(setting, false);
+	Ref<GDScript> plain_script = make_script(OPTIMIZER_SOURCE);
+	ProjectSettings::get_singleton()->set_setting(setting, true);
+	Ref<GDScript> optimized_script = make_script(OPTIMIZER_SOURCE);
+	ProjectSettings::get_singleton()->set_setting(setting, previous);
+
+	REQUIRE(plain_script->is_valid());
+	REQUIRE(optimized_script->is_valid());
+	Ref<RefCounted> plain = make_instance(plain_script);
+	Ref<RefCounted> optimized = make_instance(optimized_script);
+
+	for (int n : { 0, 3, 12, 40 }) {
+		CHECK(optimized->call("ints", n) == plain->call("ints", n));
+		CHECK(optimized->call("floats", n * 0.75) == plain->call("floats", n * 0.75));
+	}
+
+	// Comparison results and the temporaries of folded operations no longer need stack slots.
+	const GDScriptFunction *plain_ints = plain_script->get_member_functions()["ints"];
+	const GDScriptFunction *optimized_ints = optimized_script->get_member_functions()["ints"];
+	CHECK(optimized_ints->get_max_stack_size() < plain_ints->get_max_stack_size());
+}
+
+// Each case runs one kind of instruction in a loop, so its throughput can be compared across changes to the VM.
+TEST_CASE_BENCHMARK("[Modules][GDScript][Benchmark] VM instruction throughput") {
+	Ref<GDScript> target_script = make_script(R"(
+extends RefCounted
+var amount = 1
+func value():
+	return 1
+)");
+	Ref<RefCounted> target = make_instance(target_script);
+	Ref<Resource> resource;
+	resource.instantiate();
+
+	struct BenchmarkCase {
+		const char *name;
+		const char *body;
+	};
+	const BenchmarkCase cases[] = {
+		{ "untyped operator", "total = total + 1" },
+		{ "typed operator", "typed_total += 1" },
+		{ "typed comparison and jump", "if typed_total < 10:\n\t\t\ttyped_total += 1" },
+		{ "call on script instance", "total = target.value()" },
+		{ "call on native object", "total = resource.get_name()" },
+		{ "get member of script instance", "total = target.amount" },
+		{ "get native property", "total = resource.resource_name" },
+		{ "get built-in member", "total = vector.x" },
+	};
+
+	const int iterations = 1000000;
+	for (const BenchmarkCase &benchmark_case : cases) {
+		Ref<GDScript> script = make_script(vformat(R"(
+extends RefCounted
+
+func run(target, resource, iterations):
+	var total = 0
+	var typed_total: int = 0
+	var vector = Vector2(1, 2)
+	for i in iterations:
+		%s
+	return total
+)",
+				benchmark_case.body));
+		REQUIRE(script->is_valid());
+		Ref<RefCounted> runner = make_instance(script);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		runner->call("run", target, resource, iterations);
+		uint64_t time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+		print_line(vformat("GDScript VM: %s, %.2f msec for %d iterations, %.1f M/s", benchmark_case.name, time / 1000.0, iterations, double(iterations) / time));
+	}
+}
+
+} // namespace TestGDScriptVM
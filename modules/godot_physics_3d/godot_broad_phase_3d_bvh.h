@@ -62,6 +62,9 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 		TREE_FLAG_DYNAMIC = 1 << TREE_DYNAMIC,
 	};
 
+	// Below this many moved objects per step, pairing on worker threads costs more than it saves.
+	static const uint32_t THREADED_PAIRING_THRESHOLD = 256;
+
 	BVH_Manager<GodotCollisionObject3D, 2, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
 
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
@@ -109,6 +109,9 @@ public:
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) override;
 	virtual real_t space_get_param(RID p_space, SpaceParameter p_param) const override;
 
+	// Time spent in each phase of the last step, in microseconds.
+	uint64_t space_get_elapsed_time(RID p_space, GodotSpace3D::ElapsedTime p_time) const;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) override;
 
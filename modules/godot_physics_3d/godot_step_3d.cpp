@@ -40,6 +40,7 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define ISLAND_THREADED_THRESHOLD 256
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,6 +113,267 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+bool GodotStep3D::_is_island_node(const IslandNode &p_node) const {
+	if (p_node.body) {
+		return p_node.body->get_island_step() == _step;
+	}
+	return p_node.soft_body->get_island_step() == _step;
+}
+
+uint32_t GodotStep3D::_get_island_node_index(const IslandNode &p_node) const {
+	if (p_node.body) {
+		return p_node.body->get_island_node();
+	}
+	return p_node.soft_body->get_island_node();
+}
+
+uint32_t GodotStep3D::_add_island_node(const IslandNode &p_node) {
+	uint32_t index = island_nodes.size();
+	island_nodes.push_back(p_node);
+
+	if (p_node.body) {
+		p_node.body->set_island_step(_step);
+		p_node.body->set_island_node(index);
+	} else {
+		p_node.soft_body->set_island_step(_step);
+		p_node.soft_body->set_island_node(index);
+	}
+
+	// These are never shrunk, so the claimed constraint lists keep their capacity between steps.
+	if (island_node_parents.size() < island_nodes.size()) {
+		island_node_parents.resize(island_nodes.size());
+		island_node_constraints.resize(island_nodes.size());
+		island_node_incomplete.resize(island_nodes.size());
+	}
+	island_node_parents[index].store(index, std::memory_order_relaxed);
+	island_node_constraints[index].clear();
+	island_node_incomplete[index] = false;
+
+	return index;
+}
+
+// Fills the non-static bodies and soft bodies linked by the constraint, except the node itself.
+int GodotStep3D::_get_island_node_neighbors(const IslandNode &p_node, GodotConstraint3D *p_constraint, IslandNode *r_neighbors) const {
+	int count = 0;
+
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		GodotBody3D *body = p_constraint->get_body_ptr()[i];
+		if (body == p_node.body) {
+			continue;
+		}
+		if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
+			continue; // Static bodies don't connect islands.
+		}
+		r_neighbors[count].body = body;
+		r_neighbors[count].soft_body = nullptr;
+		count++;
+	}
+
+	for (int i = 0; i < p_constraint->get_soft_body_count(); i++) {
+		GodotSoftBody3D *soft_body = p_constraint->get_soft_body_ptr(i);
+		if (soft_body == p_node.soft_body) {
+			continue;
+		}
+		r_neighbors[count].body = nullptr;
+		r_neighbors[count].soft_body = soft_body;
+		count++;
+	}
+
+	return count;
+}
+
+uint32_t GodotStep3D::_find_island_root(uint32_t p_node) {
+	// Parents always have a lower index than their children, so this can run concurrently with unions.
+	uint32_t node = p_node;
+	while (true) {
+		uint32_t parent = island_node_parents[node].load(std::memory_order_acquire);
+		if (parent == node) {
+			return node;
+		}
+		uint32_t grandparent = island_node_parents[parent].load(std::memory_order_acquire);
+		if (grandparent != parent) {
+			// Path halving, it's fine if another thread changed the parent in the meantime.
+			island_node_parents[node].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel);
+		}
+		node = grandparent;
+	}
+}
+
+void GodotStep3D::_union_island_nodes(uint32_t p_node_a, uint32_t p_node_b) {
+	while (true) {
+		uint32_t root_a = _find_island_root(p_node_a);
+		uint32_t root_b = _find_island_root(p_node_b);
+		if (root_a == root_b) {
+			return;
+		}
+
+		// Link the higher root below the lower one, so no cycle can be formed.
+		if (root_a < root_b) {
+			SWAP(root_a, root_b);
+		}
+		uint32_t expected = root_a;
+		if (island_node_parents[root_a].compare_exchange_strong(expected, root_b, std::memory_order_acq_rel)) {
+			return;
+		}
+		// Another thread linked this root first, try again from the new roots.
+	}
+}
+
+void GodotStep3D::_scan_island_node(uint32_t p_node, void *p_userdata) {
+	const IslandNode &node = island_nodes[p_node];
+
+	auto scan_constraint = [&](GodotConstraint3D *p_constraint) {
+		if (p_constraint->get_island_step() == _step) {
+			return; // Already in the island of a moving area.
+		}
+
+		IslandNode *neighbors = (IslandNode *)alloca(sizeof(IslandNode) * (p_constraint->get_body_count() + p_constraint->get_soft_body_count()));
+		int neighbor_count = _get_island_node_neighbors(node, p_constraint, neighbors);
+
+		// The linked node with the lowest index claims the constraint, so it ends up in a single island.
+		bool claim = true;
+		for (int i = 0; i < neighbor_count; i++) {
+			if (!_is_island_node(neighbors[i])) {
+				// Not active, it will be added to the graph after scanning.
+				island_node_incomplete[p_node] = true;
+			} else if (_get_island_node_index(neighbors[i]) < p_node) {
+				claim = false;
+			}
+		}
+
+		if (!claim) {
+			return;
+		}
+
+		island_node_constraints[p_node].push_back(p_constraint);
+		for (int i = 0; i < neighbor_count; i++) {
+			if (_is_island_node(neighbors[i])) {
+				_union_island_nodes(p_node, _get_island_node_index(neighbors[i]));
+			}
+		}
+	};
+
+	if (node.body) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : node.body->get_constraint_map()) {
+			scan_constraint(E.key);
+		}
+	} else {
+		for (GodotConstraint3D *E : node.soft_body->get_constraints()) {
+			scan_constraint(E);
+		}
+	}
+}
+
+void GodotStep3D::_expand_island_node(uint32_t p_node, bool p_claim) {
+	// Copied, since adding nodes can reallocate the node list.
+	const IslandNode node = island_nodes[p_node];
+
+	auto expand_constraint = [&](GodotConstraint3D *p_constraint) {
+		if (p_constraint->get_island_step() == _step) {
+			return; // Already in the island of a moving area.
+		}
+
+		IslandNode *neighbors = (IslandNode *)alloca(sizeof(IslandNode) * (p_constraint->get_body_count() + p_constraint->get_soft_body_count()));
+		int neighbor_count = _get_island_node_neighbors(node, p_constraint, neighbors);
+
+		// Nodes added here get a higher index than this one, so they don't change which node claims the constraint.
+		bool claim = p_claim;
+		for (int i = 0; i < neighbor_count; i++) {
+			if (!_is_island_node(neighbors[i])) {
+				_add_island_node(neighbors[i]);
+			}
+			uint32_t neighbor_index = _get_island_node_index(neighbors[i]);
+			if (neighbor_index < p_node) {
+				claim = false;
+			}
+			_union_island_nodes(p_node, neighbor_index);
+		}
+
+		if (claim) {
+			island_node_constraints[p_node].push_back(p_constraint);
+		}
+	};
+
+	if (node.body) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : node.body->get_constraint_map()) {
+			expand_constraint(E.key);
+		}
+	} else {
+		for (GodotConstraint3D *E : node.soft_body->get_constraints()) {
+			expand_constraint(E);
+		}
+	}
+}
+
+void GodotStep3D::_generate_islands_threaded(const SelfList<GodotBody3D>::List *p_body_list, const SelfList<GodotSoftBody3D>::List *p_soft_body_list, uint32_t &r_island_count, uint32_t &r_body_island_count) {
+	island_nodes.clear();
+
+	// All active objects are nodes, linked inactive bodies are added once they are found.
+	for (const SelfList<GodotBody3D> *b = p_body_list->first(); b; b = b->next()) {
+		_add_island_node({ b->self(), nullptr });
+	}
+	for (const SelfList<GodotSoftBody3D> *sb = p_soft_body_list->first(); sb; sb = sb->next()) {
+		_add_island_node({ nullptr, sb->self() });
+	}
+
+	// Join the nodes linked by constraints, this is where most of the time goes.
+	uint32_t scanned_count = island_nodes.size();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_scan_island_node, nullptr, scanned_count, -1, true, SNAME("Physics3DGenerateIslands"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Add the inactive bodies linked to the active ones, like the serial traversal does.
+	for (uint32_t i = 0; i < scanned_count; i++) {
+		if (island_node_incomplete[i]) {
+			_expand_island_node(i, false);
+		}
+	}
+	for (uint32_t i = scanned_count; i < island_nodes.size(); i++) {
+		_expand_island_node(i, true);
+	}
+
+	// Gather the islands in node order, so the result doesn't depend on thread timing.
+	uint32_t node_count = island_nodes.size();
+	island_root_body_island.resize(node_count);
+	island_root_constraint_island.resize(node_count);
+	for (uint32_t i = 0; i < node_count; i++) {
+		island_root_body_island[i] = -1;
+		island_root_constraint_island[i] = -1;
+	}
+
+	for (uint32_t i = 0; i < node_count; i++) {
+		uint32_t root = _find_island_root(i);
+		const IslandNode &node = island_nodes[i];
+
+		if (node.body && node.body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			// Only rigid bodies are tested for activation.
+			if (island_root_body_island[root] == -1) {
+				island_root_body_island[root] = r_body_island_count++;
+				if (body_islands.size() < r_body_island_count) {
+					body_islands.resize(r_body_island_count);
+				}
+				body_islands[r_body_island_count - 1].clear();
+				body_islands[r_body_island_count - 1].reserve(BODY_ISLAND_SIZE_RESERVE);
+			}
+			body_islands[island_root_body_island[root]].push_back(node.body);
+		}
+
+		for (GodotConstraint3D *constraint : island_node_constraints[i]) {
+			constraint->set_island_step(_step);
+			all_constraints.push_back(constraint);
+
+			if (island_root_constraint_island[root] == -1) {
+				island_root_constraint_island[root] = r_island_count++;
+				if (constraint_islands.size() < r_island_count) {
+					constraint_islands.resize(r_island_count);
+				}
+				constraint_islands[r_island_count - 1].clear();
+				constraint_islands[r_island_count - 1].reserve(ISLAND_SIZE_RESERVE);
+			}
+			constraint_islands[island_root_constraint_island[root]].push_back(constraint);
+		}
+	}
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -221,12 +483,20 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	p_space->set_active_objects(active_count);
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
+	/* BROADPHASE */
+
 	// Update the broadphase to register collision pairs.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -258,79 +528,85 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
-
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody3D *body = b->self();
+	if (active_count >= ISLAND_THREADED_THRESHOLD) {
+		/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE BODIES ON THREADS */
 
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+		_generate_islands_threaded(body_list, soft_body_list, island_count, body_island_count);
+	} else {
+		/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+		b = body_list->first();
 
-			_populate_island(body, body_island, constraint_island);
+		while (b) {
+			GodotBody3D *body = b->self();
 
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
+			if (body->get_island_step() != _step) {
+				++body_island_count;
+				if (body_islands.size() < body_island_count) {
+					body_islands.resize(body_island_count);
+				}
+				LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
+				body_island.clear();
+				body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
 
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		b = b->next();
-	}
-
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
+				++island_count;
+				if (constraint_islands.size() < island_count) {
+					constraint_islands.resize(island_count);
+				}
+				LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
+				constraint_island.clear();
+				constraint_island.reserve(ISLAND_SIZE_RESERVE);
 
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
+				_populate_island(body, body_island, constraint_island);
 
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+				if (body_island.is_empty()) {
+					--body_island_count;
+				}
 
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
+				if (constraint_island.is_empty()) {
+					--island_count;
+				}
 			}
+			b = b->next();
+		}
 
-			if (constraint_island.is_empty()) {
-				--island_count;
+		/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
+
+		sb = soft_body_list->first();
+		while (sb) {
+			GodotSoftBody3D *soft_body = sb->self();
+
+			if (soft_body->get_island_step() != _step) {
+				++body_island_count;
+				if (body_islands.size() < body_island_count) {
+					body_islands.resize(body_island_count);
+				}
+				LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
+				body_island.clear();
+				body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+
+				++island_count;
+				if (constraint_islands.size() < island_count) {
+					constraint_islands.resize(island_count);
+				}
+				LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
+				constraint_island.clear();
+				constraint_island.reserve(ISLAND_SIZE_RESERVE);
+
+				_populate_island_soft_body(soft_body, body_island, constraint_island);
+
+				if (body_island.is_empty()) {
+					--body_island_count;
+				}
+
+				if (constraint_island.is_empty()) {
+					--island_count;
+				}
 			}
+			sb = sb->next();
 		}
-		sb = sb->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -44,8 +44,31 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	// Graph used to build islands on worker threads with a union-find,
+	// when there are too many active bodies for the serial traversal.
+	struct IslandNode {
+		GodotBody3D *body = nullptr;
+		GodotSoftBody3D *soft_body = nullptr;
+	};
+
+	LocalVector<IslandNode> island_nodes;
+	LocalVector<std::atomic<uint32_t>> island_node_parents;
+	LocalVector<LocalVector<GodotConstraint3D *>> island_node_constraints; // Constraints claimed by each node.
+	LocalVector<uint8_t> island_node_incomplete; // Whether some neighbors weren't nodes yet when scanned.
+	LocalVector<int32_t> island_root_body_island;
+	LocalVector<int32_t> island_root_constraint_island;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _generate_islands_threaded(const SelfList<GodotBody3D>::List *p_body_list, const SelfList<GodotSoftBody3D>::List *p_soft_body_list, uint32_t &r_island_count, uint32_t &r_body_island_count);
+	uint32_t _add_island_node(const IslandNode &p_node);
+	_FORCE_INLINE_ bool _is_island_node(const IslandNode &p_node) const;
+	_FORCE_INLINE_ uint32_t _get_island_node_index(const IslandNode &p_node) const;
+	int _get_island_node_neighbors(const IslandNode &p_node, GodotConstraint3D *p_constraint, IslandNode *r_neighbors) const;
+	uint32_t _find_island_root(uint32_t p_node);
+	void _union_island_nodes(uint32_t p_node_a, uint32_t p_node_b);
+	void _scan_island_node(uint32_t p_node, void *p_userdata = nullptr);
+	void _expand_island_node(uint32_t p_node, bool p_claim);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  test_godot_physics_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysics3D {
+
+class BoxScene {
+public:
+	GodotPhysicsServer3D *server = nullptr;
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	RID floor;
+	LocalVector<RID> boxes;
+
+	// Columns of boxes stacked on a static floor, every column is an island of its own.
+	BoxScene(int p_columns_per_side, int p_column_height) {
+		server = memnew(GodotPhysicsServer3D(false));
+		server->init();
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+
+		floor_shape = server->box_shape_create();
+		server->shape_set_data(floor_shape, Vector3(500, 0.5, 500));
+		box_shape = server->box_shape_create();
+		server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+		floor = server->body_create();
+		server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(floor, floor_shape);
+		server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+		server->body_set_space(floor, space);
+
+		for (int x = 0; x < p_columns_per_side; x++) {
+			for (int z = 0; z < p_columns_per_side; z++) {
+				for (int y = 0; y < p_column_height; y++) {
+					RID box = server->body_create();
+					server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+					server->body_add_shape(box, box_shape);
+					server->body_set_state(box, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+					server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 3.0, 0.5 + y, z * 3.0)));
+					server->body_set_space(box, space);
+					boxes.push_back(box);
+				}
+			}
+		}
+	}
+
+	void step() {
+		server->step(1.0 / 60.0);
+		server->sync();
+		server->flush_queries();
+		server->end_sync();
+	}
+
+	~BoxScene() {
+		for (const RID &box : boxes) {
+			server->free_rid(box);
+		}
+		server->free_rid(floor);
+		server->free_rid(box_shape);
+		server->free_rid(floor_shape);
+		server->free_rid(space);
+		server->finish();
+		memdelete(server);
+	}
+};
+
+static void check_box_scene(int p_columns_per_side, int p_column_height) {
+	BoxScene scene(p_columns_per_side, p_column_height);
+	for (int i = 0; i < 30; i++) {
+		scene.step();
+	}
+
+	CHECK_MESSAGE(
+			scene.server->get_process_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == (int)scene.boxes.size(),
+			"All boxes should still be active.");
+	CHECK_MESSAGE(
+			scene.server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT) == p_columns_per_side * p_columns_per_side,
+			"Each column of boxes should form a single island.");
+
+	bool resting = true;
+	for (const RID &box : scene.boxes) {
+		Transform3D transform = scene.server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		if (transform.origin.y < 0.4 || transform.origin.y > p_column_height) {
+			resting = false;
+		}
+	}
+	CHECK_MESSAGE(resting, "The boxes should rest on the floor or on each other.");
+}
+
+TEST_CASE("[Physics][GodotPhysics3D] Islands of a few bodies") {
+	// Below the body count at which islands are generated on threads.
+	check_box_scene(5, 2);
+}
+
+TEST_CASE("[Physics][GodotPhysics3D] Islands of many bodies") {
+	// Enough active bodies for islands and broadphase pairs to be generated on threads.
+	check_box_scene(16, 2);
+}
+
+TEST_CASE_BENCHMARK("[Physics][GodotPhysics3D][Benchmark] Step time per phase") {
+	const int step_count = 120;
+	const char *phase_names[GodotSpace3D::ELAPSED_TIME_MAX] = {
+		"integrate_forces",
+		"broadphase",
+		"generate_islands",
+		"setup_constraints",
+		"solve_constraints",
+		"integrate_velocities",
+	};
+
+	for (int columns_per_side : { 8, 16, 32, 64 }) {
+		BoxScene scene(columns_per_side, 4);
+		uint64_t phase_times[GodotSpace3D::ELAPSED_TIME_MAX] = {};
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < step_count; i++) {
+			scene.step();
+			for (int j = 0; j < GodotSpace3D::ELAPSED_TIME_MAX; j++) {
+				phase_times[j] += scene.server->space_get_elapsed_time(scene.space, GodotSpace3D::ElapsedTime(j));
+			}
+		}
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("GodotPhysics3D: %d bodies, %.1f usec per step", scene.boxes.size(), double(elapsed) / step_count));
+		for (int j = 0; j < GodotSpace3D::ELAPSED_TIME_MAX; j++) {
+			print_line(vformat("    %s: %.1f usec", phase_names[j], double(phase_times[j]) / step_count));
+		}
+	}
+}
+
+} // namespace TestGodotPhysics3D
@@ -34,6 +34,7 @@
 
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "scene/main/node.h"
 
@@ -141,15 +142,31 @@ void SceneReplicationInterface::on_network_process() {
 
 	// Process syncs.
 	uint64_t usec = OS::get_singleton()->get_ticks_usec();
-	for (KeyValue<int, PeerInfo> &E : peers_info) {
-		const HashSet<ObjectID> to_sync = E.value.sync_nodes;
-		if (to_sync.is_empty()) {
-			continue; // Nothing to sync
+	_collect_sync_states(usec);
+	if (peer_packet_count == 0) {
+		return; // Nothing to sync.
+	}
+
+	// Each state is encoded once, no matter how many peers receive it.
+	if (encoded_state_count >= THREADED_ENCODE_THRESHOLD) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneReplicationInterface::_encode_state, nullptr, encoded_state_count, -1, true, SNAME("SceneReplicationEncode"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < encoded_state_count; i++) {
+			_encode_state(i);
+		}
+	}
+
+	if (peer_packet_count >= THREADED_ASSEMBLY_THRESHOLD) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneReplicationInterface::_assemble_peer_packets, nullptr, peer_packet_count, -1, true, SNAME("SceneReplicationAssemble"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < peer_packet_count; i++) {
+			_assemble_peer_packets(i);
 		}
-		uint16_t sync_net_time = ++E.value.last_sent_sync;
-		_send_sync(E.key, to_sync, sync_net_time, usec);
-		_send_delta(E.key, to_sync, usec, E.value.last_watch_usecs);
 	}
+
+	_send_sync_states(usec);
 }
 
 Error SceneReplicationInterface::on_spawn(Object *p_obj, Variant p_config) {
@@ -706,63 +723,6 @@ MultiplayerSynchronizer *SceneReplicationInterface::_find_synchronizer(int p_pee
 	return sync;
 }
 
-void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs) {
-	MAKE_ROOM(/* header */ 1 + /* element */ 4 + 8 + 4 + delta_mtu);
-	uint8_t *ptr = packet_cache.ptrw();
-	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT);
-	int ofs = 1;
-	for (const ObjectID &oid : p_synchronizers) {
-		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
-		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
-		uint32_t net_id;
-		if (!_verify_synchronizer(p_peer, sync, net_id)) {
-			continue;
-		}
-		uint64_t last_usec = p_last_watch_usecs.has(oid) ? p_last_watch_usecs[oid] : 0;
-		uint64_t indexes;
-		List<Variant> delta = sync->get_delta_state(p_usec, last_usec, indexes);
-
-		if (!delta.size()) {
-			continue; // Nothing to update.
-		}
-
-		Vector<const Variant *> varp;
-		varp.resize(delta.size());
-		const Variant **vptr = varp.ptrw();
-		int i = 0;
-		for (const Variant &v : delta) {
-			vptr[i] = &v;
-			i++;
-		}
-		int size;
-		Error err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
-
-		ERR_CONTINUE_MSG(size > delta_mtu, vformat("Synchronizer delta bigger than MTU will not be sent (%d > %d): %s", size, delta_mtu, sync->get_path()));
-
-		if (ofs + 4 + 8 + 4 + size > delta_mtu) {
-			// Send what we got, and reset write.
-			_send_raw(packet_cache.ptr(), ofs, p_peer, true);
-			ofs = 1;
-		}
-		if (size) {
-			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
-			ofs += encode_uint64(indexes, &ptr[ofs]);
-			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
-			ofs += size;
-		}
-#ifdef DEBUG_ENABLED
-		_profile_node_data("delta_out", oid, size);
-#endif
-		peers_info[p_peer].last_watch_usecs[oid] = p_usec;
-	}
-	if (ofs > 1) {
-		// Got some left over to send.
-		_send_raw(packet_cache.ptr(), ofs, p_peer, true);
-	}
-}
-
 Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
 	int ofs = 1;
 	while (ofs + 4 + 8 + 4 < p_buffer_len) {
@@ -798,56 +758,251 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 	return OK;
 }
 
-void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
-	MAKE_ROOM(/* header */ 3 + /* element */ 4 + 4 + sync_mtu);
-	uint8_t *ptr = packet_cache.ptrw();
-	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
-	int ofs = 1;
-	ofs += encode_uint16(p_sync_net_time, &ptr[1]);
-	// Can only send updates for already notified nodes.
-	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
-	for (const ObjectID &oid : p_synchronizers) {
-		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
-		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
-		if (!sync->update_outbound_sync_time(p_usec)) {
-			continue; // nothing to sync.
+uint32_t SceneReplicationInterface::_add_encoded_state(MultiplayerSynchronizer *p_sync) {
+	const uint32_t index = encoded_state_count++;
+	if (index == encoded_states.size()) {
+		encoded_states.push_back(EncodedState());
+	}
+
+	// Reset everything but the capacity of the encoded data.
+	EncodedState &state = encoded_states[index];
+	state.sync = p_sync->get_instance_id();
+	state.net_id = p_sync->get_net_id();
+	state.indexes = 0;
+	state.last_usec = 0;
+	state.next_delta = UINT32_MAX;
+	state.delta = false;
+	state.valid = false;
+	state.oversized = false;
+	state.size = 0;
+	state.vars.clear();
+	state.data.clear();
+	return index;
+}
+
+uint32_t SceneReplicationInterface::_get_sync_state(MultiplayerSynchronizer *p_sync) {
+	const ObjectID oid = p_sync->get_instance_id();
+	const uint32_t *existing = frame_sync_states.getptr(oid);
+	if (existing) {
+		return *existing;
+	}
+
+	const uint32_t index = _add_encoded_state(p_sync);
+	frame_sync_states.insert(oid, index);
+	EncodedState &state = encoded_states[index];
+
+	Node *node = p_sync->get_root_node();
+	ERR_FAIL_NULL_V(node, index);
+	Vector<const Variant *> varp;
+	const List<NodePath> props = p_sync->get_replication_config_ptr()->get_sync_properties();
+	Error err = MultiplayerSynchronizer::get_state(props, node, state.vars, varp);
+	ERR_FAIL_COND_V_MSG(err != OK, index, "Unable to retrieve sync state.");
+	state.valid = true;
+	return index;
+}
+
+uint32_t SceneReplicationInterface::_get_delta_state(MultiplayerSynchronizer *p_sync, uint64_t p_usec, uint64_t p_last_usec) {
+	// Peers that were last sent this synchronizer's changes at the same time get the same delta.
+	const ObjectID oid = p_sync->get_instance_id();
+	uint32_t *first = frame_delta_states.getptr(oid);
+	uint32_t index = first ? *first : UINT32_MAX;
+	while (index != UINT32_MAX) {
+		if (encoded_states[index].last_usec == p_last_usec) {
+			return index;
 		}
+		index = encoded_states[index].next_delta;
+	}
 
-		Node *node = sync->get_root_node();
-		ERR_CONTINUE(!node);
-		uint32_t net_id = sync->get_net_id();
-		if (!_verify_synchronizer(p_peer, sync, net_id)) {
-			// The path based sync is not yet confirmed, skipping.
+	index = _add_encoded_state(p_sync);
+	EncodedState &state = encoded_states[index];
+	state.delta = true;
+	state.last_usec = p_last_usec;
+	if (first) {
+		state.next_delta = *first;
+		*first = index;
+	} else {
+		frame_delta_states.insert(oid, index);
+	}
+
+	List<Variant> delta = p_sync->get_delta_state(p_usec, p_last_usec, state.indexes);
+	if (delta.is_empty()) {
+		return index; // Nothing to update.
+	}
+	state.vars.resize(delta.size());
+	Variant *vars = state.vars.ptrw();
+	for (const Variant &v : delta) {
+		*(vars++) = v;
+	}
+	state.valid = true;
+	return index;
+}
+
+void SceneReplicationInterface::_collect_sync_states(uint64_t p_usec) {
+	encoded_state_count = 0;
+	frame_sync_states.clear();
+	frame_delta_states.clear();
+	peer_packet_count = 0;
+
+	// Reading the states and verifying the synchronizers touches the scene and the cache, so it stays on this thread.
+	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		const HashSet<ObjectID> &to_sync = E.value.sync_nodes;
+		if (to_sync.is_empty()) {
+			continue; // Nothing to sync
+		}
+
+		if (peer_packet_count == peer_packets.size()) {
+			peer_packets.push_back(PeerPackets());
+		}
+		PeerPackets &packets = peer_packets[peer_packet_count++];
+		packets.peer = E.key;
+		packets.sync_net_time = ++E.value.last_sent_sync;
+		packets.sync_states.clear();
+		packets.delta_states.clear();
+
+		for (const ObjectID &oid : to_sync) {
+			MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
+			ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
+			uint32_t net_id;
+			if (!_verify_synchronizer(E.key, sync, net_id)) {
+				// The path based sync is not yet confirmed, skipping.
+				continue;
+			}
+			if (sync->update_outbound_sync_time(p_usec)) {
+				packets.sync_states.push_back(_get_sync_state(sync));
+			}
+			const uint64_t *last_usec = E.value.last_watch_usecs.getptr(oid);
+			packets.delta_states.push_back(_get_delta_state(sync, p_usec, last_usec ? *last_usec : 0));
+		}
+	}
+}
+
+void SceneReplicationInterface::_encode_state(uint32_t p_index, void *p_userdata) {
+	EncodedState &state = encoded_states[p_index];
+	if (!state.valid) {
+		return;
+	}
+
+	Vector<const Variant *> varp;
+	varp.resize(state.vars.size());
+	const Variant **vptr = varp.ptrw();
+	for (int i = 0; i < state.vars.size(); i++) {
+		vptr[i] = &state.vars[i];
+	}
+
+	Error err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, state.size);
+	if (err != OK) {
+		state.valid = false;
+		ERR_FAIL_MSG(state.delta ? "Unable to encode delta state." : "Unable to encode sync state.");
+	}
+	// TODO Handle single state above MTU.
+	if (state.size > (state.delta ? delta_mtu : sync_mtu)) {
+		// The node path can't be safely read from here.
+		state.valid = false;
+		state.oversized = true;
+		return;
+	}
+	state.data.resize(state.size);
+	MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), state.data.ptr(), state.size);
+}
+
+void SceneReplicationInterface::_append_states(PeerPackets &r_peer, const LocalVector<uint32_t> &p_states, const uint8_t *p_header, uint32_t p_header_size, uint32_t p_mtu, bool p_reliable) {
+	uint32_t start = r_peer.buffer.size();
+	r_peer.buffer.resize(start + p_header_size);
+	memcpy(r_peer.buffer.ptr() + start, p_header, p_header_size);
+
+	for (uint32_t index : p_states) {
+		const EncodedState &state = encoded_states[index];
+		if (!state.valid || state.data.is_empty()) {
 			continue;
 		}
-		int size;
-		Vector<Variant> vars;
-		Vector<const Variant *> varp;
-		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
-		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
-		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
-		// TODO Handle single state above MTU.
-		ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
-		if (ofs + 4 + 4 + size > sync_mtu) {
+		const uint32_t size = state.data.size();
+		const uint32_t element_size = 4 + (state.delta ? 8 : 0) + 4 + size;
+		uint32_t ofs = r_peer.buffer.size();
+		if (ofs - start + element_size > p_mtu && ofs - start > p_header_size) {
 			// Send what we got, and reset write.
-			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
-			ofs = 3;
+			r_peer.packets.push_back({ start, ofs - start, p_reliable });
+			start = ofs;
+			ofs += p_header_size;
+			r_peer.buffer.resize(ofs);
+			memcpy(r_peer.buffer.ptr() + start, p_header, p_header_size);
 		}
-		if (size) {
-			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
-			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
-			ofs += size;
+		r_peer.buffer.resize(ofs + element_size);
+		uint8_t *ptr = r_peer.buffer.ptr() + ofs;
+		ptr += encode_uint32(state.net_id, ptr);
+		if (state.delta) {
+			ptr += encode_uint64(state.indexes, ptr);
 		}
-#ifdef DEBUG_ENABLED
-		_profile_node_data("sync_out", oid, size);
-#endif
+		ptr += encode_uint32(size, ptr);
+		memcpy(ptr, state.data.ptr(), size);
 	}
-	if (ofs > 3) {
+
+	if (r_peer.buffer.size() - start > p_header_size) {
 		// Got some left over to send.
-		_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+		r_peer.packets.push_back({ start, r_peer.buffer.size() - start, p_reliable });
+	} else {
+		r_peer.buffer.resize(start);
+	}
+}
+
+void SceneReplicationInterface::_assemble_peer_packets(uint32_t p_index, void *p_userdata) {
+	PeerPackets &peer = peer_packets[p_index];
+	peer.buffer.clear();
+	peer.packets.clear();
+
+	uint8_t sync_header[3];
+	sync_header[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
+	encode_uint16(peer.sync_net_time, &sync_header[1]);
+	_append_states(peer, peer.sync_states, sync_header, 3, sync_mtu, false);
+
+	const uint8_t delta_header = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT);
+	_append_states(peer, peer.delta_states, &delta_header, 1, delta_mtu, true);
+}
+
+void SceneReplicationInterface::_send_sync_states(uint64_t p_usec) {
+	for (uint32_t i = 0; i < encoded_state_count; i++) {
+		const EncodedState &state = encoded_states[i];
+		if (!state.oversized) {
+			continue;
+		}
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(state.sync);
+		ERR_CONTINUE(!sync);
+		if (state.delta) {
+			ERR_PRINT(vformat("Synchronizer delta bigger than MTU will not be sent (%d > %d): %s", state.size, delta_mtu, sync->get_path()));
+		} else {
+			ERR_PRINT(vformat("Node states bigger than MTU will not be sent (%d > %d): %s", state.size, sync_mtu, sync->get_root_node() ? sync->get_root_node()->get_path() : sync->get_path()));
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	const bool profiling = EngineDebugger::is_profiling("multiplayer:replication");
+#endif
+	for (uint32_t i = 0; i < peer_packet_count; i++) {
+		const PeerPackets &peer = peer_packets[i];
+		for (const PeerPackets::Packet &packet : peer.packets) {
+			_send_raw(peer.buffer.ptr() + packet.offset, packet.size, peer.peer, packet.reliable);
+		}
+
+		PeerInfo *info = peers_info.getptr(peer.peer);
+		ERR_CONTINUE(!info);
+		for (uint32_t index : peer.delta_states) {
+			const EncodedState &state = encoded_states[index];
+			if (state.valid) {
+				info->last_watch_usecs[state.sync] = p_usec;
+			}
+		}
+
+#ifdef DEBUG_ENABLED
+		if (profiling) {
+			for (uint32_t index : peer.sync_states) {
+				_profile_node_data("sync_out", encoded_states[index].sync, encoded_states[index].size);
+			}
+			for (uint32_t index : peer.delta_states) {
+				if (encoded_states[index].valid) {
+					_profile_node_data("delta_out", encoded_states[index].sync, encoded_states[index].size);
+				}
+			}
+		}
+#endif
 	}
 }
 
@@ -34,6 +34,7 @@
 #include "multiplayer_synchronizer.h"
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_set.h"
 
 class SceneMultiplayer;
@@ -69,6 +70,36 @@ private:
 		uint16_t last_sent_sync = 0;
 	};
 
+	// A synchronizer state (or delta) encoded once per network frame, then copied into the packets of every peer that receives it.
+	struct EncodedState {
+		ObjectID sync;
+		uint32_t net_id = 0;
+		uint64_t indexes = 0; // Delta only, the properties that changed.
+		uint64_t last_usec = 0; // Delta only, peers that were last sent the same watch time share the same delta.
+		uint32_t next_delta = UINT32_MAX; // Delta only, the same synchronizer with a different watch time.
+		bool delta = false;
+		bool valid = false;
+		bool oversized = false; // Bigger than the MTU, reported when sending.
+		int size = 0;
+		Vector<Variant> vars;
+		LocalVector<uint8_t> data;
+	};
+
+	struct PeerPackets {
+		struct Packet {
+			uint32_t offset = 0;
+			uint32_t size = 0;
+			bool reliable = false;
+		};
+
+		int peer = 0;
+		uint16_t sync_net_time = 0;
+		LocalVector<uint32_t> sync_states;
+		LocalVector<uint32_t> delta_states;
+		LocalVector<uint8_t> buffer;
+		LocalVector<Packet> packets;
+	};
+
 	// Replication state.
 	HashMap<int, PeerInfo> peers_info;
 	uint32_t last_net_id = 0;
@@ -93,6 +124,19 @@ private:
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
 	int delta_mtu = 65535;
 
+	// Per frame sync state, kept around to reuse the allocations.
+	// Only the first encoded_state_count states belong to the current frame, the others keep their buffers for later frames.
+	LocalVector<EncodedState> encoded_states;
+	uint32_t encoded_state_count = 0;
+	HashMap<ObjectID, uint32_t> frame_sync_states;
+	HashMap<ObjectID, uint32_t> frame_delta_states;
+	LocalVector<PeerPackets> peer_packets;
+	uint32_t peer_packet_count = 0;
+
+	// Below these counts, states are encoded and packets assembled on the calling thread.
+	static constexpr uint32_t THREADED_ENCODE_THRESHOLD = 64;
+	static constexpr uint32_t THREADED_ASSEMBLY_THRESHOLD = 4;
+
 	TrackedNode &_track(const ObjectID &p_id);
 	void _untrack(const ObjectID &p_id);
 	void _node_ready(const ObjectID &p_oid);
@@ -101,8 +145,14 @@ private:
 	bool _verify_synchronizer(int p_peer, MultiplayerSynchronizer *p_sync, uint32_t &r_net_id);
 	MultiplayerSynchronizer *_find_synchronizer(int p_peer, uint32_t p_net_ida);
 
-	void _send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
-	void _send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
+	uint32_t _add_encoded_state(MultiplayerSynchronizer *p_sync);
+	uint32_t _get_sync_state(MultiplayerSynchronizer *p_sync);
+	uint32_t _get_delta_state(MultiplayerSynchronizer *p_sync, uint64_t p_usec, uint64_t p_last_usec);
+	void _collect_sync_states(uint64_t p_usec);
+	void _encode_state(uint32_t p_index, void *p_userdata = nullptr);
+	void _assemble_peer_packets(uint32_t p_index, void *p_userdata = nullptr);
+	void _append_states(PeerPackets &r_peer, const LocalVector<uint32_t> &p_states, const uint8_t *p_header, uint32_t p_header_size, uint32_t p_mtu, bool p_reliable);
+	void _send_sync_states(uint64_t p_usec);
 	Error _make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len);
 	Error _make_despawn_packet(Node *p_node, int &r_len);
 	Error _send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable);
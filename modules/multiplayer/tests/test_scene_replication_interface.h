@@ -0,0 +1,270 @@
+/**************************************************************************/
+/*  test_scene_replication_interface.h                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+#include "../multiplayer_synchronizer.h"
+#include "../scene_multiplayer.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
+
+namespace TestSceneReplicationInterface {
+
+// Server side of an in-process network. Paths sent to peers are confirmed right away, sync packets are recorded.
+class LoopbackMultiplayerPeer : public MultiplayerPeer {
+	GDCLASS(LoopbackMultiplayerPeer, MultiplayerPeer);
+
+	struct Packet {
+		int peer = 0;
+		Vector<uint8_t> data;
+	};
+
+	int target_peer = 0;
+	List<Packet> incoming;
+	Packet current;
+
+public:
+	struct PeerSyncs {
+		HashMap<uint32_t, Vector<uint8_t>> states;
+		int state_count = 0;
+		int delta_count = 0;
+	};
+
+	HashMap<int, PeerSyncs> syncs;
+	int sync_packet_count = 0;
+	int max_sync_packet_size = 0;
+	uint64_t sync_bytes = 0;
+
+	void connect_peer(int p_peer) {
+		emit_signal(SNAME("peer_connected"), p_peer);
+	}
+
+	void clear_syncs() {
+		syncs.clear();
+		sync_packet_count = 0;
+		max_sync_packet_size = 0;
+		sync_bytes = 0;
+	}
+
+	virtual void set_target_peer(int p_peer_id) override { target_peer = p_peer_id; }
+	virtual int get_packet_peer() const override { return incoming.is_empty() ? 0 : incoming.front()->get().peer; }
+	virtual TransferMode get_packet_mode() const override { return TRANSFER_MODE_RELIABLE; }
+	virtual int get_packet_channel() const override { return 0; }
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override {}
+	virtual bool is_server() const override { return true; }
+	virtual void poll() override {}
+	virtual void close() override {}
+	virtual int get_unique_id() const override { return TARGET_PEER_SERVER; }
+	virtual ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+	virtual int get_available_packet_count() const override { return incoming.size(); }
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(incoming.is_empty(), ERR_UNAVAILABLE);
+		current = incoming.front()->get();
+		incoming.pop_front();
+		*r_buffer = current.data.ptr();
+		r_buffer_size = current.data.size();
+		return OK;
+	}
+
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		const int command = p_buffer[0] & SceneMultiplayer::CMD_MASK;
+		if (command == SceneMultiplayer::NETWORK_COMMAND_SIMPLIFY_PATH) {
+			// Command, methods checksum written with `encode_cstring()`, then the cache ID.
+			int ofs = 1;
+			ofs += strlen(reinterpret_cast<const char *>(&p_buffer[ofs])) + 1;
+			const uint32_t cache_id = decode_uint32(&p_buffer[ofs]);
+
+			Packet confirm;
+			confirm.peer = target_peer;
+			confirm.data.resize(6);
+			confirm.data.write[0] = SceneMultiplayer::NETWORK_COMMAND_CONFIRM_PATH;
+			confirm.data.write[1] = 1;
+			encode_uint32(cache_id, &confirm.data.write[2]);
+			incoming.push_back(confirm);
+		} else if (command == SceneMultiplayer::NETWORK_COMMAND_SYNC) {
+			sync_packet_count++;
+			sync_bytes += p_buffer_size;
+			max_sync_packet_size = MAX(max_sync_packet_size, p_buffer_size);
+			PeerSyncs &peer_syncs = syncs[target_peer];
+			const bool is_delta = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT)) != 0;
+			int ofs = is_delta ? 1 : 3;
+			while (ofs < p_buffer_size) {
+				const uint32_t net_id = decode_uint32(&p_buffer[ofs]);
+				ofs += is_delta ? 4 + 8 : 4;
+				const uint32_t size = decode_uint32(&p_buffer[ofs]);
+				ofs += 4;
+				if (is_delta) {
+					peer_syncs.delta_count++;
+				} else {
+					Vector<uint8_t> state;
+					state.resize(size);
+					memcpy(state.ptrw(), &p_buffer[ofs], size);
+					peer_syncs.states[net_id] = state;
+					peer_syncs.state_count++;
+				}
+				ofs += size;
+			}
+		}
+		return OK;
+	}
+};
+
+// Server with synchronized nodes and connected loopback peers.
+class ReplicationScene {
+public:
+	Ref<SceneMultiplayer> multiplayer;
+	Ref<LoopbackMultiplayerPeer> peer;
+	Node *root = nullptr;
+	LocalVector<Node2D *> nodes;
+
+	ReplicationScene(int p_peer_count, int p_node_count) {
+		root = memnew(Node);
+		root->set_name("Replication");
+		SceneTree::get_singleton()->get_root()->add_child(root);
+
+		multiplayer.instantiate();
+		SceneTree::get_singleton()->set_multiplayer(multiplayer, root->get_path());
+		peer.instantiate();
+		multiplayer->set_multiplayer_peer(peer);
+
+		Ref<SceneReplicationConfig> config;
+		config.instantiate();
+		config->add_property(NodePath(":position"));
+		config->add_property(NodePath(":rotation"));
+		config->property_set_replication_mode(NodePath(":rotation"), SceneReplicationConfig::REPLICATION_MODE_ON_CHANGE);
+
+		for (int i = 0; i < p_node_count; i++) {
+			Node2D *node = memnew(Node2D);
+			node->set_name(vformat("Node%d", i));
+			node->set_position(Vector2(i, -i));
+			MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+			sync->set_replication_config(config);
+			node->add_child(sync);
+			root->add_child(node);
+			nodes.push_back(node);
+		}
+
+		for (int i = 0; i < p_peer_count; i++) {
+			peer->connect_peer(i + 2);
+		}
+		// Send the synchronizer paths, they are confirmed on the next poll.
+		multiplayer->poll();
+	}
+
+	~ReplicationScene() {
+		memdelete(root);
+		SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), NodePath("/root/Replication"));
+	}
+};
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface][SceneTree] Shared sync states and deltas") {
+	// Enough nodes and peers to encode and assemble on threads.
+	const int peer_count = 8;
+	const int node_count = 200;
+	ReplicationScene scene(peer_count, node_count);
+	Ref<LoopbackMultiplayerPeer> peer = scene.peer;
+
+	scene.multiplayer->poll();
+	REQUIRE(peer->syncs.size() == peer_count);
+	const LoopbackMultiplayerPeer::PeerSyncs &first = peer->syncs[2];
+	CHECK(first.state_count == node_count);
+	CHECK(first.delta_count == node_count);
+	for (const KeyValue<int, LoopbackMultiplayerPeer::PeerSyncs> &E : peer->syncs) {
+		CHECK(E.value.state_count == node_count);
+		CHECK(E.value.states.size() == node_count);
+		// Every peer gets the same encoded states.
+		for (const KeyValue<uint32_t, Vector<uint8_t>> &state : E.value.states) {
+			REQUIRE(first.states.has(state.key));
+			CHECK(first.states[state.key] == state.value);
+		}
+	}
+	CHECK(peer->max_sync_packet_size <= 65535);
+
+	SUBCASE("Unchanged properties are not sent again") {
+		peer->clear_syncs();
+		scene.multiplayer->poll();
+		for (const KeyValue<int, LoopbackMultiplayerPeer::PeerSyncs> &E : peer->syncs) {
+			CHECK(E.value.state_count == node_count);
+			CHECK(E.value.delta_count == 0);
+		}
+	}
+
+	SUBCASE("Changed properties are sent to every peer") {
+		scene.nodes[3]->set_rotation(1.0);
+		scene.nodes[7]->set_rotation(2.0);
+		peer->clear_syncs();
+		scene.multiplayer->poll();
+		for (const KeyValue<int, LoopbackMultiplayerPeer::PeerSyncs> &E : peer->syncs) {
+			CHECK(E.value.delta_count == 2);
+		}
+	}
+
+	SUBCASE("Sync packets are split at the MTU") {
+		scene.multiplayer->set_max_sync_packet_size(200);
+		peer->clear_syncs();
+		scene.multiplayer->poll();
+		CHECK(peer->syncs[2].state_count == node_count);
+		CHECK(peer->sync_packet_count > peer_count * 2);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Multiplayer][SceneReplicationInterface][SceneTree][Benchmark] Sync many nodes to many peers") {
+	const int frames = 60;
+	for (int peer_count : { 8, 32, 64 }) {
+		for (int node_count : { 500, 2000 }) {
+			ReplicationScene scene(peer_count, node_count);
+			scene.multiplayer->poll();
+			scene.peer->clear_syncs();
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int frame = 0; frame < frames; frame++) {
+				// A tenth of the nodes change every frame.
+				for (int i = frame % 10; i < node_count; i += 10) {
+					scene.nodes[i]->set_rotation(frame * 0.1);
+				}
+				scene.multiplayer->poll();
+			}
+			uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+			print_line(vformat("SceneReplicationInterface: %d peers, %d nodes, %.2f msec per frame, %d packets, %d KiB per frame",
+					peer_count, node_count, elapsed / 1000.0 / frames, scene.peer->sync_packet_count / frames, int(scene.peer->sync_bytes / frames / 1024)));
+		}
+	}
+}
+
+} // namespace TestSceneReplicationInterface
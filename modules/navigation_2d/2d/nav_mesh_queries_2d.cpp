@@ -51,46 +51,151 @@ bool NavMeshQueries2D::emit_callback(const Callable &p_callback) {
 	return ce.error == Callable::CallError::CALL_OK;
 }
 
-Vector2 NavMeshQueries2D::polygons_get_random_point(const LocalVector<Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly) {
-	const LocalVector<Polygon> &region_polygons = p_polygons;
+// Squared distance between the rectangle and the point, zero inside the rectangle.
+static real_t _rect_distance_squared(const Rect2 &p_rect, const Vector2 &p_point) {
+	const Vector2 end = p_rect.get_end();
+	real_t distance_squared = 0.0;
+	for (int i = 0; i < 2; i++) {
+		const real_t gap = MAX(MAX(p_rect.position[i] - p_point[i], p_point[i] - end[i]), real_t(0.0));
+		distance_squared += gap * gap;
+	}
+	return distance_squared;
+}
 
-	if (region_polygons.is_empty()) {
-		return Vector2();
+// Visits the polygons of the region in the leaves of its hierarchy that may be closer than `p_best_distance`,
+// nearest first. `p_node_distance` returns a lower bound of the distance to anything inside a node's bounds.
+template <typename NodeDistance, typename VisitPolygon>
+static void _region_query_polygon_bvh(const NavRegionIteration2D &p_region, const real_t &p_best_distance, NodeDistance p_node_distance, VisitPolygon p_visit_polygon) {
+	const LocalVector<PolygonBVHNode> &nodes = p_region.get_polygon_bvh();
+	if (nodes.is_empty()) {
+		return;
 	}
+	const LocalVector<uint32_t> &indices = p_region.get_polygon_bvh_indices();
+	const LocalVector<Polygon> &polygons = p_region.get_navmesh_polygons();
+
+	struct StackEntry {
+		uint32_t node;
+		real_t distance;
+	};
+
+	// Each level pushes two children and pops one.
+	StackEntry stack[PolygonBVHNode::MAX_DEPTH + 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, p_node_distance(nodes[0].bounds) };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		if (entry.distance >= p_best_distance) {
+			continue;
+		}
 
-	if (p_uniformly) {
-		real_t accumulated_area = 0;
-		RBMap<real_t, uint32_t> region_area_map;
+		const PolygonBVHNode &node = nodes[entry.node];
+		if (node.count > 0) {
+			for (uint32_t i = node.index; i < node.index + node.count; i++) {
+				p_visit_polygon(polygons[indices[i]]);
+			}
+			continue;
+		}
 
-		for (uint32_t rp_index = 0; rp_index < region_polygons.size(); rp_index++) {
-			const Polygon &region_polygon = region_polygons[rp_index];
-			real_t polyon_area = region_polygon.surface_area;
+		StackEntry near_child = { entry.node + 1, p_node_distance(nodes[entry.node + 1].bounds) };
+		StackEntry far_child = { node.index, p_node_distance(nodes[node.index].bounds) };
+		if (far_child.distance < near_child.distance) {
+			SWAP(near_child, far_child);
+		}
+		stack[stack_size++] = far_child;
+		stack[stack_size++] = near_child;
+	}
+}
 
-			if (polyon_area == 0.0) {
-				continue;
+// Closest point of the polygon to the point, returning their squared distance.
+// Points inside the polygon are their own closest point.
+static real_t _polygon_get_closest_point(const Polygon &p_polygon, const Vector2 &p_point, Vector2 &r_closest_point) {
+	const LocalVector<Vector2> &vertices = p_polygon.vertices;
+
+	real_t cross = -(vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]);
+	Vector2 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector2 previous = vertices[vertices.size() - 1];
+	for (uint32_t point_id = 0; point_id < vertices.size(); ++point_id) {
+		Vector2 edge = vertices[point_id] - previous;
+		Vector2 to_point = p_point - previous;
+		real_t edge_to_point_cross = -edge.cross(to_point);
+		bool clockwise = (edge_to_point_cross * cross) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = vertices[point_id].distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = vertices[point_id];
+					closest = distance;
+				}
+			} else if (point_projected_on_edge < 0.0) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
 			}
-			region_area_map[accumulated_area] = rp_index;
-			accumulated_area += polyon_area;
-		}
-		if (region_area_map.is_empty() || accumulated_area == 0) {
-			// All polygons have no real surface / no area.
-			return Vector2();
 		}
+		previous = vertices[point_id];
+	}
 
-		real_t region_area_map_pos = Math::random(real_t(0), accumulated_area);
+	if (inside) {
+		r_closest_point = p_point;
+		return 0.0;
+	}
 
-		RBMap<real_t, uint32_t>::Iterator region_E = region_area_map.find_closest(region_area_map_pos);
-		ERR_FAIL_COND_V(!region_E, Vector2());
-		uint32_t rrp_polygon_index = region_E->value;
-		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector2());
+	r_closest_point = closest_on_polygon;
+	return closest_on_polygon.distance_squared_to(p_point);
+}
+
+// Closest point of the triangles of the polygon to the point, returning their squared distance.
+static real_t _polygon_get_closest_triangle_point(const Polygon &p_polygon, const Vector2 &p_point, Vector2 &r_closest_point) {
+	real_t closest_distance_squared = FLT_MAX;
+	for (uint32_t point_id = 2; point_id < p_polygon.vertices.size(); point_id++) {
+		const Triangle2 triangle(p_polygon.vertices[0], p_polygon.vertices[point_id - 1], p_polygon.vertices[point_id]);
+		const Vector2 point = triangle.get_closest_point_to(p_point);
+		const real_t distance_squared = point.distance_squared_to(p_point);
+		if (distance_squared < closest_distance_squared) {
+			closest_distance_squared = distance_squared;
+			r_closest_point = point;
+		}
+	}
+	return closest_distance_squared;
+}
 
-		const Polygon &rr_polygon = region_polygons[rrp_polygon_index];
+static void _region_find_closest_point(const NavRegionIteration2D &p_region, const Vector2 &p_point, ClosestPointQueryResult &r_result, real_t &r_distance_squared) {
+	_region_query_polygon_bvh(
+			p_region, r_distance_squared,
+			[&](const Rect2 &p_bounds) { return _rect_distance_squared(p_bounds, p_point); },
+			[&](const Polygon &p_polygon) {
+				Vector2 point;
+				const real_t distance_squared = _polygon_get_closest_point(p_polygon, p_point, point);
+				if (distance_squared < r_distance_squared) {
+					r_distance_squared = distance_squared;
+					r_result.point = point;
+					r_result.owner = p_polygon.owner->get_self();
+				}
+			});
+}
 
+static Vector2 _polygon_get_random_point(const Polygon &p_polygon, bool p_uniformly) {
+	if (p_uniformly) {
 		real_t accumulated_polygon_area = 0;
 		RBMap<real_t, uint32_t> polygon_area_map;
 
-		for (uint32_t rpp_index = 2; rpp_index < rr_polygon.vertices.size(); rpp_index++) {
-			real_t triangle_area = Triangle2(rr_polygon.vertices[0], rr_polygon.vertices[rpp_index - 1], rr_polygon.vertices[rpp_index]).get_area();
+		for (uint32_t rpp_index = 2; rpp_index < p_polygon.vertices.size(); rpp_index++) {
+			real_t triangle_area = Triangle2(p_polygon.vertices[0], p_polygon.vertices[rpp_index - 1], p_polygon.vertices[rpp_index]).get_area();
 
 			if (triangle_area == 0.0) {
 				continue;
@@ -108,25 +213,103 @@ Vector2 NavMeshQueries2D::polygons_get_random_point(const LocalVector<Polygon> &
 		RBMap<real_t, uint32_t>::Iterator polygon_E = polygon_area_map.find_closest(polygon_area_map_pos);
 		ERR_FAIL_COND_V(!polygon_E, Vector2());
 		uint32_t rrp_face_index = polygon_E->value;
-		ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, rr_polygon.vertices.size(), Vector2());
+		ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, p_polygon.vertices.size(), Vector2());
+
+		const Triangle2 triangle(p_polygon.vertices[0], p_polygon.vertices[rrp_face_index - 1], p_polygon.vertices[rrp_face_index]);
+
+		Vector2 triangle_random_position = triangle.get_random_point_inside();
+		return triangle_random_position;
+
+	} else {
+		uint32_t rrp_face_index = Math::random(int(2), p_polygon.vertices.size() - 1);
 
-		const Triangle2 triangle(rr_polygon.vertices[0], rr_polygon.vertices[rrp_face_index - 1], rr_polygon.vertices[rrp_face_index]);
+		const Triangle2 triangle(p_polygon.vertices[0], p_polygon.vertices[rrp_face_index - 1], p_polygon.vertices[rrp_face_index]);
 
 		Vector2 triangle_random_position = triangle.get_random_point_inside();
 		return triangle_random_position;
+	}
+}
+
+Vector2 NavMeshQueries2D::polygons_get_random_point(const LocalVector<Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly) {
+	const LocalVector<Polygon> &region_polygons = p_polygons;
+
+	if (region_polygons.is_empty()) {
+		return Vector2();
+	}
+
+	if (p_uniformly) {
+		real_t accumulated_area = 0;
+		RBMap<real_t, uint32_t> region_area_map;
+
+		for (uint32_t rp_index = 0; rp_index < region_polygons.size(); rp_index++) {
+			const Polygon &region_polygon = region_polygons[rp_index];
+			real_t polyon_area = region_polygon.surface_area;
+
+			if (polyon_area == 0.0) {
+				continue;
+			}
+			region_area_map[accumulated_area] = rp_index;
+			accumulated_area += polyon_area;
+		}
+		if (region_area_map.is_empty() || accumulated_area == 0) {
+			// All polygons have no real surface / no area.
+			return Vector2();
+		}
+
+		real_t region_area_map_pos = Math::random(real_t(0), accumulated_area);
+
+		RBMap<real_t, uint32_t>::Iterator region_E = region_area_map.find_closest(region_area_map_pos);
+		ERR_FAIL_COND_V(!region_E, Vector2());
+		uint32_t rrp_polygon_index = region_E->value;
+		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector2());
+
+		return _polygon_get_random_point(region_polygons[rrp_polygon_index], p_uniformly);
 
 	} else {
 		uint32_t rrp_polygon_index = Math::random(int(0), region_polygons.size() - 1);
 
-		const Polygon &rr_polygon = region_polygons[rrp_polygon_index];
+		return _polygon_get_random_point(region_polygons[rrp_polygon_index], p_uniformly);
+	}
+}
 
-		uint32_t rrp_face_index = Math::random(int(2), rr_polygon.vertices.size() - 1);
+Vector2 NavMeshQueries2D::region_iteration_get_random_point(const NavRegionIteration2D &p_region_iteration, uint32_t p_navigation_layers, bool p_uniformly) {
+	const LocalVector<Polygon> &region_polygons = p_region_iteration.get_navmesh_polygons();
 
-		const Triangle2 triangle(rr_polygon.vertices[0], rr_polygon.vertices[rrp_face_index - 1], rr_polygon.vertices[rrp_face_index]);
+	if (region_polygons.is_empty()) {
+		return Vector2();
+	}
 
-		Vector2 triangle_random_position = triangle.get_random_point_inside();
-		return triangle_random_position;
+	if (!p_uniformly) {
+		return polygons_get_random_point(region_polygons, p_navigation_layers, p_uniformly);
+	}
+
+	const LocalVector<real_t> &polygon_area_sums = p_region_iteration.get_polygon_area_sums();
+	ERR_FAIL_COND_V(polygon_area_sums.size() != region_polygons.size(), Vector2());
+
+	const real_t accumulated_area = polygon_area_sums[polygon_area_sums.size() - 1];
+	if (accumulated_area == 0) {
+		// All polygons have no real surface / no area.
+		return Vector2();
+	}
+
+	// Binary search for the first polygon whose accumulated area exceeds the random position.
+	const real_t area_position = Math::random(real_t(0), accumulated_area);
+	uint32_t low = 0;
+	uint32_t high = polygon_area_sums.size() - 1;
+	while (low < high) {
+		const uint32_t middle = (low + high) / 2;
+		if (polygon_area_sums[middle] > area_position) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
 	}
+	// The random position can be the total area, which would land on trailing polygons without area.
+	while (low > 0 && region_polygons[low].surface_area == 0.0) {
+		low--;
+	}
+
+	return _polygon_get_random_point(region_polygons[low], p_uniformly);
 }
 
 void NavMeshQueries2D::_query_task_push_back_point_with_metadata(NavMeshPathQueryTask2D &p_query_task, const Vector2 &p_point, const Polygon *p_point_polygon) {
@@ -241,38 +424,36 @@ void NavMeshQueries2D::_query_task_find_start_end_positions(NavMeshPathQueryTask
 	const LocalVector<Ref<NavRegionIteration2D>> &regions = p_map_iteration.region_iterations;
 
 	for (const Ref<NavRegionIteration2D> &region : regions) {
+		// Also skips regions with incompatible layers.
 		if (!_query_task_is_connection_owner_usable(p_query_task, region.ptr())) {
 			continue;
 		}
 
-		// Find the initial poly and the end poly on this map.
-		for (const Polygon &p : region->get_navmesh_polygons()) {
-			// Only consider the polygon if it in a region with compatible layers.
-			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
-				continue;
-			}
-
-			// For each triangle check the distance between the origin/destination.
-			for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
-				const Triangle2 triangle(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
-
-				Vector2 point = triangle.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
-				}
-
-				point = triangle.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
-				}
-			}
-		}
+		_region_query_polygon_bvh(
+				**region, begin_d,
+				[&](const Rect2 &p_bounds) { return _rect_distance_squared(p_bounds, p_query_task.start_position); },
+				[&](const Polygon &p_polygon) {
+					Vector2 point;
+					const real_t distance_squared = _polygon_get_closest_triangle_point(p_polygon, p_query_task.start_position, point);
+					if (distance_squared < begin_d) {
+						begin_d = distance_squared;
+						p_query_task.begin_polygon = &p_polygon;
+						p_query_task.begin_position = point;
+					}
+				});
+
+		_region_query_polygon_bvh(
+				**region, end_d,
+				[&](const Rect2 &p_bounds) { return _rect_distance_squared(p_bounds, p_query_task.target_position); },
+				[&](const Polygon &p_polygon) {
+					Vector2 point;
+					const real_t distance_squared = _polygon_get_closest_triangle_point(p_polygon, p_query_task.target_position, point);
+					if (distance_squared < end_d) {
+						end_d = distance_squared;
+						p_query_task.end_polygon = &p_polygon;
+						p_query_task.end_position = point;
+					}
+				});
 	}
 }
 
@@ -891,65 +1072,19 @@ ClosestPointQueryResult NavMeshQueries2D::map_iteration_get_closest_point_info(c
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
 
-	// TODO: Check for further 2D improvements.
-
 	const LocalVector<Ref<NavRegionIteration2D>> &regions = p_map_iteration.region_iterations;
 	for (const Ref<NavRegionIteration2D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			real_t cross = -(polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
-			Vector2 closest_on_polygon;
-			real_t closest = FLT_MAX;
-			bool inside = true;
-			Vector2 previous = polygon.vertices[polygon.vertices.size() - 1];
-			for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-				Vector2 edge = polygon.vertices[point_id] - previous;
-				Vector2 to_point = p_point - previous;
-				real_t edge_to_point_cross = -edge.cross(to_point);
-				bool clockwise = (edge_to_point_cross * cross) > 0;
-				// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-				if (!clockwise) {
-					inside = false;
-					real_t point_projected_on_edge = edge.dot(to_point);
-					real_t edge_square = edge.length_squared();
-
-					if (point_projected_on_edge > edge_square) {
-						real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = polygon.vertices[point_id];
-							closest = distance;
-						}
-					} else if (point_projected_on_edge < 0.0) {
-						real_t distance = previous.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = previous;
-							closest = distance;
-						}
-					} else {
-						// If we project on this edge, this will be the closest point.
-						real_t percent = point_projected_on_edge / edge_square;
-						closest_on_polygon = previous + percent * edge;
-						break;
-					}
-				}
-				previous = polygon.vertices[point_id];
-			}
+		_region_find_closest_point(**region, p_point, result, closest_point_distance_squared);
+	}
 
-			if (inside) {
-				closest_point_distance_squared = 0.0;
-				result.point = p_point;
-				result.owner = polygon.owner->get_self();
+	return result;
+}
 
-				break;
-			} else {
-				real_t distance = closest_on_polygon.distance_squared_to(p_point);
-				if (distance < closest_point_distance_squared) {
-					closest_point_distance_squared = distance;
-					result.point = closest_on_polygon;
-					result.owner = polygon.owner->get_self();
-				}
-			}
-		}
-	}
+ClosestPointQueryResult NavMeshQueries2D::region_iteration_get_closest_point_info(const NavRegionIteration2D &p_region_iteration, const Vector2 &p_point) {
+	ClosestPointQueryResult result;
+	real_t closest_point_distance_squared = FLT_MAX;
+
+	_region_find_closest_point(p_region_iteration, p_point, result, closest_point_distance_squared);
 
 	return result;
 }
@@ -1005,14 +1140,14 @@ Vector2 NavMeshQueries2D::map_iteration_get_random_point(const NavMapIteration2D
 
 		const Ref<NavRegionIteration2D> &random_region = p_map_iteration.region_iterations[accessible_regions[random_region_index]];
 
-		return NavMeshQueries2D::polygons_get_random_point(random_region->navmesh_polygons, p_navigation_layers, p_uniformly);
+		return NavMeshQueries2D::region_iteration_get_random_point(**random_region, p_navigation_layers, p_uniformly);
 
 	} else {
 		uint32_t random_region_index = Math::random(int(0), accessible_regions.size() - 1);
 
 		const Ref<NavRegionIteration2D> &random_region = p_map_iteration.region_iterations[accessible_regions[random_region_index]];
 
-		return NavMeshQueries2D::polygons_get_random_point(random_region->navmesh_polygons, p_navigation_layers, p_uniformly);
+		return NavMeshQueries2D::region_iteration_get_random_point(**random_region, p_navigation_layers, p_uniformly);
 	}
 }
 
@@ -1025,58 +1160,20 @@ ClosestPointQueryResult NavMeshQueries2D::polygons_get_closest_point_info(const
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
 
-	// TODO: Check for further 2D improvements.
-
 	for (const Polygon &polygon : p_polygons) {
-		real_t cross = -(polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
-		Vector2 closest_on_polygon;
-		real_t closest = FLT_MAX;
-		bool inside = true;
-		Vector2 previous = polygon.vertices[polygon.vertices.size() - 1];
-		for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-			Vector2 edge = polygon.vertices[point_id] - previous;
-			Vector2 to_point = p_point - previous;
-			real_t edge_to_point_cross = -edge.cross(to_point);
-			bool clockwise = (edge_to_point_cross * cross) > 0;
-			// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-			if (!clockwise) {
-				inside = false;
-				real_t point_projected_on_edge = edge.dot(to_point);
-				real_t edge_square = edge.length_squared();
-
-				if (point_projected_on_edge > edge_square) {
-					real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = polygon.vertices[point_id];
-						closest = distance;
-					}
-				} else if (point_projected_on_edge < 0.0) {
-					real_t distance = previous.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = previous;
-						closest = distance;
-					}
-				} else {
-					// If we project on this edge, this will be the closest point.
-					real_t percent = point_projected_on_edge / edge_square;
-					closest_on_polygon = previous + percent * edge;
-					break;
-				}
-			}
-			previous = polygon.vertices[point_id];
+		if (polygon.vertices.size() < 3) {
+			continue;
 		}
 
-		if (inside) {
-			closest_point_distance_squared = 0.0;
-			result.point = p_point;
+		Vector2 point;
+		const real_t distance_squared = _polygon_get_closest_point(polygon, p_point, point);
+		if (distance_squared < closest_point_distance_squared) {
+			closest_point_distance_squared = distance_squared;
+			result.point = point;
 			result.owner = polygon.owner->get_self();
-			break;
-		} else {
-			real_t distance = closest_on_polygon.distance_squared_to(p_point);
-			if (distance < closest_point_distance_squared) {
-				closest_point_distance_squared = distance;
-				result.point = closest_on_polygon;
-				result.owner = polygon.owner->get_self();
+
+			if (distance_squared == 0.0) {
+				break;
 			}
 		}
 	}
@@ -44,6 +44,7 @@ using namespace NavigationEnums2D;
 
 class NavMap2D;
 struct NavMapIteration2D;
+class NavRegionIteration2D;
 
 class NavMeshQueries2D {
 public:
@@ -130,6 +131,9 @@ public:
 	static Nav2D::ClosestPointQueryResult polygons_get_closest_point_info(const LocalVector<Nav2D::Polygon> &p_polygons, const Vector2 &p_point);
 	static RID polygons_get_closest_point_owner(const LocalVector<Nav2D::Polygon> &p_polygons, const Vector2 &p_point);
 
+	static Nav2D::ClosestPointQueryResult region_iteration_get_closest_point_info(const NavRegionIteration2D &p_region_iteration, const Vector2 &p_point);
+	static Vector2 region_iteration_get_random_point(const NavRegionIteration2D &p_region_iteration, uint32_t p_navigation_layers, bool p_uniformly);
+
 	static Vector2 map_iteration_get_closest_point(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
 	static RID map_iteration_get_closest_point_owner(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
 	static Nav2D::ClosestPointQueryResult map_iteration_get_closest_point_info(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
@@ -36,9 +36,19 @@
 #include "nav_region_iteration_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/templates/sort_array.h"
 
 using namespace Nav2D;
 
+struct PolygonCenterComparator {
+	const Rect2 *polygon_bounds = nullptr;
+	Vector2::Axis axis = Vector2::AXIS_X;
+
+	bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return polygon_bounds[p_a].get_center()[axis] < polygon_bounds[p_b].get_center()[axis];
+	}
+};
+
 void NavRegionBuilder2D::build_iteration(NavRegionIterationBuild2D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
 
@@ -54,6 +64,8 @@ void NavRegionBuilder2D::build_iteration(NavRegionIterationBuild2D &r_build) {
 
 	_build_step_merge_edge_connection_pairs(r_build);
 
+	_build_step_polygon_bvh(r_build);
+
 	_build_update_iteration(r_build);
 }
 
@@ -257,6 +269,82 @@ void NavRegionBuilder2D::_build_step_merge_edge_connection_pairs(NavRegionIterat
 	}
 }
 
+void NavRegionBuilder2D::_build_step_polygon_bvh(NavRegionIterationBuild2D &r_build) {
+	Ref<NavRegionIteration2D> region_iteration = r_build.region_iteration;
+	const LocalVector<Nav2D::Polygon> &navmesh_polygons = region_iteration->navmesh_polygons;
+
+	LocalVector<PolygonBVHNode> &polygon_bvh = region_iteration->polygon_bvh;
+	LocalVector<uint32_t> &polygon_bvh_indices = region_iteration->polygon_bvh_indices;
+	LocalVector<real_t> &polygon_area_sums = region_iteration->polygon_area_sums;
+
+	polygon_bvh.clear();
+	polygon_bvh_indices.clear();
+	polygon_area_sums.resize(navmesh_polygons.size());
+
+	LocalVector<Rect2> polygon_bounds;
+	polygon_bounds.resize(navmesh_polygons.size());
+
+	real_t accumulated_area = 0.0;
+
+	for (uint32_t i = 0; i < navmesh_polygons.size(); i++) {
+		const Polygon &polygon = navmesh_polygons[i];
+
+		accumulated_area += polygon.surface_area;
+		polygon_area_sums[i] = accumulated_area;
+
+		// Polygons of corrupted navigation meshes have no vertices.
+		if (polygon.vertices.size() < 3) {
+			continue;
+		}
+
+		Rect2 bounds(polygon.vertices[0], Vector2());
+		for (uint32_t j = 1; j < polygon.vertices.size(); j++) {
+			bounds.expand_to(polygon.vertices[j]);
+		}
+		polygon_bounds[i] = bounds;
+		polygon_bvh_indices.push_back(i);
+	}
+
+	if (polygon_bvh_indices.is_empty()) {
+		return;
+	}
+
+	polygon_bvh.reserve(2 * polygon_bvh_indices.size() / PolygonBVHNode::LEAF_SIZE + 1);
+	_build_polygon_bvh_node(polygon_bvh, polygon_bvh_indices, polygon_bounds, 0, polygon_bvh_indices.size(), 0);
+}
+
+uint32_t NavRegionBuilder2D::_build_polygon_bvh_node(LocalVector<PolygonBVHNode> &r_nodes, LocalVector<uint32_t> &r_indices, const LocalVector<Rect2> &p_polygon_bounds, uint32_t p_begin, uint32_t p_end, uint32_t p_depth) {
+	const uint32_t node_index = r_nodes.size();
+	r_nodes.push_back(PolygonBVHNode());
+
+	Rect2 bounds = p_polygon_bounds[r_indices[p_begin]];
+	Rect2 center_bounds(bounds.get_center(), Vector2());
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		const Rect2 &polygon_bounds = p_polygon_bounds[r_indices[i]];
+		bounds = bounds.merge(polygon_bounds);
+		center_bounds.expand_to(polygon_bounds.get_center());
+	}
+	r_nodes[node_index].bounds = bounds;
+
+	const uint32_t count = p_end - p_begin;
+	if (count <= PolygonBVHNode::LEAF_SIZE || p_depth >= PolygonBVHNode::MAX_DEPTH) {
+		r_nodes[node_index].index = p_begin;
+		r_nodes[node_index].count = count;
+		return node_index;
+	}
+
+	// Split the polygons in halves along the longest axis of their centers.
+	const uint32_t middle = p_begin + count / 2;
+	SortArray<uint32_t, PolygonCenterComparator> sorter;
+	sorter.compare.polygon_bounds = p_polygon_bounds.ptr();
+	sorter.compare.axis = center_bounds.size.x >= center_bounds.size.y ? Vector2::AXIS_X : Vector2::AXIS_Y;
+	sorter.nth_element(p_begin, p_end, middle, r_indices.ptr());
+
+	_build_polygon_bvh_node(r_nodes, r_indices, p_polygon_bounds, p_begin, middle, p_depth + 1);
+	r_nodes[node_index].index = _build_polygon_bvh_node(r_nodes, r_indices, p_polygon_bounds, middle, p_end, p_depth + 1);
+	return node_index;
+}
+
 void NavRegionBuilder2D::_build_update_iteration(NavRegionIterationBuild2D &r_build) {
 	ERR_FAIL_NULL(r_build.region);
 	// Stub. End of the build.
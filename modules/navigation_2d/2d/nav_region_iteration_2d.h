@@ -78,14 +78,24 @@ public:
 	real_t surface_area = 0.0;
 	Rect2 bounds;
 	LocalVector<Nav2D::ConnectableEdge> external_edges;
+	LocalVector<Nav2D::PolygonBVHNode> polygon_bvh;
+	LocalVector<uint32_t> polygon_bvh_indices;
+	LocalVector<real_t> polygon_area_sums;
 
 	const Transform2D &get_transform() const { return transform; }
 	real_t get_surface_area() const { return surface_area; }
 	Rect2 get_bounds() const { return bounds; }
 	const LocalVector<Nav2D::ConnectableEdge> &get_external_edges() const { return external_edges; }
+	const LocalVector<Nav2D::PolygonBVHNode> &get_polygon_bvh() const { return polygon_bvh; }
+	const LocalVector<uint32_t> &get_polygon_bvh_indices() const { return polygon_bvh_indices; }
+	// Surface area of the polygons up to and including each one, to pick random points uniformly.
+	const LocalVector<real_t> &get_polygon_area_sums() const { return polygon_area_sums; }
 
 	virtual ~NavRegionIteration2D() override {
 		external_edges.clear();
+		polygon_bvh.clear();
+		polygon_bvh_indices.clear();
+		polygon_area_sums.clear();
 		navmesh_polygons.clear();
 		internal_connections.clear();
 	}
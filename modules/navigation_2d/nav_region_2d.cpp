@@ -113,8 +113,9 @@ void NavRegion2D::set_navigation_mesh(Ref<NavigationPolygon> p_navigation_mesh)
 
 ClosestPointQueryResult NavRegion2D::get_closest_point_info(const Vector2 &p_point) const {
 	RWLockRead read_lock(region_rwlock);
+	RWLockRead iteration_read_lock(iteration_rwlock);
 
-	return NavMeshQueries2D::polygons_get_closest_point_info(get_polygons(), p_point);
+	return NavMeshQueries2D::region_iteration_get_closest_point_info(**iteration, p_point);
 }
 
 Vector2 NavRegion2D::get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const {
@@ -124,7 +125,9 @@ Vector2 NavRegion2D::get_random_point(uint32_t p_navigation_layers, bool p_unifo
 		return Vector2();
 	}
 
-	return NavMeshQueries2D::polygons_get_random_point(get_polygons(), p_navigation_layers, p_uniformly);
+	RWLockRead iteration_read_lock(iteration_rwlock);
+
+	return NavMeshQueries2D::region_iteration_get_random_point(**iteration, p_navigation_layers, p_uniformly);
 }
 
 void NavRegion2D::set_navigation_layers(uint32_t p_navigation_layers) {
@@ -51,46 +51,236 @@ bool NavMeshQueries3D::emit_callback(const Callable &p_callback) {
 	return ce.error == Callable::CallError::CALL_OK;
 }
 
-Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly) {
-	const LocalVector<Polygon> &region_polygons = p_polygons;
+// Squared distance between the box and the point, zero inside the box.
+static real_t _aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 end = p_aabb.get_end();
+	real_t distance_squared = 0.0;
+	for (int i = 0; i < 3; i++) {
+		const real_t gap = MAX(MAX(p_aabb.position[i] - p_point[i], p_point[i] - end[i]), real_t(0.0));
+		distance_squared += gap * gap;
+	}
+	return distance_squared;
+}
 
-	if (region_polygons.is_empty()) {
-		return Vector3();
+// Squared distance between the boxes, zero if they overlap.
+static real_t _aabb_distance_squared(const AABB &p_a, const AABB &p_b) {
+	const Vector3 a_end = p_a.get_end();
+	const Vector3 b_end = p_b.get_end();
+	real_t distance_squared = 0.0;
+	for (int i = 0; i < 3; i++) {
+		const real_t gap = MAX(MAX(p_a.position[i] - b_end[i], p_b.position[i] - a_end[i]), real_t(0.0));
+		distance_squared += gap * gap;
 	}
+	return distance_squared;
+}
 
-	if (p_uniformly) {
-		real_t accumulated_area = 0;
-		RBMap<real_t, uint32_t> region_area_map;
+// Visits the polygons of the region in the leaves of its hierarchy that may be closer than `p_best_distance`,
+// nearest first. `p_node_distance` returns a lower bound of the distance to anything inside a node's bounds.
+template <typename NodeDistance, typename VisitPolygon>
+static void _region_query_polygon_bvh(const NavRegionIteration3D &p_region, const real_t &p_best_distance, NodeDistance p_node_distance, VisitPolygon p_visit_polygon) {
+	const LocalVector<PolygonBVHNode> &nodes = p_region.get_polygon_bvh();
+	if (nodes.is_empty()) {
+		return;
+	}
+	const LocalVector<uint32_t> &indices = p_region.get_polygon_bvh_indices();
+	const LocalVector<Polygon> &polygons = p_region.get_navmesh_polygons();
+
+	struct StackEntry {
+		uint32_t node;
+		real_t distance;
+	};
+
+	// Each level pushes two children and pops one.
+	StackEntry stack[PolygonBVHNode::MAX_DEPTH + 2];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, p_node_distance(nodes[0].bounds) };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		if (entry.distance >= p_best_distance) {
+			continue;
+		}
 
-		for (uint32_t rp_index = 0; rp_index < region_polygons.size(); rp_index++) {
-			const Polygon &region_polygon = region_polygons[rp_index];
-			real_t polyon_area = region_polygon.surface_area;
+		const PolygonBVHNode &node = nodes[entry.node];
+		if (node.count > 0) {
+			for (uint32_t i = node.index; i < node.index + node.count; i++) {
+				p_visit_polygon(polygons[indices[i]]);
+			}
+			continue;
+		}
 
-			if (polyon_area == 0.0) {
-				continue;
+		StackEntry near_child = { entry.node + 1, p_node_distance(nodes[entry.node + 1].bounds) };
+		StackEntry far_child = { node.index, p_node_distance(nodes[node.index].bounds) };
+		if (far_child.distance < near_child.distance) {
+			SWAP(near_child, far_child);
+		}
+		stack[stack_size++] = far_child;
+		stack[stack_size++] = near_child;
+	}
+}
+
+// Closest point of the polygon to the point, returning their squared distance.
+static real_t _polygon_get_closest_point(const Polygon &p_polygon, const Vector3 &p_point, Vector3 &r_closest_point, Vector3 &r_normal) {
+	const LocalVector<Vector3> &vertices = p_polygon.vertices;
+
+	Vector3 plane_normal = (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]);
+	Vector3 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector3 previous = vertices[vertices.size() - 1];
+	for (uint32_t point_id = 0; point_id < vertices.size(); ++point_id) {
+		Vector3 edge = vertices[point_id] - previous;
+		Vector3 to_point = p_point - previous;
+		Vector3 edge_to_point_pormal = edge.cross(to_point);
+		bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = vertices[point_id].distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = vertices[point_id];
+					closest = distance;
+				}
+			} else if (point_projected_on_edge < 0.f) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
 			}
-			region_area_map[accumulated_area] = rp_index;
-			accumulated_area += polyon_area;
 		}
-		if (region_area_map.is_empty() || accumulated_area == 0) {
-			// All polygons have no real surface / no area.
-			return Vector3();
+		previous = vertices[point_id];
+	}
+
+	r_normal = plane_normal;
+
+	if (inside) {
+		Vector3 plane_normalized = plane_normal.normalized();
+		real_t distance = plane_normalized.dot(p_point - vertices[0]);
+		r_closest_point = p_point - plane_normalized * distance;
+		return distance * distance;
+	}
+
+	r_closest_point = closest_on_polygon;
+	return closest_on_polygon.distance_squared_to(p_point);
+}
+
+// Closest point of the triangles of the polygon to the point, returning their squared distance.
+static real_t _polygon_get_closest_face_point(const Polygon &p_polygon, const Vector3 &p_point, Vector3 &r_closest_point) {
+	real_t closest_distance_squared = FLT_MAX;
+	for (uint32_t point_id = 2; point_id < p_polygon.vertices.size(); point_id++) {
+		const Face3 face(p_polygon.vertices[0], p_polygon.vertices[point_id - 1], p_polygon.vertices[point_id]);
+		const Vector3 point = face.get_closest_point_to(p_point);
+		const real_t distance_squared = point.distance_squared_to(p_point);
+		if (distance_squared < closest_distance_squared) {
+			closest_distance_squared = distance_squared;
+			r_closest_point = point;
 		}
+	}
+	return closest_distance_squared;
+}
 
-		real_t region_area_map_pos = Math::random(real_t(0), accumulated_area);
+static void _region_find_closest_point(const NavRegionIteration3D &p_region, const Vector3 &p_point, ClosestPointQueryResult &r_result, real_t &r_distance_squared) {
+	_region_query_polygon_bvh(
+			p_region, r_distance_squared,
+			[&](const AABB &p_bounds) { return _aabb_distance_squared(p_bounds, p_point); },
+			[&](const Polygon &p_polygon) {
+				Vector3 point;
+				Vector3 normal;
+				const real_t distance_squared = _polygon_get_closest_point(p_polygon, p_point, point, normal);
+				if (distance_squared < r_distance_squared) {
+					r_distance_squared = distance_squared;
+					r_result.point = point;
+					r_result.normal = normal;
+					r_result.owner = p_polygon.owner->get_self();
+				}
+			});
+}
 
-		RBMap<real_t, uint32_t>::Iterator region_E = region_area_map.find_closest(region_area_map_pos);
-		ERR_FAIL_COND_V(!region_E, Vector3());
-		uint32_t rrp_polygon_index = region_E->value;
-		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector3());
+// Finds where the segment first hits the polygons of the region, measured from `p_from`.
+static void _region_find_segment_intersection(const NavRegionIteration3D &p_region, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point, real_t &r_distance_squared) {
+	_region_query_polygon_bvh(
+			p_region, r_distance_squared,
+			[&](const AABB &p_bounds) { return p_bounds.intersects_segment(p_from, p_to) ? _aabb_distance_squared(p_bounds, p_from) : real_t(FLT_MAX); },
+			[&](const Polygon &p_polygon) {
+				for (uint32_t point_id = 2; point_id < p_polygon.vertices.size(); point_id += 1) {
+					const Face3 face(p_polygon.vertices[0], p_polygon.vertices[point_id - 1], p_polygon.vertices[point_id]);
+					Vector3 intersection_point;
+					if (face.intersects_segment(p_from, p_to, &intersection_point)) {
+						const real_t distance_squared = p_from.distance_squared_to(intersection_point);
+						if (distance_squared < r_distance_squared) {
+							r_point = intersection_point;
+							r_distance_squared = distance_squared;
+						}
+					}
+				}
+			});
+}
+
+// Finds the point of the polygons of the region closest to a segment that doesn't hit them.
+static void _region_find_closest_point_to_segment(const NavRegionIteration3D &p_region, const Vector3 &p_from, const Vector3 &p_to, Vector3 &r_point, real_t &r_distance_squared) {
+	AABB segment_bounds(p_from, Vector3());
+	segment_bounds.expand_to(p_to);
+
+	_region_query_polygon_bvh(
+			p_region, r_distance_squared,
+			[&](const AABB &p_bounds) { return _aabb_distance_squared(p_bounds, segment_bounds); },
+			[&](const Polygon &p_polygon) {
+				// For each face check the distance from the segment's endpoints.
+				for (uint32_t point_id = 2; point_id < p_polygon.vertices.size(); point_id += 1) {
+					const Face3 face(p_polygon.vertices[0], p_polygon.vertices[point_id - 1], p_polygon.vertices[point_id]);
+
+					const Vector3 p_from_closest = face.get_closest_point_to(p_from);
+					const real_t d_p_from = p_from.distance_squared_to(p_from_closest);
+					if (r_distance_squared > d_p_from) {
+						r_point = p_from_closest;
+						r_distance_squared = d_p_from;
+					}
+
+					const Vector3 p_to_closest = face.get_closest_point_to(p_to);
+					const real_t d_p_to = p_to.distance_squared_to(p_to_closest);
+					if (r_distance_squared > d_p_to) {
+						r_point = p_to_closest;
+						r_distance_squared = d_p_to;
+					}
+				}
+				// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
+				for (uint32_t point_id = 0; point_id < p_polygon.vertices.size(); point_id += 1) {
+					Vector3 a, b;
 
-		const Polygon &rr_polygon = region_polygons[rrp_polygon_index];
+					Geometry3D::get_closest_points_between_segments(
+							p_from,
+							p_to,
+							p_polygon.vertices[point_id],
+							p_polygon.vertices[(point_id + 1) % p_polygon.vertices.size()],
+							a,
+							b);
 
+					const real_t d = a.distance_squared_to(b);
+					if (d < r_distance_squared) {
+						r_distance_squared = d;
+						r_point = b;
+					}
+				}
+			});
+}
+
+static Vector3 _polygon_get_random_point(const Polygon &p_polygon, bool p_uniformly) {
+	if (p_uniformly) {
 		real_t accumulated_polygon_area = 0;
 		RBMap<real_t, uint32_t> polygon_area_map;
 
-		for (uint32_t rpp_index = 2; rpp_index < rr_polygon.vertices.size(); rpp_index++) {
-			real_t face_area = Face3(rr_polygon.vertices[0], rr_polygon.vertices[rpp_index - 1], rr_polygon.vertices[rpp_index]).get_area();
+		for (uint32_t rpp_index = 2; rpp_index < p_polygon.vertices.size(); rpp_index++) {
+			real_t face_area = Face3(p_polygon.vertices[0], p_polygon.vertices[rpp_index - 1], p_polygon.vertices[rpp_index]).get_area();
 
 			if (face_area == 0.0) {
 				continue;
@@ -108,25 +298,103 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<Polygon> &
 		RBMap<real_t, uint32_t>::Iterator polygon_E = polygon_area_map.find_closest(polygon_area_map_pos);
 		ERR_FAIL_COND_V(!polygon_E, Vector3());
 		uint32_t rrp_face_index = polygon_E->value;
-		ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, rr_polygon.vertices.size(), Vector3());
+		ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, p_polygon.vertices.size(), Vector3());
 
-		const Face3 face(rr_polygon.vertices[0], rr_polygon.vertices[rrp_face_index - 1], rr_polygon.vertices[rrp_face_index]);
+		const Face3 face(p_polygon.vertices[0], p_polygon.vertices[rrp_face_index - 1], p_polygon.vertices[rrp_face_index]);
 
 		Vector3 face_random_position = face.get_random_point_inside();
 		return face_random_position;
 
+	} else {
+		uint32_t rrp_face_index = Math::random(int(2), p_polygon.vertices.size() - 1);
+
+		const Face3 face(p_polygon.vertices[0], p_polygon.vertices[rrp_face_index - 1], p_polygon.vertices[rrp_face_index]);
+
+		Vector3 face_random_position = face.get_random_point_inside();
+		return face_random_position;
+	}
+}
+
+Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly) {
+	const LocalVector<Polygon> &region_polygons = p_polygons;
+
+	if (region_polygons.is_empty()) {
+		return Vector3();
+	}
+
+	if (p_uniformly) {
+		real_t accumulated_area = 0;
+		RBMap<real_t, uint32_t> region_area_map;
+
+		for (uint32_t rp_index = 0; rp_index < region_polygons.size(); rp_index++) {
+			const Polygon &region_polygon = region_polygons[rp_index];
+			real_t polyon_area = region_polygon.surface_area;
+
+			if (polyon_area == 0.0) {
+				continue;
+			}
+			region_area_map[accumulated_area] = rp_index;
+			accumulated_area += polyon_area;
+		}
+		if (region_area_map.is_empty() || accumulated_area == 0) {
+			// All polygons have no real surface / no area.
+			return Vector3();
+		}
+
+		real_t region_area_map_pos = Math::random(real_t(0), accumulated_area);
+
+		RBMap<real_t, uint32_t>::Iterator region_E = region_area_map.find_closest(region_area_map_pos);
+		ERR_FAIL_COND_V(!region_E, Vector3());
+		uint32_t rrp_polygon_index = region_E->value;
+		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector3());
+
+		return _polygon_get_random_point(region_polygons[rrp_polygon_index], p_uniformly);
+
 	} else {
 		uint32_t rrp_polygon_index = Math::random(int(0), region_polygons.size() - 1);
 
-		const Polygon &rr_polygon = region_polygons[rrp_polygon_index];
+		return _polygon_get_random_point(region_polygons[rrp_polygon_index], p_uniformly);
+	}
+}
 
-		uint32_t rrp_face_index = Math::random(int(2), rr_polygon.vertices.size() - 1);
+Vector3 NavMeshQueries3D::region_iteration_get_random_point(const NavRegionIteration3D &p_region_iteration, uint32_t p_navigation_layers, bool p_uniformly) {
+	const LocalVector<Polygon> &region_polygons = p_region_iteration.get_navmesh_polygons();
 
-		const Face3 face(rr_polygon.vertices[0], rr_polygon.vertices[rrp_face_index - 1], rr_polygon.vertices[rrp_face_index]);
+	if (region_polygons.is_empty()) {
+		return Vector3();
+	}
 
-		Vector3 face_random_position = face.get_random_point_inside();
-		return face_random_position;
+	if (!p_uniformly) {
+		return polygons_get_random_point(region_polygons, p_navigation_layers, p_uniformly);
+	}
+
+	const LocalVector<real_t> &polygon_area_sums = p_region_iteration.get_polygon_area_sums();
+	ERR_FAIL_COND_V(polygon_area_sums.size() != region_polygons.size(), Vector3());
+
+	const real_t accumulated_area = polygon_area_sums[polygon_area_sums.size() - 1];
+	if (accumulated_area == 0) {
+		// All polygons have no real surface / no area.
+		return Vector3();
 	}
+
+	// Binary search for the first polygon whose accumulated area exceeds the random position.
+	const real_t area_position = Math::random(real_t(0), accumulated_area);
+	uint32_t low = 0;
+	uint32_t high = polygon_area_sums.size() - 1;
+	while (low < high) {
+		const uint32_t middle = (low + high) / 2;
+		if (polygon_area_sums[middle] > area_position) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+	// The random position can be the total area, which would land on trailing polygons without area.
+	while (low > 0 && region_polygons[low].surface_area == 0.0) {
+		low--;
+	}
+
+	return _polygon_get_random_point(region_polygons[low], p_uniformly);
 }
 
 void NavMeshQueries3D::_query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Polygon *p_point_polygon) {
@@ -241,38 +509,37 @@ void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
 
 	for (const Ref<NavRegionIteration3D> &region : regions) {
+		// Also skips regions with incompatible layers.
 		if (!_query_task_is_connection_owner_usable(p_query_task, region.ptr())) {
 			continue;
 		}
 
 		// Find the initial poly and the end poly on this map.
-		for (const Polygon &p : region->get_navmesh_polygons()) {
-			// Only consider the polygon if it in a region with compatible layers.
-			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
-				continue;
-			}
-
-			// For each face check the distance between the origin/destination.
-			for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
-				const Face3 face(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
-
-				Vector3 point = face.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
-				}
-
-				point = face.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
-				}
-			}
-		}
+		_region_query_polygon_bvh(
+				**region, begin_d,
+				[&](const AABB &p_bounds) { return _aabb_distance_squared(p_bounds, p_query_task.start_position); },
+				[&](const Polygon &p_polygon) {
+					Vector3 point;
+					const real_t distance_squared = _polygon_get_closest_face_point(p_polygon, p_query_task.start_position, point);
+					if (distance_squared < begin_d) {
+						begin_d = distance_squared;
+						p_query_task.begin_polygon = &p_polygon;
+						p_query_task.begin_position = point;
+					}
+				});
+
+		_region_query_polygon_bvh(
+				**region, end_d,
+				[&](const AABB &p_bounds) { return _aabb_distance_squared(p_bounds, p_query_task.target_position); },
+				[&](const Polygon &p_polygon) {
+					Vector3 point;
+					const real_t distance_squared = _polygon_get_closest_face_point(p_polygon, p_query_task.target_position, point);
+					if (distance_squared < end_d) {
+						end_d = distance_squared;
+						p_query_task.end_polygon = &p_polygon;
+						p_query_task.end_position = point;
+					}
+				});
 	}
 }
 
@@ -878,66 +1145,33 @@ void NavMeshQueries3D::_query_task_post_process_nopostprocessing(NavMeshPathQuer
 }
 
 Vector3 NavMeshQueries3D::map_iteration_get_closest_point_to_segment(const NavMapIteration3D &p_map_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
-	bool use_collision = p_use_collision;
 	Vector3 closest_point;
-	real_t closest_point_distance = FLT_MAX;
+	real_t closest_point_distance_squared = FLT_MAX;
 
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
 	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			// For each face check the distance to the segment.
-			for (uint32_t point_id = 2; point_id < polygon.vertices.size(); point_id += 1) {
-				const Face3 face(polygon.vertices[0], polygon.vertices[point_id - 1], polygon.vertices[point_id]);
-				Vector3 intersection_point;
-				if (face.intersects_segment(p_from, p_to, &intersection_point)) {
-					const real_t d = p_from.distance_to(intersection_point);
-					if (!use_collision) {
-						closest_point = intersection_point;
-						use_collision = true;
-						closest_point_distance = d;
-					} else if (closest_point_distance > d) {
-						closest_point = intersection_point;
-						closest_point_distance = d;
-					}
-				}
-				// If segment does not itersect face, check the distance from segment's endpoints.
-				else if (!use_collision) {
-					const Vector3 p_from_closest = face.get_closest_point_to(p_from);
-					const real_t d_p_from = p_from.distance_to(p_from_closest);
-					if (closest_point_distance > d_p_from) {
-						closest_point = p_from_closest;
-						closest_point_distance = d_p_from;
-					}
+		_region_find_segment_intersection(**region, p_from, p_to, closest_point, closest_point_distance_squared);
+	}
 
-					const Vector3 p_to_closest = face.get_closest_point_to(p_to);
-					const real_t d_p_to = p_to.distance_to(p_to_closest);
-					if (closest_point_distance > d_p_to) {
-						closest_point = p_to_closest;
-						closest_point_distance = d_p_to;
-					}
-				}
-			}
-			// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
-			if (!use_collision) {
-				for (uint32_t point_id = 0; point_id < polygon.vertices.size(); point_id += 1) {
-					Vector3 a, b;
+	// Without intersection, fall back to the point closest to the segment.
+	if (closest_point_distance_squared == FLT_MAX && !p_use_collision) {
+		for (const Ref<NavRegionIteration3D> &region : regions) {
+			_region_find_closest_point_to_segment(**region, p_from, p_to, closest_point, closest_point_distance_squared);
+		}
+	}
 
-					Geometry3D::get_closest_points_between_segments(
-							p_from,
-							p_to,
-							polygon.vertices[point_id],
-							polygon.vertices[(point_id + 1) % polygon.vertices.size()],
-							a,
-							b);
+	return closest_point;
+}
 
-					const real_t d = a.distance_to(b);
-					if (d < closest_point_distance) {
-						closest_point_distance = d;
-						closest_point = b;
-					}
-				}
-			}
-		}
+Vector3 NavMeshQueries3D::region_iteration_get_closest_point_to_segment(const NavRegionIteration3D &p_region_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
+	Vector3 closest_point;
+	real_t closest_point_distance_squared = FLT_MAX;
+
+	_region_find_segment_intersection(p_region_iteration, p_from, p_to, closest_point, closest_point_distance_squared);
+
+	// Without intersection, fall back to the point closest to the segment.
+	if (closest_point_distance_squared == FLT_MAX && !p_use_collision) {
+		_region_find_closest_point_to_segment(p_region_iteration, p_from, p_to, closest_point, closest_point_distance_squared);
 	}
 
 	return closest_point;
@@ -964,74 +1198,21 @@ ClosestPointQueryResult NavMeshQueries3D::map_iteration_get_closest_point_info(c
 
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
 	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			Vector3 plane_normal = (polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
-			Vector3 closest_on_polygon;
-			real_t closest = FLT_MAX;
-			bool inside = true;
-			Vector3 previous = polygon.vertices[polygon.vertices.size() - 1];
-			for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-				Vector3 edge = polygon.vertices[point_id] - previous;
-				Vector3 to_point = p_point - previous;
-				Vector3 edge_to_point_pormal = edge.cross(to_point);
-				bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-				// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-				if (!clockwise) {
-					inside = false;
-					real_t point_projected_on_edge = edge.dot(to_point);
-					real_t edge_square = edge.length_squared();
-
-					if (point_projected_on_edge > edge_square) {
-						real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = polygon.vertices[point_id];
-							closest = distance;
-						}
-					} else if (point_projected_on_edge < 0.f) {
-						real_t distance = previous.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = previous;
-							closest = distance;
-						}
-					} else {
-						// If we project on this edge, this will be the closest point.
-						real_t percent = point_projected_on_edge / edge_square;
-						closest_on_polygon = previous + percent * edge;
-						break;
-					}
-				}
-				previous = polygon.vertices[point_id];
-			}
-
-			if (inside) {
-				Vector3 plane_normalized = plane_normal.normalized();
-				real_t distance = plane_normalized.dot(p_point - polygon.vertices[0]);
-				real_t distance_squared = distance * distance;
-				if (distance_squared < closest_point_distance_squared) {
-					closest_point_distance_squared = distance_squared;
-					result.point = p_point - plane_normalized * distance;
-					result.normal = plane_normal;
-					result.owner = polygon.owner->get_self();
-
-					if (Math::is_zero_approx(distance)) {
-						break;
-					}
-				}
-			} else {
-				real_t distance = closest_on_polygon.distance_squared_to(p_point);
-				if (distance < closest_point_distance_squared) {
-					closest_point_distance_squared = distance;
-					result.point = closest_on_polygon;
-					result.normal = plane_normal;
-					result.owner = polygon.owner->get_self();
-				}
-			}
-		}
+		_region_find_closest_point(**region, p_point, result, closest_point_distance_squared);
 	}
 
 	return result;
 }
 
+ClosestPointQueryResult NavMeshQueries3D::region_iteration_get_closest_point_info(const NavRegionIteration3D &p_region_iteration, const Vector3 &p_point) {
+	ClosestPointQueryResult result;
+	real_t closest_point_distance_squared = FLT_MAX;
+
+	_region_find_closest_point(p_region_iteration, p_point, result, closest_point_distance_squared);
+
+	return result;
+}
+
 Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly) {
 	if (p_map_iteration.region_iterations.is_empty()) {
 		return Vector3();
@@ -1083,14 +1264,14 @@ Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D
 
 		const Ref<NavRegionIteration3D> &random_region = p_map_iteration.region_iterations[accessible_regions[random_region_index]];
 
-		return NavMeshQueries3D::polygons_get_random_point(random_region->navmesh_polygons, p_navigation_layers, p_uniformly);
+		return NavMeshQueries3D::region_iteration_get_random_point(**random_region, p_navigation_layers, p_uniformly);
 
 	} else {
 		uint32_t random_region_index = Math::random(int(0), accessible_regions.size() - 1);
 
 		const Ref<NavRegionIteration3D> &random_region = p_map_iteration.region_iterations[accessible_regions[random_region_index]];
 
-		return NavMeshQueries3D::polygons_get_random_point(random_region->navmesh_polygons, p_navigation_layers, p_uniformly);
+		return NavMeshQueries3D::region_iteration_get_random_point(**random_region, p_navigation_layers, p_uniformly);
 	}
 }
 
@@ -1172,66 +1353,18 @@ ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const
 	real_t closest_point_distance_squared = FLT_MAX;
 
 	for (const Polygon &polygon : p_polygons) {
-		Vector3 plane_normal = (polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
-		Vector3 closest_on_polygon;
-		real_t closest = FLT_MAX;
-		bool inside = true;
-		Vector3 previous = polygon.vertices[polygon.vertices.size() - 1];
-		for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-			Vector3 edge = polygon.vertices[point_id] - previous;
-			Vector3 to_point = p_point - previous;
-			Vector3 edge_to_point_pormal = edge.cross(to_point);
-			bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-			// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-			if (!clockwise) {
-				inside = false;
-				real_t point_projected_on_edge = edge.dot(to_point);
-				real_t edge_square = edge.length_squared();
-
-				if (point_projected_on_edge > edge_square) {
-					real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = polygon.vertices[point_id];
-						closest = distance;
-					}
-				} else if (point_projected_on_edge < 0.f) {
-					real_t distance = previous.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = previous;
-						closest = distance;
-					}
-				} else {
-					// If we project on this edge, this will be the closest point.
-					real_t percent = point_projected_on_edge / edge_square;
-					closest_on_polygon = previous + percent * edge;
-					break;
-				}
-			}
-			previous = polygon.vertices[point_id];
+		if (polygon.vertices.size() < 3) {
+			continue;
 		}
 
-		if (inside) {
-			Vector3 plane_normalized = plane_normal.normalized();
-			real_t distance = plane_normalized.dot(p_point - polygon.vertices[0]);
-			real_t distance_squared = distance * distance;
-			if (distance_squared < closest_point_distance_squared) {
-				closest_point_distance_squared = distance_squared;
-				result.point = p_point - plane_normalized * distance;
-				result.normal = plane_normal;
-				result.owner = polygon.owner->get_self();
-
-				if (Math::is_zero_approx(distance)) {
-					break;
-				}
-			}
-		} else {
-			real_t distance = closest_on_polygon.distance_squared_to(p_point);
-			if (distance < closest_point_distance_squared) {
-				closest_point_distance_squared = distance;
-				result.point = closest_on_polygon;
-				result.normal = plane_normal;
-				result.owner = polygon.owner->get_self();
-			}
+		Vector3 point;
+		Vector3 normal;
+		const real_t distance_squared = _polygon_get_closest_point(polygon, p_point, point, normal);
+		if (distance_squared < closest_point_distance_squared) {
+			closest_point_distance_squared = distance_squared;
+			result.point = point;
+			result.normal = normal;
+			result.owner = polygon.owner->get_self();
 		}
 	}
 
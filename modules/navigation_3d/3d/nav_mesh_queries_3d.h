@@ -44,6 +44,7 @@ using namespace NavigationEnums3D;
 
 class NavMap3D;
 struct NavMapIteration3D;
+class NavRegionIteration3D;
 
 class NavMeshQueries3D {
 public:
@@ -133,6 +134,10 @@ public:
 	static Nav3D::ClosestPointQueryResult polygons_get_closest_point_info(const LocalVector<Nav3D::Polygon> &p_polygons, const Vector3 &p_point);
 	static RID polygons_get_closest_point_owner(const LocalVector<Nav3D::Polygon> &p_polygons, const Vector3 &p_point);
 
+	static Vector3 region_iteration_get_closest_point_to_segment(const NavRegionIteration3D &p_region_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision);
+	static Nav3D::ClosestPointQueryResult region_iteration_get_closest_point_info(const NavRegionIteration3D &p_region_iteration, const Vector3 &p_point);
+	static Vector3 region_iteration_get_random_point(const NavRegionIteration3D &p_region_iteration, uint32_t p_navigation_layers, bool p_uniformly);
+
 	static Vector3 map_iteration_get_closest_point_to_segment(const NavMapIteration3D &p_map_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision);
 	static Vector3 map_iteration_get_closest_point(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
 	static Vector3 map_iteration_get_closest_point_normal(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
@@ -38,6 +38,8 @@ class NavRegionBuilder3D {
 	static void _build_step_process_navmesh_data(NavRegionIterationBuild3D &r_build);
 	static void _build_step_find_edge_connection_pairs(NavRegionIterationBuild3D &r_build);
 	static void _build_step_merge_edge_connection_pairs(NavRegionIterationBuild3D &r_build);
+	static void _build_step_polygon_bvh(NavRegionIterationBuild3D &r_build);
+	static uint32_t _build_polygon_bvh_node(LocalVector<Nav3D::PolygonBVHNode> &r_nodes, LocalVector<uint32_t> &r_indices, const LocalVector<AABB> &p_polygon_bounds, uint32_t p_begin, uint32_t p_end, uint32_t p_depth);
 	static void _build_update_iteration(NavRegionIterationBuild3D &r_build);
 
 public:
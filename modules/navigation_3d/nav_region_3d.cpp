@@ -124,15 +124,17 @@ void NavRegion3D::set_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) {
 
 Vector3 NavRegion3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, bool p_use_collision) const {
 	RWLockRead read_lock(region_rwlock);
+	RWLockRead iteration_read_lock(iteration_rwlock);
 
-	return NavMeshQueries3D::polygons_get_closest_point_to_segment(
-			get_polygons(), p_from, p_to, p_use_collision);
+	return NavMeshQueries3D::region_iteration_get_closest_point_to_segment(
+			**iteration, p_from, p_to, p_use_collision);
 }
 
 ClosestPointQueryResult NavRegion3D::get_closest_point_info(const Vector3 &p_point) const {
 	RWLockRead read_lock(region_rwlock);
+	RWLockRead iteration_read_lock(iteration_rwlock);
 
-	return NavMeshQueries3D::polygons_get_closest_point_info(get_polygons(), p_point);
+	return NavMeshQueries3D::region_iteration_get_closest_point_info(**iteration, p_point);
 }
 
 Vector3 NavRegion3D::get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const {
@@ -142,7 +144,9 @@ Vector3 NavRegion3D::get_random_point(uint32_t p_navigation_layers, bool p_unifo
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_random_point(get_polygons(), p_navigation_layers, p_uniformly);
+	RWLockRead iteration_read_lock(iteration_rwlock);
+
+	return NavMeshQueries3D::region_iteration_get_random_point(**iteration, p_navigation_layers, p_uniformly);
 }
 
 void NavRegion3D::set_navigation_layers(uint32_t p_navigation_layers) {
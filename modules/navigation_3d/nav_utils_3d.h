@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/math/aabb.h"
 #include "core/math/vector3.h"
 #include "core/object/ref_counted.h"
 #include "core/templates/hash_map.h"
@@ -106,6 +107,21 @@ struct Polygon {
 	real_t surface_area = 0.0;
 };
 
+/// Node of the bounding volume hierarchy over the polygons of a region, stored depth-first.
+struct PolygonBVHNode {
+	static constexpr uint32_t LEAF_SIZE = 4;
+	static constexpr uint32_t MAX_DEPTH = 32;
+
+	AABB bounds;
+
+	/// Leaves: first entry in the polygon indices of the hierarchy.
+	/// Inner nodes: second child, the first one directly follows the node.
+	uint32_t index = 0;
+
+	/// Polygons in the leaf, zero for inner nodes.
+	uint32_t count = 0;
+};
+
 struct NavigationPoly {
 	/// This poly.
 	const Polygon *poly = nullptr;
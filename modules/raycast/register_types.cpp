@@ -34,9 +34,16 @@
 #include "raycast_occlusion_cull.h"
 #include "static_raycaster_embree.h"
 
-RaycastOcclusionCull *raycast_occlusion_cull = nullptr;
+static RendererSceneOcclusionCull *_create_raycast_occlusion_cull() {
+	return memnew(RaycastOcclusionCull);
+}
 
 void initialize_raycast_module(ModuleInitializationLevel p_level) {
+	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
+		// Created by the scene renderer, which owns it.
+		RendererSceneOcclusionCull::create_func = _create_raycast_occlusion_cull;
+	}
+
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
@@ -45,17 +52,17 @@ void initialize_raycast_module(ModuleInitializationLevel p_level) {
 	LightmapRaycasterEmbree::make_default_raycaster();
 	StaticRaycasterEmbree::make_default_raycaster();
 #endif
-	raycast_occlusion_cull = memnew(RaycastOcclusionCull);
 }
 
 void uninitialize_raycast_module(ModuleInitializationLevel p_level) {
+	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
+		RendererSceneOcclusionCull::create_func = nullptr;
+	}
+
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
 
-	if (raycast_occlusion_cull) {
-		memdelete(raycast_occlusion_cull);
-	}
 #ifdef TOOLS_ENABLED
 	StaticRaycasterEmbree::free();
 #endif
@@ -0,0 +1,118 @@
+#include "ruby_bytecode_cache.h"
+
+#include "core/io/file_access.h"
+#include "modules/ruby/context/ruby_eval_context.h"
+#include "mruby.h"
+#include "mruby/compile.h"
+#include "mruby/dump.h"
+#include "mruby/proc.h"
+
+Mutex RubyBytecodeCache::mutex;
+HashMap<String, RubyBytecodeCache::Entry> RubyBytecodeCache::entries;
+
+String RubyBytecodeCache::get_bytecode_path(const String &p_path) {
+	return p_path.get_basename() + ".mrb";
+}
+
+Vector<uint8_t> RubyBytecodeCache::compile(mrb_state *p_mrb, const char *p_source, int64_t p_length, const String &p_filename, String *r_error) {
+	Vector<uint8_t> bytecode;
+	const int arena_index = mrb_gc_arena_save(p_mrb);
+
+	mrb_ccontext *compile_context = mrb_ccontext_new(p_mrb);
+	CharString filename = p_filename.utf8();
+	mrb_ccontext_filename(p_mrb, compile_context, filename.get_data());
+	compile_context->capture_errors = true;
+
+	mrb_parser_state *parser = mrb_parse_nstring(p_mrb, p_source, p_length, compile_context);
+	if (!parser) {
+		if (r_error) {
+			*r_error = "Failed to create parser.";
+		}
+	} else if (parser->nerr > 0) {
+		if (r_error) {
+			*r_error = vformat("Line %d: %s", parser->error_buffer[0].lineno, String::utf8(parser->error_buffer[0].message));
+		}
+	} else {
+		RProc *proc = mrb_generate_code(p_mrb, parser);
+		uint8_t *bin = nullptr;
+		size_t bin_size = 0;
+		// Keep the debug info, require_relative needs the file names.
+		if (proc && mrb_dump_irep(p_mrb, proc->body.irep, MRB_DUMP_DEBUG_INFO, &bin, &bin_size) == MRB_DUMP_OK) {
+			bytecode.resize(bin_size);
+			memcpy(bytecode.ptrw(), bin, bin_size);
+		} else if (r_error) {
+			*r_error = "Failed to generate bytecode.";
+		}
+		mrb_free(p_mrb, bin);
+	}
+
+	if (parser) {
+		mrb_parser_free(parser);
+	}
+	mrb_ccontext_free(p_mrb, compile_context);
+	mrb_gc_arena_restore(p_mrb, arena_index);
+	return bytecode;
+}
+
+Vector<uint8_t> RubyBytecodeCache::compile_file(mrb_state *p_mrb, const String &p_path, String *r_error) {
+	Error err = OK;
+	Vector<uint8_t> file = FileAccess::get_file_as_bytes(p_path, &err);
+	if (err != OK) {
+		if (r_error) {
+			*r_error = vformat("Can't read file (%s).", error_names[err]);
+		}
+		return Vector<uint8_t>();
+	}
+	return compile(p_mrb, file.is_empty() ? "" : reinterpret_cast<const char *>(file.ptr()), file.size(), p_path, r_error);
+}
+
+Vector<uint8_t> RubyBytecodeCache::get_bytecode(mrb_state *p_mrb, const String &p_path) {
+	// Files can only change while the editor is running.
+	uint64_t modified_time = 0;
+#ifdef TOOLS_ENABLED
+	modified_time = FileAccess::get_modified_time(p_path);
+#endif
+
+	{
+		MutexLock lock(mutex);
+		const Entry *entry = entries.getptr(p_path);
+		if (entry && entry->modified_time == modified_time) {
+			return entry->bytecode;
+		}
+	}
+
+	Vector<uint8_t> bytecode;
+	String bytecode_path = get_bytecode_path(p_path);
+	bool use_bytecode_file = FileAccess::exists(bytecode_path);
+#ifdef TOOLS_ENABLED
+	// A `.mrb` left next to an edited script would run old code. Exported files have no modification time.
+	use_bytecode_file = use_bytecode_file && FileAccess::get_modified_time(bytecode_path) >= modified_time;
+#endif
+	if (use_bytecode_file) {
+		bytecode = FileAccess::get_file_as_bytes(bytecode_path);
+	} else {
+		Ref<RubyFile> file = RubyEvalContext::try_load_ruby_file(p_path);
+		if (!file.is_valid()) {
+			return bytecode;
+		}
+
+		const CharString &source = file->get_source();
+		String error;
+		bytecode = compile(p_mrb, source.get_data(), source.length(), p_path, &error);
+		if (bytecode.is_empty()) {
+			print_error(vformat("Failed to compile ruby file '%s': %s", p_path, error));
+			return bytecode;
+		}
+	}
+
+	MutexLock lock(mutex);
+	Entry &entry = entries[p_path];
+	entry.bytecode = bytecode;
+	entry.modified_time = modified_time;
+	return bytecode;
+}
+
+void RubyBytecodeCache::clear() {
+	MutexLock lock(mutex);
+	entries.clear();
+}
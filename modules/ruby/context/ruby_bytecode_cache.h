@@ -0,0 +1,28 @@
+#pragma once
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/vector.h"
+
+struct mrb_state;
+
+// Compiled RITE bytecode of Ruby files, so each file is only parsed once per process.
+// Exported projects contain the bytecode as `.mrb` files next to the source paths, which are loaded as-is.
+// In editor builds, a `.mrb` file older than its source is ignored.
+class RubyBytecodeCache {
+	struct Entry {
+		Vector<uint8_t> bytecode;
+		uint64_t modified_time = 0;
+	};
+
+	static Mutex mutex;
+	static HashMap<String, Entry> entries;
+
+public:
+	static String get_bytecode_path(const String &p_path);
+	static Vector<uint8_t> compile(mrb_state *p_mrb, const char *p_source, int64_t p_length, const String &p_filename, String *r_error = nullptr);
+	// Compiles the source file as it is on disk, like the export plugin does.
+	static Vector<uint8_t> compile_file(mrb_state *p_mrb, const String &p_path, String *r_error = nullptr);
+	static Vector<uint8_t> get_bytecode(mrb_state *p_mrb, const String &p_path);
+	static void clear();
+};
@@ -3,25 +3,35 @@
 #include "mruby.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
+#include "core/io/resource_uid.h"
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
+#include "modules/ruby/context/ruby_bytecode_cache.h"
+#include "modules/ruby/context/ruby_vm_pool.h"
 #include "modules/ruby/mruby_print.h"
 #include "modules/ruby/resource/ruby_file.h"
 #include "mruby/array.h"
 #include "mruby/compile.h"
 #include "mruby/debug.h"
+#include "mruby/irep.h"
 #include "mruby/hash.h"
 #include "mruby/proc.h"
 #include "mruby/string.h"
 #include "mruby/variable.h"
 
-String ruby_to_string(mrb_state *p_mrb, mrb_value p_str) {
-	mrb_value str = mrb_obj_as_string(p_mrb, p_str);
-	const char *cstr = RSTRING_PTR(str);
-	mrb_int len = RSTRING_LEN(str);
-	Span s = Span(cstr, (uint64_t)len);
-	String godot_str;
-	godot_str.append_ascii(s);
-	return godot_str;
+String ruby_to_string(mrb_state *p_mrb, mrb_value p_value) {
+	if (mrb_symbol_p(p_value)) {
+		return ruby_symbol_to_string(p_mrb, mrb_symbol(p_value));
+	}
+	mrb_value str = mrb_obj_as_string(p_mrb, p_value);
+	return String::utf8(RSTRING_PTR(str), RSTRING_LEN(str));
+}
+
+String ruby_symbol_to_string(mrb_state *p_mrb, mrb_sym p_sym) {
+	// Reads the symbol table entry directly instead of allocating a ruby string first.
+	mrb_int len = 0;
+	const char *name = mrb_sym_name_len(p_mrb, p_sym, &len);
+	return String::utf8(name, len);
 }
 
 void ensure_absolute_ruby_file(String &path) {
@@ -36,13 +46,9 @@ void ensure_absolute_ruby_file(String &path) {
 	}
 }
 
-CharString string_to_c(const String &p_str) {
-	return p_str.ascii(true);
-}
-
 mrb_value string_to_ruby(mrb_state *mrb, const String &p_str) {
-	CharString str_c = string_to_c(p_str);
-	return mrb_str_new(mrb, str_c.ptr(), str_c.length());
+	CharString str_c = p_str.utf8();
+	return mrb_str_new(mrb, str_c.get_data(), str_c.length());
 }
 
 const char *mrb_get_calling_file(mrb_state *p_mrb) {
@@ -161,9 +167,7 @@ void StoryCharacter::init_from_mrb(mrb_state *mrb, mrb_value self) {
 	// Get @emotion instance variable (it's a symbol)
 	mrb_value emotion_val = mrb_iv_get(mrb, self, mrb_intern_lit(mrb, "@emotion"));
 	if (mrb_symbol_p(emotion_val)) {
-		mrb_sym emotion_sym = mrb_symbol(emotion_val);
-		mrb_value emotion_str = mrb_sym_str(mrb, emotion_sym);
-		this->emotion = ruby_to_string(mrb, emotion_str);
+		this->emotion = ruby_symbol_to_string(mrb, mrb_symbol(emotion_val));
 	}
 }
 
@@ -221,13 +225,7 @@ void StoryOption::_bind_methods() {
 void StoryOption::init_from_mrb(mrb_state *mrb, mrb_value self) {
 	// Get @id instance variable (could be symbol or string)
 	mrb_value id_val = mrb_iv_get(mrb, self, mrb_intern_lit(mrb, "@id"));
-	if (mrb_symbol_p(id_val)) {
-		mrb_sym id_sym = mrb_symbol(id_val);
-		mrb_value id_str = mrb_sym_str(mrb, id_sym);
-		this->id = ruby_to_string(mrb, id_str);
-	} else {
-		this->id = ruby_to_string(mrb, id_val);
-	}
+	this->id = ruby_to_string(mrb, id_val);
 
 	// Get @text instance variable
 	mrb_value text_val = mrb_iv_get(mrb, self, mrb_intern_lit(mrb, "@text"));
@@ -283,13 +281,7 @@ void StoryChoice::init_from_mrb(mrb_state *mrb, mrb_value self) {
 
 	// Get @id instance variable (could be symbol or string)
 	mrb_value id_val = mrb_iv_get(mrb, self, mrb_intern_lit(mrb, "@id"));
-	if (mrb_symbol_p(id_val)) {
-		mrb_sym id_sym = mrb_symbol(id_val);
-		mrb_value id_str = mrb_sym_str(mrb, id_sym);
-		this->id = ruby_to_string(mrb, id_str);
-	} else {
-		this->id = ruby_to_string(mrb, id_val);
-	}
+	this->id = ruby_to_string(mrb, id_val);
 
 	// Get @question instance variable
 	mrb_value question_val = mrb_iv_get(mrb, self, mrb_intern_lit(mrb, "@question"));
@@ -329,6 +321,8 @@ void RubyEvalContext::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("eval_file", "path"), &RubyEvalContext::eval_file);
 	ClassDB::bind_method(D_METHOD("resume"), &RubyEvalContext::resume);
 	ClassDB::bind_method(D_METHOD("choose", "option_id"), &RubyEvalContext::choose);
+	ClassDB::bind_static_method("RubyEvalContext", D_METHOD("resume_batch", "contexts"), &RubyEvalContext::resume_batch);
+	ClassDB::bind_static_method("RubyEvalContext", D_METHOD("prewarm_vms", "count"), &RubyEvalContext::prewarm_vms);
 	ADD_SIGNAL(MethodInfo("on_say", PropertyInfo(Variant::OBJECT, "character", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT, "StoryVoiceline")));
 	ADD_SIGNAL(MethodInfo("on_choice", PropertyInfo(Variant::OBJECT, "choice", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT, "StoryChoice")));
 	ADD_SIGNAL(MethodInfo("on_show_character", PropertyInfo(Variant::OBJECT, "character", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT, "StoryCharacter")));
@@ -344,77 +338,162 @@ mrb_mruby_fiber_gem_init(mrb_state *mrb);
 
 void
 mrb_mruby_catch_gem_init(mrb_state *mrb);
+}
+
+// Evaluated in every new context, their bytecode is only compiled once per process.
+static const char *const stdlib_files[] = {
+	"res://mruby/mrblib/00class.rb",
+	"res://mruby/mrblib/00kernel.rb",
+	"res://mruby/mrblib/10error.rb",
+	"res://mruby/mrblib/array.rb",
+	"res://mruby/mrblib/compar.rb",
+	"res://mruby/mrblib/enum.rb",
+	"res://mruby/mrblib/hash.rb",
+	"res://mruby/mrblib/kernel.rb",
+	"res://mruby/mrblib/numeric.rb",
+	"res://mruby/mrblib/range.rb",
+	"res://mruby/mrblib/string.rb",
+	"res://mruby/mrblib/symbol.rb",
+	"res://mruby/mrblib/catch.rb",
+};
+
+static RClass *get_story_class(mrb_state *mrb, const char *p_name) {
+	if (!mrb_class_defined(mrb, p_name)) {
+		print_error(vformat("Ruby story runtime doesn't define class %s.", p_name));
+		return nullptr;
+	}
+	return mrb_class_get(mrb, p_name);
+}
 
-RProc *
-mrb_create_proc_from_string(mrb_state *mrb, const char *s, mrb_int len, mrb_value binding, const char *file, mrb_int line);
+void RubyEvalContext::init_vm(RubyVM *p_vm) {
+	mrb_state *mrb = p_vm->mrb;
+
+	// Register custom print functions that redirect to Godot's printing system
+	// This hooks puts, print, p, and all other output
+	mrb_init_godot_print(mrb);
+	mrb_mruby_fiber_gem_init(mrb);
+	mrb_mruby_catch_gem_init(mrb);
+	mrb_show_version(mrb);
+
+	for (const char *stdlib_file : stdlib_files) {
+		compile_from_disk(mrb, stdlib_file);
+	}
+
+	mrb_define_method(mrb, mrb->kernel_module, "require", &godot_require, MRB_ARGS_ARG(1, 0));
+	mrb_define_method(mrb, mrb->kernel_module, "require_relative", &godot_require_relative, MRB_ARGS_ARG(1, 0));
+
+	compile_from_disk(mrb, "res://mruby/runtime.rb");
+
+	p_vm->choice_class = get_story_class(mrb, "Choice");
+	p_vm->voice_line_class = get_story_class(mrb, "VoiceLine");
+	p_vm->scene_class = get_story_class(mrb, "Scene");
+	p_vm->character_class = get_story_class(mrb, "Character");
 }
 
 void RubyEvalContext::eval_file(const String &p_path) {
-	// Initialize mruby runtime
-	mruby_state = mrb_open();
-	if (mruby_state) {
-		// Add this as user data so bound methods can get back at the game state.
-		mruby_state->ud = this;
-
-		// Register custom print functions that redirect to Godot's printing system
-		// This hooks puts, print, p, and all other output
-		mrb_init_godot_print(mruby_state);
-		mrb_mruby_fiber_gem_init(mruby_state);
-		mrb_mruby_catch_gem_init(mruby_state);
-		mrb_show_version(mruby_state);
-
-		compile_from_disk("res://mruby/mrblib/00class.rb");
-		compile_from_disk("res://mruby/mrblib/00kernel.rb");
-		compile_from_disk("res://mruby/mrblib/10error.rb");
-		compile_from_disk("res://mruby/mrblib/array.rb");
-		compile_from_disk("res://mruby/mrblib/compar.rb");
-		compile_from_disk("res://mruby/mrblib/enum.rb");
-		compile_from_disk("res://mruby/mrblib/hash.rb");
-		compile_from_disk("res://mruby/mrblib/kernel.rb");
-		compile_from_disk("res://mruby/mrblib/numeric.rb");
-		compile_from_disk("res://mruby/mrblib/range.rb");
-		compile_from_disk("res://mruby/mrblib/string.rb");
-		compile_from_disk("res://mruby/mrblib/symbol.rb");
-		compile_from_disk("res://mruby/mrblib/catch.rb");
-
-		mrb_define_method(mruby_state, mruby_state->kernel_module, "require", &godot_require, MRB_ARGS_ARG(1, 0));
-		mrb_define_method(mruby_state, mruby_state->kernel_module, "require_relative", &godot_require_relative, MRB_ARGS_ARG(1, 0));
-
-		compile_from_disk("res://mruby/runtime.rb");
-
-		mrb_value fiber = compile_to_fibre(mruby_state, p_path);
-		if (mrb_nil_p(fiber)) {
-			return;
-		}
+	terminate();
 
-		current_fiber = fiber;
-		mrb_value result = mrb_fiber_resume(mruby_state, fiber, 0, nullptr);
-		handle_fiber_result(result, fiber);
-	} else {
+	vm = RubyVMPool::acquire(this);
+	if (!vm) {
 		print_error("Failed to initialize mruby");
+		return;
+	}
+	mruby_state = vm->mrb;
+
+	mrb_value fiber = compile_to_fibre(mruby_state, p_path);
+	if (mrb_nil_p(fiber)) {
+		return;
 	}
+
+	// The fiber is only referenced from here, keep the GC from collecting it.
+	current_fiber = fiber;
+	mrb_gc_register(mruby_state, current_fiber);
+	_resume_fiber(0, nullptr);
+	_emit_pending_signal();
 }
 
 void RubyEvalContext::terminate() {
 	// Clean up mruby runtime
-	if (mruby_state) {
+	if (vm) {
+		if (!mrb_nil_p(current_fiber)) {
+			mrb_gc_unregister(mruby_state, current_fiber);
+		}
 		current_fiber = mrb_nil_value();
-		mrb_close(mruby_state);
+		RubyVMPool::release(vm);
+		vm = nullptr;
 		mruby_state = nullptr;
 	}
 }
 
 void RubyEvalContext::resume() {
-	mrb_value result = mrb_fiber_resume(mruby_state, current_fiber, 0, nullptr);
-	handle_fiber_result(result, current_fiber);
+	ERR_FAIL_NULL(mruby_state);
+	_resume_fiber(0, nullptr);
+	_emit_pending_signal();
 }
 
 void RubyEvalContext::choose(StringName option_id) {
+	ERR_FAIL_NULL(mruby_state);
 	mrb_value argv = string_to_ruby(mruby_state, option_id);
-	mrb_value result = mrb_fiber_resume(mruby_state, current_fiber, 1, &argv);
+	_resume_fiber(1, &argv);
+	_emit_pending_signal();
+}
+
+void RubyEvalContext::resume_batch(const TypedArray<RubyEvalContext> &p_contexts) {
+	// Each context has a VM of its own, so different contexts can run on different threads.
+	LocalVector<RubyEvalContext *> contexts;
+	HashSet<RubyEvalContext *> added_contexts;
+	for (int i = 0; i < p_contexts.size(); i++) {
+		RubyEvalContext *context = Object::cast_to<RubyEvalContext>(p_contexts[i]);
+		ERR_CONTINUE(!context || !context->mruby_state);
+		if (added_contexts.has(context)) {
+			continue;
+		}
+		added_contexts.insert(context);
+		contexts.push_back(context);
+	}
+
+	if (contexts.size() == 1) {
+		contexts[0]->_resume_fiber(0, nullptr);
+	} else if (contexts.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&RubyEvalContext::_resume_batch_task, contexts.ptr(), contexts.size(), -1, true, SNAME("RubyEvalContextResume"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	for (RubyEvalContext *context : contexts) {
+		context->_emit_pending_signal();
+	}
+}
+
+void RubyEvalContext::_resume_batch_task(void *p_userdata, uint32_t p_index) {
+	RubyEvalContext *context = static_cast<RubyEvalContext **>(p_userdata)[p_index];
+	context->_resume_fiber(0, nullptr);
+}
+
+void RubyEvalContext::prewarm_vms(int p_count) {
+	RubyVMPool::prewarm(p_count);
+}
+
+void RubyEvalContext::_resume_fiber(int p_argc, const mrb_value *p_argv) {
+	mrb_value result = mrb_fiber_resume(mruby_state, current_fiber, p_argc, p_argv);
 	handle_fiber_result(result, current_fiber);
 }
 
+void RubyEvalContext::_emit_pending_signal() {
+	if (pending_signal.is_empty()) {
+		return;
+	}
+
+	StringName signal = pending_signal;
+	Variant argument = pending_argument;
+	pending_signal = StringName();
+	pending_argument = Variant();
+	emit_signal(signal, argument);
+}
+
+RubyEvalContext::~RubyEvalContext() {
+	terminate();
+}
+
 mrb_value RubyEvalContext::compile_from_disk(const String &p_path, mrb_ccontext *p_compile_context) {
 	return compile_from_disk(mruby_state, p_path, p_compile_context);
 }
@@ -431,32 +510,32 @@ void RubyEvalContext::handle_fiber_result(mrb_value result, mrb_value fiber) {
 			}
 			break;
 		} else if (mrb_object_p(result)) {
-			CharString classname = mrb_obj_classname(mruby_state, result);
-			if (classname == "Choice") {
+			RClass *result_class = mrb_obj_class(mruby_state, result);
+			if (result_class == vm->choice_class) {
 				Ref<StoryChoice> choice;
 				choice.instantiate();
 				choice->init_from_mrb(mruby_state, result);
 				_on_choice(choice);
 				break;
-			} else if (classname == "VoiceLine") {
+			} else if (result_class == vm->voice_line_class) {
 				Ref<StoryVoiceLine> voice_line;
 				voice_line.instantiate();
 				voice_line->init_from_mrb(mruby_state, result);
 				_on_say(voice_line);
 				break;
-			} else if (classname == "Scene") {
+			} else if (result_class == vm->scene_class) {
 				mrb_value id_val = mrb_iv_get(mruby_state, result, mrb_intern_lit(mruby_state, "@name"));
 				StringName name = ruby_to_string(mruby_state, id_val);
 				_on_show_scene(name);
 				break;
-			} else if (classname == "Character") {
+			} else if (result_class == vm->character_class) {
 				Ref<StoryCharacter> character;
 				character.instantiate();
 				character->init_from_mrb(mruby_state, result);
 				_on_show_character(character);
 				break;
 			} else {
-				print_error(vformat("unrecognized classname from ruby: %s", classname.ptr()));
+				print_error(vformat("unrecognized classname from ruby: %s", mrb_obj_classname(mruby_state, result)));
 				result = mrb_fiber_resume(mruby_state, fiber, 0, nullptr);
 			}
 		} else {
@@ -468,7 +547,6 @@ void RubyEvalContext::handle_fiber_result(mrb_value result, mrb_value fiber) {
 
 Ref<RubyFile> RubyEvalContext::try_load_ruby_file(const String &p_path) {
 	Error err = OK;
-	String lib_file = FileAccess::get_file_as_string(p_path, &err);
 	Ref<RubyFile> file = ResourceLoader::load(p_path, "RubyFile", ResourceFormatLoader::CACHE_MODE_REUSE, &err);
 	if (err != OK) {
 		print_error(vformat("Failed to load ruby file '%s': %s", p_path, err ? error_names[err] : "unknown error - check log."));
@@ -481,29 +559,26 @@ mrb_value RubyEvalContext::compile_from_disk(mrb_state *mrb, const String &p_pat
 	mrb_value result = mrb_nil_value();
 	String path = p_path;
 	ensure_absolute_ruby_file(path);
-	Ref<RubyFile> file = try_load_ruby_file(path);
-	if (!file.is_valid()) {
+	path = ResourceUID::ensure_path(path);
+
+	HashSet<StringName> &already_required_files_ref = RubyVMPool::get_vm(mrb)->required_files;
+	if (already_required_files_ref.has(path)) {
 		return result;
 	}
 
-	print_verbose(vformat("Loading ruby file %s", path));
-	HashSet<StringName> &already_required_files_ref = get_owning_eval_context(mrb)->already_required_files;
-	if (already_required_files_ref.has(path)) {
+	Vector<uint8_t> bytecode = RubyBytecodeCache::get_bytecode(mrb, path);
+	if (bytecode.is_empty()) {
 		return result;
 	}
 
+	print_verbose(vformat("Loading ruby file %s", path));
 	already_required_files_ref.insert(path);
 	const int arena_index = mrb_gc_arena_save(mrb);
 	if (!p_compile_context) {
-		mrb_ccontext *compile_context = mrb_ccontext_new(mrb);
-		CharString filename = path.ascii(true);
-		mrb_ccontext_filename(mrb, compile_context, filename.ptr());
-		compile_context->capture_errors = true;
-		result = mrb_load_string_cxt(mrb, file->get_text().ascii(true).get_data(), compile_context);
+		result = mrb_load_irep_buf(mrb, bytecode.ptr(), bytecode.size());
 		mrb_print_error(mrb);
-		mrb_ccontext_free(mrb, compile_context);
 	} else {
-		result = mrb_load_string_cxt(mrb, file->get_text().ascii(true).get_data(), p_compile_context);
+		result = mrb_load_irep_buf_cxt(mrb, bytecode.ptr(), bytecode.size(), p_compile_context);
 	}
 	mrb_gc_arena_restore(mrb, arena_index);
 	return result;
@@ -513,42 +588,50 @@ mrb_value RubyEvalContext::compile_to_fibre(mrb_state *mrb, const String &p_path
 	mrb_value result = mrb_nil_value();
 	String path = p_path;
 	ensure_absolute_ruby_file(path);
-	Ref<RubyFile> file = try_load_ruby_file(path);
-	if (!file.is_valid()) {
+	path = ResourceUID::ensure_path(path);
+
+	Vector<uint8_t> bytecode = RubyBytecodeCache::get_bytecode(mrb, path);
+	if (bytecode.is_empty()) {
 		return result;
 	}
 
-	CharString file_content = string_to_c(file->get_text());
-	CharString filename = string_to_c(path);
-	RProc *proc = mrb_create_proc_from_string(mrb, file_content.ptr(), file_content.length(), mrb_nil_value(), filename.ptr(), 1);
+	// Only create the top level proc, it runs when the fiber is resumed.
+	mrb_ccontext *load_context = mrb_ccontext_new(mrb);
+	load_context->no_exec = true;
+	mrb_value proc = mrb_load_irep_buf_cxt(mrb, bytecode.ptr(), bytecode.size(), load_context);
+	mrb_ccontext_free(mrb, load_context);
+	if (!mrb_proc_p(proc)) {
+		mrb_print_error(mrb);
+		return result;
+	}
 
-	result = mrb_fiber_new(mrb, proc);
+	result = mrb_fiber_new(mrb, mrb_proc_ptr(proc));
 	mrb_print_error(mrb);
 	return result;
 }
 
 RubyEvalContext *RubyEvalContext::get_owning_eval_context(mrb_state *mrb) {
-	RubyEvalContext *ruby_eval_context = static_cast<RubyEvalContext *>(mrb->ud);
-	if (ruby_eval_context->mruby_state == mrb) {
-		return ruby_eval_context;
-	}
-	return nullptr;
+	return RubyVMPool::get_vm(mrb)->owner;
 }
 
 void RubyEvalContext::_on_say(Ref<StoryVoiceLine> p_voiceline) {
-	emit_signal("on_say", p_voiceline);
+	pending_signal = SNAME("on_say");
+	pending_argument = p_voiceline;
 }
 
 void RubyEvalContext::_on_choice(Ref<StoryChoice> p_choice) {
-	emit_signal("on_choice", p_choice);
+	pending_signal = SNAME("on_choice");
+	pending_argument = p_choice;
 }
 
 
 void RubyEvalContext::_on_show_character(Ref<StoryCharacter> p_character) {
-	emit_signal("on_show_character", p_character);
+	pending_signal = SNAME("on_show_character");
+	pending_argument = p_character;
 }
 
 
 void RubyEvalContext::_on_show_scene(StringName p_scene_name) {
-	emit_signal("on_show_scene", p_scene_name);
+	pending_signal = SNAME("on_show_scene");
+	pending_argument = p_scene_name;
 }
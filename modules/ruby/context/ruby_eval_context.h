@@ -10,6 +10,11 @@ struct mrb_state;
 struct mrb_ccontext;
 struct RFiber;
 struct RProc;
+struct RubyVM;
+
+// Ruby strings are UTF-8, these decode them into Godot strings in a single pass.
+String ruby_to_string(mrb_state *p_mrb, mrb_value p_value);
+String ruby_symbol_to_string(mrb_state *p_mrb, mrb_sym p_sym);
 
 class StoryCharacter : public RefCounted {
 	GDCLASS(StoryCharacter, RefCounted)
@@ -88,22 +93,36 @@ public:
 	void resume();
 	void choose(StringName option_id);
 
+	// Resumes the fibers of all contexts on worker threads, then emits their signals in order on the calling thread.
+	static void resume_batch(const TypedArray<RubyEvalContext> &p_contexts);
+	static void prewarm_vms(int p_count);
+
 	mrb_value compile_from_disk(const String &p_path, mrb_ccontext *p_compile_context = nullptr);
 
 	static Ref<RubyFile> try_load_ruby_file(const String &p_path);
 	static mrb_value compile_from_disk(mrb_state *mrb, const String &p_path, mrb_ccontext *p_compile_context = nullptr);
 	static mrb_value compile_to_fibre(mrb_state *mrb, const String &p_path);
 
+	static void init_vm(RubyVM *p_vm);
 	static RubyEvalContext *get_owning_eval_context(mrb_state *mrb);
 
+	~RubyEvalContext();
+
 private:
 	void _on_say(Ref<StoryVoiceLine> p_voiceline);
 	void _on_choice(Ref<StoryChoice> p_choice);
 	void _on_show_character(Ref<StoryCharacter> p_character);
 	void _on_show_scene(StringName p_scene_name);
 
-	mrb_state *mruby_state;
-	mrb_value current_fiber;
+	void _resume_fiber(int p_argc, const mrb_value *p_argv);
+	void _emit_pending_signal();
+	static void _resume_batch_task(void *p_userdata, uint32_t p_index);
+
+	RubyVM *vm = nullptr;
+	mrb_state *mruby_state = nullptr;
+	mrb_value current_fiber = mrb_nil_value();
 
-	HashSet<StringName> already_required_files;
+	// Fibers can be resumed on worker threads, so the signal for their result is emitted afterwards.
+	StringName pending_signal;
+	Variant pending_argument;
 };
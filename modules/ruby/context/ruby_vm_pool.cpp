@@ -0,0 +1,162 @@
+#include "ruby_vm_pool.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "modules/ruby/context/ruby_eval_context.h"
+#include "mruby.h"
+#include "mruby/array.h"
+#include "mruby/internal.h"
+#include "mruby/variable.h"
+
+Mutex RubyVMPool::mutex;
+LocalVector<RubyVM *> RubyVMPool::free_vms;
+
+// `global_variables`, `constants` and `instance_variables` come from the mruby-metaprog gem, which isn't built,
+// so the variable tables are read through the C API instead. Unlike method calls, these can't raise.
+static int _collect_variable(mrb_state *p_mrb, mrb_sym p_name, mrb_value p_value, void *p_userdata) {
+	static_cast<LocalVector<mrb_sym> *>(p_userdata)->push_back(p_name);
+	return 0;
+}
+
+static LocalVector<mrb_sym> _get_variables(mrb_state *p_mrb, mrb_value p_object) {
+	LocalVector<mrb_sym> names;
+	mrb_iv_foreach(p_mrb, p_object, &_collect_variable, &names);
+	return names;
+}
+
+static LocalVector<mrb_sym> _get_globals(mrb_state *p_mrb) {
+	LocalVector<mrb_sym> names;
+	int arena_index = mrb_gc_arena_save(p_mrb);
+	mrb_value globals = mrb_f_global_variables(p_mrb, mrb_top_self(p_mrb));
+	for (mrb_int i = 0; i < RARRAY_LEN(globals); i++) {
+		names.push_back(mrb_symbol(RARRAY_PTR(globals)[i]));
+	}
+	mrb_gc_arena_restore(p_mrb, arena_index);
+	return names;
+}
+
+RubyVM *RubyVMPool::_create_vm() {
+	mrb_state *mrb = mrb_open();
+	if (!mrb) {
+		return nullptr;
+	}
+
+	RubyVM *vm = memnew(RubyVM);
+	vm->mrb = mrb;
+	mrb->ud = vm;
+	RubyEvalContext::init_vm(vm);
+
+	for (mrb_sym global : _get_globals(mrb)) {
+		vm->runtime_globals.insert(global);
+	}
+	// Constants are stored with the instance variables of their class.
+	for (mrb_sym constant : _get_variables(mrb, mrb_obj_value(mrb->object_class))) {
+		vm->runtime_constants.insert(constant);
+	}
+
+	return vm;
+}
+
+void RubyVMPool::_reset_vm(RubyVM *p_vm) {
+	mrb_state *mrb = p_vm->mrb;
+	// An error the story didn't handle was already reported by its context.
+	mrb->exc = nullptr;
+
+	for (mrb_sym global : _get_globals(mrb)) {
+		if (!p_vm->runtime_globals.has(global)) {
+			mrb_gv_remove(mrb, global);
+		}
+	}
+
+	mrb_value object = mrb_obj_value(mrb->object_class);
+	for (mrb_sym constant : _get_variables(mrb, object)) {
+		if (!p_vm->runtime_constants.has(constant)) {
+			mrb_iv_remove(mrb, object, constant);
+		}
+	}
+
+	mrb_value top_self = mrb_top_self(mrb);
+	for (mrb_sym instance_variable : _get_variables(mrb, top_self)) {
+		mrb_iv_remove(mrb, top_self, instance_variable);
+	}
+
+	// The classes defined by required files were removed, so they have to be loaded again.
+	p_vm->required_files.clear();
+	p_vm->owner = nullptr;
+
+	// Collects the fibers and objects of the story.
+	mrb_full_gc(mrb);
+}
+
+void RubyVMPool::_destroy_vm(RubyVM *p_vm) {
+	mrb_close(p_vm->mrb);
+	memdelete(p_vm);
+}
+
+void RubyVMPool::_create_vm_task(void *p_userdata, uint32_t p_index) {
+	RubyVM *vm = _create_vm();
+	if (!vm) {
+		return;
+	}
+
+	MutexLock lock(mutex);
+	free_vms.push_back(vm);
+}
+
+RubyVM *RubyVMPool::get_vm(mrb_state *p_mrb) {
+	return static_cast<RubyVM *>(p_mrb->ud);
+}
+
+RubyVM *RubyVMPool::acquire(RubyEvalContext *p_owner) {
+	RubyVM *vm = nullptr;
+	{
+		MutexLock lock(mutex);
+		if (!free_vms.is_empty()) {
+			vm = free_vms[free_vms.size() - 1];
+			free_vms.remove_at(free_vms.size() - 1);
+		}
+	}
+
+	if (!vm) {
+		vm = _create_vm();
+		if (!vm) {
+			return nullptr;
+		}
+	}
+
+	vm->owner = p_owner;
+	return vm;
+}
+
+void RubyVMPool::release(RubyVM *p_vm) {
+	_reset_vm(p_vm);
+
+	MutexLock lock(mutex);
+	free_vms.push_back(p_vm);
+}
+
+void RubyVMPool::prewarm(int p_count) {
+	int missing = 0;
+	{
+		MutexLock lock(mutex);
+		missing = p_count - int(free_vms.size());
+	}
+	if (missing <= 0) {
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&RubyVMPool::_create_vm_task, nullptr, missing, -1, true, SNAME("RubyVMPoolPrewarm"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+int RubyVMPool::get_free_vm_count() {
+	MutexLock lock(mutex);
+	return free_vms.size();
+}
+
+void RubyVMPool::clear() {
+	MutexLock lock(mutex);
+	for (RubyVM *vm : free_vms) {
+		_destroy_vm(vm);
+	}
+	free_vms.clear();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "core/os/mutex.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+struct mrb_state;
+struct RClass;
+class RubyEvalContext;
+
+// An mruby VM with the stdlib and the story runtime loaded, stored in `mrb->ud`.
+struct RubyVM {
+	mrb_state *mrb = nullptr;
+	RubyEvalContext *owner = nullptr;
+	HashSet<StringName> required_files;
+
+	// Global variables and constants defined by the runtime, the ones a story adds are removed when the VM is released.
+	HashSet<uint32_t> runtime_globals;
+	HashSet<uint32_t> runtime_constants;
+
+	// Classes of the objects yielded by story fibers, compared by pointer instead of by name.
+	RClass *choice_class = nullptr;
+	RClass *voice_line_class = nullptr;
+	RClass *scene_class = nullptr;
+	RClass *character_class = nullptr;
+};
+
+// Keeps VMs ready for new story contexts, so starting a story doesn't have to wait for the runtime to load.
+// Released VMs go back to the pool after the globals, constants and top-level instance variables the story
+// defined are removed. Methods a story adds to existing classes stay, like with `require` in a single VM.
+class RubyVMPool {
+	static Mutex mutex;
+	static LocalVector<RubyVM *> free_vms;
+
+	static RubyVM *_create_vm();
+	static void _create_vm_task(void *p_userdata, uint32_t p_index);
+	static void _reset_vm(RubyVM *p_vm);
+	static void _destroy_vm(RubyVM *p_vm);
+
+public:
+	static RubyVM *get_vm(mrb_state *p_mrb);
+
+	static RubyVM *acquire(RubyEvalContext *p_owner);
+	static void release(RubyVM *p_vm);
+	// Creates VMs on worker threads until p_count are ready.
+	static void prewarm(int p_count);
+	static int get_free_vm_count();
+	static void clear();
+};
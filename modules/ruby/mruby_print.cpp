@@ -30,22 +30,14 @@ mrb_value godot_puts(mrb_state *mrb, mrb_value self) {
 
 	for (mrb_int i = 0; i < argc; i++) {
 		mrb_value str = mrb_obj_as_string(mrb, argv[i]);
-		const char *cstr = RSTRING_PTR(str);
-		mrb_int len = RSTRING_LEN(str);
-
-		Span s = Span(cstr, (uint64_t)len);
-		String godot_str;
-		godot_str.append_ascii(s);
-		print_line(godot_str);
+		print_line(String::utf8(RSTRING_PTR(str), RSTRING_LEN(str)));
 	}
 
 	return mrb_nil_value();
 }
 
 void print(const char *str, size_t len, int stream) {
-	Span s = Span(str, (uint64_t)len);
-	String godot_str;
-	godot_str.append_ascii(s);
+	String godot_str = String::utf8(str, len);
 	if (stream == 0) {
 		__print_line_rich(godot_str);
 	}
@@ -30,7 +30,9 @@
 
 #include "register_types.h"
 
+#include "context/ruby_bytecode_cache.h"
 #include "context/ruby_eval_context.h"
+#include "context/ruby_vm_pool.h"
 #include "core/object/class_db.h"
 #include "core/variant/variant.h"
 #include "resource/ruby_file_loader.h"
@@ -38,8 +40,59 @@
 
 #include <mruby.h>
 
+#ifdef TOOLS_ENABLED
+#include "editor/editor_node.h"
+#include "editor/export/editor_export.h"
+#endif // TOOLS_ENABLED
+
 static Ref<ResourceFormatLoaderRuby> ruby_loader;
 
+#ifdef TOOLS_ENABLED
+// Exports Ruby files as precompiled bytecode, so they don't need to be parsed at runtime.
+class EditorExportRuby : public EditorExportPlugin {
+	GDCLASS(EditorExportRuby, EditorExportPlugin);
+
+	mrb_state *mrb = nullptr;
+
+protected:
+	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
+		mrb = mrb_open();
+	}
+
+	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
+		if (p_path.get_extension() != "rb" || !mrb) {
+			return;
+		}
+
+		String error;
+		Vector<uint8_t> bytecode = RubyBytecodeCache::compile_file(mrb, p_path, &error);
+		if (bytecode.is_empty()) {
+			// Keep the source, the error will show up when it's loaded.
+			print_error(vformat("Failed to compile ruby file '%s' for export: %s", p_path, error));
+			return;
+		}
+
+		add_file(RubyBytecodeCache::get_bytecode_path(p_path), bytecode, true);
+	}
+
+	virtual void _export_end() override {
+		if (mrb) {
+			mrb_close(mrb);
+			mrb = nullptr;
+		}
+	}
+
+public:
+	virtual String get_name() const override { return "Ruby"; }
+};
+
+static void _editor_init() {
+	Ref<EditorExportRuby> ruby_export;
+	ruby_export.instantiate();
+	EditorExport::get_singleton()->add_export_plugin(ruby_export);
+}
+#endif // TOOLS_ENABLED
+
 // Forward declaration - defined in mruby_print.cpp
 void mrb_init_godot_print(mrb_state *mrb);
 
@@ -57,11 +110,17 @@ void initialize_ruby_module(ModuleInitializationLevel p_level) {
 			mrb_close(mrb);
 		}
 	}
+
+#ifdef TOOLS_ENABLED
+	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
+		EditorNode::add_init_callback(_editor_init);
+	}
+#endif // TOOLS_ENABLED
 }
 
 void uninitialize_ruby_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_CORE) {
-		register_ruby_types();
+		unregister_ruby_types();
 	}
 }
 
@@ -85,4 +144,7 @@ void unregister_ruby_types() {
 
 	ResourceLoader::remove_resource_format_loader(ruby_loader);
 	ruby_loader.unref();
+
+	RubyVMPool::clear();
+	RubyBytecodeCache::clear();
 }
@@ -1 +1,43 @@
-#include "ruby_file.h"
\ No newline at end of file
+#include "ruby_file.h"
+
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+
+Error RubyFile::load_source(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(err, err, "Cannot open RubyFile '" + p_path + "'.");
+
+	uint64_t len = f->get_length();
+	CharString buffer;
+	buffer.resize_uninitialized(len + 1);
+	uint64_t r = f->get_buffer(reinterpret_cast<uint8_t *>(buffer.ptrw()), len);
+	ERR_FAIL_COND_V(r != len, ERR_CANT_OPEN);
+	buffer[len] = 0;
+
+	source = buffer;
+	source_path = p_path;
+	set_file_path(p_path);
+#ifdef TOOLS_ENABLED
+	if (ResourceLoader::get_timestamp_on_load()) {
+		set_last_modified_time(FileAccess::get_modified_time(p_path));
+	}
+#endif // TOOLS_ENABLED
+	return OK;
+}
+
+bool RubyFile::has_text() const {
+	return source.length() > 0;
+}
+
+String RubyFile::get_text() const {
+	return String::utf8(source.get_data(), source.length());
+}
+
+void RubyFile::set_text(const String &p_code) {
+	source = p_code.utf8();
+}
+
+void RubyFile::reload_from_file() {
+	load_source(source_path);
+}
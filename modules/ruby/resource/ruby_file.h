@@ -1,8 +1,20 @@
 #pragma once
 #include "scene/resources/text_file.h"
 
+// Keeps the UTF-8 source exactly as it was read from disk, so it can be handed to mruby without converting it.
+// The text is only decoded when something asks for it (e.g. the editor).
 class RubyFile : public TextFile {
 	GDCLASS(RubyFile, TextFile);
+
+	CharString source;
+	String source_path;
+
 public:
+	Error load_source(const String &p_path);
+	const CharString &get_source() const { return source; }
 
+	virtual bool has_text() const override;
+	virtual String get_text() const override;
+	virtual void set_text(const String &p_code) override;
+	virtual void reload_from_file() override;
 };
@@ -1,7 +1,6 @@
 #include "ruby_file_loader.h"
 
 #include "ruby_file.h"
-#include "scene/resources/text_file.h"
 
 Ref<Resource> ResourceFormatLoaderRuby::load(const String& p_path, const String& p_original_path, Error* r_error, bool p_use_sub_threads, float* r_progress, CacheMode p_cache_mode) {
 	Ref<RubyFile> res;
@@ -12,7 +11,7 @@ Ref<Resource> ResourceFormatLoaderRuby::load(const String& p_path, const String&
 		r_error = &local_error;
 	}
 
-	*r_error = res->load_text(p_path);
+	*r_error = res->load_source(p_path);
 	if (*r_error == OK) {
 		return res;
 	}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "modules/ruby/context/ruby_bytecode_cache.h"
+#include "modules/ruby/context/ruby_eval_context.h"
+#include "modules/ruby/context/ruby_vm_pool.h"
+#include "modules/ruby/resource/ruby_file.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+#include "mruby.h"
+#include "mruby/compile.h"
+#include "mruby/irep.h"
+#include "mruby/string.h"
+#include "mruby/variable.h"
+
+namespace TestRuby {
+
+inline String make_story_script(int p_line_count) {
+	String script = "character :narrator\n";
+	for (int i = 0; i < p_line_count; i++) {
+		script += vformat("say :narrator, \"Línea %d: ¿Qué pasó con el café? — ✓\"\n", i);
+	}
+	return script;
+}
+
+inline String write_script(const String &p_name, const String &p_script) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_string(p_script);
+	return path;
+}
+
+TEST_CASE("[Ruby] RubyFile keeps the UTF-8 source") {
+	const String script = make_story_script(4);
+	const String path = write_script("ruby_file_source.rb", script);
+
+	Ref<RubyFile> file;
+	file.instantiate();
+	REQUIRE(file->load_source(path) == OK);
+
+	const CharString expected = script.utf8();
+	CHECK(file->get_source().length() == expected.length());
+	CHECK(memcmp(file->get_source().get_data(), expected.get_data(), expected.length()) == 0);
+	CHECK(file->get_text() == script);
+
+	file->set_text("say \"ñ\"");
+	CHECK(file->get_source() == String("say \"ñ\"").utf8());
+}
+
+TEST_CASE("[Ruby] Ruby strings and symbols convert as UTF-8") {
+	mrb_state *mrb = mrb_open();
+
+	const String text = U"¿Qué pasó? — ✓ 日本語";
+	const CharString text_utf8 = text.utf8();
+	CHECK(ruby_to_string(mrb, mrb_str_new(mrb, text_utf8.get_data(), text_utf8.length())) == text);
+
+	mrb_sym symbol = mrb_intern_cstr(mrb, "sorpresa_ñ");
+	CHECK(ruby_symbol_to_string(mrb, symbol) == U"sorpresa_ñ");
+	CHECK(ruby_to_string(mrb, mrb_symbol_value(symbol)) == U"sorpresa_ñ");
+
+	mrb_close(mrb);
+}
+
+inline void write_bytes(const String &p_path, const Vector<uint8_t> &p_bytes) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	f->store_buffer(p_bytes);
+}
+
+TEST_CASE("[Ruby] Bytecode cache compiles each source once") {
+	mrb_state *mrb = mrb_open();
+	RubyBytecodeCache::clear();
+
+	const String path = write_script("ruby_bytecode_cache.rb", "1 + 41\n");
+	DirAccess::remove_absolute(RubyBytecodeCache::get_bytecode_path(path));
+
+	const Vector<uint8_t> bytecode = RubyBytecodeCache::get_bytecode(mrb, path);
+	REQUIRE(!bytecode.is_empty());
+	CHECK(bytecode == RubyBytecodeCache::compile_file(mrb, path));
+	CHECK(RubyBytecodeCache::get_bytecode(mrb, path).ptr() == bytecode.ptr());
+
+	mrb_value result = mrb_load_irep_buf(mrb, bytecode.ptr(), bytecode.size());
+	CHECK(mrb_integer_p(result));
+	CHECK(mrb_integer(result) == 42);
+
+	RubyBytecodeCache::clear();
+	mrb_close(mrb);
+}
+
+// Only the editor checks the source's modified time, exported projects may only contain the bytecode.
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Ruby] Bytecode cache ignores bytecode files older than the source") {
+	mrb_state *mrb = mrb_open();
+	RubyBytecodeCache::clear();
+
+	const String path = write_script("ruby_stale_bytecode.rb", "1\n");
+	const String bytecode_path = RubyBytecodeCache::get_bytecode_path(path);
+	const Vector<uint8_t> old_bytecode = RubyBytecodeCache::compile_file(mrb, path);
+	REQUIRE(!old_bytecode.is_empty());
+	write_bytes(bytecode_path, old_bytecode);
+
+	write_script("ruby_stale_bytecode.rb", "2\n");
+	// Backdate the bytecode instead of waiting, modification times only have a precision of one second.
+	REQUIRE(FileAccess::set_modified_time(bytecode_path, FileAccess::get_modified_time(path) - 10) == OK);
+	const Vector<uint8_t> new_bytecode = RubyBytecodeCache::compile_file(mrb, path);
+	CHECK(RubyBytecodeCache::get_bytecode(mrb, path) == new_bytecode);
+	CHECK(RubyBytecodeCache::get_bytecode(mrb, path) != old_bytecode);
+
+	// Once the bytecode is rebuilt, it's used again.
+	write_bytes(bytecode_path, new_bytecode);
+	RubyBytecodeCache::clear();
+	CHECK(RubyBytecodeCache::get_bytecode(mrb, path) == FileAccess::get_file_as_bytes(bytecode_path));
+
+	DirAccess::remove_absolute(bytecode_path);
+	RubyBytecodeCache::clear();
+	mrb_close(mrb);
+}
+#endif // TOOLS_ENABLED
+
+TEST_CASE("[Ruby] Exported bytecode runs without the source") {
+	mrb_state *mrb = mrb_open();
+	RubyBytecodeCache::clear();
+
+	// Exported projects only contain the bytecode the export plugin compiled.
+	const String path = write_script("ruby_exported.rb", "6 * 7\n");
+	const String bytecode_path = RubyBytecodeCache::get_bytecode_path(path);
+	String error;
+	const Vector<uint8_t> exported_bytecode = RubyBytecodeCache::compile_file(mrb, path, &error);
+	REQUIRE_MESSAGE(!exported_bytecode.is_empty(), error);
+	write_bytes(bytecode_path, exported_bytecode);
+	DirAccess::remove_absolute(path);
+
+	const Vector<uint8_t> bytecode = RubyBytecodeCache::get_bytecode(mrb, path);
+	CHECK(bytecode == exported_bytecode);
+
+	mrb_value result = mrb_load_irep_buf(mrb, bytecode.ptr(), bytecode.size());
+	CHECK(mrb_integer_p(result));
+	CHECK(mrb_integer(result) == 42);
+
+	ERR_PRINT_OFF;
+	CHECK(RubyBytecodeCache::compile_file(mrb, path, &error).is_empty());
+	ERR_PRINT_ON;
+	CHECK(!error.is_empty());
+
+	DirAccess::remove_absolute(bytecode_path);
+	RubyBytecodeCache::clear();
+	mrb_close(mrb);
+}
+
+TEST_CASE("[Ruby] VM pool reuses released VMs") {
+	RubyVMPool::clear();
+	// The story runtime isn't part of the test project.
+	ERR_PRINT_OFF;
+
+	RubyVMPool::prewarm(3);
+	CHECK(RubyVMPool::get_free_vm_count() == 3);
+	RubyVMPool::prewarm(2);
+	CHECK_MESSAGE(RubyVMPool::get_free_vm_count() == 3, "Prewarming shouldn't create VMs when enough are ready.");
+
+	RubyVM *vm = RubyVMPool::acquire(nullptr);
+	REQUIRE(vm);
+	CHECK(RubyVMPool::get_free_vm_count() == 2);
+
+	mrb_state *mrb = vm->mrb;
+	mrb_load_string(mrb, "$story_flag = 1; StoryConstant = 2; @story_variable = 3");
+	CHECK(mrb_integer_p(mrb_gv_get(mrb, mrb_intern_cstr(mrb, "$story_flag"))));
+	vm->required_files.insert(StringName("res://story.rb"));
+
+	RubyVMPool::release(vm);
+	CHECK(RubyVMPool::get_free_vm_count() == 3);
+
+	RubyVM *reused_vm = RubyVMPool::acquire(nullptr);
+	CHECK_MESSAGE(reused_vm == vm, "The last released VM should be handed out again.");
+	CHECK(reused_vm->mrb == mrb);
+	CHECK(RubyVMPool::get_vm(mrb) == reused_vm);
+
+	// The state the story defined is gone.
+	CHECK(mrb_nil_p(mrb_gv_get(mrb, mrb_intern_cstr(mrb, "$story_flag"))));
+	CHECK(!mrb_const_defined(mrb, mrb_obj_value(mrb->object_class), mrb_intern_cstr(mrb, "StoryConstant")));
+	CHECK(mrb_nil_p(mrb_iv_get(mrb, mrb_top_self(mrb), mrb_intern_cstr(mrb, "@story_variable"))));
+	CHECK(reused_vm->required_files.is_empty());
+	// The runtime still works.
+	mrb_value result = mrb_load_string(mrb, "6 * 7");
+	CHECK(mrb_integer_p(result));
+	CHECK(mrb_integer(result) == 42);
+
+	RubyVMPool::release(reused_vm);
+	RubyVMPool::clear();
+	CHECK(RubyVMPool::get_free_vm_count() == 0);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE_BENCHMARK("[Ruby][Benchmark] Load and compile large story scripts") {
+	mrb_state *mrb = mrb_open();
+
+	for (int line_count : { 1000, 10000, 100000 }) {
+		const String path = write_script("ruby_benchmark_story.rb", make_story_script(line_count));
+
+		// Previous path: decode into a String, then transcode back for the compiler.
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		Ref<TextFile> text_file;
+		text_file.instantiate();
+		text_file->load_text(path);
+		CharString transcoded = text_file->get_text().utf8();
+		uint64_t transcoded_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		Ref<RubyFile> ruby_file;
+		ruby_file.instantiate();
+		ruby_file->load_source(path);
+		uint64_t source_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		const CharString &source = ruby_file->get_source();
+		Vector<uint8_t> bytecode = RubyBytecodeCache::compile(mrb, source.get_data(), source.length(), path);
+		uint64_t compile_time = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(!bytecode.is_empty());
+		CHECK(transcoded.length() == source.length());
+
+		print_line(vformat("Ruby: %d lines (%d KiB), load %.2f msec with transcoding, %.2f msec as UTF-8, compile %.2f msec",
+				line_count, source.length() / 1024, transcoded_time / 1000.0, source_time / 1000.0, compile_time / 1000.0));
+	}
+
+	mrb_close(mrb);
+}
+
+} // namespace TestRuby
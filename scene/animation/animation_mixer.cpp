@@ -33,6 +33,7 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
 #include "scene/animation/animation_player.h"
@@ -589,6 +590,7 @@ void AnimationMixer::_clear_caches() {
 	}
 	track_cache.clear();
 	animation_track_num_to_track_cache.clear();
+	animation_key_cursors.clear();
 	cache_valid = false;
 	capture_cache.clear();
 
@@ -635,6 +637,7 @@ void AnimationMixer::_create_track_num_to_track_cache_for_animation(Ref<Animatio
 	const LocalVector<Animation::Track *> &tracks = p_animation->get_tracks();
 
 	track_num_to_track_cache.resize(tracks.size());
+	animation_key_cursors[p_animation].resize(tracks.size());
 	for (uint32_t i = 0; i < tracks.size(); i++) {
 		TrackCache **track_ptr = track_cache.getptr(tracks[i]->thash);
 		if (track_ptr == nullptr) {
@@ -645,6 +648,11 @@ void AnimationMixer::_create_track_num_to_track_cache_for_animation(Ref<Animatio
 	}
 }
 
+void AnimationMixer::_erase_track_num_to_track_cache_for_animation(const Ref<Animation> &p_animation) {
+	animation_track_num_to_track_cache.erase(p_animation);
+	animation_key_cursors.erase(p_animation);
+}
+
 bool AnimationMixer::_update_caches() {
 	setup_pass++;
 
@@ -982,6 +990,7 @@ bool AnimationMixer::_update_caches() {
 	}
 
 	animation_track_num_to_track_cache.clear();
+	animation_key_cursors.clear();
 	for (const StringName &E : sname_list) {
 		Ref<Animation> anim = get_animation(E);
 		_create_track_num_to_track_cache_for_animation(anim);
@@ -1011,6 +1020,275 @@ void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 	clear_animation_instances();
 }
 
+#ifndef _3D_DISABLED
+LocalVector<AnimationMixer::BatchedProcess> AnimationMixer::batched_processes;
+LocalVector<AnimationMixer *> AnimationMixer::batched_mixers;
+
+void AnimationMixer::TransformBlendBatch::clear() {
+	position_tracks.clear();
+	position_x.clear();
+	position_y.clear();
+	position_z.clear();
+	position_weight.clear();
+	rotation_tracks.clear();
+	rotation_x.clear();
+	rotation_y.clear();
+	rotation_z.clear();
+	rotation_w.clear();
+	rotation_weight.clear();
+	scale_tracks.clear();
+	scale_x.clear();
+	scale_y.clear();
+	scale_z.clear();
+	scale_weight.clear();
+}
+
+void AnimationMixer::_queue_batched_process(double p_delta) {
+	if (batched_processes.is_empty()) {
+		callable_mp_static(&AnimationMixer::_process_batched).call_deferred();
+	}
+	batched_processes.push_back({ get_instance_id(), p_delta });
+}
+
+void AnimationMixer::_process_batched() {
+	// Everything that can call into scripts or change the scene runs on the main thread,
+	// only transform tracks are sampled and blended on threads.
+	LocalVector<BatchedProcess> processes = batched_processes;
+	batched_processes.clear();
+
+	batched_mixers.clear();
+	LocalVector<BatchedProcess> blended;
+	for (const BatchedProcess &E : processes) {
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(E.mixer);
+		if (!mixer || !mixer->active || !mixer->is_inside_tree()) {
+			continue;
+		}
+		mixer->_blend_init();
+		if (mixer->cache_valid && mixer->_blend_pre_process(E.delta, mixer->track_count, mixer->track_map)) {
+			mixer->_blend_capture(E.delta);
+			mixer->_blend_calc_total_weight();
+			// Script post-processing of key values can't run on threads.
+			mixer->transforms_batched = !mixer->GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value);
+			if (mixer->transforms_batched) {
+				batched_mixers.push_back(mixer);
+			}
+			blended.push_back(E);
+		} else {
+			mixer->clear_animation_instances();
+		}
+	}
+
+	if (batched_mixers.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationMixer::_blend_process_transforms_task, batched_mixers.ptr(), batched_mixers.size(), -1, true, SNAME("AnimationMixerBlendTransforms"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (batched_mixers.size() == 1) {
+		batched_mixers[0]->_blend_process_transforms();
+	}
+	batched_mixers.clear();
+
+	for (const BatchedProcess &E : blended) {
+		// Signals emitted by previous mixers may have freed this one.
+		AnimationMixer *mixer = ObjectDB::get_instance<AnimationMixer>(E.mixer);
+		if (!mixer) {
+			continue;
+		}
+		mixer->_blend_process(E.delta);
+		mixer->transforms_batched = false;
+		mixer->_blend_apply();
+		mixer->_blend_post_process();
+		mixer->emit_signal(SNAME("mixer_applied"));
+		mixer->clear_animation_instances();
+	}
+}
+
+void AnimationMixer::_blend_process_transforms_task(void *p_userdata, uint32_t p_index) {
+	AnimationMixer **mixers = static_cast<AnimationMixer **>(p_userdata);
+	mixers[p_index]->_blend_process_transforms();
+}
+
+// Turns each sample into its contribution, (sample - rest) * weight, in place.
+static void _blend_linear_soa(real_t *r_x, real_t *r_y, real_t *r_z, const real_t *p_rest_x, const real_t *p_rest_y, const real_t *p_rest_z, const real_t *p_weight, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_x[i] = (r_x[i] - p_rest_x[i]) * p_weight[i];
+		r_y[i] = (r_y[i] - p_rest_y[i]) * p_weight[i];
+		r_z[i] = (r_z[i] - p_rest_z[i]) * p_weight[i];
+	}
+}
+
+// Turns each sample into its rotation from the rest pose, rest.inverse() * sample, in place.
+static void _rotation_from_rest_soa(real_t *r_x, real_t *r_y, real_t *r_z, real_t *r_w, const real_t *p_rest_x, const real_t *p_rest_y, const real_t *p_rest_z, const real_t *p_rest_w, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		const real_t ax = -p_rest_x[i];
+		const real_t ay = -p_rest_y[i];
+		const real_t az = -p_rest_z[i];
+		const real_t aw = p_rest_w[i];
+		const real_t bx = r_x[i];
+		const real_t by = r_y[i];
+		const real_t bz = r_z[i];
+		const real_t bw = r_w[i];
+		r_x[i] = aw * bx + ax * bw + ay * bz - az * by;
+		r_y[i] = aw * by + ay * bw + az * bx - ax * bz;
+		r_z[i] = aw * bz + az * bw + ax * by - ay * bx;
+		r_w[i] = aw * bw - ax * bx - ay * by - az * bz;
+	}
+}
+
+void AnimationMixer::_blend_process_transforms() {
+	// Must match the transform track handling in _blend_process(), minus root motion.
+	TransformBlendBatch &batch = transform_batch;
+	batch.clear();
+
+	ObjectID motion_scale_id;
+	real_t motion_scale = 1.0;
+
+	for (const AnimationInstance &ai : animation_instances) {
+		const Ref<Animation> &a = ai.animation_data.animation;
+		const LocalVector<TrackCache *> *track_num_to_track_cache = animation_track_num_to_track_cache.getptr(a);
+		if (!track_num_to_track_cache) {
+			continue; // Reported by _blend_process().
+		}
+		const double time = ai.playback_info.time;
+		const real_t weight = ai.playback_info.weight;
+		const real_t *track_weights_ptr = ai.playback_info.track_weights.ptr();
+		const int track_weights_count = ai.playback_info.track_weights.size();
+
+		const LocalVector<Animation::Track *> &tracks = a->get_tracks();
+		Animation::KeyCursor *key_cursors = _get_key_cursors(a, tracks.size());
+		for (uint32_t i = 0; i < tracks.size(); i++) {
+			const Animation::Track *animation_track = tracks[i];
+			if (!animation_track->enabled || !_is_transform_track_batched(animation_track)) {
+				continue;
+			}
+			TrackCache *track = (*track_num_to_track_cache)[i];
+			if (track == nullptr) {
+				continue;
+			}
+			const int blend_idx = track->blend_idx;
+			if (blend_idx < 0 || blend_idx >= track_count) {
+				continue; // Reported by _blend_process().
+			}
+			real_t blend = blend_idx < track_weights_count ? track_weights_ptr[blend_idx] * weight : weight;
+			if (!deterministic) {
+				if (Math::is_zero_approx(track->total_weight)) {
+					continue;
+				}
+				blend = blend / track->total_weight;
+			}
+			track->root_motion = false;
+			if (Math::is_zero_approx(blend)) {
+				continue;
+			}
+
+			TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+			switch (animation_track->type) {
+				case Animation::TYPE_POSITION_3D: {
+					Vector3 loc;
+					if (a->try_position_track_interpolate(i, time, &loc, false, key_cursors ? &key_cursors[i] : nullptr) != OK) {
+						continue;
+					}
+					if (t->bone_idx >= 0) {
+						// Same as the default _post_process_key_value().
+						if (t->object_id != motion_scale_id) {
+							Skeleton3D *skel = ObjectDB::get_instance<Skeleton3D>(t->object_id);
+							motion_scale_id = t->object_id;
+							motion_scale = skel ? skel->get_motion_scale() : 1.0;
+						}
+						loc *= motion_scale;
+					}
+					batch.position_tracks.push_back(t);
+					batch.position_x.push_back(loc.x);
+					batch.position_y.push_back(loc.y);
+					batch.position_z.push_back(loc.z);
+					batch.position_weight.push_back(blend);
+				} break;
+				case Animation::TYPE_ROTATION_3D: {
+					Quaternion rot;
+					if (a->try_rotation_track_interpolate(i, time, &rot, false, key_cursors ? &key_cursors[i] : nullptr) != OK) {
+						continue;
+					}
+					batch.rotation_tracks.push_back(t);
+					batch.rotation_x.push_back(rot.x);
+					batch.rotation_y.push_back(rot.y);
+					batch.rotation_z.push_back(rot.z);
+					batch.rotation_w.push_back(rot.w);
+					batch.rotation_weight.push_back(blend);
+				} break;
+				case Animation::TYPE_SCALE_3D: {
+					Vector3 scale;
+					if (a->try_scale_track_interpolate(i, time, &scale, false, key_cursors ? &key_cursors[i] : nullptr) != OK) {
+						continue;
+					}
+					batch.scale_tracks.push_back(t);
+					batch.scale_x.push_back(scale.x);
+					batch.scale_y.push_back(scale.y);
+					batch.scale_z.push_back(scale.z);
+					batch.scale_weight.push_back(blend);
+				} break;
+				default: {
+				} break;
+			}
+		}
+	}
+
+	// Blend in the order the keys were sampled, so results match _blend_process().
+	uint32_t count = batch.position_tracks.size();
+	if (count) {
+		batch.rest_x.resize(count);
+		batch.rest_y.resize(count);
+		batch.rest_z.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			const Vector3 &rest = batch.position_tracks[i]->init_loc;
+			batch.rest_x[i] = rest.x;
+			batch.rest_y[i] = rest.y;
+			batch.rest_z[i] = rest.z;
+		}
+		_blend_linear_soa(batch.position_x.ptr(), batch.position_y.ptr(), batch.position_z.ptr(), batch.rest_x.ptr(), batch.rest_y.ptr(), batch.rest_z.ptr(), batch.position_weight.ptr(), count);
+		for (uint32_t i = 0; i < count; i++) {
+			batch.position_tracks[i]->loc += Vector3(batch.position_x[i], batch.position_y[i], batch.position_z[i]);
+		}
+	}
+
+	count = batch.rotation_tracks.size();
+	if (count) {
+		batch.rest_x.resize(count);
+		batch.rest_y.resize(count);
+		batch.rest_z.resize(count);
+		batch.rest_w.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			const Quaternion &rest = batch.rotation_tracks[i]->init_rot;
+			batch.rest_x[i] = rest.x;
+			batch.rest_y[i] = rest.y;
+			batch.rest_z[i] = rest.z;
+			batch.rest_w[i] = rest.w;
+		}
+		_rotation_from_rest_soa(batch.rotation_x.ptr(), batch.rotation_y.ptr(), batch.rotation_z.ptr(), batch.rotation_w.ptr(), batch.rest_x.ptr(), batch.rest_y.ptr(), batch.rest_z.ptr(), batch.rest_w.ptr(), count);
+		for (uint32_t i = 0; i < count; i++) {
+			// Same as Animation::interpolate_via_rest().
+			TrackCacheTransform *t = batch.rotation_tracks[i];
+			const Quaternion from_rest(batch.rotation_x[i], batch.rotation_y[i], batch.rotation_z[i], batch.rotation_w[i]);
+			t->rot = (t->rot * Quaternion().slerp(from_rest, batch.rotation_weight[i])).normalized();
+		}
+	}
+
+	count = batch.scale_tracks.size();
+	if (count) {
+		batch.rest_x.resize(count);
+		batch.rest_y.resize(count);
+		batch.rest_z.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			const Vector3 &rest = batch.scale_tracks[i]->init_scale;
+			batch.rest_x[i] = rest.x;
+			batch.rest_y[i] = rest.y;
+			batch.rest_z[i] = rest.z;
+		}
+		_blend_linear_soa(batch.scale_x.ptr(), batch.scale_y.ptr(), batch.scale_z.ptr(), batch.rest_x.ptr(), batch.rest_y.ptr(), batch.rest_z.ptr(), batch.scale_weight.ptr(), count);
+		for (uint32_t i = 0; i < count; i++) {
+			batch.scale_tracks[i]->scale += Vector3(batch.scale_x[i], batch.scale_y[i], batch.scale_z[i]);
+		}
+	}
+}
+#endif // _3D_DISABLED
+
 Variant AnimationMixer::_post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant &p_value, ObjectID p_object_id, int p_object_sub_idx) {
 #ifndef _3D_DISABLED
 	switch (p_anim->track_get_type(p_track)) {
@@ -1118,7 +1396,7 @@ void AnimationMixer::blend_capture(double p_delta) {
 	capture_cache.remain -= p_delta * capture_cache.step;
 	if (Animation::is_less_or_equal_approx(capture_cache.remain, 0)) {
 		if (capture_cache.animation.is_valid()) {
-			animation_track_num_to_track_cache.erase(capture_cache.animation);
+			_erase_track_num_to_track_cache_for_animation(capture_cache.animation);
 		}
 		capture_cache.clear();
 		return;
@@ -1206,6 +1484,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 		LocalVector<TrackCache *> &track_num_to_track_cache = animation_track_num_to_track_cache[a];
 		const LocalVector<Animation::Track *> &tracks = a->get_tracks();
 		Animation::Track *const *tracks_ptr = tracks.ptr();
+		Animation::KeyCursor *key_cursors = _get_key_cursors(a, tracks.size());
 		real_t a_length = a->get_length();
 		int count = tracks.size();
 		for (int i = 0; i < count; i++) {
@@ -1233,6 +1512,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 			switch (ttype) {
 				case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
+					if (_is_transform_track_batched(animation_track)) {
+						continue; // Already blended by _blend_process_transforms().
+					}
 					if (Math::is_zero_approx(blend)) {
 						continue; // Nothing to blend.
 					}
@@ -1365,7 +1647,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
+						Error err = a->try_position_track_interpolate(i, time, &loc, false, key_cursors ? &key_cursors[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
@@ -1376,6 +1658,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				} break;
 				case Animation::TYPE_ROTATION_3D: {
 #ifndef _3D_DISABLED
+					if (_is_transform_track_batched(animation_track)) {
+						continue; // Already blended by _blend_process_transforms().
+					}
 					if (Math::is_zero_approx(blend)) {
 						continue; // Nothing to blend.
 					}
@@ -1453,7 +1738,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
+						Error err = a->try_rotation_track_interpolate(i, time, &rot, false, key_cursors ? &key_cursors[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
@@ -1464,6 +1749,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				} break;
 				case Animation::TYPE_SCALE_3D: {
 #ifndef _3D_DISABLED
+					if (_is_transform_track_batched(animation_track)) {
+						continue; // Already blended by _blend_process_transforms().
+					}
 					if (Math::is_zero_approx(blend)) {
 						continue; // Nothing to blend.
 					}
@@ -1541,7 +1829,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
+						Error err = a->try_scale_track_interpolate(i, time, &scale, false, key_cursors ? &key_cursors[i] : nullptr);
 						if (err != OK) {
 							continue;
 						}
@@ -1557,7 +1845,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+					Error err = a->try_blend_shape_track_interpolate(i, time, &value, false, key_cursors ? &key_cursors[i] : nullptr);
 					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 					if (err != OK) {
 						continue;
@@ -1580,7 +1868,14 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 
 						Variant value;
 						if (t->is_variant_interpolatable) {
-							value = is_value ? a->value_track_interpolate(i, time, is_discrete && force_continuous ? backward : false) : Variant(a->bezier_track_interpolate(i, time));
+							Animation::KeyCursor *key_cursor = key_cursors ? &key_cursors[i] : nullptr;
+							if (is_value) {
+								a->try_value_track_interpolate(i, time, &value, is_discrete && force_continuous ? backward : false, key_cursor);
+							} else {
+								real_t bezier = 0;
+								a->try_bezier_track_interpolate(i, time, &bezier, key_cursor);
+								value = bezier;
+							}
 							value = post_process_key_value(a, i, value, t->object_id);
 							if (value == Variant()) {
 								continue;
@@ -2304,7 +2599,7 @@ void AnimationMixer::capture(const StringName &p_name, double p_duration, Tween:
 	capture_cache.trans_type = p_trans_type;
 	capture_cache.ease_type = p_ease_type;
 	if (capture_cache.animation.is_valid()) {
-		animation_track_num_to_track_cache.erase(capture_cache.animation);
+		_erase_track_num_to_track_cache_for_animation(capture_cache.animation);
 	}
 	capture_cache.animation.instantiate();
 
@@ -2354,12 +2649,24 @@ void AnimationMixer::_notification(int p_what) {
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
+#ifndef _3D_DISABLED
+				if (GLOBAL_GET_CACHED(bool, "animation/mixers/use_batched_evaluation")) {
+					_queue_batched_process(get_process_delta_time());
+					break;
+				}
+#endif // _3D_DISABLED
 				_process_animation(get_process_delta_time());
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
+#ifndef _3D_DISABLED
+				if (GLOBAL_GET_CACHED(bool, "animation/mixers/use_batched_evaluation")) {
+					_queue_batched_process(get_physics_process_delta_time());
+					break;
+				}
+#endif // _3D_DISABLED
 				_process_animation(get_physics_process_delta_time());
 			}
 		} break;
@@ -306,6 +306,8 @@ protected:
 	RootMotionCache root_motion_cache;
 	AHashMap<Animation::TypeHash, TrackCache *, HashHasher> track_cache;
 	AHashMap<Ref<Animation>, LocalVector<TrackCache *>> animation_track_num_to_track_cache;
+	// Per track key cursors, kept per mixer so mixers sharing an Animation never touch the same cursor.
+	AHashMap<Ref<Animation>, LocalVector<Animation::KeyCursor>> animation_key_cursors;
 	HashSet<TrackCache *> playing_caches;
 	Vector<Node *> playing_audio_stream_players;
 
@@ -316,6 +318,11 @@ protected:
 	void _init_root_motion_cache();
 	bool _update_caches();
 	void _create_track_num_to_track_cache_for_animation(Ref<Animation> &p_animation);
+	void _erase_track_num_to_track_cache_for_animation(const Ref<Animation> &p_animation);
+	_FORCE_INLINE_ Animation::KeyCursor *_get_key_cursors(const Ref<Animation> &p_animation, uint32_t p_track_count) {
+		LocalVector<Animation::KeyCursor> *key_cursors = animation_key_cursors.getptr(p_animation);
+		return key_cursors && key_cursors->size() == p_track_count ? key_cursors->ptr() : nullptr;
+	}
 
 	/* ---- Audio ---- */
 	AudioServer::PlaybackType playback_type;
@@ -326,6 +333,57 @@ protected:
 	int track_count = 0;
 	bool deterministic = false;
 
+#ifndef _3D_DISABLED
+	/* ---- Batched evaluation ---- */
+	// When enabled, mixers processed in the same frame are blended together, and their
+	// transform tracks are sampled and blended on the WorkerThreadPool.
+	struct BatchedProcess {
+		ObjectID mixer;
+		double delta = 0.0;
+	};
+	static LocalVector<BatchedProcess> batched_processes;
+	static LocalVector<AnimationMixer *> batched_mixers;
+
+	// Sampled transform keys in blending order, as structures of arrays.
+	struct TransformBlendBatch {
+		LocalVector<TrackCacheTransform *> position_tracks;
+		LocalVector<real_t> position_x;
+		LocalVector<real_t> position_y;
+		LocalVector<real_t> position_z;
+		LocalVector<real_t> position_weight;
+
+		LocalVector<TrackCacheTransform *> rotation_tracks;
+		LocalVector<real_t> rotation_x;
+		LocalVector<real_t> rotation_y;
+		LocalVector<real_t> rotation_z;
+		LocalVector<real_t> rotation_w;
+		LocalVector<real_t> rotation_weight;
+
+		LocalVector<TrackCacheTransform *> scale_tracks;
+		LocalVector<real_t> scale_x;
+		LocalVector<real_t> scale_y;
+		LocalVector<real_t> scale_z;
+		LocalVector<real_t> scale_weight;
+
+		// Scratch for the rest pose of each key.
+		LocalVector<real_t> rest_x;
+		LocalVector<real_t> rest_y;
+		LocalVector<real_t> rest_z;
+		LocalVector<real_t> rest_w;
+
+		void clear();
+	} transform_batch;
+	bool transforms_batched = false;
+
+	static void _process_batched();
+	static void _blend_process_transforms_task(void *p_userdata, uint32_t p_index);
+	void _queue_batched_process(double p_delta);
+	_FORCE_INLINE_ bool _is_transform_track_batched(const Animation::Track *p_animation_track) const {
+		return transforms_batched && (p_animation_track->type == Animation::TYPE_POSITION_3D || p_animation_track->type == Animation::TYPE_ROTATION_3D || p_animation_track->type == Animation::TYPE_SCALE_3D) && p_animation_track->path != root_motion_track;
+	}
+	void _blend_process_transforms();
+#endif // _3D_DISABLED
+
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
 	bool root_motion_local = false;
@@ -2034,6 +2034,8 @@ SceneTree::SceneTree() {
 
 	GLOBAL_DEF("debug/shapes/collision/draw_2d_outlines", true);
 
+	SceneState::set_threaded_instantiation_min_nodes(GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/scene/threaded_instantiation_min_nodes", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 0));
+
 	process_group_call_queue_allocator = memnew(CallQueue::Allocator(64));
 	Math::randomize();
 
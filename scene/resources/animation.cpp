@@ -31,7 +31,72 @@
 #include "animation.h"
 #include "animation.compat.inc"
 
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
 #include "core/io/marshalls.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+
+// Pages of streamed compressed animations, shared by all animations and kept within a byte budget.
+struct AnimationStreamedPageCache {
+	struct Key {
+		ObjectID animation;
+		uint32_t page = 0;
+
+		static uint32_t hash(const Key &p_key) {
+			return hash_murmur3_one_32(p_key.page, hash_murmur3_one_64((uint64_t)p_key.animation));
+		}
+		bool operator==(const Key &p_key) const {
+			return animation == p_key.animation && page == p_key.page;
+		}
+	};
+
+	struct Entry {
+		Vector<uint8_t> data;
+		List<Key>::Element *lru = nullptr;
+	};
+
+	Mutex mutex;
+	HashMap<Key, Entry, Key> pages;
+	List<Key> lru; // Most recently used first.
+	uint64_t budget = 0;
+	Animation::StreamedPageStats stats;
+
+	uint64_t get_budget() {
+		if (budget == 0) {
+			const uint64_t budget_mb = ProjectSettings::get_singleton() ? (uint64_t)GLOBAL_GET("animation/compression/streamed_page_budget_mb") : 64;
+			return MAX<uint64_t>(budget_mb, 1) * 1024 * 1024;
+		}
+		return budget;
+	}
+
+	void erase(HashMap<Key, Entry, Key>::Iterator p_entry) {
+		stats.resident_bytes -= p_entry->value.data.size();
+		lru.erase(p_entry->value.lru);
+		pages.remove(p_entry);
+	}
+
+	void insert(const Key &p_key, const Vector<uint8_t> &p_data) {
+		if (pages.has(p_key)) {
+			return; // Paged in by another thread meanwhile.
+		}
+		Entry &entry = pages.insert(p_key, Entry())->value;
+		entry.data = p_data;
+		entry.lru = lru.push_front(p_key);
+		stats.resident_bytes += p_data.size();
+		stats.peak_resident_bytes = MAX(stats.peak_resident_bytes, stats.resident_bytes);
+
+		// Always keep the page that was just requested, even if it alone exceeds the budget.
+		const uint64_t max_bytes = get_budget();
+		while (stats.resident_bytes > max_bytes && lru.size() > 1) {
+			erase(pages.find(lru.back()->get()));
+			stats.evictions++;
+		}
+	}
+};
+
+static AnimationStreamedPageCache streamed_page_cache;
 
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 	String prop_name = p_name;
@@ -52,16 +117,34 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 			compression.bounds[i] = bounds[i];
 		}
 		Array pages = comp["pages"];
+		compression.streamed = comp.get("streamed", false);
 		compression.pages.resize(pages.size());
 		for (int i = 0; i < pages.size(); i++) {
 			Dictionary page = pages[i];
-			ERR_FAIL_COND_V(!page.has("data"), false);
 			ERR_FAIL_COND_V(!page.has("time_offset"), false);
-			compression.pages[i].data = page["data"];
 			compression.pages[i].time_offset = page["time_offset"];
+			if (compression.streamed) {
+				// Page data follows in "_compression_page_data".
+				ERR_FAIL_COND_V(!page.has("size"), false);
+				compression.pages[i].stream_size = page["size"];
+			} else {
+				ERR_FAIL_COND_V(!page.has("data"), false);
+				compression.pages[i].data = page["data"];
+			}
 		}
 		compression.enabled = true;
 		return true;
+	} else if (p_name == SNAME("_compression_page_data")) {
+		// Only reached when the data could not be streamed from the file, so keep it resident.
+		ERR_FAIL_COND_V(!compression.enabled || !compression.streamed, false);
+		Vector<uint8_t> data = p_value;
+		uint64_t offset = 0;
+		for (Compression::Page &page : compression.pages) {
+			ERR_FAIL_COND_V(offset + page.stream_size > (uint64_t)data.size(), false);
+			page.data = data.slice(offset, offset + page.stream_size);
+			offset += page.stream_size;
+		}
+		return true;
 	} else if (prop_name == SNAME("markers")) {
 		Array markers = p_value;
 		for (const Dictionary marker : markers) {
@@ -479,15 +562,35 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 		pages.resize(compression.pages.size());
 		for (uint32_t i = 0; i < compression.pages.size(); i++) {
 			Dictionary page;
-			page["data"] = compression.pages[i].data;
+			if (!compression.streamed) {
+				page["data"] = compression.stream_path.is_empty() ? compression.pages[i].data : _read_streamed_page(i);
+			} else if (!compression.stream_path.is_empty()) {
+				page["size"] = compression.pages[i].stream_size;
+			} else {
+				page["size"] = compression.pages[i].data.size();
+			}
 			page["time_offset"] = compression.pages[i].time_offset;
 			pages[i] = page;
 		}
 		comp["pages"] = pages;
+		if (compression.streamed) {
+			comp["streamed"] = true;
+		}
 		comp["format_version"] = Compression::FORMAT_VERSION;
 
 		r_ret = comp;
 		return true;
+	} else if (p_name == SNAME("_compression_page_data")) {
+		if (!compression.enabled || !compression.streamed) {
+			return false;
+		}
+		// All pages in one block, so the binary loader can leave it on disk.
+		Vector<uint8_t> data;
+		for (uint32_t i = 0; i < compression.pages.size(); i++) {
+			data.append_array(compression.stream_path.is_empty() ? compression.pages[i].data : _read_streamed_page(i));
+		}
+		r_ret = data;
+		return true;
 	} else if (prop_name == SNAME("markers")) {
 		Array markers;
 
@@ -868,6 +971,9 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 void Animation::_get_property_list(List<PropertyInfo> *p_list) const {
 	if (compression.enabled) {
 		p_list->push_back(PropertyInfo(Variant::DICTIONARY, "_compression", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		if (compression.streamed) {
+			p_list->push_back(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "_compression_page_data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		}
 	}
 	p_list->push_back(PropertyInfo(Variant::ARRAY, "markers", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 	for (uint32_t i = 0; i < tracks.size(); i++) {
@@ -1185,7 +1291,7 @@ Error Animation::position_track_get_key(int p_track, int p_key, Vector3 *r_posit
 	return OK;
 }
 
-Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, KeyCursor *r_cursor) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, ERR_INVALID_PARAMETER);
@@ -1202,7 +1308,7 @@ Error Animation::try_position_track_interpolate(int p_track, double p_time, Vect
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1265,7 +1371,7 @@ Error Animation::rotation_track_get_key(int p_track, int p_key, Quaternion *r_ro
 	return OK;
 }
 
-Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward) const {
+Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward, KeyCursor *r_cursor) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, ERR_INVALID_PARAMETER);
@@ -1282,7 +1388,7 @@ Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quat
 
 	bool ok = false;
 
-	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward);
+	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1345,7 +1451,7 @@ Error Animation::scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) c
 	return OK;
 }
 
-Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, KeyCursor *r_cursor) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, ERR_INVALID_PARAMETER);
@@ -1362,7 +1468,7 @@ Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1425,7 +1531,7 @@ Error Animation::blend_shape_track_get_key(int p_track, int p_key, float *r_blen
 	return OK;
 }
 
-Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward) const {
+Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward, KeyCursor *r_cursor) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_BLEND_SHAPE, ERR_INVALID_PARAMETER);
@@ -1442,7 +1548,7 @@ Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, f
 
 	bool ok = false;
 
-	float tk = _interpolate(bst->blend_shapes, p_time, bst->interpolation, bst->loop_wrap, &ok, p_backward);
+	float tk = _interpolate(bst->blend_shapes, p_time, bst->interpolation, bst->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -2401,12 +2507,37 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, real_t p_tr
 }
 
 template <typename K>
-int Animation::_find(const LocalVector<K> &p_keys, double p_time, bool p_backward, bool p_limit) const {
+int Animation::_find(const LocalVector<K> &p_keys, double p_time, bool p_backward, bool p_limit, int *r_hint) const {
 	int len = p_keys.size();
 	if (len == 0) {
 		return -2;
 	}
 
+	const K *keys = &p_keys[0];
+
+	if (r_hint) {
+		// Sequential playback usually lands on the hinted key or one of the next ones,
+		// so check those before falling back to the binary search (e.g. after a seek).
+		// A key is accepted only if it is the one the binary search would return.
+		for (int step = 0; step < 3; step++) {
+			int idx = p_backward ? *r_hint - step : *r_hint + step;
+			if (p_backward ? (idx < 0 || idx > len) : (idx < -1 || idx >= len)) {
+				break;
+			}
+			if (idx > -1 && idx < len && Math::is_equal_approx(p_time, (double)keys[idx].time)) {
+				*r_hint = idx;
+				return idx; //match
+			}
+			int next = p_backward ? idx - 1 : idx + 1;
+			bool next_beyond = next < 0 || next >= len || (p_backward ? keys[next].time < p_time : keys[next].time > p_time);
+			bool idx_before = idx < 0 || idx >= len || (p_backward ? keys[idx].time > p_time : keys[idx].time < p_time);
+			if (idx_before && next_beyond && (next < 0 || next >= len || !Math::is_equal_approx(p_time, (double)keys[next].time))) {
+				*r_hint = idx;
+				return _find_check_limit(keys, len, idx, p_limit);
+			}
+		}
+	}
+
 	int low = 0;
 	int high = len - 1;
 	int middle = 0;
@@ -2417,12 +2548,13 @@ int Animation::_find(const LocalVector<K> &p_keys, double p_time, bool p_backwar
 	}
 #endif
 
-	const K *keys = &p_keys[0];
-
 	while (low <= high) {
 		middle = (low + high) / 2;
 
 		if (Math::is_equal_approx(p_time, (double)keys[middle].time)) { //match
+			if (r_hint) {
+				*r_hint = middle;
+			}
 			return middle;
 		} else if (p_time < keys[middle].time) {
 			high = middle - 1; //search low end of array
@@ -2441,15 +2573,24 @@ int Animation::_find(const LocalVector<K> &p_keys, double p_time, bool p_backwar
 		}
 	}
 
-	if (p_limit && middle > -1 && middle < len) {
-		double diff = length - keys[middle].time;
-		if ((std::signbit(keys[middle].time) && !Math::is_zero_approx(keys[middle].time)) || (std::signbit(diff) && !Math::is_zero_approx(diff))) {
+	if (r_hint) {
+		*r_hint = middle;
+	}
+
+	return _find_check_limit(keys, len, middle, p_limit);
+}
+
+template <typename K>
+int Animation::_find_check_limit(const K *p_keys, int p_len, int p_idx, bool p_limit) const {
+	if (p_limit && p_idx > -1 && p_idx < p_len) {
+		double diff = length - p_keys[p_idx].time;
+		if ((std::signbit(p_keys[p_idx].time) && !Math::is_zero_approx(p_keys[p_idx].time)) || (std::signbit(diff) && !Math::is_zero_approx(diff))) {
 			ERR_PRINT_ONCE_ED("Found the key outside the animation range. Consider using the clean-up option in AnimationTrackEditor to fix it.");
 			return -1;
 		}
 	}
 
-	return middle;
+	return p_idx;
 }
 
 // Linear interpolation for anytype.
@@ -2521,8 +2662,8 @@ Variant Animation::_cubic_interpolate_angle_in_time(const Variant &p_pre_a, cons
 }
 
 template <typename T>
-T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward) const {
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward, KeyCursor *r_cursor) const {
+	int len = _find(p_keys, length, false, false, r_cursor ? &r_cursor->end_key : nullptr) + 1; // try to find last key (there may be more past the end)
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -2539,7 +2680,7 @@ T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, Int
 		return p_keys[0].value;
 	}
 
-	int idx = _find(p_keys, p_time, p_backward);
+	int idx = _find(p_keys, p_time, p_backward, false, r_cursor ? &r_cursor->key : nullptr);
 
 	ERR_FAIL_COND_V(idx == -2, T());
 	int maxi = len - 1;
@@ -2725,17 +2866,29 @@ T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, Int
 	// do a barrel roll
 }
 
-Variant Animation::value_track_interpolate(int p_track, double p_time, bool p_backward) const {
-	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), 0);
+Error Animation::try_value_track_interpolate(int p_track, double p_time, Variant *r_interpolation, bool p_backward, KeyCursor *r_cursor) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
-	ERR_FAIL_COND_V(t->type != TYPE_VALUE, Variant());
+	ERR_FAIL_COND_V(t->type != TYPE_VALUE, ERR_INVALID_PARAMETER);
 	ValueTrack *vt = static_cast<ValueTrack *>(t);
 
 	bool ok = false;
 
-	Variant res = _interpolate(vt->values, p_time, vt->update_mode == UPDATE_DISCRETE ? INTERPOLATION_NEAREST : vt->interpolation, vt->loop_wrap, &ok, p_backward);
+	Variant res = _interpolate(vt->values, p_time, vt->update_mode == UPDATE_DISCRETE ? INTERPOLATION_NEAREST : vt->interpolation, vt->loop_wrap, &ok, p_backward, r_cursor);
+
+	if (!ok) {
+		return ERR_UNAVAILABLE;
+	}
+	*r_interpolation = res;
+	return OK;
+}
+
+Variant Animation::value_track_interpolate(int p_track, double p_time, bool p_backward) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), 0);
+	ERR_FAIL_COND_V(tracks[p_track]->type != TYPE_VALUE, Variant());
 
-	if (ok) {
+	Variant res;
+	if (try_value_track_interpolate(p_track, p_time, &res, p_backward) == OK) {
 		return res;
 	}
 
@@ -3600,35 +3753,38 @@ bool Animation::bezier_track_calculate_handles(float p_time, float p_prev_time,
 
 #endif // TOOLS_ENABLED
 
-real_t Animation::bezier_track_interpolate(int p_track, double p_time) const {
+Error Animation::try_bezier_track_interpolate(int p_track, double p_time, real_t *r_interpolation, KeyCursor *r_cursor) const {
 	//this uses a different interpolation scheme
-	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), 0);
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *track = tracks[p_track];
-	ERR_FAIL_COND_V(track->type != TYPE_BEZIER, 0);
+	ERR_FAIL_COND_V(track->type != TYPE_BEZIER, ERR_INVALID_PARAMETER);
 
 	BezierTrack *bt = static_cast<BezierTrack *>(track);
 
-	int len = _find(bt->values, length) + 1; // try to find last key (there may be more past the end)
+	int len = _find(bt->values, length, false, false, r_cursor ? &r_cursor->end_key : nullptr) + 1; // try to find last key (there may be more past the end)
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
-		return 0;
+		return ERR_UNAVAILABLE;
 	} else if (len == 1) { // one key found (0+1), return it
-		return bt->values[0].value.value;
+		*r_interpolation = bt->values[0].value.value;
+		return OK;
 	}
 
-	int idx = _find(bt->values, p_time);
+	int idx = _find(bt->values, p_time, false, false, r_cursor ? &r_cursor->key : nullptr);
 
-	ERR_FAIL_COND_V(idx == -2, 0);
+	ERR_FAIL_COND_V(idx == -2, ERR_BUG);
 
 	//there really is no looping interpolation on bezier
 
 	if (idx < 0) {
-		return bt->values[0].value.value;
+		*r_interpolation = bt->values[0].value.value;
+		return OK;
 	}
 
 	if (idx >= (int)bt->values.size() - 1) {
-		return bt->values[bt->values.size() - 1].value.value;
+		*r_interpolation = bt->values[bt->values.size() - 1].value.value;
+		return OK;
 	}
 
 	double t = p_time - bt->values[idx].time;
@@ -3662,7 +3818,17 @@ real_t Animation::bezier_track_interpolate(int p_track, double p_time) const {
 	Vector2 high_pos = start.bezier_interpolate(start_out, end_in, end, high);
 	real_t c = (t - low_pos.x) / (high_pos.x - low_pos.x);
 
-	return low_pos.lerp(high_pos, c).y;
+	*r_interpolation = low_pos.lerp(high_pos, c).y;
+	return OK;
+}
+
+real_t Animation::bezier_track_interpolate(int p_track, double p_time) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), 0);
+	ERR_FAIL_COND_V(tracks[p_track]->type != TYPE_BEZIER, 0);
+
+	real_t ret = 0;
+	try_bezier_track_interpolate(p_track, p_time, &ret);
+	return ret;
 }
 
 int Animation::audio_track_insert_key(int p_track, double p_time, const Ref<Resource> &p_stream, real_t p_start_offset, real_t p_end_offset) {
@@ -4070,6 +4236,10 @@ void Animation::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("optimize", "allowed_velocity_err", "allowed_angular_err", "precision"), &Animation::optimize, DEFVAL(0.01), DEFVAL(0.01), DEFVAL(3));
 	ClassDB::bind_method(D_METHOD("compress", "page_size", "fps", "split_tolerance"), &Animation::compress, DEFVAL(8192), DEFVAL(120), DEFVAL(4.0));
+	ClassDB::bind_method(D_METHOD("set_compression_streamed", "streamed"), &Animation::set_compression_streamed);
+	ClassDB::bind_method(D_METHOD("is_compression_streamed"), &Animation::is_compression_streamed);
+	ClassDB::bind_static_method("Animation", D_METHOD("get_streamed_page_stats"), &Animation::_get_streamed_page_stats_bind);
+	ClassDB::bind_static_method("Animation", D_METHOD("reset_streamed_page_stats"), &Animation::reset_streamed_page_stats);
 
 	ClassDB::bind_method(D_METHOD("is_capture_included"), &Animation::is_capture_included);
 
@@ -4118,7 +4288,10 @@ void Animation::clear() {
 	tracks.clear();
 	loop_mode = LOOP_NONE;
 	length = 1;
+	_evict_streamed_pages();
 	compression.enabled = false;
+	compression.streamed = false;
+	_set_stream_path(String());
 	compression.bounds.clear();
 	compression.pages.clear();
 	compression.fps = 120;
@@ -5350,18 +5523,14 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 
 	double frame_to_sec = 1.0 / double(compression.fps);
 
-	int32_t page_index = -1;
-	for (uint32_t i = 0; i < compression.pages.size(); i++) {
-		if (compression.pages[i].time_offset > p_time) {
-			break;
-		}
-		page_index = i;
-	}
+	int32_t page_index = _find_compressed_page(p_time);
 
 	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
 
 	double page_base_time = compression.pages[page_index].time_offset;
-	const uint8_t *page_data = compression.pages[page_index].data.ptr();
+	const Vector<uint8_t> page = _get_compressed_page(page_index);
+	ERR_FAIL_COND_V(page.is_empty(), false);
+	const uint8_t *page_data = page.ptr();
 	// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
 	const uint32_t *indices = (const uint32_t *)page_data;
 	const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
@@ -5504,7 +5673,9 @@ void Animation::_get_compressed_key_indices_in_range(uint32_t p_compressed_track
 		uint32_t page_index = p;
 
 		double page_base_time = compression.pages[page_index].time_offset;
-		const uint8_t *page_data = compression.pages[page_index].data.ptr();
+		const Vector<uint8_t> page = _get_compressed_page(page_index);
+		ERR_FAIL_COND(page.is_empty());
+		const uint8_t *page_data = page.ptr();
 		// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
 		const uint32_t *indices = (const uint32_t *)page_data;
 		const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
@@ -5573,8 +5744,10 @@ int Animation::_get_compressed_key_count(uint32_t p_compressed_track) const {
 
 	int key_count = 0;
 
-	for (const Compression::Page &page : compression.pages) {
-		const uint8_t *page_data = page.data.ptr();
+	for (uint32_t p = 0; p < compression.pages.size(); p++) {
+		const Vector<uint8_t> page = _get_compressed_page(p);
+		ERR_FAIL_COND_V(page.is_empty(), -1);
+		const uint8_t *page_data = page.ptr();
 		// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
 		const uint32_t *indices = (const uint32_t *)page_data;
 		const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
@@ -5588,6 +5761,198 @@ int Animation::_get_compressed_key_count(uint32_t p_compressed_track) const {
 	return key_count;
 }
 
+int32_t Animation::_find_compressed_page(double p_time) const {
+	// Last page starting at or before p_time, -1 if none.
+	int32_t low = 0;
+	int32_t high = int32_t(compression.pages.size()) - 1;
+	int32_t page_index = -1;
+	while (low <= high) {
+		int32_t middle = (low + high) / 2;
+		if (compression.pages[middle].time_offset > p_time) {
+			high = middle - 1;
+		} else {
+			page_index = middle;
+			low = middle + 1;
+		}
+	}
+	return page_index;
+}
+
+Vector<uint8_t> Animation::_get_compressed_page(uint32_t p_page) const {
+	if (compression.stream_path.is_empty()) {
+		return compression.pages[p_page].data;
+	}
+
+	AnimationStreamedPageCache::Key key;
+	key.animation = get_instance_id();
+	key.page = p_page;
+	{
+		MutexLock lock(streamed_page_cache.mutex);
+		HashMap<AnimationStreamedPageCache::Key, AnimationStreamedPageCache::Entry, AnimationStreamedPageCache::Key>::Iterator E = streamed_page_cache.pages.find(key);
+		if (E) {
+			streamed_page_cache.stats.hits++;
+			streamed_page_cache.lru.move_to_front(E->value.lru);
+			return E->value.data; // Shares the buffer, so eviction can't free it while in use.
+		}
+		streamed_page_cache.stats.misses++;
+	}
+
+	// Read outside the lock so other threads keep hitting the cache meanwhile.
+	Vector<uint8_t> data = _read_streamed_page(p_page);
+	if (data.is_empty()) {
+		return data;
+	}
+
+	// Playback mostly moves forward, so page in the following page as well.
+	AnimationStreamedPageCache::Key next_key = key;
+	next_key.page++;
+	Vector<uint8_t> next_data;
+	if (next_key.page < compression.pages.size()) {
+		bool resident = false;
+		{
+			MutexLock lock(streamed_page_cache.mutex);
+			resident = streamed_page_cache.pages.has(next_key);
+		}
+		if (!resident) {
+			next_data = _read_streamed_page(next_key.page);
+		}
+	}
+
+	MutexLock lock(streamed_page_cache.mutex);
+	if (!next_data.is_empty()) {
+		streamed_page_cache.stats.prefetches++;
+		streamed_page_cache.insert(next_key, next_data);
+	}
+	streamed_page_cache.insert(key, data);
+	return data;
+}
+
+Vector<uint8_t> Animation::_read_streamed_page(uint32_t p_page) const {
+	const Compression::Page &page = compression.pages[p_page];
+	Vector<uint8_t> data;
+	data.resize(page.stream_size);
+
+	MutexLock lock(compression.stream_mutex);
+	if (compression.stream_file.is_null()) {
+		compression.stream_file = FileAccess::open(compression.stream_path, FileAccess::READ);
+		ERR_FAIL_COND_V_MSG(compression.stream_file.is_null(), Vector<uint8_t>(), vformat("Can't open '%s' to stream animation pages.", compression.stream_path));
+	}
+	compression.stream_file->seek(page.stream_offset);
+	uint64_t read = compression.stream_file->get_buffer(data.ptrw(), page.stream_size);
+	ERR_FAIL_COND_V_MSG(read != page.stream_size, Vector<uint8_t>(), vformat("Can't read animation page %d from '%s'.", p_page, compression.stream_path));
+	return data;
+}
+
+void Animation::_make_streamed_pages_resident() {
+	if (compression.stream_path.is_empty()) {
+		return;
+	}
+	for (uint32_t i = 0; i < compression.pages.size(); i++) {
+		compression.pages[i].data = _read_streamed_page(i);
+	}
+	_evict_streamed_pages();
+	_set_stream_path(String());
+}
+
+void Animation::_set_stream_path(const String &p_path) {
+	MutexLock lock(compression.stream_mutex);
+	compression.stream_file.unref();
+	compression.stream_path = p_path;
+}
+
+void Animation::_evict_streamed_pages() const {
+	if (compression.stream_path.is_empty()) {
+		return;
+	}
+	const ObjectID id = get_instance_id();
+	MutexLock lock(streamed_page_cache.mutex);
+	for (uint32_t i = 0; i < compression.pages.size(); i++) {
+		AnimationStreamedPageCache::Key key;
+		key.animation = id;
+		key.page = i;
+		HashMap<AnimationStreamedPageCache::Key, AnimationStreamedPageCache::Entry, AnimationStreamedPageCache::Key>::Iterator E = streamed_page_cache.pages.find(key);
+		if (E) {
+			streamed_page_cache.erase(E);
+		}
+	}
+}
+
+void Animation::set_compression_streamed(bool p_streamed) {
+	if (compression.streamed == p_streamed) {
+		return;
+	}
+	if (!p_streamed) {
+		_make_streamed_pages_resident();
+	}
+	compression.streamed = p_streamed;
+	notify_property_list_changed();
+}
+
+bool Animation::is_compression_streamed() const {
+	return compression.streamed;
+}
+
+bool Animation::set_streamed_buffer(const StringName &p_property, const String &p_file, uint64_t p_offset, uint64_t p_length) {
+	if (p_property != SNAME("_compression_page_data") || !compression.enabled || !compression.streamed) {
+		return false;
+	}
+	uint64_t offset = p_offset;
+	for (Compression::Page &page : compression.pages) {
+		page.stream_offset = offset;
+		offset += page.stream_size;
+	}
+	ERR_FAIL_COND_V_MSG(offset - p_offset != p_length, false, "Streamed animation page sizes don't match the stored page data.");
+	_evict_streamed_pages();
+	_set_stream_path(p_file);
+	return true;
+}
+
+void Animation::make_streamed_buffers_resident(const String &p_file) {
+	if (compression.stream_path.is_empty()) {
+		return;
+	}
+	// The saved file gets a new layout, so the old page offsets wouldn't be valid afterwards either.
+	const ProjectSettings *project_settings = ProjectSettings::get_singleton();
+	if (project_settings->localize_path(compression.stream_path) == project_settings->localize_path(p_file)) {
+		_make_streamed_pages_resident();
+	}
+}
+
+void Animation::set_streamed_page_budget(uint64_t p_bytes) {
+	MutexLock lock(streamed_page_cache.mutex);
+	streamed_page_cache.budget = p_bytes;
+}
+
+uint64_t Animation::get_streamed_page_budget() {
+	MutexLock lock(streamed_page_cache.mutex);
+	return streamed_page_cache.get_budget();
+}
+
+Animation::StreamedPageStats Animation::get_streamed_page_stats() {
+	MutexLock lock(streamed_page_cache.mutex);
+	return streamed_page_cache.stats;
+}
+
+void Animation::reset_streamed_page_stats() {
+	MutexLock lock(streamed_page_cache.mutex);
+	const uint64_t resident_bytes = streamed_page_cache.stats.resident_bytes;
+	streamed_page_cache.stats = StreamedPageStats();
+	streamed_page_cache.stats.resident_bytes = resident_bytes;
+	streamed_page_cache.stats.peak_resident_bytes = resident_bytes;
+}
+
+Dictionary Animation::_get_streamed_page_stats_bind() {
+	StreamedPageStats stats = get_streamed_page_stats();
+	Dictionary ret;
+	ret["hits"] = stats.hits;
+	ret["misses"] = stats.misses;
+	ret["prefetches"] = stats.prefetches;
+	ret["evictions"] = stats.evictions;
+	ret["resident_bytes"] = stats.resident_bytes;
+	ret["peak_resident_bytes"] = stats.peak_resident_bytes;
+	return ret;
+}
+
 Quaternion Animation::_uncompress_quaternion(const Vector3i &p_value) const {
 	Vector3 axis = Vector3::octahedron_decode(Vector2(float(p_value.x) / 65535.0, float(p_value.y) / 65535.0));
 	float angle = (float(p_value.z) / 65535.0) * 2.0 * Math::PI;
@@ -5607,8 +5972,10 @@ bool Animation::_fetch_compressed_by_index(uint32_t p_compressed_track, int p_in
 	ERR_FAIL_COND_V(!compression.enabled, false);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
 
-	for (const Compression::Page &page : compression.pages) {
-		const uint8_t *page_data = page.data.ptr();
+	for (uint32_t p = 0; p < compression.pages.size(); p++) {
+		const Vector<uint8_t> page = _get_compressed_page(p);
+		ERR_FAIL_COND_V(page.is_empty(), false);
+		const uint8_t *page_data = page.ptr();
 		// Little endian assumed. No major big endian hardware exists any longer, but in case it does it will need to be supported.
 		const uint32_t *indices = (const uint32_t *)page_data;
 		const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
@@ -5658,7 +6025,7 @@ bool Animation::_fetch_compressed_by_index(uint32_t p_compressed_track, int p_in
 					}
 				}
 
-				r_time = page.time_offset + double(frame) / double(compression.fps);
+				r_time = compression.pages[p].time_offset + double(frame) / double(compression.fps);
 				for (uint32_t l = 0; l < COMPONENTS; l++) {
 					r_value[l] = decode[l];
 				}
@@ -6538,6 +6905,7 @@ Animation::Animation() {
 }
 
 Animation::~Animation() {
+	_evict_streamed_pages();
 	for (uint32_t i = 0; i < tracks.size(); i++) {
 		memdelete(tracks[i]);
 	}
@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
+#include "core/os/mutex.h"
 #include "core/templates/local_vector.h"
 
 #define ANIM_MIN_LENGTH 0.001
@@ -115,6 +117,14 @@ public:
 		virtual ~Track() {}
 	};
 
+	// Remembers where the previous interpolation of a track landed, so sequential playback
+	// only steps to the neighboring key instead of searching the whole track.
+	// Owned by the caller (one per track and playback), never share it between threads.
+	struct KeyCursor {
+		int key = -1;
+		int end_key = -1;
+	};
+
 private:
 	struct Key {
 		real_t transition = 1.0;
@@ -258,7 +268,9 @@ private:
 
 	template <typename K>
 
-	inline int _find(const LocalVector<K> &p_keys, double p_time, bool p_backward = false, bool p_limit = false) const;
+	inline int _find(const LocalVector<K> &p_keys, double p_time, bool p_backward = false, bool p_limit = false, int *r_hint = nullptr) const;
+	template <typename K>
+	inline int _find_check_limit(const K *p_keys, int p_len, int p_idx, bool p_limit) const;
 
 	_FORCE_INLINE_ Vector3 _interpolate(const Vector3 &p_a, const Vector3 &p_b, real_t p_c) const;
 	_FORCE_INLINE_ Quaternion _interpolate(const Quaternion &p_a, const Quaternion &p_b, real_t p_c) const;
@@ -273,7 +285,7 @@ private:
 	_FORCE_INLINE_ Variant _cubic_interpolate_angle_in_time(const Variant &p_pre_a, const Variant &p_a, const Variant &p_b, const Variant &p_post_b, real_t p_c, real_t p_pre_a_t, real_t p_b_t, real_t p_post_b_t) const;
 
 	template <typename T>
-	_FORCE_INLINE_ T _interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward = false) const;
+	_FORCE_INLINE_ T _interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward = false, KeyCursor *r_cursor = nullptr) const;
 
 	template <typename T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const LocalVector<T> &p_array, double from_time, double to_time, List<int> *p_indices, bool p_is_backward) const;
@@ -344,16 +356,29 @@ private:
 			FORMAT_VERSION = 1
 		};
 		struct Page {
-			Vector<uint8_t> data;
+			Vector<uint8_t> data; // Empty while the page is streamed.
 			double time_offset;
+			uint64_t stream_offset = 0;
+			uint32_t stream_size = 0;
 		};
 
 		uint32_t fps = 120;
 		LocalVector<Page> pages;
 		LocalVector<AABB> bounds; // Used by position and scale tracks (which contain index to track and index to bounds).
 		bool enabled = false;
+		bool streamed = false; // Saved with pages laid out so they can be streamed from the resource file.
+		String stream_path; // When set, pages are read from this file on demand.
+		mutable Ref<FileAccess> stream_file; // Opened on the first read and shared by all of them.
+		mutable BinaryMutex stream_mutex; // Guards stream_file, so seeks and reads don't interleave.
 	} compression;
 
+	int32_t _find_compressed_page(double p_time) const;
+	Vector<uint8_t> _get_compressed_page(uint32_t p_page) const;
+	Vector<uint8_t> _read_streamed_page(uint32_t p_page) const;
+	void _make_streamed_pages_resident();
+	void _set_stream_path(const String &p_path);
+	void _evict_streamed_pages() const;
+
 	Vector3i _compress_key(uint32_t p_track, const AABB &p_bounds, int32_t p_key = -1, float p_time = 0.0);
 	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const;
 	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret) const;
@@ -393,6 +418,8 @@ protected:
 
 	static bool inform_variant_array(int &r_min, int &r_max); // Returns true if max and min are swapped.
 
+	static Dictionary _get_streamed_page_stats_bind();
+
 #ifndef DISABLE_DEPRECATED
 	Vector3 _position_track_interpolate_bind_compat_86629(int p_track, double p_time) const;
 	Quaternion _rotation_track_interpolate_bind_compat_86629(int p_track, double p_time) const;
@@ -448,22 +475,22 @@ public:
 
 	int position_track_insert_key(int p_track, double p_time, const Vector3 &p_position);
 	Error position_track_get_key(int p_track, int p_key, Vector3 *r_position) const;
-	Error try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward = false) const;
+	Error try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward = false, KeyCursor *r_cursor = nullptr) const;
 	Vector3 position_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
 	int rotation_track_insert_key(int p_track, double p_time, const Quaternion &p_rotation);
 	Error rotation_track_get_key(int p_track, int p_key, Quaternion *r_rotation) const;
-	Error try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward = false) const;
+	Error try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward = false, KeyCursor *r_cursor = nullptr) const;
 	Quaternion rotation_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
 	int scale_track_insert_key(int p_track, double p_time, const Vector3 &p_scale);
 	Error scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) const;
-	Error try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward = false) const;
+	Error try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward = false, KeyCursor *r_cursor = nullptr) const;
 	Vector3 scale_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
 	int blend_shape_track_insert_key(int p_track, double p_time, float p_blend);
 	Error blend_shape_track_get_key(int p_track, int p_key, float *r_blend) const;
-	Error try_blend_shape_track_interpolate(int p_track, double p_time, float *r_blend, bool p_backward = false) const;
+	Error try_blend_shape_track_interpolate(int p_track, double p_time, float *r_blend, bool p_backward = false, KeyCursor *r_cursor = nullptr) const;
 	float blend_shape_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 
 	void track_set_interpolation_type(int p_track, InterpolationType p_interp);
@@ -484,6 +511,7 @@ public:
 	bool bezier_track_calculate_handles(float p_time, float p_prev_time, float p_prev_value, float p_next_time, float p_next_value, HandleMode p_mode, HandleSetMode p_set_mode, Vector2 *r_in_handle, Vector2 *r_out_handle);
 #endif // TOOLS_ENABLED
 
+	Error try_bezier_track_interpolate(int p_track, double p_time, real_t *r_interpolation, KeyCursor *r_cursor = nullptr) const;
 	real_t bezier_track_interpolate(int p_track, double p_time) const;
 
 	int audio_track_insert_key(int p_track, double p_time, const Ref<Resource> &p_stream, real_t p_start_offset = 0, real_t p_end_offset = 0);
@@ -503,6 +531,7 @@ public:
 	void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
+	Error try_value_track_interpolate(int p_track, double p_time, Variant *r_interpolation, bool p_backward = false, KeyCursor *r_cursor = nullptr) const;
 	Variant value_track_interpolate(int p_track, double p_time, bool p_backward = false) const;
 	void value_track_set_update_mode(int p_track, UpdateMode p_mode);
 	UpdateMode value_track_get_update_mode(int p_track) const;
@@ -539,6 +568,27 @@ public:
 	void optimize(real_t p_allowed_velocity_err = 0.01, real_t p_allowed_angular_err = 0.01, int p_precision = 3);
 	void compress(uint32_t p_page_size = 8192, uint32_t p_fps = 120, float p_split_tolerance = 4.0); // 4.0 seems to be the split tolerance sweet spot from many tests.
 
+	struct StreamedPageStats {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t prefetches = 0;
+		uint64_t evictions = 0;
+		uint64_t resident_bytes = 0;
+		uint64_t peak_resident_bytes = 0;
+	};
+
+	void set_compression_streamed(bool p_streamed);
+	bool is_compression_streamed() const;
+	bool is_compression_streaming() const { return !compression.stream_path.is_empty(); }
+	virtual bool set_streamed_buffer(const StringName &p_property, const String &p_file, uint64_t p_offset, uint64_t p_length) override;
+	virtual void make_streamed_buffers_resident(const String &p_file) override;
+
+	// Streamed pages of all animations share one LRU cache bounded by this budget.
+	static void set_streamed_page_budget(uint64_t p_bytes); // 0 uses the project setting.
+	static uint64_t get_streamed_page_budget();
+	static StreamedPageStats get_streamed_page_stats();
+	static void reset_streamed_page_stats();
+
 	// Helper functions for Rotation.
 	static double interpolate_via_rest(double p_from, double p_to, double p_weight, double p_rest = 0.0); // Deterministic slerp to prevent to cross the inverted rest axis.
 	static Quaternion interpolate_via_rest(const Quaternion &p_from, const Quaternion &p_to, real_t p_weight, const Quaternion &p_rest = Quaternion()); // Deterministic slerp to prevent to cross the inverted rest axis.
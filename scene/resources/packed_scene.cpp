@@ -35,6 +35,8 @@
 #include "core/io/missing_resource.h"
 #include "core/io/resource_loader.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "core/templates/local_vector.h"
 #include "core/variant/callable_bind.h"
 #include "scene/2d/node_2d.h"
@@ -49,6 +51,8 @@
 
 #define PACKED_SCENE_VERSION 3
 
+static thread_local SceneState::InstantiateTimings last_instantiate_timings;
+
 #ifdef TOOLS_ENABLED
 SceneState::InstantiationWarningNotify SceneState::instantiation_warn_notify = nullptr;
 #endif
@@ -150,7 +154,47 @@ static Node *_find_node_by_id(Node *p_owner, Node *p_node, int32_t p_id) {
 	return nullptr;
 }
 
+// Duplicates a stored container so instances don't share it, converting it to
+// the typing of the current property value when needed.
+static Array _match_property_array(Node *p_node, const StringName &p_property, const Array &p_array) {
+	Array set_array = p_array;
+	bool is_get_valid = false;
+	Variant get_value = p_node->get(p_property, &is_get_valid);
+
+	if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+		Array get_array = get_value;
+		if (set_array.is_same_typed(get_array)) {
+			set_array = set_array.duplicate();
+		} else {
+			set_array = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+		}
+	}
+	return set_array;
+}
+
+static Dictionary _match_property_dictionary(Node *p_node, const StringName &p_property, const Dictionary &p_dictionary) {
+	Dictionary set_dict = p_dictionary;
+	bool is_get_valid = false;
+	Variant get_value = p_node->get(p_property, &is_get_valid);
+
+	if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+		Dictionary get_dict = get_value;
+		if (set_dict.is_same_typed(get_dict)) {
+			set_dict = set_dict.duplicate();
+		} else {
+			set_dict = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(), get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
+		}
+	}
+	return set_dict;
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && threaded_instantiation_min_nodes > 0 && nodes.size() >= threaded_instantiation_min_nodes && _prepare_threaded_instantiation()) {
+		return _instantiate_threaded();
+	}
+
+	uint64_t start_time = OS::get_singleton()->get_ticks_usec();
+
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
@@ -446,36 +490,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 						}
 
 						if (value.get_type() == Variant::ARRAY) {
-							Array set_array = value;
-							bool is_get_valid = false;
-							Variant get_value = node->get(snames[nprops[j].name], &is_get_valid);
-
-							if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-								Array get_array = get_value;
-								if (set_array.is_same_typed(get_array)) {
-									set_array = set_array.duplicate();
-								} else {
-									set_array = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-								}
-							}
-
+							Array set_array = _match_property_array(node, snames[nprops[j].name], value);
 							value = setup_resources_in_array(set_array, n, resources_local_to_scenes, node, snames[nprops[j].name], i, ret_nodes, p_edit_state);
 						}
 
 						if (value.get_type() == Variant::DICTIONARY) {
-							Dictionary set_dict = value;
-							bool is_get_valid = false;
-							Variant get_value = node->get(snames[nprops[j].name], &is_get_valid);
-
-							if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-								Dictionary get_dict = get_value;
-								if (set_dict.is_same_typed(get_dict)) {
-									set_dict = set_dict.duplicate();
-								} else {
-									set_dict = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(), get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-								}
-							}
-
+							Dictionary set_dict = _match_property_dictionary(node, snames[nprops[j].name], value);
 							value = setup_resources_in_dictionary(set_dict, n, resources_local_to_scenes, node, snames[nprops[j].name], i, ret_nodes, p_edit_state);
 						}
 
@@ -592,7 +612,43 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		}
 	}
 
-	for (const DeferredNodePathProperties &dnp : deferred_node_paths) {
+	_resolve_deferred_node_paths(deferred_node_paths);
+
+	for (KeyValue<Node *, HashMap<Ref<Resource>, Ref<Resource>>> &E : resources_local_to_scenes) {
+		for (KeyValue<Ref<Resource>, Ref<Resource>> &R : E.value) {
+			R.value->setup_local_to_scene(); // Setup may be required for the resource to work properly.
+		}
+	}
+
+	//do connections
+
+	_connect_instantiated_nodes(ret_nodes, nc, p_edit_state == GEN_EDIT_STATE_MAIN ? 0 : CONNECT_INHERITED);
+
+	//Node *s = ret_nodes[0];
+
+	//remove nodes that could not be added, likely as a result that
+	while (stray_instances.size()) {
+		memdelete(stray_instances.front()->get());
+		stray_instances.pop_front();
+	}
+
+	for (int i = 0; i < editable_instances.size(); i++) {
+		Node *ei = ret_nodes[0]->get_node_or_null(editable_instances[i]);
+		if (ei) {
+			ret_nodes[0]->set_editable_instance(ei, true);
+		}
+	}
+
+	InstantiateTimings timings;
+	timings.node_count = nc;
+	timings.total_usec = OS::get_singleton()->get_ticks_usec() - start_time;
+	last_instantiate_timings = timings;
+
+	return ret_nodes[0];
+}
+
+void SceneState::_resolve_deferred_node_paths(const LocalVector<DeferredNodePathProperties> &p_deferred_node_paths) const {
+	for (const DeferredNodePathProperties &dnp : p_deferred_node_paths) {
 		// Replace properties stored as NodePaths with actual Nodes.
 		Node *base = ObjectDB::get_instance<Node>(dnp.base);
 		ERR_CONTINUE_EDMSG(!base, vformat("Failed to set deferred property '%s' as the base node disappeared.", dnp.property));
@@ -637,25 +693,33 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			base->set(dnp.property, base->get_node_or_null(dnp.value));
 		}
 	}
+}
 
-	for (KeyValue<Node *, HashMap<Ref<Resource>, Ref<Resource>>> &E : resources_local_to_scenes) {
-		for (KeyValue<Ref<Resource>, Ref<Resource>> &R : E.value) {
-			R.value->setup_local_to_scene(); // Setup may be required for the resource to work properly.
+Node *SceneState::_get_instantiated_node(Node *const *p_nodes, int p_node_count, int p_id) const {
+	if (p_id & FLAG_ID_IS_PATH) {
+		Node *node = p_nodes[0]->get_node_or_null(node_paths[p_id & FLAG_MASK]);
+		if (!node) {
+			node = _recover_node_path_index(p_nodes[0], p_id & FLAG_MASK);
 		}
+		return node;
 	}
 
-	//do connections
+	ERR_FAIL_INDEX_V(p_id & FLAG_MASK, p_node_count, nullptr);
+	return p_nodes[p_id & FLAG_MASK];
+}
+
+void SceneState::_connect_instantiated_nodes(Node *const *p_nodes, int p_node_count, uint32_t p_connect_flags) const {
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
 
 	int cc = connections.size();
 	const ConnectionData *cdata = connections.ptr();
 
 	for (int i = 0; i < cc; i++) {
 		const ConnectionData &c = cdata[i];
-		//ERR_FAIL_INDEX_V( c.from, nc, nullptr );
-		//ERR_FAIL_INDEX_V( c.to, nc, nullptr );
 
-		NODE_FROM_ID(cfrom, c.from);
-		NODE_FROM_ID(cto, c.to);
+		Node *cfrom = _get_instantiated_node(p_nodes, p_node_count, c.from);
+		Node *cto = _get_instantiated_node(p_nodes, p_node_count, c.to);
 
 		if (!cfrom || !cto) {
 			continue;
@@ -680,25 +744,353 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			callable = callable.unbind(c.unbinds);
 		}
 
-		cfrom->connect(snames[c.signal], callable, CONNECT_PERSIST | c.flags | (p_edit_state == GEN_EDIT_STATE_MAIN ? 0 : CONNECT_INHERITED));
+		cfrom->connect(snames[c.signal], callable, CONNECT_PERSIST | c.flags | p_connect_flags);
 	}
+}
 
-	//Node *s = ret_nodes[0];
+void SceneState::_invalidate_threaded_instantiation() {
+	MutexLock lock(threaded_data_mutex);
+	threaded_data = ThreadedInstantiationData();
+}
 
-	//remove nodes that could not be added, likely as a result that
-	while (stray_instances.size()) {
-		memdelete(stray_instances.front()->get());
-		stray_instances.pop_front();
+static bool _is_local_resource(const Variant &p_value) {
+	Ref<Resource> res = p_value;
+	return res.is_valid() && res->is_local_to_scene();
+}
+
+bool SceneState::_prepare_threaded_instantiation() const {
+	MutexLock lock(threaded_data_mutex);
+
+	if (threaded_data.checked) {
+		return threaded_data.supported;
 	}
+	threaded_data.checked = true;
 
-	for (int i = 0; i < editable_instances.size(); i++) {
-		Node *ei = ret_nodes[0]->get_node_or_null(editable_instances[i]);
-		if (ei) {
-			ret_nodes[0]->set_editable_instance(ei, true);
+	if (Engine::get_singleton()->is_editor_hint() || ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+		// Not cached, the editor may toggle these at any time.
+		threaded_data.checked = false;
+		return false;
+	}
+
+	// Only plain scenes qualify: every node must be created by this state, with
+	// no scripts, instanced sub-scenes or local-to-scene resources, since those
+	// run user code or share state across the whole scene while being set up.
+	if (base_scene_idx >= 0) {
+		return false;
+	}
+
+	const int nc = nodes.size();
+	const NodeData *nd = nodes.ptr();
+	const StringName *snames = names.ptr();
+	const int sname_count = names.size();
+	const int prop_count = variants.size();
+
+	HashMap<uint64_t, ResolvedSetter> setter_cache;
+	LocalVector<int> node_subtree;
+	node_subtree.resize(nc);
+
+	LocalVector<int> subtree_roots;
+	LocalVector<uint32_t> setter_offsets;
+	LocalVector<ResolvedSetter> setters;
+	setter_offsets.resize(nc + 1);
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nd[i];
+
+		if (n.instance >= 0 || n.type == TYPE_INSTANTIATED || n.type < 0 || n.type >= sname_count) {
+			return false;
+		}
+
+		const StringName &type = snames[n.type];
+		if (!ClassDB::can_instantiate(type) || !ClassDB::is_parent_class(type, SNAME("Node"))) {
+			return false;
+		}
+		ClassDB::APIType api = ClassDB::get_api_type(type);
+		if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+			return false;
+		}
+
+		if (i == 0) {
+			node_subtree[i] = -1;
+		} else {
+			if (n.parent < 0 || (n.parent & FLAG_ID_IS_PATH) || n.parent >= i) {
+				return false;
+			}
+			if (n.parent == 0) {
+				node_subtree[i] = subtree_roots.size();
+				subtree_roots.push_back(i);
+			} else {
+				node_subtree[i] = node_subtree[n.parent];
+			}
+		}
+
+		if (n.owner >= 0 && ((n.owner & FLAG_ID_IS_PATH) || n.owner >= nc)) {
+			return false;
+		}
+
+		setter_offsets[i] = setters.size();
+
+		for (const NodeData::Property &prop : n.properties) {
+			ResolvedSetter setter;
+			if (prop.value < 0 || prop.value >= prop_count) {
+				return false;
+			}
+
+			if (prop.name < 0 || (prop.name & FLAG_PROP_NAME_MASK) >= sname_count) {
+				return false;
+			}
+
+			if (!(prop.name & FLAG_PATH_PROPERTY_IS_NODE)) {
+				if (snames[prop.name] == CoreStringName(script)) {
+					return false;
+				}
+
+				const Variant &value = variants[prop.value];
+				if (value.get_type() == Variant::OBJECT) {
+					if (_is_local_resource(value)) {
+						return false;
+					}
+				} else if (value.get_type() == Variant::ARRAY) {
+					if (has_local_resource(value)) {
+						return false;
+					}
+				} else if (value.get_type() == Variant::DICTIONARY) {
+					Dictionary dict = value;
+					if (has_local_resource(dict.keys()) || has_local_resource(dict.values())) {
+						return false;
+					}
+				}
+
+				uint64_t key = (uint64_t(n.type) << 32) | uint32_t(prop.name);
+				ResolvedSetter *cached = setter_cache.getptr(key);
+				if (cached) {
+					setter = *cached;
+				} else {
+					const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(type, snames[prop.name]);
+					if (psg && psg->_setptr) {
+						setter.method = psg->_setptr;
+						setter.index = psg->index;
+					}
+					setter_cache.insert(key, setter);
+				}
+			}
+
+			setters.push_back(setter);
 		}
 	}
+	setter_offsets[nc] = setters.size();
 
-	return ret_nodes[0];
+	if (subtree_roots.size() < 2) {
+		// Nothing to build in parallel.
+		return false;
+	}
+
+	// Bucket the nodes by subtree, keeping the scene order inside each one so
+	// parents are always built before their children.
+	LocalVector<uint32_t> subtree_offsets;
+	subtree_offsets.resize(subtree_roots.size() + 1);
+	for (uint32_t &offset : subtree_offsets) {
+		offset = 0;
+	}
+	for (int i = 1; i < nc; i++) {
+		subtree_offsets[node_subtree[i] + 1]++;
+	}
+	for (uint32_t i = 1; i < subtree_offsets.size(); i++) {
+		subtree_offsets[i] += subtree_offsets[i - 1];
+	}
+
+	LocalVector<int> subtree_nodes;
+	subtree_nodes.resize(nc - 1);
+	LocalVector<uint32_t> fill = subtree_offsets;
+	for (int i = 1; i < nc; i++) {
+		subtree_nodes[fill[node_subtree[i]]++] = i;
+	}
+
+	threaded_data.supported = true;
+	threaded_data.subtree_roots = subtree_roots;
+	threaded_data.subtree_offsets = subtree_offsets;
+	threaded_data.subtree_nodes = subtree_nodes;
+	threaded_data.setter_offsets = setter_offsets;
+	threaded_data.setters = setters;
+	return true;
+}
+
+Node *SceneState::_instantiate_threaded_node(int p_idx, Node **p_nodes, LocalVector<DeferredNodePathProperties> &r_deferred_node_paths) const {
+	const NodeData &n = nodes[p_idx];
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+
+	Node *parent = nullptr;
+	if (p_idx > 0) {
+		parent = p_nodes[n.parent];
+		if (!parent) {
+			// The parent failed to be created, so there is nowhere to put this one.
+			return nullptr;
+		}
+	}
+
+	Object *obj = ClassDB::instantiate(snames[n.type]);
+	Node *node = Object::cast_to<Node>(obj);
+	if (!node) {
+		if (obj) {
+			memdelete(obj);
+		}
+		ERR_FAIL_V_MSG(nullptr, vformat("Node %s of type %s cannot be created.", snames[n.name], snames[n.type]));
+	}
+
+	if (p_idx < ids.size()) {
+		node->set_unique_scene_id(ids[p_idx]);
+	}
+
+	const ResolvedSetter *setters = &threaded_data.setters[threaded_data.setter_offsets[p_idx]];
+	for (int j = 0; j < n.properties.size(); j++) {
+		const NodeData::Property &prop = n.properties[j];
+
+		if (prop.name & FLAG_PATH_PROPERTY_IS_NODE) {
+			DeferredNodePathProperties dnp;
+			dnp.value = props[prop.value];
+			dnp.base = node->get_instance_id();
+			dnp.property = snames[prop.name & FLAG_PROP_NAME_MASK];
+			r_deferred_node_paths.push_back(dnp);
+			continue;
+		}
+
+		const StringName &property = snames[prop.name];
+		Variant value = props[prop.value];
+		if (value.get_type() == Variant::ARRAY) {
+			value = _match_property_array(node, property, value);
+		} else if (value.get_type() == Variant::DICTIONARY) {
+			value = _match_property_dictionary(node, property, value);
+		}
+
+		const ResolvedSetter &setter = setters[j];
+		if (!setter.method) {
+			node->set(property, value);
+			continue;
+		}
+
+#ifdef TOOLS_ENABLED
+		node->set_edited(true);
+#endif
+		Callable::CallError ce;
+		if (setter.index >= 0) {
+			Variant index = setter.index;
+			const Variant *args[2] = { &index, &value };
+			setter.method->call(node, args, 2, ce);
+		} else {
+			const Variant *args[1] = { &value };
+			setter.method->call(node, args, 1, ce);
+		}
+	}
+
+	for (int group : n.groups) {
+		node->add_to_group(snames[group], true);
+	}
+
+	node->remove_meta("_edit_pinned_properties_");
+
+	if (p_idx == 0) {
+		node->_set_name_nocheck(snames[n.name]);
+	} else if (n.parent != 0) {
+		// Roots of subtrees are added to the scene root in the final batch.
+		parent->_add_child_nocheck(node, snames[n.name]);
+		if (n.index >= 0 && n.index < parent->get_child_count() - 1) {
+			parent->move_child(node, n.index);
+		}
+	}
+
+	return node;
+}
+
+void SceneState::_instantiate_subtree(uint32_t p_subtree, ThreadedInstantiation *p_instantiation) const {
+	LocalVector<DeferredNodePathProperties> &deferred_node_paths = p_instantiation->deferred_node_paths[p_subtree];
+	for (uint32_t i = threaded_data.subtree_offsets[p_subtree]; i < threaded_data.subtree_offsets[p_subtree + 1]; i++) {
+		int idx = threaded_data.subtree_nodes[i];
+		p_instantiation->nodes[idx] = _instantiate_threaded_node(idx, p_instantiation->nodes, deferred_node_paths);
+	}
+}
+
+Node *SceneState::_instantiate_threaded() const {
+	// Subtrees hanging from the scene root don't reference each other until
+	// NodePaths and connections are resolved, so each one is built and
+	// configured on a worker thread while still outside the scene tree.
+	// Attaching them to the root, ownership and everything that looks nodes
+	// up by path happen afterwards on the calling thread.
+	InstantiateTimings timings;
+	timings.threaded = true;
+	timings.node_count = nodes.size();
+	timings.subtree_count = threaded_data.subtree_roots.size();
+
+	uint64_t start_time = OS::get_singleton()->get_ticks_usec();
+
+	const int nc = nodes.size();
+	const NodeData *nd = nodes.ptr();
+	const StringName *snames = names.ptr();
+
+	ThreadedInstantiation instantiation;
+	instantiation.nodes = (Node **)alloca(sizeof(Node *) * nc);
+	memset(instantiation.nodes, 0, sizeof(Node *) * nc);
+	instantiation.deferred_node_paths.resize(threaded_data.subtree_roots.size() + 1);
+
+	LocalVector<DeferredNodePathProperties> &root_deferred_node_paths = instantiation.deferred_node_paths[threaded_data.subtree_roots.size()];
+	Node *root = _instantiate_threaded_node(0, instantiation.nodes, root_deferred_node_paths);
+	ERR_FAIL_NULL_V(root, nullptr);
+	instantiation.nodes[0] = root;
+
+	uint64_t build_start = OS::get_singleton()->get_ticks_usec();
+	timings.prepare_usec = build_start - start_time;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneState::_instantiate_subtree, &instantiation, threaded_data.subtree_roots.size(), -1, true, SNAME("SceneStateInstantiate"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	uint64_t attach_start = OS::get_singleton()->get_ticks_usec();
+	timings.build_usec = attach_start - build_start;
+
+	for (int idx : threaded_data.subtree_roots) {
+		Node *node = instantiation.nodes[idx];
+		if (!node) {
+			continue;
+		}
+		const NodeData &n = nd[idx];
+		root->_add_child_nocheck(node, snames[n.name]);
+		if (n.index >= 0 && n.index < root->get_child_count() - 1) {
+			root->move_child(node, n.index);
+		}
+	}
+
+	for (int i = 1; i < nc; i++) {
+		Node *node = instantiation.nodes[i];
+		const NodeData &n = nd[i];
+		if (!node || n.owner < 0) {
+			continue;
+		}
+		Node *owner = instantiation.nodes[n.owner];
+		if (owner) {
+			node->_set_owner_nocheck(owner);
+			if (node->data.unique_name_in_owner) {
+				node->_acquire_unique_name_in_owner();
+			}
+		}
+	}
+
+	uint64_t node_paths_start = OS::get_singleton()->get_ticks_usec();
+	timings.attach_usec = node_paths_start - attach_start;
+
+	for (const LocalVector<DeferredNodePathProperties> &deferred_node_paths : instantiation.deferred_node_paths) {
+		_resolve_deferred_node_paths(deferred_node_paths);
+	}
+
+	uint64_t connections_start = OS::get_singleton()->get_ticks_usec();
+	timings.node_paths_usec = connections_start - node_paths_start;
+
+	_connect_instantiated_nodes(instantiation.nodes, nc, CONNECT_INHERITED);
+
+	uint64_t end_time = OS::get_singleton()->get_ticks_usec();
+	timings.connections_usec = end_time - connections_start;
+	timings.total_usec = end_time - start_time;
+	last_instantiate_timings = timings;
+
+	return root;
 }
 
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Node *, HashMap<Ref<Resource>, Ref<Resource>>> &p_resources_local_to_scenes, Node *p_node, const StringName p_sname, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
@@ -1451,6 +1843,7 @@ void SceneState::clear() {
 	ids.clear();
 	id_paths.clear();
 	base_scene_idx = -1;
+	_invalidate_threaded_instantiation();
 }
 
 Error SceneState::copy_from(const Ref<SceneState> &p_scene_state) {
@@ -1596,6 +1989,20 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+int SceneState::threaded_instantiation_min_nodes = 0;
+
+void SceneState::set_threaded_instantiation_min_nodes(int p_min_nodes) {
+	threaded_instantiation_min_nodes = p_min_nodes;
+}
+
+int SceneState::get_threaded_instantiation_min_nodes() {
+	return threaded_instantiation_min_nodes;
+}
+
+SceneState::InstantiateTimings SceneState::get_last_instantiate_timings() {
+	return last_instantiate_timings;
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1645,6 +2052,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_invalidate_threaded_instantiation();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -2300,6 +2709,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nodes.push_back(nd);
 
 	ids.push_back(p_unique_id);
+	_invalidate_threaded_instantiation();
 
 	return nodes.size() - 1;
 }
@@ -2316,6 +2726,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	}
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_invalidate_threaded_instantiation();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -2327,6 +2738,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
 	base_scene_idx = p_idx;
+	_invalidate_threaded_instantiation();
 }
 
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, int p_unbinds, const Vector<int> &p_binds) {
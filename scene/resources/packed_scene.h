@@ -98,6 +98,44 @@ class SceneState : public RefCounted {
 	uint64_t last_modified_time = 0;
 
 	static bool disable_placeholders;
+	static int threaded_instantiation_min_nodes;
+
+	// Setter resolved once per node type and property, so threaded instantiation
+	// can skip the string lookups done by Object::set().
+	struct ResolvedSetter {
+		MethodBind *method = nullptr;
+		int index = -1;
+	};
+
+	struct ThreadedInstantiationData {
+		bool checked = false;
+		bool supported = false;
+		// Nodes are grouped by the root child they descend from, in scene order.
+		LocalVector<int> subtree_roots;
+		LocalVector<uint32_t> subtree_offsets;
+		LocalVector<int> subtree_nodes;
+		// One entry per node property, starting at setter_offsets[node].
+		LocalVector<uint32_t> setter_offsets;
+		LocalVector<ResolvedSetter> setters;
+	};
+
+	struct ThreadedInstantiation {
+		Node **nodes = nullptr;
+		LocalVector<LocalVector<DeferredNodePathProperties>> deferred_node_paths;
+	};
+
+	mutable ThreadedInstantiationData threaded_data;
+	mutable BinaryMutex threaded_data_mutex;
+
+	void _invalidate_threaded_instantiation();
+	bool _prepare_threaded_instantiation() const;
+	Node *_instantiate_threaded_node(int p_idx, Node **p_nodes, LocalVector<DeferredNodePathProperties> &r_deferred_node_paths) const;
+	void _instantiate_subtree(uint32_t p_subtree, ThreadedInstantiation *p_instantiation) const;
+	Node *_instantiate_threaded() const;
+
+	void _resolve_deferred_node_paths(const LocalVector<DeferredNodePathProperties> &p_deferred_node_paths) const;
+	void _connect_instantiated_nodes(Node *const *p_nodes, int p_node_count, uint32_t p_connect_flags) const;
+	Node *_get_instantiated_node(Node *const *p_nodes, int p_node_count, int p_id) const;
 
 	Vector<String> _get_node_groups(int p_idx) const;
 
@@ -138,7 +176,23 @@ public:
 		int node = -1;
 	};
 
+	struct InstantiateTimings {
+		bool threaded = false;
+		uint32_t node_count = 0;
+		uint32_t subtree_count = 0;
+		uint64_t prepare_usec = 0;
+		uint64_t build_usec = 0;
+		uint64_t attach_usec = 0;
+		uint64_t node_paths_usec = 0;
+		uint64_t connections_usec = 0;
+		uint64_t total_usec = 0;
+	};
+
 	static void set_disable_placeholders(bool p_disable);
+	static void set_threaded_instantiation_min_nodes(int p_min_nodes);
+	static int get_threaded_instantiation_min_nodes();
+	// Timings of the last instantiate() call made from the calling thread.
+	static InstantiateTimings get_last_instantiate_timings();
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Node *, HashMap<Ref<Resource>, Ref<Resource>>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
@@ -31,6 +31,11 @@
 #include "audio_filter_sw.h"
 
 #include "core/math/math_funcs.h"
+#include "servers/audio/audio_mixer_simd.h"
+
+#ifdef AUDIO_MIXER_SSE2
+#include <emmintrin.h>
+#endif
 
 void AudioFilterSW::set_mode(Mode p_mode) {
 	mode = p_mode;
@@ -260,3 +265,80 @@ void AudioFilterSW::Processor::process(float *p_samples, int p_amount, int p_str
 		}
 	}
 }
+
+void AudioFilterSW::Processor::process_stereo_interp(Processor *p_left, Processor *p_right, float *p_samples, int p_amount) {
+	if (!p_left->filter || !p_right->filter) {
+		return;
+	}
+
+#ifdef AUDIO_MIXER_SSE2
+	// Same operations as process_one_interp() on both sides at once, so the output is identical.
+	const __m128d incr_b0 = _mm_set1_pd(p_left->incr_coeffs.b0);
+	const __m128d incr_b1 = _mm_set1_pd(p_left->incr_coeffs.b1);
+	const __m128d incr_b2 = _mm_set1_pd(p_left->incr_coeffs.b2);
+	const __m128d incr_a1 = _mm_set1_pd(p_left->incr_coeffs.a1);
+	const __m128d incr_a2 = _mm_set1_pd(p_left->incr_coeffs.a2);
+	__m128d b0 = _mm_set1_pd(p_left->coeffs.b0);
+	__m128d b1 = _mm_set1_pd(p_left->coeffs.b1);
+	__m128d b2 = _mm_set1_pd(p_left->coeffs.b2);
+	__m128d a1 = _mm_set1_pd(p_left->coeffs.a1);
+	__m128d a2 = _mm_set1_pd(p_left->coeffs.a2);
+
+	__m128d ha1 = _mm_setr_pd(p_left->ha1, p_right->ha1);
+	__m128d ha2 = _mm_setr_pd(p_left->ha2, p_right->ha2);
+	__m128d hb1 = _mm_setr_pd(p_left->hb1, p_right->hb1);
+	__m128d hb2 = _mm_setr_pd(p_left->hb2, p_right->hb2);
+
+	for (int i = 0; i < p_amount; i++) {
+		float *sample = &p_samples[i * 2];
+		__m128d pre = _mm_setr_pd(sample[0], sample[1]);
+		__m128d result = _mm_mul_pd(pre, b0);
+		result = _mm_add_pd(result, _mm_mul_pd(hb1, b1));
+		result = _mm_add_pd(result, _mm_mul_pd(hb2, b2));
+		result = _mm_add_pd(result, _mm_mul_pd(ha1, a1));
+		result = _mm_add_pd(result, _mm_mul_pd(ha2, a2));
+
+		// The history is kept in single precision, like the output.
+		__m128 result_f = _mm_cvtpd_ps(result);
+		sample[0] = _mm_cvtss_f32(result_f);
+		sample[1] = _mm_cvtss_f32(_mm_shuffle_ps(result_f, result_f, _MM_SHUFFLE(1, 1, 1, 1)));
+
+		ha2 = ha1;
+		hb2 = hb1;
+		hb1 = pre;
+		ha1 = _mm_cvtps_pd(result_f);
+
+		b0 = _mm_add_pd(b0, incr_b0);
+		b1 = _mm_add_pd(b1, incr_b1);
+		b2 = _mm_add_pd(b2, incr_b2);
+		a1 = _mm_add_pd(a1, incr_a1);
+		a2 = _mm_add_pd(a2, incr_a2);
+	}
+
+	double lanes[2];
+	_mm_storeu_pd(lanes, ha1);
+	p_left->ha1 = lanes[0];
+	p_right->ha1 = lanes[1];
+	_mm_storeu_pd(lanes, ha2);
+	p_left->ha2 = lanes[0];
+	p_right->ha2 = lanes[1];
+	_mm_storeu_pd(lanes, hb1);
+	p_left->hb1 = lanes[0];
+	p_right->hb1 = lanes[1];
+	_mm_storeu_pd(lanes, hb2);
+	p_left->hb2 = lanes[0];
+	p_right->hb2 = lanes[1];
+
+	p_left->coeffs.b0 = _mm_cvtsd_f64(b0);
+	p_left->coeffs.b1 = _mm_cvtsd_f64(b1);
+	p_left->coeffs.b2 = _mm_cvtsd_f64(b2);
+	p_left->coeffs.a1 = _mm_cvtsd_f64(a1);
+	p_left->coeffs.a2 = _mm_cvtsd_f64(a2);
+	p_right->coeffs = p_left->coeffs;
+#else
+	for (int i = 0; i < p_amount; i++) {
+		p_left->process_one_interp(p_samples[i * 2]);
+		p_right->process_one_interp(p_samples[i * 2 + 1]);
+	}
+#endif
+}
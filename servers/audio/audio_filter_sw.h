@@ -69,6 +69,8 @@ public:
 		void update_coeffs(int p_interp_buffer_len = 0);
 		_ALWAYS_INLINE_ void process_one(float &p_sample);
 		_ALWAYS_INLINE_ void process_one_interp(float &p_sample);
+		// Processes interleaved stereo samples, with both processors set to the same filter and updated together.
+		static void process_stereo_interp(Processor *p_left, Processor *p_right, float *p_samples, int p_amount);
 
 		Processor();
 	};
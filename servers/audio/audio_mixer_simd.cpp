@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  audio_mixer_simd.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "audio_mixer_simd.h"
+
+#include "core/math/math_funcs.h"
+
+#if defined(AUDIO_MIXER_SSE2)
+#include <emmintrin.h>
+#elif defined(AUDIO_MIXER_NEON)
+#include <arm_neon.h>
+#endif
+
+template <bool ACCUMULATE>
+static _FORCE_INLINE_ void _mix_volume_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	// The volume of frame i is p_vol_start + vol_step * i, computed from the index so it doesn't drift.
+	const AudioFrame vol_step = (p_vol_final - p_vol_start) * (1.0f / p_frames);
+	uint32_t i = 0;
+
+#if defined(AUDIO_MIXER_SSE2)
+	const __m128 vol_start = _mm_setr_ps(p_vol_start.left, p_vol_start.right, p_vol_start.left, p_vol_start.right);
+	const __m128 vol_incr = _mm_setr_ps(vol_step.left, vol_step.right, vol_step.left, vol_step.right);
+	const __m128 two = _mm_set1_ps(2.0f);
+	__m128 index = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 vol = _mm_add_ps(vol_start, _mm_mul_ps(vol_incr, index));
+		__m128 mixed = _mm_mul_ps(vol, _mm_loadu_ps(&p_src[i].left));
+		if constexpr (ACCUMULATE) {
+			mixed = _mm_add_ps(_mm_loadu_ps(&p_dst[i].left), mixed);
+		}
+		_mm_storeu_ps(&p_dst[i].left, mixed);
+		index = _mm_add_ps(index, two);
+	}
+#elif defined(AUDIO_MIXER_NEON)
+	const float32x4_t vol_start = { p_vol_start.left, p_vol_start.right, p_vol_start.left, p_vol_start.right };
+	const float32x4_t vol_incr = { vol_step.left, vol_step.right, vol_step.left, vol_step.right };
+	const float32x4_t two = vdupq_n_f32(2.0f);
+	float32x4_t index = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+	for (; i + 2 <= p_frames; i += 2) {
+		float32x4_t vol = vaddq_f32(vol_start, vmulq_f32(vol_incr, index));
+		float32x4_t mixed = vmulq_f32(vol, vld1q_f32(&p_src[i].left));
+		if constexpr (ACCUMULATE) {
+			mixed = vaddq_f32(vld1q_f32(&p_dst[i].left), mixed);
+		}
+		vst1q_f32(&p_dst[i].left, mixed);
+		index = vaddq_f32(index, two);
+	}
+#endif
+
+	for (; i < p_frames; i++) {
+		AudioFrame mixed = (p_vol_start + vol_step * float(i)) * p_src[i];
+		if constexpr (ACCUMULATE) {
+			p_dst[i] += mixed;
+		} else {
+			p_dst[i] = mixed;
+		}
+	}
+}
+
+void AudioMixerSIMD::mix_volume_ramp(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	_mix_volume_ramp<false>(p_dst, p_src, p_vol_start, p_vol_final, p_frames);
+}
+
+void AudioMixerSIMD::mix_volume_ramp_add(AudioFrame *p_dst, const AudioFrame *p_src, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	_mix_volume_ramp<true>(p_dst, p_src, p_vol_start, p_vol_final, p_frames);
+}
+
+void AudioMixerSIMD::add(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames) {
+	uint32_t i = 0;
+
+#if defined(AUDIO_MIXER_SSE2)
+	for (; i + 2 <= p_frames; i += 2) {
+		_mm_storeu_ps(&p_dst[i].left, _mm_add_ps(_mm_loadu_ps(&p_dst[i].left), _mm_loadu_ps(&p_src[i].left)));
+	}
+#elif defined(AUDIO_MIXER_NEON)
+	for (; i + 2 <= p_frames; i += 2) {
+		vst1q_f32(&p_dst[i].left, vaddq_f32(vld1q_f32(&p_dst[i].left), vld1q_f32(&p_src[i].left)));
+	}
+#endif
+
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+AudioFrame AudioMixerSIMD::scale_and_get_peak(AudioFrame *p_buf, float p_volume, uint32_t p_frames) {
+	AudioFrame peak = AudioFrame(0, 0);
+	uint32_t i = 0;
+
+	// NaN samples are ignored by the peak, like in the scalar loop.
+#if defined(AUDIO_MIXER_SSE2)
+	const __m128 volume = _mm_set1_ps(p_volume);
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	__m128 peak4 = _mm_setzero_ps();
+
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 scaled = _mm_mul_ps(_mm_loadu_ps(&p_buf[i].left), volume);
+		_mm_storeu_ps(&p_buf[i].left, scaled);
+		// Returns the second operand when the first one is NaN.
+		peak4 = _mm_max_ps(_mm_and_ps(scaled, abs_mask), peak4);
+	}
+
+	float lanes[4];
+	_mm_storeu_ps(lanes, peak4);
+	peak = AudioFrame(MAX(lanes[0], lanes[2]), MAX(lanes[1], lanes[3]));
+#elif defined(AUDIO_MIXER_NEON)
+	const float32x4_t volume = vdupq_n_f32(p_volume);
+	float32x4_t peak4 = vdupq_n_f32(0.0f);
+
+	for (; i + 2 <= p_frames; i += 2) {
+		float32x4_t scaled = vmulq_f32(vld1q_f32(&p_buf[i].left), volume);
+		vst1q_f32(&p_buf[i].left, scaled);
+		float32x4_t magnitude = vabsq_f32(scaled);
+		peak4 = vbslq_f32(vcgtq_f32(magnitude, peak4), magnitude, peak4);
+	}
+
+	float lanes[4];
+	vst1q_f32(lanes, peak4);
+	peak = AudioFrame(MAX(lanes[0], lanes[2]), MAX(lanes[1], lanes[3]));
+#endif
+
+	for (; i < p_frames; i++) {
+		p_buf[i] *= p_volume;
+
+		float l = Math::abs(p_buf[i].left);
+		if (l > peak.left) {
+			peak.left = l;
+		}
+		float r = Math::abs(p_buf[i].right);
+		if (r > peak.right) {
+			peak.right = r;
+		}
+	}
+
+	return peak;
+}
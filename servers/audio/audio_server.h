@@ -33,6 +33,7 @@
 #include "core/math/audio_frame.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_list.h"
 #include "core/variant/variant.h"
 #include "servers/audio/audio_effect.h"
@@ -249,6 +250,7 @@ private:
 			bool active = false;
 			AudioFrame peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
 			Vector<AudioFrame> buffer;
+			Vector<AudioFrame> effect_buffer; // Output of the effects, swapped with the buffer after each one.
 			Vector<Ref<AudioEffectInstance>> effect_instances;
 			uint64_t last_mix_with_audio = 0;
 			Channel() {}
@@ -318,8 +320,8 @@ private:
 	// TODO document if this is necessary.
 	SafeList<AudioStreamPlaybackBusDetails *> bus_details_graveyard_frame_old;
 
-	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
 	Vector<AudioFrame> mix_buffer;
+	Vector<AudioFrame> filter_buffer;
 	Vector<Bus *> buses;
 	HashMap<StringName, Bus *> bus_map;
 
@@ -332,6 +334,16 @@ private:
 	void _mix_step();
 	void _mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r);
 
+	bool use_threads_for_buses = false;
+	LocalVector<uint32_t> bus_process_level;
+	LocalVector<uint32_t> bus_process_order;
+
+	Bus *_get_bus_send(int p_bus) const;
+	void _process_bus(int p_bus, bool p_solo_mode);
+	void _send_bus(int p_bus);
+	void _process_bus_task(uint32_t p_index, void *p_userdata);
+	void _process_buses_threaded(bool p_solo_mode);
+
 	// Should only be called on the main thread.
 	AudioStreamPlaybackListNode *_find_playback_list_node(Ref<AudioStreamPlayback> p_playback);
 
@@ -502,6 +514,10 @@ public:
 
 	void set_enable_tagging_used_audio_streams(bool p_enable);
 
+	// Overrides `audio/buses/use_threads`. Must not be called while the driver is mixing.
+	void set_use_threads_for_buses(bool p_enable);
+	bool is_using_threads_for_buses() const;
+
 #ifdef TOOLS_ENABLED
 	virtual void get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const override;
 #endif
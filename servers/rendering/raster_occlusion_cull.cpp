@@ -0,0 +1,580 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RASTER_OCCLUSION_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RASTER_OCCLUSION_NEON
+#endif
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	depth.clear();
+	bands.clear();
+	stride = 0;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	stride = (p_size.x + 3) & ~3;
+	depth.resize(stride * p_size.y);
+	bands.resize((p_size.y + BAND_HEIGHT - 1) / BAND_HEIGHT);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_band(uint32_t p_band, const RasterThreadData *p_data) {
+	const int w = sizes[0].x;
+	const int from_y = p_band * BAND_HEIGHT;
+	const int to_y = MIN(sizes[0].y, from_y + BAND_HEIGHT);
+	const float far_depth = p_data->far_depth;
+
+	for (int y = from_y; y < to_y; y++) {
+		float *row = depth.ptr() + y * stride;
+		for (uint32_t x = 0; x < stride; x++) {
+			row[x] = far_depth;
+		}
+	}
+
+	for (const Triangle *t : bands[p_band]) {
+		const int min_y = MAX(t->min_y, from_y);
+		const int max_y = MIN(t->max_y, to_y - 1);
+		// Start on a multiple of 4 so the rows can be processed 4 pixels at a time.
+		const int min_x = t->min_x & ~3;
+
+		for (int y = min_y; y <= max_y; y++) {
+			const float py = y + 0.5f;
+			const float e0 = t->edge_b[0] * py + t->edge_c[0];
+			const float e1 = t->edge_b[1] * py + t->edge_c[1];
+			const float e2 = t->edge_b[2] * py + t->edge_c[2];
+			const float dw = t->depth_w[1] * py + t->depth_w[2];
+			const float iw = t->inv_w[1] * py + t->inv_w[2];
+			float *row = depth.ptr() + y * stride;
+
+#if defined(RASTER_OCCLUSION_SSE2)
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 a0 = _mm_set1_ps(t->edge_a[0]);
+			const __m128 a1 = _mm_set1_ps(t->edge_a[1]);
+			const __m128 a2 = _mm_set1_ps(t->edge_a[2]);
+			const __m128 dwx = _mm_set1_ps(t->depth_w[0]);
+			const __m128 iwx = _mm_set1_ps(t->inv_w[0]);
+			for (int x = min_x; x <= t->max_x; x += 4) {
+				const __m128 px = _mm_add_ps(_mm_set1_ps(float(x)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+				__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), _mm_set1_ps(e0)), zero);
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), _mm_set1_ps(e1)), zero));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), _mm_set1_ps(e2)), zero));
+				if (_mm_movemask_ps(inside) == 0) {
+					continue;
+				}
+				const __m128 d = _mm_div_ps(_mm_add_ps(_mm_mul_ps(dwx, px), _mm_set1_ps(dw)), _mm_add_ps(_mm_mul_ps(iwx, px), _mm_set1_ps(iw)));
+				const __m128 old = _mm_loadu_ps(row + x);
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, _mm_min_ps(old, d)), _mm_andnot_ps(inside, old)));
+			}
+#elif defined(RASTER_OCCLUSION_NEON)
+			const float32x4_t zero = vdupq_n_f32(0.0f);
+			const float offsets_data[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+			const float32x4_t offsets = vld1q_f32(offsets_data);
+			for (int x = min_x; x <= t->max_x; x += 4) {
+				const float32x4_t px = vaddq_f32(vdupq_n_f32(float(x)), offsets);
+				uint32x4_t inside = vcgeq_f32(vaddq_f32(vmulq_n_f32(px, t->edge_a[0]), vdupq_n_f32(e0)), zero);
+				inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(vmulq_n_f32(px, t->edge_a[1]), vdupq_n_f32(e1)), zero));
+				inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(vmulq_n_f32(px, t->edge_a[2]), vdupq_n_f32(e2)), zero));
+				if (vmaxvq_u32(inside) == 0) {
+					continue;
+				}
+				const float32x4_t d = vdivq_f32(vaddq_f32(vmulq_n_f32(px, t->depth_w[0]), vdupq_n_f32(dw)), vaddq_f32(vmulq_n_f32(px, t->inv_w[0]), vdupq_n_f32(iw)));
+				const float32x4_t old = vld1q_f32(row + x);
+				vst1q_f32(row + x, vbslq_f32(inside, vminq_f32(old, d), old));
+			}
+#else
+			for (int x = t->min_x; x <= t->max_x; x++) {
+				const float px = x + 0.5f;
+				if (t->edge_a[0] * px + e0 < 0.0f || t->edge_a[1] * px + e1 < 0.0f || t->edge_a[2] * px + e2 < 0.0f) {
+					continue;
+				}
+				const float d = (t->depth_w[0] * px + dw) / (t->inv_w[0] * px + iw);
+				row[x] = MIN(row[x], d);
+			}
+#endif
+		}
+	}
+
+	// Store distances along the camera rays, like the raycast culler does.
+	for (int y = from_y; y < to_y; y++) {
+		const float *row = depth.ptr() + y * stride;
+		float *dst = mips[0] + y * w;
+		const Vector3 row_start = p_data->near_corner + p_data->near_v * ((y + 0.5f) / sizes[0].y);
+		for (int x = 0; x < w; x++) {
+			if (row[x] >= far_depth || p_data->orthogonal) {
+				dst[x] = row[x];
+			} else {
+				const Vector3 ray = row_start + p_data->near_u * ((x + 0.5f) / w);
+				dst[x] = row[x] * ray.length() / p_data->z_near;
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario || !scenario->instances.has(E.instance));
+
+		if (!scenario->dirty_instances.has(E.instance)) {
+			scenario->dirty_instances.insert(E.instance);
+			scenario->dirty_instances_array.push_back(E.instance);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	instance.enabled = p_enabled;
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		occ_inst->xformed_vertices.clear();
+		occ_inst->indices.clear();
+		return;
+	}
+
+	const Vector3 *read = occ->vertices.ptr();
+	uint32_t vertex_count = occ->vertices.size();
+
+	occ_inst->xformed_vertices.resize(vertex_count);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		occ_inst->xformed_vertices[i] = occ_inst->xform.xform(read[i]);
+		if (i == 0) {
+			occ_inst->aabb = AABB(occ_inst->xformed_vertices[i], Vector3());
+		} else {
+			occ_inst->aabb.expand_to(occ_inst->xformed_vertices[i]);
+		}
+	}
+
+	// Drop triangles with invalid indices once here, so rasterization doesn't have to check.
+	occ_inst->indices.clear();
+	const int32_t *indices = occ->indices.ptr();
+	for (int i = 0; i + 2 < occ->indices.size(); i += 3) {
+		if ((uint32_t)indices[i] < vertex_count && (uint32_t)indices[i + 1] < vertex_count && (uint32_t)indices[i + 2] < vertex_count) {
+			occ_inst->indices.push_back(indices[i]);
+			occ_inst->indices.push_back(indices[i + 1]);
+			occ_inst->indices.push_back(indices[i + 2]);
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	if (dirty_instances_array.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (dirty_instances_array.size() == 1) {
+		_update_dirty_instance(0, dirty_instances_array.ptr());
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+Vector2 RasterOcclusionCull::_get_jitter(const Size2i &p_buffer_size) const {
+	if (!jitter_enabled || p_buffer_size.x <= 0 || p_buffer_size.y <= 0) {
+		return Vector2();
+	}
+
+	// Same pattern as the raycast culler, in pixels.
+	static const Vector2 pattern[9] = {
+		Vector2(0, 0),
+		Vector2(-1, -1),
+		Vector2(1, -1),
+		Vector2(-1, 1),
+		Vector2(1, 1),
+		Vector2(-0.5f, -0.5f),
+		Vector2(0.5f, -0.5f),
+		Vector2(-0.5f, 0.5f),
+		Vector2(0.5f, 0.5f),
+	};
+
+	return pattern[Engine::get_singleton()->get_frames_drawn() % 9] * 0.33f;
+}
+
+static _FORCE_INLINE_ void _raster_add_triangle(LocalVector<RasterOcclusionCull::Triangle> &r_triangles, const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c, const float p_w[3], const Size2i &p_size) {
+	// Vertices are (screen x, screen y, view depth).
+	Vector3 v[3] = { p_a, p_b, p_c };
+	float w[3] = { p_w[0], p_w[1], p_w[2] };
+
+	float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+	if (Math::abs(area) < 1e-6f) {
+		return;
+	}
+	if (area < 0.0f) {
+		// Occluders are double sided.
+		SWAP(v[1], v[2]);
+		SWAP(w[1], w[2]);
+		area = -area;
+	}
+
+	RasterOcclusionCull::Triangle t;
+	// Pixels are sampled at their centers.
+	t.min_x = MAX(0, (int)Math::ceil(MIN(v[0].x, MIN(v[1].x, v[2].x)) - 0.5f));
+	t.max_x = MIN(p_size.x - 1, (int)Math::floor(MAX(v[0].x, MAX(v[1].x, v[2].x)) - 0.5f));
+	t.min_y = MAX(0, (int)Math::ceil(MIN(v[0].y, MIN(v[1].y, v[2].y)) - 0.5f));
+	t.max_y = MIN(p_size.y - 1, (int)Math::floor(MAX(v[0].y, MAX(v[1].y, v[2].y)) - 0.5f));
+	if (t.min_x > t.max_x || t.min_y > t.max_y) {
+		return;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		t.depth_w[i] = 0.0f;
+		t.inv_w[i] = 0.0f;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		// Edge opposite to vertex i, positive inside the triangle and equal to the area at vertex i.
+		const Vector3 &from = v[(i + 1) % 3];
+		const Vector3 &to = v[(i + 2) % 3];
+		t.edge_a[i] = from.y - to.y;
+		t.edge_b[i] = to.x - from.x;
+		t.edge_c[i] = -(t.edge_a[i] * from.x + t.edge_b[i] * from.y);
+
+		// Interpolated attributes are the barycentric (edge / area) weighted sums.
+		const float depth_w = v[i].z / w[i] / area;
+		const float inv_w = 1.0f / w[i] / area;
+		t.depth_w[0] += t.edge_a[i] * depth_w;
+		t.depth_w[1] += t.edge_b[i] * depth_w;
+		t.depth_w[2] += t.edge_c[i] * depth_w;
+		t.inv_w[0] += t.edge_a[i] * inv_w;
+		t.inv_w[1] += t.edge_b[i] * inv_w;
+		t.inv_w[2] += t.edge_c[i] * inv_w;
+	}
+
+	r_triangles.push_back(t);
+}
+
+void RasterOcclusionCull::_setup_triangles(uint32_t p_idx, const SetupThreadData *p_data) {
+	OccluderInstance *instance = p_data->instances[p_idx];
+	const Size2i size = Size2i(p_data->screen_size.x, p_data->screen_size.y);
+	const Vector3 *vertices = instance->xformed_vertices.ptr();
+	const uint32_t *indices = instance->indices.ptr();
+	const uint32_t index_count = instance->indices.size();
+
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		Vector3 view[3] = {
+			p_data->inv_cam_transform.xform(vertices[indices[i]]),
+			p_data->inv_cam_transform.xform(vertices[indices[i + 1]]),
+			p_data->inv_cam_transform.xform(vertices[indices[i + 2]]),
+		};
+
+		// Clip against the near plane, which can turn the triangle into a quad.
+		Vector3 clipped[4];
+		int clipped_count = 0;
+		for (int j = 0; j < 3; j++) {
+			const Vector3 &a = view[j];
+			const Vector3 &b = view[(j + 1) % 3];
+			const float da = -a.z - p_data->z_near;
+			const float db = -b.z - p_data->z_near;
+			if (da >= 0.0f) {
+				clipped[clipped_count++] = a;
+			}
+			if ((da >= 0.0f) != (db >= 0.0f)) {
+				clipped[clipped_count++] = a + (b - a) * (da / (da - db));
+			}
+		}
+
+		if (clipped_count < 3) {
+			continue;
+		}
+
+		Vector3 screen[4];
+		float w[4];
+		for (int j = 0; j < clipped_count; j++) {
+			Vector4 clip = p_data->view_projection.xform(Vector4(clipped[j].x, clipped[j].y, clipped[j].z, 1.0));
+			w[j] = clip.w;
+			screen[j] = Vector3(
+					(clip.x / clip.w * 0.5f + 0.5f) * p_data->screen_size.x - p_data->jitter.x,
+					(clip.y / clip.w * 0.5f + 0.5f) * p_data->screen_size.y - p_data->jitter.y,
+					-clipped[j].z);
+		}
+
+		_raster_add_triangle(instance->triangles, screen[0], screen[1], screen[2], w, size);
+		if (clipped_count == 4) {
+			const float quad_w[3] = { w[0], w[2], w[3] };
+			_raster_add_triangle(instance->triangles, screen[0], screen[2], screen[3], quad_w, size);
+		}
+	}
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty() || !scenarios.has(buffer->scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer->scenario_rid];
+	scenario.update();
+
+	const Size2i &size = buffer->sizes[0];
+
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	Vector3 endpoints[8];
+	p_cam_projection.get_endpoints(p_cam_transform, endpoints);
+
+	visible_instances.clear();
+	for (KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		OccluderInstance &instance = E.value;
+		instance.triangles.clear();
+		if (instance.enabled && !instance.indices.is_empty() && instance.aabb.intersects_convex_shape(planes.ptr(), planes.size(), endpoints, 8)) {
+			visible_instances.push_back(&instance);
+		}
+	}
+
+	SetupThreadData setup;
+	setup.instances = visible_instances.ptr();
+	setup.view_projection = p_cam_projection;
+	setup.inv_cam_transform = p_cam_transform.affine_inverse();
+	setup.z_near = p_cam_projection.get_z_near();
+	setup.screen_size = Vector2(size.x, size.y);
+	setup.jitter = _get_jitter(size);
+
+	if (visible_instances.size() > 0) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_setup_triangles, &setup, visible_instances.size(), -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	for (LocalVector<const Triangle *> &band : buffer->bands) {
+		band.clear();
+	}
+	for (const OccluderInstance *instance : visible_instances) {
+		for (const Triangle &t : instance->triangles) {
+			for (int band = t.min_y / RasterHZBuffer::BAND_HEIGHT; band <= t.max_y / RasterHZBuffer::BAND_HEIGHT; band++) {
+				buffer->bands[band].push_back(&t);
+			}
+		}
+	}
+
+	RasterHZBuffer::RasterThreadData raster;
+	raster.far_depth = p_cam_projection.get_z_far() * 1.05f;
+	raster.orthogonal = p_cam_orthogonal;
+	raster.z_near = setup.z_near;
+
+	// Any point on a camera ray gives its direction, so unproject the corners of the screen.
+	Projection inv_projection = p_cam_projection.inverse();
+	const Vector2 jitter_ndc = setup.jitter / setup.screen_size * 2.0;
+	raster.near_corner = inv_projection.xform(Vector3(-1.0 + jitter_ndc.x, -1.0 + jitter_ndc.y, -1.0));
+	raster.near_u = inv_projection.xform(Vector3(1.0 + jitter_ndc.x, -1.0 + jitter_ndc.y, -1.0)) - raster.near_corner;
+	raster.near_v = inv_projection.xform(Vector3(-1.0 + jitter_ndc.x, 1.0 + jitter_ndc.y, -1.0)) - raster.near_corner;
+	// Rescale so the corner sits on the near plane.
+	const real_t corner_scale = raster.z_near / -raster.near_corner.z;
+	raster.near_corner *= corner_scale;
+	raster.near_u *= corner_scale;
+	raster.near_v *= corner_scale;
+
+	buffer->debug_tex_range = raster.far_depth;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(buffer, &RasterHZBuffer::_rasterize_band, &raster, buffer->bands.size(), -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	buffer->update_mips();
+}
+
+RendererSceneOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+	jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -40,6 +41,16 @@
 #include "scene/main/node.h"
 #endif
 
+#if !defined(REAL_T_IS_DOUBLE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCENE_CULL_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SCENE_CULL_NEON
+#endif
+#endif
+
 /* HALTON SEQUENCE */
 
 #ifndef _3D_DISABLED
@@ -148,6 +159,45 @@ bool RendererSceneCull::is_camera(RID p_camera) const {
 	return camera_owner.owns(p_camera);
 }
 
+Projection RendererSceneCull::_camera_get_projection(const Camera *p_camera, const Size2 &p_viewport_size, bool &r_is_orthogonal, bool &r_is_frustum) const {
+	Projection projection;
+	r_is_orthogonal = false;
+	r_is_frustum = false;
+
+	switch (p_camera->type) {
+		case Camera::ORTHOGONAL: {
+			projection.set_orthogonal(
+					p_camera->size,
+					p_viewport_size.width / (float)p_viewport_size.height,
+					p_camera->znear,
+					p_camera->zfar,
+					p_camera->vaspect);
+			r_is_orthogonal = true;
+		} break;
+		case Camera::PERSPECTIVE: {
+			projection.set_perspective(
+					p_camera->fov,
+					p_viewport_size.width / (float)p_viewport_size.height,
+					p_camera->znear,
+					p_camera->zfar,
+					p_camera->vaspect);
+
+		} break;
+		case Camera::FRUSTUM: {
+			projection.set_frustum(
+					p_camera->size,
+					p_viewport_size.width / (float)p_viewport_size.height,
+					p_camera->offset,
+					p_camera->znear,
+					p_camera->zfar,
+					p_camera->vaspect);
+			r_is_frustum = true;
+		} break;
+	}
+
+	return projection;
+}
+
 /* OCCLUDER API */
 
 RID RendererSceneCull::occluder_allocate() {
@@ -418,6 +468,31 @@ void RendererSceneCull::_instance_unpair(Instance *p_A, Instance *p_B) {
 	}
 }
 
+void RendererSceneCull::Scenario::instance_bounds_push_back(const InstanceBounds &p_bounds) {
+	uint32_t index = instance_aabbs.size();
+	instance_aabbs.push_back(p_bounds);
+	if ((index >> CULL_CELL_SHIFT) >= instance_cells.size()) {
+		instance_cells.resize((index >> CULL_CELL_SHIFT) + 1);
+	}
+	instance_cells[index >> CULL_CELL_SHIFT].set(index & CULL_CELL_MASK, p_bounds);
+}
+
+void RendererSceneCull::Scenario::instance_bounds_set(uint32_t p_index, const InstanceBounds &p_bounds) {
+	instance_aabbs[p_index] = p_bounds;
+	instance_cells[p_index >> CULL_CELL_SHIFT].set(p_index & CULL_CELL_MASK, p_bounds);
+}
+
+void RendererSceneCull::Scenario::instance_bounds_pop_back() {
+	instance_aabbs.pop_back();
+	uint32_t size = instance_aabbs.size();
+	uint32_t cell_count = (size + CULL_CELL_MASK) >> CULL_CELL_SHIFT;
+	if (cell_count < instance_cells.size()) {
+		instance_cells.resize(cell_count);
+	} else {
+		instance_cells[size >> CULL_CELL_SHIFT].bounds_dirty = true;
+	}
+}
+
 RID RendererSceneCull::scenario_allocate() {
 	return scenario_owner.allocate_rid();
 }
@@ -1156,6 +1231,7 @@ void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabl
 		} else {
 			idata.flags &= ~InstanceData::FLAG_IGNORE_ALL_CULLING;
 		}
+		instance->scenario->instance_bounds_mark_dirty(instance->array_index);
 	}
 }
 
@@ -1836,7 +1912,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		}
 
 		p_instance->scenario->instance_data.push_back(idata);
-		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->instance_bounds_push_back(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1844,7 +1920,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_bounds_set(p_instance->array_index, InstanceBounds(p_instance->transformed_aabb));
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1931,7 +2007,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		Instance *swapped_instance = p_instance->scenario->instance_data[swap_with_index].instance;
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->instance_bounds_set(p_instance->array_index, p_instance->scenario->instance_aabbs[swap_with_index]);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -1947,7 +2023,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 
 	// pop last
 	p_instance->scenario->instance_data.pop_back();
-	p_instance->scenario->instance_aabbs.pop_back();
+	p_instance->scenario->instance_bounds_pop_back();
 
 	//uninitialize
 	p_instance->array_index = -1;
@@ -2619,41 +2695,10 @@ void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_bu
 	if (p_xr_interface.is_null()) {
 		// Normal camera
 		Transform3D transform = camera->transform;
-		Projection projection;
 		bool vaspect = camera->vaspect;
 		bool is_orthogonal = false;
 		bool is_frustum = false;
-
-		switch (camera->type) {
-			case Camera::ORTHOGONAL: {
-				projection.set_orthogonal(
-						camera->size,
-						p_viewport_size.width / (float)p_viewport_size.height,
-						camera->znear,
-						camera->zfar,
-						camera->vaspect);
-				is_orthogonal = true;
-			} break;
-			case Camera::PERSPECTIVE: {
-				projection.set_perspective(
-						camera->fov,
-						p_viewport_size.width / (float)p_viewport_size.height,
-						camera->znear,
-						camera->zfar,
-						camera->vaspect);
-
-			} break;
-			case Camera::FRUSTUM: {
-				projection.set_frustum(
-						camera->size,
-						p_viewport_size.width / (float)p_viewport_size.height,
-						camera->offset,
-						camera->znear,
-						camera->zfar,
-						camera->vaspect);
-				is_frustum = true;
-			} break;
-		}
+		Projection projection = _camera_get_projection(camera, p_viewport_size, is_orthogonal, is_frustum);
 
 		camera_data.set_camera(transform, projection, is_orthogonal, is_frustum, vaspect, jitter, taa_frame_count, camera->visible_layers);
 #ifndef XR_DISABLED
@@ -2804,11 +2849,129 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
+// Returns one bit per lane in [0, p_count) telling whether its bounds pass InstanceBounds::in_frustum().
+static uint64_t _cull_cell_frustum_mask(const RendererSceneCull::InstanceBoundsCell &p_cell, uint32_t p_count, const RendererSceneCull::Frustum &p_frustum) {
+	uint64_t mask = 0;
+
+#if defined(SCENE_CULL_SSE2) || defined(SCENE_CULL_NEON)
+	const uint32_t MAX_PLANES = 8;
+	if (p_frustum.plane_count <= MAX_PLANES) {
+		const real_t *xs[MAX_PLANES];
+		const real_t *ys[MAX_PLANES];
+		const real_t *zs[MAX_PLANES];
+		for (uint32_t j = 0; j < p_frustum.plane_count; j++) {
+			const uint32_t *signs = p_frustum.plane_signs_ptr[j].signs;
+			xs[j] = signs[0] == 0 ? p_cell.min_x : p_cell.max_x;
+			ys[j] = signs[1] == 1 ? p_cell.min_y : p_cell.max_y;
+			zs[j] = signs[2] == 2 ? p_cell.min_z : p_cell.max_z;
+		}
+
+		for (uint32_t i = 0; i < p_count; i += 4) {
+#if defined(SCENE_CULL_SSE2)
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (uint32_t j = 0; j < p_frustum.plane_count; j++) {
+				const Plane &plane = p_frustum.planes_ptr[j];
+				__m128 d = _mm_mul_ps(_mm_set1_ps(plane.normal.x), _mm_loadu_ps(xs[j] + i));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.normal.y), _mm_loadu_ps(ys[j] + i)));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.normal.z), _mm_loadu_ps(zs[j] + i)));
+				d = _mm_sub_ps(d, _mm_set1_ps(plane.d));
+				inside = _mm_and_ps(inside, _mm_cmplt_ps(d, _mm_setzero_ps()));
+			}
+			mask |= uint64_t(_mm_movemask_ps(inside)) << i;
+#else
+			uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+			for (uint32_t j = 0; j < p_frustum.plane_count; j++) {
+				const Plane &plane = p_frustum.planes_ptr[j];
+				float32x4_t d = vmulq_n_f32(vld1q_f32(xs[j] + i), plane.normal.x);
+				d = vaddq_f32(d, vmulq_n_f32(vld1q_f32(ys[j] + i), plane.normal.y));
+				d = vaddq_f32(d, vmulq_n_f32(vld1q_f32(zs[j] + i), plane.normal.z));
+				d = vsubq_f32(d, vdupq_n_f32(plane.d));
+				inside = vandq_u32(inside, vcltq_f32(d, vdupq_n_f32(0.0f)));
+			}
+			mask |= uint64_t((vgetq_lane_u32(inside, 0) & 1) | (vgetq_lane_u32(inside, 1) & 2) | (vgetq_lane_u32(inside, 2) & 4) | (vgetq_lane_u32(inside, 3) & 8)) << i;
+#endif
+		}
+
+		// Lanes past p_count hold stale bounds.
+		return p_count == RendererSceneCull::CULL_CELL_SIZE ? mask : (mask & ((uint64_t(1) << p_count) - 1));
+	}
+#endif
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		RendererSceneCull::InstanceBounds bounds;
+		bounds.bounds[0] = p_cell.min_x[i];
+		bounds.bounds[1] = p_cell.min_y[i];
+		bounds.bounds[2] = p_cell.min_z[i];
+		bounds.bounds[3] = p_cell.max_x[i];
+		bounds.bounds[4] = p_cell.max_y[i];
+		bounds.bounds[5] = p_cell.max_z[i];
+		if (bounds.in_frustum(p_frustum)) {
+			mask |= uint64_t(1) << i;
+		}
+	}
+
+	return mask;
+}
+
+uint64_t RendererSceneCull::_scene_cull_cell(const CullData &p_cull_data, uint32_t p_cell_index) {
+	Scenario *scenario = p_cull_data.scenario;
+	InstanceBoundsCell &cell = scenario->instance_cells[p_cell_index];
+	uint32_t from = p_cell_index << CULL_CELL_SHIFT;
+	uint32_t count = MIN(uint32_t(CULL_CELL_SIZE), scenario->instance_data.size() - from);
+
+	if (cell.bounds_dirty) {
+		real_t *bounds = cell.bounds.bounds;
+		bounds[0] = cell.min_x[0];
+		bounds[1] = cell.min_y[0];
+		bounds[2] = cell.min_z[0];
+		bounds[3] = cell.max_x[0];
+		bounds[4] = cell.max_y[0];
+		bounds[5] = cell.max_z[0];
+		cell.has_ignore_all_culling = false;
+
+		for (uint32_t i = 0; i < count; i++) {
+			bounds[0] = MIN(bounds[0], cell.min_x[i]);
+			bounds[1] = MIN(bounds[1], cell.min_y[i]);
+			bounds[2] = MIN(bounds[2], cell.min_z[i]);
+			bounds[3] = MAX(bounds[3], cell.max_x[i]);
+			bounds[4] = MAX(bounds[4], cell.max_y[i]);
+			bounds[5] = MAX(bounds[5], cell.max_z[i]);
+			if (scenario->instance_data[from + i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING) {
+				cell.has_ignore_all_culling = true;
+			}
+		}
+
+		cell.bounds_dirty = false;
+		cell.frustum_version = 0;
+	}
+
+	if (cell.frustum_version == p_cull_data.frustum_version) {
+		return cell.visible_mask;
+	}
+
+	switch (cell.classify(p_cull_data.cull->frustum)) {
+		case InstanceBoundsCell::STATE_OUTSIDE: {
+			cell.visible_mask = 0;
+		} break;
+		case InstanceBoundsCell::STATE_INSIDE: {
+			cell.visible_mask = count == CULL_CELL_SIZE ? ~uint64_t(0) : ((uint64_t(1) << count) - 1);
+		} break;
+		case InstanceBoundsCell::STATE_INTERSECTS: {
+			cell.visible_mask = _cull_cell_frustum_mask(cell, count, p_cull_data.cull->frustum);
+		} break;
+	}
+
+	cell.frustum_version = p_cull_data.frustum_version;
+	return cell.visible_mask;
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
+	// Split on cell boundaries, so each cell is only updated by one thread.
 	uint32_t cull_total = cull_data->scenario->instance_data.size();
+	uint32_t cell_total = cull_data->scenario->instance_cells.size();
 	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
-	uint32_t cull_from = p_thread * cull_total / total_threads;
-	uint32_t cull_to = (p_thread + 1 == total_threads) ? cull_total : ((p_thread + 1) * cull_total / total_threads);
+	uint32_t cull_from = MIN(cull_total, (p_thread * cell_total / total_threads) << CULL_CELL_SHIFT);
+	uint32_t cull_to = (p_thread + 1 == total_threads) ? cull_total : MIN(cull_total, ((p_thread + 1) * cell_total / total_threads) << CULL_CELL_SHIFT);
 
 	_scene_cull(*cull_data, scene_cull_result_threads[p_thread], cull_from, cull_to);
 }
@@ -2826,7 +2989,20 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	float z_near = cull_data.camera_matrix->get_z_near();
 	bool is_orthogonal = cull_data.camera_matrix->is_orthogonal();
 
+	// Outside the camera frustum, instances can still be needed by shadows or SDFGI.
+	bool skip_cells_outside = cull_data.cull->shadow_count == 0 && cull_data.cull->sdfgi.region_count == 0;
+	uint64_t frustum_mask = 0;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
+		if (i == p_from || (i & CULL_CELL_MASK) == 0) {
+			uint32_t cell_index = i >> CULL_CELL_SHIFT;
+			frustum_mask = _scene_cull_cell(cull_data, cell_index);
+			if (frustum_mask == 0 && skip_cells_outside && !cull_data.scenario->instance_cells[cell_index].has_ignore_all_culling) {
+				i = MIN(p_to, uint64_t(cell_index + 1) << CULL_CELL_SHIFT) - 1;
+				continue;
+			}
+		}
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2836,13 +3012,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
 #define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_CAMERA_FRUSTUM ((frustum_mask >> (i & CULL_CELL_MASK)) & 1)
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, is_orthogonal, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && IN_CAMERA_FRUSTUM && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3061,6 +3238,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
 #undef IN_FRUSTUM
+#undef IN_CAMERA_FRUSTUM
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
@@ -3094,6 +3272,85 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	}
 }
 
+void RendererSceneCull::_scene_cull_instances(CullData &p_cull_data) {
+	Scenario *scenario = p_cull_data.scenario;
+	uint64_t cull_to = scenario->instance_data.size();
+
+	// Cells remember their result for the last frustum they were tested against.
+	if (scenario->cull_frustum_planes != p_cull_data.cull->frustum.planes) {
+		scenario->cull_frustum_planes = p_cull_data.cull->frustum.planes;
+		scenario->cull_frustum_version++;
+	}
+	p_cull_data.frustum_version = scenario->cull_frustum_version;
+
+//#define DEBUG_CULL_TIME
+#ifdef DEBUG_CULL_TIME
+	uint64_t time_from = OS::get_singleton()->get_ticks_usec();
+#endif
+
+	if (cull_to > thread_cull_threshold) {
+		//multiple threads
+		for (InstanceCullResult &thread : scene_cull_result_threads) {
+			thread.clear();
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_scene_cull_threaded, &p_cull_data, scene_cull_result_threads.size(), -1, true, SNAME("RenderCullInstances"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (InstanceCullResult &thread : scene_cull_result_threads) {
+			scene_cull_result.append_from(thread);
+		}
+
+	} else {
+		//single threaded
+		_scene_cull(p_cull_data, scene_cull_result, 0, cull_to);
+	}
+
+#ifdef DEBUG_CULL_TIME
+	static float time_avg = 0;
+	static uint32_t time_count = 0;
+	time_avg += double(OS::get_singleton()->get_ticks_usec() - time_from) / 1000.0;
+	time_count++;
+	print_line("time taken: " + rtos(time_avg / time_count));
+#endif
+}
+
+uint32_t RendererSceneCull::cull_camera(RID p_camera, RID p_scenario, Size2 p_viewport_size) {
+#ifndef _3D_DISABLED
+	Camera *camera = camera_owner.get_or_null(p_camera);
+	ERR_FAIL_NULL_V(camera, 0);
+	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
+	ERR_FAIL_NULL_V(scenario, 0);
+
+	update_dirty_instances();
+
+	bool is_orthogonal = false;
+	bool is_frustum = false;
+	Projection projection = _camera_get_projection(camera, p_viewport_size, is_orthogonal, is_frustum);
+
+	cull.frustum = Frustum(projection.get_projection_planes(camera->transform));
+	cull.shadow_count = 0;
+	cull.sdfgi.region_count = 0;
+
+	scene_cull_result.clear();
+
+	CullData cull_data;
+	cull_data.cull = &cull;
+	cull_data.scenario = scenario;
+	cull_data.cam_transform = camera->transform;
+	cull_data.visible_layers = camera->visible_layers;
+	cull_data.occlusion_buffer = nullptr;
+	cull_data.camera_matrix = &projection;
+	cull_data.visibility_viewport_mask = 0;
+
+	_scene_cull_instances(cull_data);
+
+	return scene_cull_result.geometry_instances.size();
+#else
+	return 0;
+#endif
+}
+
 void RendererSceneCull::_scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis) {
 	RSG::particles_storage->particles_set_view_axis(p_particles, p_axis, p_up_axis);
 }
@@ -3220,9 +3477,6 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	scene_cull_result.clear();
 
 	{
-		uint64_t cull_from = 0;
-		uint64_t cull_to = scenario->instance_data.size();
-
 		CullData cull_data;
 
 		//prepare for eventual thread usage
@@ -3235,36 +3489,8 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
-//#define DEBUG_CULL_TIME
-#ifdef DEBUG_CULL_TIME
-		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
-#endif
-
-		if (cull_to > thread_cull_threshold) {
-			//multiple threads
-			for (InstanceCullResult &thread : scene_cull_result_threads) {
-				thread.clear();
-			}
 
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_scene_cull_threaded, &cull_data, scene_cull_result_threads.size(), -1, true, SNAME("RenderCullInstances"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-			for (InstanceCullResult &thread : scene_cull_result_threads) {
-				scene_cull_result.append_from(thread);
-			}
-
-		} else {
-			//single threaded
-			_scene_cull(cull_data, scene_cull_result, cull_from, cull_to);
-		}
-
-#ifdef DEBUG_CULL_TIME
-		static float time_avg = 0;
-		static uint32_t time_count = 0;
-		time_avg += double(OS::get_singleton()->get_ticks_usec() - time_from) / 1000.0;
-		time_count++;
-		print_line("time taken: " + rtos(time_avg / time_count));
-#endif
+		_scene_cull_instances(cull_data);
 
 		if (scene_cull_result.mesh_instances.size()) {
 			for (uint64_t i = 0; i < scene_cull_result.mesh_instances.size(); i++) {
@@ -4174,6 +4400,7 @@ bool RendererSceneCull::free(RID p_rid) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
 		scenario->instance_aabbs.reset();
+		scenario->instance_cells.clear();
 		scenario->instance_data.reset();
 		scenario->instance_visibility.reset();
 
@@ -4289,7 +4516,11 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	if (RendererSceneOcclusionCull::create_func && !GLOBAL_GET("rendering/occlusion_culling/force_software_rasterizer")) {
+		occlusion_culling = RendererSceneOcclusionCull::create_func();
+	} else {
+		occlusion_culling = memnew(RasterOcclusionCull);
+	}
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4315,8 +4546,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (occlusion_culling) {
+		memdelete(occlusion_culling);
 	}
 
 	if (light_culler) {
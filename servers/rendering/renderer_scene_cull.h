@@ -117,6 +117,8 @@ public:
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable);
 	virtual bool is_camera(RID p_camera) const;
 
+	Projection _camera_get_projection(const Camera *p_camera, const Size2 &p_viewport_size, bool &r_is_orthogonal, bool &r_is_frustum) const;
+
 	/* OCCLUDER API */
 
 	virtual RID occluder_allocate();
@@ -125,7 +127,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -250,6 +252,83 @@ public:
 		}
 	};
 
+	enum {
+		CULL_CELL_SHIFT = 6,
+		CULL_CELL_SIZE = 1 << CULL_CELL_SHIFT,
+		CULL_CELL_MASK = CULL_CELL_SIZE - 1,
+	};
+
+	struct InstanceBoundsCell {
+		// Bounds of CULL_CELL_SIZE consecutive instances, mirrored as
+		// structure of arrays so they can be tested against the frustum
+		// several at a time, and which of them passed the last frustum
+		// test, so static cells can skip it when the frustum is unchanged.
+
+		enum State {
+			STATE_OUTSIDE,
+			STATE_INSIDE,
+			STATE_INTERSECTS,
+		};
+
+		real_t min_x[CULL_CELL_SIZE];
+		real_t min_y[CULL_CELL_SIZE];
+		real_t min_z[CULL_CELL_SIZE];
+		real_t max_x[CULL_CELL_SIZE];
+		real_t max_y[CULL_CELL_SIZE];
+		real_t max_z[CULL_CELL_SIZE];
+
+		InstanceBounds bounds; // Union of all the instances in the cell.
+		uint64_t visible_mask = 0; // One bit per instance, valid for frustum_version.
+		uint64_t frustum_version = 0;
+		uint32_t plane_hint = 0; // Plane that rejected the cell last time.
+		bool bounds_dirty = true;
+		bool has_ignore_all_culling = false;
+
+		_ALWAYS_INLINE_ void set(uint32_t p_lane, const InstanceBounds &p_bounds) {
+			min_x[p_lane] = p_bounds.bounds[0];
+			min_y[p_lane] = p_bounds.bounds[1];
+			min_z[p_lane] = p_bounds.bounds[2];
+			max_x[p_lane] = p_bounds.bounds[3];
+			max_y[p_lane] = p_bounds.bounds[4];
+			max_z[p_lane] = p_bounds.bounds[5];
+			bounds_dirty = true;
+		}
+
+		_ALWAYS_INLINE_ State classify(const Frustum &p_frustum) {
+			// Same test as InstanceBounds::in_frustum(), but also checks the farthest corner
+			// to tell whether every instance in the cell passes. Starts with the plane that
+			// rejected the cell last time, which most of the time still does.
+			bool intersects = false;
+			for (uint32_t n = 0; n < p_frustum.plane_count; n++) {
+				uint32_t i = (plane_hint + n) % p_frustum.plane_count;
+				const Plane &plane = p_frustum.planes_ptr[i];
+				const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+
+				Vector3 min(bounds.bounds[signs[0]], bounds.bounds[signs[1]], bounds.bounds[signs[2]]);
+				if (plane.distance_to(min) >= 0.0) {
+					plane_hint = i;
+					return STATE_OUTSIDE;
+				}
+
+				if (!intersects) {
+					Vector3 max(bounds.bounds[(signs[0] + 3) % 6], bounds.bounds[(signs[1] + 3) % 6], bounds.bounds[(signs[2] + 3) % 6]);
+					intersects = plane.distance_to(max) >= 0.0;
+				}
+			}
+
+			return intersects ? STATE_INTERSECTS : STATE_INSIDE;
+		}
+
+		InstanceBoundsCell() {
+			memset(min_x, 0, sizeof(min_x));
+			memset(min_y, 0, sizeof(min_y));
+			memset(min_z, 0, sizeof(min_z));
+			memset(max_x, 0, sizeof(max_x));
+			memset(max_y, 0, sizeof(max_y));
+			memset(max_z, 0, sizeof(max_z));
+		}
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -352,6 +431,18 @@ public:
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		// Mirrors instance_aabbs, see InstanceBoundsCell.
+		LocalVector<InstanceBoundsCell> instance_cells;
+		Vector<Plane> cull_frustum_planes;
+		uint64_t cull_frustum_version = 1;
+
+		void instance_bounds_push_back(const InstanceBounds &p_bounds);
+		void instance_bounds_set(uint32_t p_index, const InstanceBounds &p_bounds);
+		void instance_bounds_pop_back();
+		_FORCE_INLINE_ void instance_bounds_mark_dirty(uint32_t p_index) {
+			instance_cells[p_index >> CULL_CELL_SHIFT].bounds_dirty = true;
+		}
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -1144,10 +1235,13 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		uint64_t frustum_version = 0;
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
+	void _scene_cull_instances(CullData &p_cull_data);
+	_FORCE_INLINE_ uint64_t _scene_cull_cell(const CullData &p_cull_data, uint32_t p_cell_index);
 	static void _scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
 
@@ -1157,6 +1251,9 @@ public:
 	void render_empty_scene(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_scenario, RID p_shadow_atlas);
 
 	void render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderingMethod::RenderInfo *r_render_info = nullptr);
+	// Runs only the instance culling step of render_camera() and returns the amount of visible geometry instances,
+	// so culling can be measured without a renderer.
+	uint32_t cull_camera(RID p_camera, RID p_scenario, Size2 p_viewport_size);
 	void update_dirty_instances() const;
 
 	void render_particle_colliders();
@@ -31,6 +31,7 @@
 #include "renderer_scene_occlusion_cull.h"
 
 RendererSceneOcclusionCull *RendererSceneOcclusionCull::singleton = nullptr;
+RendererSceneOcclusionCull::CreateFunc RendererSceneOcclusionCull::create_func = nullptr;
 
 bool RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
 
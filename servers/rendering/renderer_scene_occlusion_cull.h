@@ -202,6 +202,10 @@ public:
 		virtual ~HZBuffer() {}
 	};
 
+	typedef RendererSceneOcclusionCull *(*CreateFunc)();
+	// Set by modules providing their own occlusion culling, used instead of the built-in rasterizer.
+	static CreateFunc create_func;
+
 	static RendererSceneOcclusionCull *get_singleton() { return singleton; }
 
 	void _print_warning() {
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/os/os.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -248,4 +250,135 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+static Vector<uint8_t> _create_compressible_data(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	uint32_t state = 12345;
+	for (int i = 0; i < p_size; i++) {
+		// Runs of repeated bytes with some noise, so blocks compress to different sizes.
+		if (i % 64 == 0) {
+			state = state * 1664525 + 1013904223;
+		}
+		w[i] = uint8_t((state >> 24) + (i % 7 == 0 ? i : 0));
+	}
+	return data;
+}
+
+struct CompressedBlocks {
+	Vector<uint8_t> data;
+	LocalVector<uint32_t> sizes;
+};
+
+static bool _append_block(void *p_userdata, const uint8_t *p_data, int64_t p_size) {
+	CompressedBlocks *blocks = (CompressedBlocks *)p_userdata;
+	const int64_t offset = blocks->data.size();
+	blocks->data.resize(offset + p_size);
+	memcpy(blocks->data.ptrw() + offset, p_data, p_size);
+	blocks->sizes.push_back(p_size);
+	return true;
+}
+
+TEST_CASE("[FileAccess] Compressed files in parallel block mode") {
+	const Vector<uint8_t> data = _create_compressible_data(1024 * 1024 + 123);
+	const int parallel_min_blocks_backup = Compression::parallel_min_blocks;
+
+	Vector<uint8_t> files[2];
+	for (int pass = 0; pass < 2; pass++) {
+		// Serial first, then parallel; both must produce the same file.
+		Compression::parallel_min_blocks = pass == 0 ? 0 : 2;
+		const String file_path = TestUtils::get_temp_path(vformat("compressed_blocks_%d.bin", pass));
+		Ref<FileAccess> f = FileAccess::open_compressed(file_path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+		f->close();
+		files[pass] = FileAccess::get_file_as_bytes(file_path);
+	}
+	CHECK_MESSAGE(
+			files[0] == files[1],
+			"Parallel block compression should write the same file as serial compression.");
+
+	const String file_path = TestUtils::get_temp_path("compressed_blocks_1.bin");
+	Ref<FileAccess> f = FileAccess::open_compressed(file_path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_buffer(100) == data.slice(0, 100));
+	// Spans many whole blocks, decompressed in parallel.
+	CHECK(f->get_buffer(500000) == data.slice(100, 500100));
+	CHECK(f->get_position() == 500100);
+	CHECK(f->get_buffer(1000) == data.slice(500100, 501100));
+	f->seek(499000);
+	CHECK(f->get_buffer(2000) == data.slice(499000, 501000));
+	f->seek(0);
+	CHECK(f->get_buffer(data.size()) == data);
+	CHECK(!f->eof_reached());
+	f.unref();
+
+	SUBCASE("Closing asynchronously") {
+		const String async_path = TestUtils::get_temp_path("compressed_blocks_async.bin");
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("GCPF", Compression::MODE_ZSTD);
+		REQUIRE(fac->open_internal(async_path, FileAccess::WRITE) == OK);
+		fac->store_buffer(data.ptr(), data.size());
+		const WorkerThreadPool::TaskID task = fac->close_async();
+		REQUIRE(task != WorkerThreadPool::INVALID_TASK_ID);
+		CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(task) == OK);
+		CHECK(fac->get_close_error() == OK);
+		CHECK(FileAccess::get_file_as_bytes(async_path) == files[1]);
+
+		// The task keeps the file alive when the caller drops it.
+		fac.instantiate();
+		fac->configure("GCPF", Compression::MODE_ZSTD);
+		REQUIRE(fac->open_internal(async_path, FileAccess::WRITE) == OK);
+		fac->store_buffer(data.ptr(), data.size());
+		const WorkerThreadPool::TaskID unreferenced_task = fac->close_async();
+		REQUIRE(unreferenced_task != WorkerThreadPool::INVALID_TASK_ID);
+		fac.unref();
+		CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(unreferenced_task) == OK);
+		CHECK(FileAccess::get_file_as_bytes(async_path) == files[1]);
+	}
+
+	SUBCASE("Block API round trip") {
+		const uint32_t block_size = 16 * 1024;
+		CompressedBlocks blocks;
+		REQUIRE(Compression::compress_blocks(data.ptr(), data.size(), block_size, Compression::MODE_ZSTD, &_append_block, &blocks));
+		REQUIRE(blocks.sizes.size() == Compression::get_block_count(data.size(), block_size));
+
+		Vector<uint8_t> decompressed;
+		decompressed.resize(data.size());
+		CHECK(Compression::decompress_blocks(decompressed.ptrw(), decompressed.size(), blocks.data.ptr(), blocks.sizes.ptr(), blocks.sizes.size(), block_size, Compression::MODE_ZSTD));
+		CHECK(decompressed == data);
+	}
+
+	Compression::parallel_min_blocks = parallel_min_blocks_backup;
+}
+
+TEST_CASE_BENCHMARK("[FileAccess][Benchmark] Block compression throughput") {
+	const Vector<uint8_t> data = _create_compressible_data(64 * 1024 * 1024);
+	const double size_mb = data.size() / (1024.0 * 1024.0);
+	const int parallel_min_blocks_backup = Compression::parallel_min_blocks;
+	Compression::parallel_min_blocks = 2;
+
+	const uint32_t block_sizes[] = { 4 * 1024, 64 * 1024, 1024 * 1024 };
+	const int task_counts[] = { 1, 2, 4, -1 };
+	for (uint32_t block_size : block_sizes) {
+		for (int tasks : task_counts) {
+			CompressedBlocks blocks;
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			Compression::compress_blocks(data.ptr(), data.size(), block_size, Compression::MODE_ZSTD, &_append_block, &blocks, tasks);
+			const uint64_t compress_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			Vector<uint8_t> decompressed;
+			decompressed.resize(data.size());
+			begin = OS::get_singleton()->get_ticks_usec();
+			Compression::decompress_blocks(decompressed.ptrw(), decompressed.size(), blocks.data.ptr(), blocks.sizes.ptr(), blocks.sizes.size(), block_size, Compression::MODE_ZSTD, tasks);
+			const uint64_t decompress_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			print_line(vformat("zstd, %d KiB blocks, %s tasks: compress %.1f MiB/s, decompress %.1f MiB/s.", block_size / 1024, tasks < 0 ? String("all") : itos(tasks), size_mb / (compress_usec / 1000000.0), size_mb / (decompress_usec / 1000000.0)));
+		}
+	}
+
+	Compression::parallel_min_blocks = parallel_min_blocks_backup;
+}
+
 } // namespace TestFileAccess
@@ -30,8 +30,12 @@
 
 #pragma once
 
+#include "core/io/dir_access.h"
 #include "core/io/json.h"
+#include "core/os/os.h"
 
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
 #include "thirdparty/doctest/doctest.h"
 
 namespace TestJSON {
@@ -423,4 +427,205 @@ TEST_CASE("[JSON] Serialization") {
 		}
 	}
 }
+
+static Variant _parse_utf8(const String &p_json, Error &r_error) {
+	const CharString utf8 = p_json.utf8();
+	JSON json;
+	r_error = json.parse_utf8((const uint8_t *)utf8.get_data(), utf8.length());
+	return json.get_data();
+}
+
+TEST_CASE("[JSON] UTF-8 parsing") {
+	const char *documents[] = {
+		"null",
+		"true",
+		" false ",
+		"-12.5e3",
+		"\"hello\"",
+		"\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"",
+		"\"\\u00e9\\ud83d\\ude00 caf\u00e9 \u65e5\u672c\"",
+		"[]",
+		"{}",
+		"[1, 2, [3, [4, {}]], \"five\", null, true]",
+		"{\"name\": \"Godot Engine\", \"nested\": {\"list\": [1.5, -2, 3e2], \"empty\": []}}",
+		"\n{\n\t\"a\": 1,\n\t\"b\": [\n\t\t\"c\"\n\t]\n}\n",
+	};
+
+	for (const char *document : documents) {
+		const String text = String::utf8(document);
+		JSON json;
+		CHECK(json.parse(text) == OK);
+
+		Error err;
+		const Variant parsed = _parse_utf8(text, err);
+		CHECK_MESSAGE(err == OK, vformat("Parsing `%s` as UTF-8 should succeed.", text));
+		CHECK_MESSAGE(parsed == json.get_data(), vformat("Parsing `%s` as UTF-8 should match parsing it as a String.", text));
+	}
+
+	const char *invalid_documents[] = {
+		"",
+		"[1, 2",
+		"{\"a\" 1}",
+		"{1: 2}",
+		"[1 2]",
+		"\"unterminated",
+		"\"\\x\"",
+		"\"\\ud83d\"",
+		"nope",
+		"[] []",
+		"@",
+	};
+
+	for (const char *document : invalid_documents) {
+		Error err;
+		_parse_utf8(String::utf8(document), err);
+		CHECK_MESSAGE(err != OK, vformat("Parsing `%s` as UTF-8 should fail.", document));
+	}
+
+	JSON json;
+	const CharString multiline = String("[\n1,\n2\n").utf8();
+	CHECK(json.parse_utf8((const uint8_t *)multiline.get_data(), multiline.length()) == ERR_PARSE_ERROR);
+	CHECK(json.get_error_line() == 3);
+	CHECK(json.get_error_message() == "Expected ']'");
+}
+
+class JSONEventCounter : public JSONStreamHandler {
+public:
+	int objects = 0;
+	int arrays = 0;
+	int keys = 0;
+	int values = 0;
+
+	virtual bool begin_object() override {
+		objects++;
+		return true;
+	}
+	virtual bool begin_array() override {
+		arrays++;
+		return true;
+	}
+	virtual bool key(const String &p_key) override {
+		keys++;
+		return true;
+	}
+	virtual bool value(const Variant &p_value) override {
+		values++;
+		return values < 100;
+	}
+};
+
+TEST_CASE("[JSON] Streaming from and to files") {
+	// Large enough to span several reads, with strings and numbers split across them.
+	Array entries;
+	for (int i = 0; i < 2000; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["value"] = i * 0.25;
+		entry["name"] = String::utf8("entrée ") + String("x").repeat(i % 97);
+		entries.push_back(entry);
+	}
+	Dictionary document;
+	document["entries"] = entries;
+	document["long"] = String("abc\"\n").repeat(40000);
+
+	const String path = TestUtils::get_temp_path("json_stream.json");
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		CHECK(JSON::stringify_to_file(document, file, "\t") == OK);
+	}
+	CHECK(FileAccess::get_file_as_string(path) == JSON::stringify(document, "\t"));
+
+	LocalVector<uint8_t> buffer;
+	CHECK(JSON::stringify_to_buffer(document, buffer) == OK);
+	CHECK(String::utf8((const char *)buffer.ptr(), buffer.size()) == JSON::stringify(document));
+
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(file.is_valid());
+		JSON json;
+		CHECK(json.parse_file(file) == OK);
+		// Numbers are parsed as floats, so compare with the String parser's result.
+		CHECK(json.get_data() == JSON::parse_string(JSON::stringify(document)));
+	}
+
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(file.is_valid());
+		JSONStreamParser parser;
+		JSONEventCounter counter;
+		CHECK(parser.parse_file(file, &counter) == ERR_SKIP);
+		CHECK(counter.values == 100);
+		CHECK(counter.arrays == 1);
+	}
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE_BENCHMARK("[JSON][Benchmark] Parsing and stringifying") {
+	Array entries;
+	for (int i = 0; i < 50000; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["position"] = Array{ i * 0.5, i * 1.5, -i * 2.5 };
+		entry["name"] = vformat("entity_%d", i);
+		entry["tags"] = Array{ "alpha", "beta", String::utf8("gamma é") };
+		entries.push_back(entry);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const String text = JSON::stringify(entries, "\t");
+	const uint64_t stringify_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	LocalVector<uint8_t> buffer;
+	begin = OS::get_singleton()->get_ticks_usec();
+	JSON::stringify_to_buffer(entries, buffer, "\t");
+	const uint64_t stringify_buffer_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	JSON json;
+	begin = OS::get_singleton()->get_ticks_usec();
+	json.parse(text);
+	const uint64_t parse_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const CharString utf8 = text.utf8();
+	json.parse(String::utf8(utf8.get_data(), utf8.length()));
+	const uint64_t parse_from_utf8_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	json.parse_utf8(buffer.ptr(), buffer.size());
+	const uint64_t parse_utf8_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	const String path = TestUtils::get_temp_path("json_benchmark.json");
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		begin = OS::get_singleton()->get_ticks_usec();
+		file->store_string(JSON::stringify(entries, "\t"));
+	}
+	const uint64_t stringify_store_string_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		begin = OS::get_singleton()->get_ticks_usec();
+		JSON::stringify_to_file(entries, file, "\t");
+	}
+	const uint64_t stringify_file_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	json.parse(FileAccess::get_file_as_string(path));
+	const uint64_t parse_file_string_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	json.parse_file(FileAccess::open(path, FileAccess::READ));
+	const uint64_t parse_file_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	DirAccess::remove_absolute(path);
+
+	print_line(vformat("JSON (%d bytes): stringify %d usec, to buffer %d usec.", buffer.size(), stringify_usec, stringify_buffer_usec));
+	print_line(vformat("JSON (%d bytes): stringify and store String %d usec, stream to file %d usec.", buffer.size(), stringify_store_string_usec, stringify_file_usec));
+	print_line(vformat("JSON (%d bytes): parse String %d usec, decode UTF-8 and parse String %d usec, parse UTF-8 %d usec.", buffer.size(), parse_usec, parse_from_utf8_usec, parse_utf8_usec));
+	print_line(vformat("JSON (%d bytes): read file as String and parse %d usec, stream file %d usec.", buffer.size(), parse_file_string_usec, parse_file_usec));
+	const Variant streamed = json.get_data();
+	json.parse(text);
+	CHECK(streamed == json.get_data());
+}
 } // namespace TestJSON
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "core/variant/typed_array.h"
 
 #include "tests/test_macros.h"
 
@@ -489,4 +491,213 @@ TEST_CASE("[Marshalls] Typed dictionary decoding") {
 	CHECK(dictionary[Variant(uint64_t(0x0f123456789abcdef))] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+static Vector<uint8_t> _encode_two_pass(const Variant &p_variant) {
+	int len = 0;
+	Error err = encode_variant(p_variant, nullptr, len);
+	CHECK(err == OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	err = encode_variant(p_variant, buffer.ptrw(), len);
+	CHECK(err == OK);
+	return buffer;
+}
+
+static Vector<uint8_t> _encode_single_pass(const Variant &p_variant) {
+	LocalVector<uint8_t> local;
+	Error err = encode_variant(p_variant, local);
+	CHECK(err == OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(local.size());
+	if (local.size()) {
+		memcpy(buffer.ptrw(), local.ptr(), local.size());
+	}
+	return buffer;
+}
+
+static Array _make_marshalls_test_values() {
+	Array values;
+	values.push_back(Variant());
+	values.push_back(true);
+	values.push_back(42);
+	values.push_back(int64_t(0x0f123456789abcdef));
+	values.push_back(1.5);
+	values.push_back(0.1);
+	values.push_back(String());
+	values.push_back(String::utf8("héllo"));
+	values.push_back(Vector2(1, 2));
+	values.push_back(Vector3i(1, 2, 3));
+	values.push_back(Transform3D());
+	values.push_back(Color(0.1, 0.2, 0.3, 0.4));
+	values.push_back(StringName("name"));
+	values.push_back(NodePath("a/b:c"));
+
+	TypedArray<int> typed_ints;
+	typed_ints.push_back(1);
+	typed_ints.push_back(2);
+	values.push_back(typed_ints);
+
+	TypedArray<Vector3> typed_vectors;
+	typed_vectors.push_back(Vector3(1, 2, 3));
+	values.push_back(typed_vectors);
+
+	Dictionary nested;
+	Array nested_array;
+	nested_array.push_back(1);
+	nested_array.push_back("two");
+	nested_array.push_back(Vector2(3, 4));
+	nested["key"] = nested_array;
+	nested[7] = Dictionary();
+	values.push_back(nested);
+
+	values.push_back(PackedByteArray({ 1, 2, 3 }));
+	values.push_back(PackedInt32Array({ 1, -2, 3 }));
+	values.push_back(PackedInt64Array({ 1, -2, int64_t(1) << 40 }));
+	values.push_back(PackedFloat32Array({ 1.5, -2.5 }));
+	values.push_back(PackedFloat64Array({ 0.1, -0.2 }));
+	values.push_back(PackedStringArray({ "a", "bcd", "" }));
+	values.push_back(PackedVector2Array({ Vector2(1, 2), Vector2(3, 4) }));
+	values.push_back(PackedVector3Array({ Vector3(1, 2, 3) }));
+	values.push_back(PackedColorArray({ Color(1, 0, 0) }));
+	values.push_back(PackedVector4Array({ Vector4(1, 2, 3, 4) }));
+	return values;
+}
+
+TEST_CASE("[Marshalls] Single pass encoding matches measured encoding") {
+	Array values = _make_marshalls_test_values();
+	for (int i = 0; i < values.size(); i++) {
+		const Variant &value = values[i];
+		CHECK_MESSAGE(_encode_single_pass(value) == _encode_two_pass(value), vformat("Encoding mismatch for %s.", Variant::get_type_name(value.get_type())));
+	}
+	CHECK(_encode_single_pass(values) == _encode_two_pass(values));
+
+	// Appending must keep what is already in the buffer.
+	LocalVector<uint8_t> buffer;
+	buffer.push_back(0xff);
+	CHECK(encode_variant(42, buffer) == OK);
+	CHECK(buffer.size() == 5);
+	CHECK(buffer[0] == 0xff);
+	CHECK(buffer[1] == 0x02);
+}
+
+TEST_CASE("[Marshalls] Decoding into reused containers") {
+	Array values = _make_marshalls_test_values();
+	Vector<uint8_t> encoded = _encode_two_pass(values);
+
+	Variant decoded;
+	int r_len = 0;
+	CHECK(decode_variant_reusing(decoded, encoded.ptr(), encoded.size(), &r_len) == OK);
+	CHECK(r_len == encoded.size());
+	CHECK(decoded == Variant(values));
+
+	const Array first = decoded;
+	const void *first_id = first.id();
+
+	// Decoding the same layout again must update the existing array in place.
+	values[2] = 43;
+	values[7] = "changed";
+	encoded = _encode_two_pass(values);
+	CHECK(decode_variant_reusing(decoded, encoded.ptr(), encoded.size(), &r_len) == OK);
+	CHECK(decoded == Variant(values));
+	CHECK(Array(decoded).id() == first_id);
+
+	SUBCASE("Dictionary with different keys") {
+		Dictionary dictionary;
+		dictionary["a"] = 1;
+		dictionary["b"] = 2;
+		Variant target = dictionary.duplicate();
+
+		Dictionary other;
+		other["c"] = 3;
+		other["d"] = Array();
+		Vector<uint8_t> other_encoded = _encode_two_pass(other);
+		CHECK(decode_variant_reusing(target, other_encoded.ptr(), other_encoded.size()) == OK);
+		CHECK(target == Variant(other));
+	}
+
+	SUBCASE("Dictionary with reordered keys") {
+		Dictionary dictionary;
+		dictionary["a"] = 1;
+		dictionary["b"] = 2;
+		Variant target = dictionary.duplicate();
+
+		Dictionary reordered;
+		reordered["b"] = 3;
+		reordered["a"] = 4;
+		Vector<uint8_t> reordered_encoded = _encode_two_pass(reordered);
+		CHECK(decode_variant_reusing(target, reordered_encoded.ptr(), reordered_encoded.size()) == OK);
+		CHECK(Dictionary(target).keys() == reordered.keys());
+		CHECK(target == Variant(reordered));
+	}
+
+	SUBCASE("Packed arrays are decoded without copies") {
+		Dictionary dictionary;
+		dictionary["samples"] = PackedFloat32Array({ 1, 2, 3 });
+		Variant target = dictionary.duplicate(true);
+		const float *samples_ptr = PackedFloat32Array(Dictionary(target)["samples"]).ptr();
+
+		dictionary["samples"] = PackedFloat32Array({ 4, 5, 6 });
+		Vector<uint8_t> dictionary_encoded = _encode_two_pass(dictionary);
+		CHECK(decode_variant_reusing(target, dictionary_encoded.ptr(), dictionary_encoded.size()) == OK);
+		CHECK(target == Variant(dictionary));
+		CHECK(PackedFloat32Array(Dictionary(target)["samples"]).ptr() == samples_ptr);
+	}
+
+	SUBCASE("Type mismatch") {
+		Variant target = PackedInt32Array({ 1, 2, 3 });
+		Vector<uint8_t> packed = _encode_two_pass(PackedFloat32Array({ 1.5 }));
+		CHECK(decode_variant_reusing(target, packed.ptr(), packed.size()) == OK);
+		CHECK(target == Variant(PackedFloat32Array({ 1.5 })));
+	}
+}
+
+TEST_CASE_BENCHMARK("[Marshalls][Benchmark] Variant encoding and decoding") {
+	Array frame;
+	for (int i = 0; i < 64; i++) {
+		Dictionary entity;
+		entity["id"] = i;
+		entity["name"] = vformat("entity_%d", i);
+		entity["position"] = Vector3(i, i * 2, i * 3);
+		entity["rotation"] = Quaternion();
+		entity["tags"] = PackedStringArray({ "a", "b" });
+		PackedFloat32Array samples;
+		samples.resize(64);
+		entity["samples"] = samples;
+		frame.push_back(entity);
+	}
+	const int iterations = 2000;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		_encode_two_pass(frame);
+	}
+	const uint64_t two_pass_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	LocalVector<uint8_t> buffer;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		buffer.clear();
+		encode_variant(frame, buffer);
+	}
+	const uint64_t single_pass_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Vector<uint8_t> encoded = _encode_two_pass(frame);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Variant decoded;
+		decode_variant(decoded, encoded.ptr(), encoded.size());
+	}
+	const uint64_t decode_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Variant reused;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		decode_variant_reusing(reused, encoded.ptr(), encoded.size());
+	}
+	const uint64_t decode_reusing_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("Variant encoding (%d bytes x %d): measured %d usec, single pass %d usec.", encoded.size(), iterations, two_pass_usec, single_pass_usec));
+	print_line(vformat("Variant decoding (%d bytes x %d): fresh %d usec, reusing %d usec.", encoded.size(), iterations, decode_usec, decode_reusing_usec));
+	CHECK(reused == Variant(frame));
+}
+
 } // namespace TestMarshalls
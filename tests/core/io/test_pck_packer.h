@@ -34,8 +34,8 @@
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 
+#include "tests/test_macros.h"
 #include "tests/test_utils.h"
-#include "thirdparty/doctest/doctest.h"
 
 namespace TestPCKPacker {
 
@@ -61,6 +61,11 @@ TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	CHECK_MESSAGE(
 			f->get_length() <= 500,
 			"The generated empty PCK file shouldn't be too large.");
+
+	f->seek(4);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION_V3,
+			"A PCK file without compressed entries should stay readable by older versions.");
 }
 
 TEST_CASE("[PCKPacker] Pack empty with zero alignment invalid") {
@@ -116,4 +121,202 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+// Mostly repetitive data with a stretch of noise, so some blocks compress and some are stored as is.
+static Vector<uint8_t> _create_pck_test_data(int p_size, uint32_t p_seed) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	uint32_t state = p_seed | 1;
+	for (int i = 0; i < p_size; i++) {
+		if (i > p_size / 2 && i < p_size / 2 + PACK_COMPRESSION_BLOCK_SIZE) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			w[i] = state & 0xFF;
+		} else {
+			w[i] = uint8_t((i / 64) * 7 + (i % 13) + p_seed);
+		}
+	}
+	return data;
+}
+
+static String _write_pck_test_file(const String &p_name, const Vector<uint8_t> &p_data) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_buffer(p_data);
+	return path;
+}
+
+TEST_CASE("[PCKPacker] Read back compressed files") {
+	const Vector<uint8_t> large_data = _create_pck_test_data(PACK_COMPRESSION_BLOCK_SIZE * 6 + 1234, 3);
+	const Vector<uint8_t> small_data = _create_pck_test_data(1000, 5);
+	const String large_path = _write_pck_test_file("compressed_large.bin", large_data);
+	const String small_path = _write_pck_test_file("compressed_small.bin", small_data);
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file_compressed("pck_compressed/large_zstd.bin", large_path) == OK);
+	CHECK(pck_packer.add_file_compressed("pck_compressed/large_fastlz.bin", large_path, FileAccess::COMPRESSION_FASTLZ) == OK);
+	CHECK(pck_packer.add_file_compressed("pck_compressed/small.bin", small_path) == OK);
+	CHECK(pck_packer.add_file("pck_compressed/plain.bin", large_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes(output_pck_path).size() < large_data.size() * 3,
+			"Compressed files should take less space than the plain one.");
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		f->seek(4);
+		CHECK(f->get_32() == PACK_FORMAT_VERSION_V4);
+	}
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	const String packed_files[] = { "res://pck_compressed/large_zstd.bin", "res://pck_compressed/large_fastlz.bin", "res://pck_compressed/plain.bin" };
+	for (const String &packed_file : packed_files) {
+		CHECK_MESSAGE(FileAccess::get_file_as_bytes(packed_file) == large_data, packed_file);
+
+		{
+			Ref<FileAccess> f = FileAccess::open(packed_file, FileAccess::READ);
+			REQUIRE(f.is_valid());
+			CHECK(f->get_length() == uint64_t(large_data.size()));
+
+			// Crosses a block boundary.
+			f->seek(PACK_COMPRESSION_BLOCK_SIZE - 10);
+			uint8_t buffer[32];
+			CHECK(f->get_buffer(buffer, 32) == 32);
+			CHECK(memcmp(buffer, large_data.ptr() + PACK_COMPRESSION_BLOCK_SIZE - 10, 32) == 0);
+
+			// Partial block, whole blocks, then another partial block.
+			Vector<uint8_t> middle;
+			middle.resize(PACK_COMPRESSION_BLOCK_SIZE * 4 + 100);
+			f->seek(100);
+			CHECK(f->get_buffer(middle.ptrw(), middle.size()) == uint64_t(middle.size()));
+			CHECK(memcmp(middle.ptr(), large_data.ptr() + 100, middle.size()) == 0);
+
+			f->seek(large_data.size() - 2);
+			CHECK(f->get_8() == large_data[large_data.size() - 2]);
+			CHECK(f->get_8() == large_data[large_data.size() - 1]);
+			CHECK_FALSE(f->eof_reached());
+			f->get_8();
+			CHECK(f->eof_reached());
+		}
+	}
+
+	CHECK(FileAccess::get_file_as_bytes("res://pck_compressed/small.bin") == small_data);
+
+	PackedData::get_singleton()->remove_path("pck_compressed/large_zstd.bin");
+	PackedData::get_singleton()->remove_path("pck_compressed/large_fastlz.bin");
+	PackedData::get_singleton()->remove_path("pck_compressed/small.bin");
+	PackedData::get_singleton()->remove_path("pck_compressed/plain.bin");
+}
+
+TEST_CASE("[PCKPacker] Reject files outside of the pack") {
+	const Vector<uint8_t> data = _create_pck_test_data(PACK_COMPRESSION_BLOCK_SIZE * 2, 7);
+	const String data_path = _write_pck_test_file("bounds.bin", data);
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_bounds.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file("pck_bounds/plain.bin", data_path) == OK);
+	CHECK(pck_packer.add_file_compressed("pck_bounds/compressed.bin", data_path) == OK);
+	CHECK(pck_packer.add_file("pck_bounds/intact.bin", data_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ_WRITE);
+		REQUIRE(f.is_valid());
+		f->seek(24);
+		const uint64_t file_base = f->get_64();
+		const uint64_t dir_offset = f->get_64();
+		f->seek(dir_offset);
+		REQUIRE(f->get_32() == 3);
+
+		// The first file gets larger than the whole pack.
+		uint32_t path_length = f->get_32();
+		f->seek(f->get_position() + path_length + 8);
+		f->store_64(f->get_length());
+		f->seek(f->get_position() + 16 + 4);
+
+		// The first block of the compressed file gets larger than a block.
+		path_length = f->get_32();
+		f->seek(f->get_position() + path_length);
+		const uint64_t compressed_ofs = f->get_64();
+		f->seek(file_base + compressed_ofs);
+		f->store_32(PACK_COMPRESSION_BLOCK_SIZE + 1);
+	}
+
+	ERR_PRINT_OFF;
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	CHECK_FALSE(PackedData::get_singleton()->has_path("res://pck_bounds/plain.bin"));
+	REQUIRE(PackedData::get_singleton()->has_path("res://pck_bounds/compressed.bin"));
+	CHECK(FileAccess::open("res://pck_bounds/compressed.bin", FileAccess::READ).is_null());
+	ERR_PRINT_ON;
+
+	CHECK(FileAccess::get_file_as_bytes("res://pck_bounds/intact.bin") == data);
+
+	PackedData::get_singleton()->remove_path("pck_bounds/compressed.bin");
+	PackedData::get_singleton()->remove_path("pck_bounds/intact.bin");
+}
+
+TEST_CASE_BENCHMARK("[PCKPacker][Benchmark] Load files from a synthetic PCK") {
+	const int file_count = 64;
+	const int file_size = 4 * 1024 * 1024;
+
+	Vector<String> source_paths;
+	for (int i = 0; i < file_count; i++) {
+		source_paths.push_back(_write_pck_test_file(vformat("benchmark_%d.bin", i), _create_pck_test_data(file_size, i)));
+	}
+
+	for (int pass = 0; pass < 3; pass++) {
+		const String modes[] = { "uncompressed", "zstd", "fastlz" };
+		const String pck_path = TestUtils::get_temp_path(vformat("benchmark_%s.pck", modes[pass]));
+		const String prefix = vformat("pck_benchmark_%s", modes[pass]);
+
+		PCKPacker pck_packer;
+		pck_packer.pck_start(pck_path);
+		for (int i = 0; i < file_count; i++) {
+			const String target = prefix.path_join(vformat("%d.bin", i));
+			if (pass == 0) {
+				pck_packer.add_file(target, source_paths[i]);
+			} else {
+				pck_packer.add_file_compressed(target, source_paths[i], pass == 1 ? FileAccess::COMPRESSION_ZSTD : FileAccess::COMPRESSION_FASTLZ);
+			}
+		}
+		pck_packer.flush();
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		PackedData::get_singleton()->add_pack(pck_path, true, 0);
+		const uint64_t mount_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		Vector<uint8_t> buffer;
+		buffer.resize(file_size);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open("res://" + prefix.path_join(vformat("%d.bin", i)), FileAccess::READ);
+			f->get_buffer(buffer.ptrw(), file_size);
+		}
+		const uint64_t whole_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open("res://" + prefix.path_join(vformat("%d.bin", i)), FileAccess::READ);
+			while (!f->eof_reached()) {
+				f->get_32();
+			}
+		}
+		const uint64_t sequential_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		const double total_mb = double(file_count) * file_size / (1024.0 * 1024.0);
+		print_line(vformat("%s PCK (%.1f MiB on disk): mount %.3f ms, whole files %.1f MiB/s, 4 byte reads %.1f MiB/s.", modes[pass], FileAccess::get_size(pck_path) / (1024.0 * 1024.0), mount_usec / 1000.0, total_mb / (whole_usec / 1000000.0), total_mb / (sequential_usec / 1000000.0)));
+
+		for (int i = 0; i < file_count; i++) {
+			PackedData::get_singleton()->remove_path(prefix.path_join(vformat("%d.bin", i)));
+		}
+	}
+}
+
 } // namespace TestPCKPacker
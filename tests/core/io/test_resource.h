@@ -627,4 +627,163 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Saving and loading packed arrays in both byte orders") {
+	Ref<Resource> resource = memnew(Resource);
+	PackedInt32Array int32_array;
+	PackedInt64Array int64_array;
+	PackedFloat32Array float32_array;
+	PackedFloat64Array float64_array;
+	PackedVector2Array vector2_array;
+	PackedVector3Array vector3_array;
+	PackedVector4Array vector4_array;
+	PackedColorArray color_array;
+	// More elements than a conversion chunk, so byte swapping crosses chunk boundaries.
+	for (int i = 0; i < 2500; i++) {
+		int32_array.push_back(i * -7919);
+		int64_array.push_back(int64_t(i) * -1000000007LL);
+		float32_array.push_back(i * 0.25f);
+		float64_array.push_back(i * 0.125);
+		vector2_array.push_back(Vector2(i, -i));
+		vector3_array.push_back(Vector3(i, i * 0.5, -i));
+		vector4_array.push_back(Vector4(i, i * 2, i * 3, i * 4));
+		color_array.push_back(Color(i / 2500.0, 0.5, 1.0 - i / 2500.0, 0.25));
+	}
+	resource->set_meta("int32", int32_array);
+	resource->set_meta("int64", int64_array);
+	resource->set_meta("float32", float32_array);
+	resource->set_meta("float64", float64_array);
+	resource->set_meta("vector2", vector2_array);
+	resource->set_meta("vector3", vector3_array);
+	resource->set_meta("vector4", vector4_array);
+	resource->set_meta("color", color_array);
+
+	for (int pass = 0; pass < 2; pass++) {
+		const String save_path = TestUtils::get_temp_path(vformat("packed_arrays_%d.res", pass));
+		REQUIRE(ResourceSaver::save(resource, save_path, pass == 0 ? 0 : ResourceSaver::FLAG_SAVE_BIG_ENDIAN) == OK);
+
+		Ref<Resource> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		CHECK(PackedInt32Array(loaded->get_meta("int32")) == int32_array);
+		CHECK(PackedInt64Array(loaded->get_meta("int64")) == int64_array);
+		CHECK(PackedFloat32Array(loaded->get_meta("float32")) == float32_array);
+		CHECK(PackedFloat64Array(loaded->get_meta("float64")) == float64_array);
+		CHECK(PackedVector2Array(loaded->get_meta("vector2")) == vector2_array);
+		CHECK(PackedVector3Array(loaded->get_meta("vector3")) == vector3_array);
+		CHECK(PackedVector4Array(loaded->get_meta("vector4")) == vector4_array);
+		CHECK(PackedColorArray(loaded->get_meta("color")) == color_array);
+	}
+}
+
+// Saves a graph of binary resources, `p_depth` levels deep. Every resource references two of the next level.
+static String _save_dependency_graph(const String &p_prefix, int p_depth, int p_width, int p_payload_size) {
+	LocalVector<Ref<Resource>> next_level;
+	for (int depth = p_depth - 1; depth >= 0; depth--) {
+		const int width = depth == 0 ? 1 : p_width;
+		LocalVector<Ref<Resource>> level;
+		for (int i = 0; i < width; i++) {
+			Ref<Resource> resource;
+			resource.instantiate();
+			resource->set_name(vformat("%d_%d", depth, i));
+			PackedByteArray payload;
+			payload.resize(p_payload_size);
+			payload.fill(i);
+			resource->set_meta("payload", payload);
+			if (!next_level.is_empty()) {
+				resource->set_meta("first", next_level[i % next_level.size()]);
+				resource->set_meta("second", next_level[(i + 1) % next_level.size()]);
+			}
+			const String path = TestUtils::get_temp_path(vformat("%s_%d_%d.res", p_prefix, depth, i));
+			ResourceSaver::save(resource, path);
+			resource->set_path(path);
+			level.push_back(resource);
+		}
+		next_level = level;
+	}
+	return next_level[0]->get_path();
+}
+
+TEST_CASE("[Resource] Threaded load prefetches binary dependencies") {
+	const String root_path = _save_dependency_graph("prefetch", 4, 3, 256);
+
+	const uint64_t budget_backup = ResourceLoader::get_dependency_prefetch_budget();
+	ResourceLoader::set_dependency_prefetch_budget(16 * 1024 * 1024);
+	ResourceLoader::clear_load_timings();
+	ResourceLoader::set_load_timings_enabled(true);
+
+	REQUIRE(ResourceLoader::load_threaded_request(root_path) == OK);
+	Ref<Resource> root = ResourceLoader::load_threaded_get(root_path);
+	ResourceLoader::set_load_timings_enabled(false);
+	REQUIRE(root.is_valid());
+
+	Ref<Resource> resource = root;
+	for (int depth = 1; depth < 4; depth++) {
+		resource = resource->get_meta("second");
+		REQUIRE(resource.is_valid());
+		CHECK_MESSAGE(
+				resource->get_name() == vformat("%d_%d", depth, depth % 3),
+				"The dependencies should be loaded from the prefetched files.");
+	}
+	const PackedByteArray payload = resource->get_meta("payload");
+	CHECK(payload.size() == 256);
+
+	const Vector<ResourceLoader::LoadTiming> timings = ResourceLoader::get_load_timings();
+	CHECK_MESSAGE(
+			timings.size() == 10,
+			"Every resource of the graph should have its load timed.");
+	int prefetched = 0;
+	for (const ResourceLoader::LoadTiming &timing : timings) {
+		CHECK(!timing.failed);
+		CHECK(timing.self_usec <= timing.total_usec);
+		if (timing.path == root_path) {
+			CHECK(timing.depth == 0);
+		}
+		prefetched += timing.prefetched ? 1 : 0;
+	}
+	CHECK_MESSAGE(
+			prefetched == 10,
+			"Every file of the graph should be read by the prefetch pass.");
+	CHECK_MESSAGE(
+			ResourceLoader::take_prefetched_file(root_path).is_empty(),
+			"Prefetched files should be released by the loaders.");
+
+	ResourceLoader::clear_load_timings();
+	ResourceLoader::set_dependency_prefetch_budget(budget_backup);
+}
+
+TEST_CASE_BENCHMARK("[Resource][Benchmark] Threaded load of a deep dependency graph") {
+	const int depth = 16;
+	const int width = 16;
+	const String root_path = _save_dependency_graph("prefetch_benchmark", depth, width, 64 * 1024);
+	const uint64_t budget_backup = ResourceLoader::get_dependency_prefetch_budget();
+
+	for (int pass = 0; pass < 2; pass++) {
+		ResourceLoader::set_dependency_prefetch_budget(pass == 0 ? 0 : 256 * 1024 * 1024);
+		ResourceLoader::clear_load_timings();
+		ResourceLoader::set_load_timings_enabled(true);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		ResourceLoader::load_threaded_request(root_path);
+		Ref<Resource> root = ResourceLoader::load_threaded_get(root_path);
+		const uint64_t load_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		ResourceLoader::set_load_timings_enabled(false);
+		CHECK(root.is_valid());
+
+		uint64_t self_usec = 0;
+		uint64_t slowest_usec = 0;
+		String slowest_path;
+		const Vector<ResourceLoader::LoadTiming> timings = ResourceLoader::get_load_timings();
+		for (const ResourceLoader::LoadTiming &timing : timings) {
+			self_usec += timing.self_usec;
+			if (timing.self_usec > slowest_usec) {
+				slowest_usec = timing.self_usec;
+				slowest_path = timing.path.get_file();
+			}
+		}
+		print_line(vformat("%s: %d resources loaded in %.3f ms, %.3f ms parsing, slowest %s (%.3f ms).", pass == 0 ? "No prefetch" : "Prefetch", timings.size(), load_usec / 1000.0, self_usec / 1000.0, slowest_path, slowest_usec / 1000.0));
+	}
+
+	ResourceLoader::clear_load_timings();
+	ResourceLoader::set_dependency_prefetch_budget(budget_backup);
+}
 } // namespace TestResource
@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = StringName(String("test_string_name_") + "interning");
+
+	CHECK_MESSAGE(a == b, "StringNames built from equal strings should compare equal.");
+	CHECK_MESSAGE(a.data_unique_pointer() == c.data_unique_pointer(), "StringNames built from equal strings should share data.");
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+	CHECK(a != StringName("test_string_name_interning_other"));
+
+	CHECK(StringName().is_empty());
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Release and re-intern") {
+	const String name = "test_string_name_release_and_reintern";
+	{
+		const StringName a = name;
+		CHECK(a == name);
+	}
+	// The entry was freed when `a` went out of scope, interning again must create a valid one.
+	const StringName b = name;
+	const StringName c = name;
+	CHECK(b == name);
+	CHECK(b.data_unique_pointer() == c.data_unique_pointer());
+}
+
+#ifdef THREADS_ENABLED
+struct ConcurrentInternTester {
+	static constexpr int NAME_COUNT = 512;
+
+	Vector<String> names;
+	Vector<String> transient_names;
+	TightLocalVector<Thread> threads;
+	TightLocalVector<LocalVector<const void *>> results;
+	uint32_t iterations = 1;
+	SafeNumeric<uint32_t> next_thread_idx;
+
+	static void thread_func(void *p_userdata) {
+		ConcurrentInternTester *tester = (ConcurrentInternTester *)p_userdata;
+		const uint32_t thread_idx = tester->next_thread_idx.postincrement();
+		LocalVector<const void *> &result = tester->results[thread_idx];
+		result.resize(tester->names.size());
+
+		for (uint32_t i = 0; i < tester->iterations; i++) {
+			for (int j = 0; j < tester->names.size(); j++) {
+				// Mix lookups of names that stay alive with names that are released right away.
+				const StringName sname = tester->names[j];
+				result[j] = sname.data_unique_pointer();
+				const StringName transient = tester->transient_names[j];
+			}
+		}
+	}
+
+	uint64_t run(uint32_t p_thread_count, uint32_t p_iterations) {
+		iterations = p_iterations;
+		next_thread_idx.set(0);
+		threads.clear();
+		threads.resize(p_thread_count);
+		results.clear();
+		results.resize(p_thread_count);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < p_thread_count; i++) {
+			threads[i].start(thread_func, this);
+		}
+		for (uint32_t i = 0; i < p_thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		return OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	ConcurrentInternTester() {
+		for (int i = 0; i < NAME_COUNT; i++) {
+			names.push_back("test_string_name_concurrent_" + itos(i));
+			transient_names.push_back("test_string_name_transient_" + itos(i));
+		}
+	}
+};
+
+TEST_CASE("[StringName] Concurrent interning") {
+	ConcurrentInternTester tester;
+
+	// Keep one reference alive on this thread, so every thread must resolve to the same entry.
+	Vector<StringName> alive;
+	for (const String &name : tester.names) {
+		alive.push_back(name);
+	}
+
+	const uint32_t thread_count = MAX(4, OS::get_singleton()->get_processor_count());
+	tester.run(thread_count, 16);
+
+	bool all_match = true;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		for (int j = 0; j < alive.size(); j++) {
+			all_match &= tester.results[i][j] == alive[j].data_unique_pointer();
+		}
+	}
+	CHECK_MESSAGE(all_match, "All threads should resolve existing names to the same entry.");
+}
+
+TEST_CASE_BENCHMARK("[StringName][Benchmark] Intern throughput by thread count") {
+	ConcurrentInternTester tester;
+
+	Vector<StringName> alive;
+	for (const String &name : tester.names) {
+		alive.push_back(name);
+	}
+
+	constexpr uint32_t ITERATIONS = 2000;
+	const uint32_t max_threads = OS::get_singleton()->get_processor_count();
+	for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		const uint64_t usec = tester.run(thread_count, ITERATIONS);
+		// Each iteration interns one existing and one transient name.
+		const double ops = double(thread_count) * ITERATIONS * tester.names.size() * 2;
+		print_line(vformat("StringName intern: %d threads, %d usec, %.2f Mops/s.", thread_count, usec, ops / MAX(usec, 1)));
+	}
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestStringName
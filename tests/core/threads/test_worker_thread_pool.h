@@ -172,4 +172,80 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_group_stealing_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Process elements using group tasks with work stealing") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	pool->init(MAX(2, OS::get_singleton()->get_processor_count()), 0.3, true);
+
+	for (int iterations = 0; iterations < 200; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 10.0f));
+		// Use more tasks than threads sometimes, so some ranges are left to be stolen.
+		const int tasks = Math::pow(2.0f, Math::random(0.0f, 6.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_group_stealing_test, nullptr, count, tasks, !low_priority);
+		pool->wait_for_group_task_completion(group);
+
+		bool all_run_once = true;
+		for (int i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+
+	memdelete(pool);
+}
+
+static void static_group_benchmark_element(void *p_arg, uint32_t p_index) {
+	// Fine-grained work, so scheduling overhead dominates.
+	float *values = (float *)p_arg;
+	float v = values[p_index];
+	for (int i = 0; i < 16; i++) {
+		v = v * 0.5f + 1.0f;
+	}
+	values[p_index] = v;
+}
+
+TEST_CASE_BENCHMARK("[WorkerThreadPool][Benchmark] Group task scaling by thread count") {
+	constexpr int ELEMENTS = 1 << 20;
+	constexpr int ROUNDS = 20;
+
+	LocalVector<float> values;
+	values.resize(ELEMENTS);
+	for (int i = 0; i < ELEMENTS; i++) {
+		values[i] = i;
+	}
+
+	// Powers of two up to the processor count, plus the processor count itself.
+	LocalVector<int> thread_counts;
+	const int max_threads = OS::get_singleton()->get_processor_count();
+	for (int thread_count = 1; thread_count < max_threads; thread_count *= 2) {
+		thread_counts.push_back(thread_count);
+	}
+	thread_counts.push_back(max_threads);
+
+	for (int thread_count : thread_counts) {
+		for (int stealing = 0; stealing < 2; stealing++) {
+			WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+			pool->init(thread_count, 0.3, stealing);
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int round = 0; round < ROUNDS; round++) {
+				WorkerThreadPool::GroupID group = pool->add_native_group_task(static_group_benchmark_element, values.ptr(), ELEMENTS, -1, true);
+				pool->wait_for_group_task_completion(group);
+			}
+			const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			print_line(vformat("WorkerThreadPool group tasks: %d threads, work stealing %s, %d usec, %.2f Melements/s.", thread_count, stealing ? "on" : "off", usec, double(ELEMENTS) * ROUNDS / MAX(usec, 1)));
+			memdelete(pool);
+		}
+	}
+}
+
 } // namespace TestWorkerThreadPool
@@ -30,9 +30,12 @@
 
 #pragma once
 
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
 #include "scene/resources/animation.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestAnimation {
 
@@ -308,4 +311,152 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Animation] Key cursors match uncached interpolation") {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(2.0);
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	const int value_track = animation->add_track(Animation::TYPE_VALUE);
+	const int bezier_track = animation->add_track(Animation::TYPE_BEZIER);
+	animation->track_set_interpolation_type(position_track, Animation::INTERPOLATION_CUBIC);
+	double key_time = 0.0;
+	for (int i = 0; i < 40; i++) {
+		animation->position_track_insert_key(position_track, key_time, Vector3(i, i * i * 0.1, -i));
+		animation->track_insert_key(value_track, key_time, i * 2.0);
+		animation->bezier_track_insert_key(bezier_track, key_time, i * 0.5, Vector2(-0.01, 0), Vector2(0.01, 0));
+		key_time += 0.02 + (i % 3) * 0.03; // Irregular key spacing.
+	}
+	// Keys past the end must still be ignored through the cached last key.
+	animation->position_track_insert_key(position_track, 2.5, Vector3(100, 100, 100));
+
+	Vector<double> times;
+	for (double t = -0.1; t < 2.2; t += 1.0 / 60.0) {
+		times.push_back(t); // Forward playback.
+	}
+	for (double t = 2.2; t > -0.1; t -= 1.0 / 60.0) {
+		times.push_back(t); // Backward playback.
+	}
+	const double seeks[] = { 0.9, 0.1, 0.05, 0.05, 1.95, -0.1, 2.0, 0.0, 0.65, 0.66 };
+	for (double t : seeks) {
+		times.push_back(t); // Seeking.
+	}
+
+	Animation::KeyCursor position_cursor;
+	Animation::KeyCursor value_cursor;
+	Animation::KeyCursor bezier_cursor;
+	for (int i = 0; i < times.size(); i++) {
+		const double time = times[i];
+		const bool backward = i > 0 && time < times[i - 1];
+
+		Vector3 position;
+		Vector3 position_cached;
+		CHECK(animation->try_position_track_interpolate(position_track, time, &position, backward) == OK);
+		CHECK(animation->try_position_track_interpolate(position_track, time, &position_cached, backward, &position_cursor) == OK);
+		CHECK_MESSAGE(position == position_cached, vformat("Position mismatch at %f.", time));
+
+		Variant value;
+		Variant value_cached;
+		CHECK(animation->try_value_track_interpolate(value_track, time, &value, backward) == OK);
+		CHECK(animation->try_value_track_interpolate(value_track, time, &value_cached, backward, &value_cursor) == OK);
+		CHECK_MESSAGE(value == value_cached, vformat("Value mismatch at %f.", time));
+
+		real_t bezier = 0;
+		real_t bezier_cached = 0;
+		CHECK(animation->try_bezier_track_interpolate(bezier_track, time, &bezier) == OK);
+		CHECK(animation->try_bezier_track_interpolate(bezier_track, time, &bezier_cached, &bezier_cursor) == OK);
+		CHECK_MESSAGE(bezier == bezier_cached, vformat("Bezier mismatch at %f.", time));
+	}
+
+	// A cursor left over from a longer track must not be trusted.
+	position_cursor.key = 1000;
+	position_cursor.end_key = 1000;
+	Vector3 position_cached;
+	CHECK(animation->try_position_track_interpolate(position_track, 0.5, &position_cached, false, &position_cursor) == OK);
+	CHECK(position_cached == animation->position_track_interpolate(position_track, 0.5));
+}
+
+TEST_CASE("[Animation] Streamed compressed animation stays within the page budget") {
+	// One hour of motion capture like data, compressed into small pages.
+	Ref<Animation> animation = memnew(Animation);
+	const double hour = 3600.0;
+	animation->set_length(hour);
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	const int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+	animation->track_set_path(position_track, NodePath("Skeleton3D:Hips"));
+	animation->track_set_path(rotation_track, NodePath("Skeleton3D:Hips"));
+	for (double t = 0.0; t <= hour; t += 0.5) {
+		animation->position_track_insert_key(position_track, t, Vector3(Math::sin(t), Math::cos(t * 0.5), t * 0.01));
+		animation->rotation_track_insert_key(rotation_track, t, Quaternion(Vector3(0, 1, 0), Math::fmod(t, Math::TAU)));
+	}
+	animation->compress(1024, 30);
+	animation->set_compression_streamed(true);
+	CHECK(animation->is_compression_streamed());
+	CHECK_FALSE(animation->is_compression_streaming()); // Pages stay resident until loaded from a binary file.
+
+	const String path = TestUtils::get_temp_path("animation_streamed.res");
+	REQUIRE(ResourceSaver::save(animation, path) == OK);
+
+	const uint64_t budget = 8 * 1024;
+	Animation::set_streamed_page_budget(budget);
+	Animation::reset_streamed_page_stats();
+
+	Ref<Animation> streamed = ResourceLoader::load(path, "Animation", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(streamed.is_valid());
+	CHECK(streamed->is_compression_streaming());
+	CHECK(streamed->track_is_compressed(position_track));
+	CHECK(Animation::get_streamed_page_stats().resident_bytes == 0); // Nothing is paged in on load.
+
+	bool values_match = true;
+	bool within_budget = true;
+	for (double t = 0.0; t <= hour; t += 1.0 / 30.0) {
+		Vector3 position;
+		Vector3 expected_position;
+		Quaternion rotation;
+		Quaternion expected_rotation;
+		values_match = values_match && streamed->try_position_track_interpolate(position_track, t, &position) == OK;
+		values_match = values_match && streamed->try_rotation_track_interpolate(rotation_track, t, &rotation) == OK;
+		animation->try_position_track_interpolate(position_track, t, &expected_position);
+		animation->try_rotation_track_interpolate(rotation_track, t, &expected_rotation);
+		values_match = values_match && position == expected_position && rotation == expected_rotation;
+		within_budget = within_budget && Animation::get_streamed_page_stats().resident_bytes <= budget;
+	}
+	CHECK(values_match);
+	CHECK(within_budget);
+
+	const Animation::StreamedPageStats stats = Animation::get_streamed_page_stats();
+	CHECK(stats.peak_resident_bytes <= budget);
+	CHECK(stats.misses > 0);
+	CHECK(stats.prefetches > 0);
+	CHECK(stats.evictions > 0);
+	CHECK(stats.hits > stats.misses * 100);
+
+	// Seeking back pages in the start of the animation again.
+	Vector3 position;
+	CHECK(streamed->try_position_track_interpolate(position_track, 1.0, &position) == OK);
+	CHECK(Animation::get_streamed_page_stats().misses == stats.misses + 1);
+
+	// Duplicating reads the pages back from the original file.
+	Ref<Animation> copy = streamed->duplicate();
+	CHECK(copy->try_position_track_interpolate(position_track, hour * 0.5, &position) == OK);
+	Vector3 expected_position;
+	animation->try_position_track_interpolate(position_track, hour * 0.5, &expected_position);
+	CHECK(position == expected_position);
+
+	// Saving over the file the pages are streamed from must read them first.
+	REQUIRE(ResourceSaver::save(streamed, path) == OK);
+	CHECK_FALSE(streamed->is_compression_streaming());
+	Ref<Animation> resaved = ResourceLoader::load(path, "Animation", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(resaved.is_valid());
+	CHECK(resaved->is_compression_streaming());
+	CHECK(resaved->try_position_track_interpolate(position_track, hour * 0.75, &position) == OK);
+	animation->try_position_track_interpolate(position_track, hour * 0.75, &expected_position);
+	CHECK(position == expected_position);
+	resaved.unref();
+
+	streamed.unref();
+	CHECK(Animation::get_streamed_page_stats().resident_bytes == 0); // Freed animations release their pages.
+
+	Animation::set_streamed_page_budget(0);
+	Animation::reset_streamed_page_stats();
+}
+
 } // namespace TestAnimation
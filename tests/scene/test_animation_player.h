@@ -30,7 +30,12 @@
 
 #pragma once
 
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+#include "scene/3d/skeleton_3d.h"
 #include "scene/animation/animation_player.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
 #include "scene/resources/animation.h"
 #include "tests/test_macros.h"
 
@@ -61,4 +66,125 @@ TEST_CASE("[AnimationPlayer] get & set blend_time") {
 	memdelete(animation_player);
 }
 
+static Ref<Animation> _create_bone_animation(int p_bone_count, real_t p_phase) {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	animation->set_loop_mode(Animation::LOOP_LINEAR);
+	for (int i = 0; i < p_bone_count; i++) {
+		const NodePath path = vformat("Skeleton3D:bone_%d", i);
+		const real_t offset = p_phase + i * 0.1;
+
+		int track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(track, path);
+		animation->position_track_insert_key(track, 0.0, Vector3(offset, 0, 0));
+		animation->position_track_insert_key(track, 0.5, Vector3(0, offset, 1));
+		animation->position_track_insert_key(track, 1.0, Vector3(offset, 0, 0));
+
+		track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(track, path);
+		animation->rotation_track_insert_key(track, 0.0, Quaternion(Vector3(0, 1, 0), offset));
+		animation->rotation_track_insert_key(track, 0.5, Quaternion(Vector3(1, 0, 0), offset + 1.0));
+		animation->rotation_track_insert_key(track, 1.0, Quaternion(Vector3(0, 1, 0), offset));
+
+		track = animation->add_track(Animation::TYPE_SCALE_3D);
+		animation->track_set_path(track, path);
+		animation->scale_track_insert_key(track, 0.0, Vector3(1, 1, 1));
+		animation->scale_track_insert_key(track, 0.5, Vector3(1, 1 + offset, 1));
+		animation->scale_track_insert_key(track, 1.0, Vector3(1, 1, 1));
+	}
+	return animation;
+}
+
+static Node3D *_create_animated_character(const Ref<AnimationLibrary> &p_library, int p_bone_count) {
+	Node3D *character = memnew(Node3D);
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton3D");
+	for (int i = 0; i < p_bone_count; i++) {
+		skeleton->add_bone(vformat("bone_%d", i));
+	}
+	character->add_child(skeleton);
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->set_name("AnimationPlayer");
+	player->add_animation_library("", p_library);
+	character->add_child(player);
+	return character;
+}
+
+TEST_CASE("[SceneTree][AnimationPlayer] Batched evaluation matches regular evaluation") {
+	const int bone_count = 8;
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("walk", _create_bone_animation(bone_count, 0.0));
+	library->add_animation("run", _create_bone_animation(bone_count, 0.7));
+
+	Node3D *characters[2];
+	for (int pass = 0; pass < 2; pass++) {
+		ProjectSettings::get_singleton()->set_setting("animation/mixers/use_batched_evaluation", pass == 1);
+		characters[pass] = _create_animated_character(library, bone_count);
+		SceneTree::get_singleton()->get_root()->add_child(characters[pass]);
+
+		AnimationPlayer *player = Object::cast_to<AnimationPlayer>(characters[pass]->get_node(NodePath("AnimationPlayer")));
+		player->play("walk");
+		for (int frame = 0; frame < 4; frame++) {
+			SceneTree::get_singleton()->process(0.1);
+		}
+		// Cross-fade, so two animations are blended with partial weights.
+		player->play("run", 0.5);
+		for (int frame = 0; frame < 3; frame++) {
+			SceneTree::get_singleton()->process(0.1);
+		}
+		SceneTree::get_singleton()->get_root()->remove_child(characters[pass]);
+	}
+	ProjectSettings::get_singleton()->set_setting("animation/mixers/use_batched_evaluation", false);
+
+	Skeleton3D *regular = Object::cast_to<Skeleton3D>(characters[0]->get_node(NodePath("Skeleton3D")));
+	Skeleton3D *batched = Object::cast_to<Skeleton3D>(characters[1]->get_node(NodePath("Skeleton3D")));
+	for (int i = 0; i < bone_count; i++) {
+		CHECK(regular->get_bone_pose_position(i).is_equal_approx(batched->get_bone_pose_position(i)));
+		CHECK(regular->get_bone_pose_rotation(i).is_equal_approx(batched->get_bone_pose_rotation(i)));
+		CHECK(regular->get_bone_pose_scale(i).is_equal_approx(batched->get_bone_pose_scale(i)));
+	}
+	// Make sure the animation was actually applied.
+	CHECK_FALSE(batched->get_bone_pose_position(1).is_zero_approx());
+
+	memdelete(characters[0]);
+	memdelete(characters[1]);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][AnimationPlayer][Benchmark] Animated crowd") {
+	const int character_count = 300;
+	const int bone_count = 40;
+	const int frame_count = 60;
+
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("walk", _create_bone_animation(bone_count, 0.0));
+
+	for (int pass = 0; pass < 2; pass++) {
+		ProjectSettings::get_singleton()->set_setting("animation/mixers/use_batched_evaluation", pass == 1);
+
+		LocalVector<Node3D *> characters;
+		for (int i = 0; i < character_count; i++) {
+			Node3D *character = _create_animated_character(library, bone_count);
+			SceneTree::get_singleton()->get_root()->add_child(character);
+			Object::cast_to<AnimationPlayer>(character->get_node(NodePath("AnimationPlayer")))->play("walk");
+			characters.push_back(character);
+		}
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < frame_count; frame++) {
+			SceneTree::get_singleton()->process(1.0 / 60.0);
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+		print_line(vformat("%d characters with %d bones, %s evaluation: %.3f ms per frame.", character_count, bone_count, pass == 1 ? "batched" : "regular", elapsed / 1000.0 / frame_count));
+
+		for (Node3D *character : characters) {
+			memdelete(character);
+		}
+	}
+	ProjectSettings::get_singleton()->set_setting("animation/mixers/use_batched_evaluation", false);
+}
+
 } // namespace TestAnimationPlayer
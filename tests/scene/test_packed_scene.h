@@ -30,6 +30,10 @@
 
 #pragma once
 
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/timer.h"
+#include "scene/main/window.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -280,4 +284,160 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+static Node2D *_create_chunked_scene(int p_chunk_count, int p_props_per_chunk) {
+	// root
+	// `- ChunkN (Node2D)
+	//    `- PropN (Node2D, in group "props")
+	//       `- Marker (Node2D)
+	//       `- Timer
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("Level");
+
+	for (int i = 0; i < p_chunk_count; i++) {
+		Node2D *chunk = memnew(Node2D);
+		chunk->set_name(vformat("Chunk%d", i));
+		chunk->set_position(Vector2(i * 64, 0));
+		scene->add_child(chunk);
+		chunk->set_owner(scene);
+
+		for (int j = 0; j < p_props_per_chunk; j++) {
+			Node2D *prop = memnew(Node2D);
+			prop->set_name(vformat("Prop%d", j));
+			prop->set_position(Vector2(j, i));
+			prop->set_rotation(0.01 * j);
+			prop->set_z_index(j % 4);
+			prop->add_to_group("props", true);
+			chunk->add_child(prop);
+			prop->set_owner(scene);
+
+			Node2D *marker = memnew(Node2D);
+			marker->set_name("Marker");
+			marker->set_visible(j % 2 == 0);
+			prop->add_child(marker);
+			marker->set_owner(scene);
+
+			Timer *timer = memnew(Timer);
+			timer->set_name("Timer");
+			timer->set_wait_time(1.0 + j);
+			prop->add_child(timer);
+			timer->set_owner(scene);
+		}
+	}
+	return scene;
+}
+
+TEST_CASE("[SceneTree][PackedScene] Threaded instantiation matches serial instantiation") {
+	Node2D *scene = _create_chunked_scene(4, 8);
+	Node *first_prop = scene->get_node(NodePath("Chunk0/Prop0"));
+	Node *last_chunk = scene->get_node(NodePath("Chunk3"));
+	first_prop->set_unique_name_in_owner(true);
+	// Connection across chunks, resolved once every chunk is attached.
+	first_prop->connect("visibility_changed", Callable(last_chunk, "hide"), Object::CONNECT_PERSIST);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(scene) == OK);
+	memdelete(scene);
+
+	const int min_nodes = SceneState::get_threaded_instantiation_min_nodes();
+
+	SceneState::set_threaded_instantiation_min_nodes(0);
+	Node *serial = packed_scene->instantiate();
+	CHECK_FALSE(SceneState::get_last_instantiate_timings().threaded);
+
+	SceneState::set_threaded_instantiation_min_nodes(1);
+	Node *threaded = packed_scene->instantiate();
+	SceneState::InstantiateTimings timings = SceneState::get_last_instantiate_timings();
+	CHECK(timings.threaded);
+	CHECK(timings.subtree_count == 4);
+	CHECK(timings.node_count == 1 + 4 * (1 + 8 * 3));
+
+	SceneState::set_threaded_instantiation_min_nodes(min_nodes);
+
+	REQUIRE(serial != nullptr);
+	REQUIRE(threaded != nullptr);
+	CHECK(threaded->get_name() == serial->get_name());
+	REQUIRE(threaded->get_child_count() == serial->get_child_count());
+
+	for (int i = 0; i < serial->get_child_count(); i++) {
+		Node2D *serial_chunk = Object::cast_to<Node2D>(serial->get_child(i));
+		Node2D *threaded_chunk = Object::cast_to<Node2D>(threaded->get_child(i));
+		REQUIRE(threaded_chunk != nullptr);
+		CHECK(threaded_chunk->get_name() == serial_chunk->get_name());
+		CHECK(threaded_chunk->get_position() == serial_chunk->get_position());
+		CHECK(threaded_chunk->get_owner() == threaded);
+		REQUIRE(threaded_chunk->get_child_count() == serial_chunk->get_child_count());
+
+		for (int j = 0; j < serial_chunk->get_child_count(); j++) {
+			Node2D *serial_prop = Object::cast_to<Node2D>(serial_chunk->get_child(j));
+			Node2D *threaded_prop = Object::cast_to<Node2D>(threaded_chunk->get_child(j));
+			REQUIRE(threaded_prop != nullptr);
+			CHECK(threaded_prop->get_name() == serial_prop->get_name());
+			CHECK(threaded_prop->get_position() == serial_prop->get_position());
+			CHECK(threaded_prop->get_rotation() == serial_prop->get_rotation());
+			CHECK(threaded_prop->get_z_index() == serial_prop->get_z_index());
+			CHECK(threaded_prop->is_in_group("props"));
+			CHECK(threaded_prop->get_owner() == threaded);
+
+			Node2D *threaded_marker = Object::cast_to<Node2D>(threaded_prop->get_node(NodePath("Marker")));
+			CHECK(threaded_marker->is_visible() == (j % 2 == 0));
+			Timer *threaded_timer = Object::cast_to<Timer>(threaded_prop->get_node(NodePath("Timer")));
+			CHECK(threaded_timer->get_wait_time() == doctest::Approx(1.0 + j));
+			CHECK(threaded_timer->get_owner() == threaded);
+		}
+	}
+
+	Node *unique_prop = threaded->get_node_or_null(NodePath("%Prop0"));
+	CHECK(unique_prop == threaded->get_node(NodePath("Chunk0/Prop0")));
+	CHECK(unique_prop->is_connected("visibility_changed", Callable(threaded->get_node(NodePath("Chunk3")), "hide")));
+
+	memdelete(serial);
+	memdelete(threaded);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][PackedScene][Benchmark] Instantiate a 20k node level chunk") {
+	const int chunk_count = 200;
+	const int props_per_chunk = 33;
+	const int iterations = 5;
+
+	Node2D *scene = _create_chunked_scene(chunk_count, props_per_chunk);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+
+	const int min_nodes = SceneState::get_threaded_instantiation_min_nodes();
+
+	for (int pass = 0; pass < 2; pass++) {
+		SceneState::set_threaded_instantiation_min_nodes(pass == 1 ? 1 : 0);
+
+		SceneState::InstantiateTimings phases;
+		uint64_t elapsed = 0;
+		for (int i = 0; i < iterations; i++) {
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			Node *instance = packed_scene->instantiate();
+			SceneTree::get_singleton()->get_root()->add_child(instance);
+			elapsed += OS::get_singleton()->get_ticks_usec() - begin;
+
+			SceneState::InstantiateTimings timings = SceneState::get_last_instantiate_timings();
+			phases.node_count = timings.node_count;
+			phases.prepare_usec += timings.prepare_usec;
+			phases.build_usec += timings.build_usec;
+			phases.attach_usec += timings.attach_usec;
+			phases.node_paths_usec += timings.node_paths_usec;
+			phases.connections_usec += timings.connections_usec;
+			phases.total_usec += timings.total_usec;
+
+			memdelete(instance);
+		}
+
+		print_line(vformat("%d nodes, %s instantiation: %.3f ms per instance (%.3f ms instantiate, %.3f ms add to tree).", phases.node_count, pass == 1 ? "threaded" : "serial", elapsed / 1000.0 / iterations, phases.total_usec / 1000.0 / iterations, (elapsed - phases.total_usec) / 1000.0 / iterations));
+		if (pass == 1) {
+			print_line(vformat("    prepare %.3f ms, build %.3f ms, attach %.3f ms, node paths %.3f ms, connections %.3f ms.", phases.prepare_usec / 1000.0 / iterations, phases.build_usec / 1000.0 / iterations, phases.attach_usec / 1000.0 / iterations, phases.node_paths_usec / 1000.0 / iterations, phases.connections_usec / 1000.0 / iterations));
+		}
+	}
+
+	SceneState::set_threaded_instantiation_min_nodes(min_nodes);
+}
+
 } // namespace TestPackedScene
@@ -0,0 +1,189 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+static RID _create_box_occluder(RendererSceneOcclusionCull *p_culler, const Vector3 &p_size) {
+	PackedVector3Array vertices;
+	for (int i = 0; i < 8; i++) {
+		vertices.push_back(Vector3(i & 1 ? 0.5 : -0.5, i & 2 ? 0.5 : -0.5, i & 4 ? 0.5 : -0.5) * p_size);
+	}
+	const int32_t faces[36] = {
+		0, 1, 3, 0, 3, 2, // -Z
+		4, 6, 7, 4, 7, 5, // +Z
+		0, 4, 5, 0, 5, 1, // -Y
+		2, 3, 7, 2, 7, 6, // +Y
+		0, 2, 6, 0, 6, 4, // -X
+		1, 5, 7, 1, 7, 3, // +X
+	};
+	PackedInt32Array indices;
+	for (int i = 0; i < 36; i++) {
+		indices.push_back(faces[i]);
+	}
+
+	RID occluder = p_culler->occluder_allocate();
+	p_culler->occluder_initialize(occluder);
+	p_culler->occluder_set_mesh(occluder, vertices, indices);
+	return occluder;
+}
+
+static bool _is_occluded(RendererSceneOcclusionCull *p_culler, RID p_buffer, const AABB &p_aabb, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, p_aabb.get_end().x, p_aabb.get_end().y, p_aabb.get_end().z };
+	uint64_t occlusion_timeout = 0;
+	return p_culler->buffer_get_ptr(p_buffer)->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near(), p_cam_projection.is_orthogonal(), occlusion_timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Instances behind an occluder are culled") {
+	RasterOcclusionCull *culler = memnew(RasterOcclusionCull);
+	const RID scenario = RID::from_uint64(1);
+	const RID buffer = RID::from_uint64(2);
+	const RID instance = RID::from_uint64(3);
+
+	culler->add_scenario(scenario);
+	RID wall = _create_box_occluder(culler, Vector3(20, 20, 0.5));
+	culler->scenario_set_instance(scenario, instance, wall, Transform3D(Basis(), Vector3(0, 0, -10)), true);
+
+	culler->add_buffer(buffer);
+	culler->buffer_set_scenario(buffer, scenario);
+	culler->buffer_set_size(buffer, Size2i(128, 72));
+
+	const Transform3D cam_transform;
+	Projection projection;
+	projection.set_perspective(75.0, 16.0 / 9.0, 0.05, 100.0);
+
+	culler->buffer_update(buffer, cam_transform, projection, false);
+
+	CHECK(_is_occluded(culler, buffer, AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2)), cam_transform, projection));
+	CHECK_FALSE(_is_occluded(culler, buffer, AABB(Vector3(-1, -1, -6), Vector3(2, 2, 2)), cam_transform, projection));
+	CHECK_FALSE(_is_occluded(culler, buffer, AABB(Vector3(23, -1, -21), Vector3(2, 2, 2)), cam_transform, projection));
+
+	SUBCASE("Camera inside the near plane of the occluder") {
+		// The wall gets clipped against the near plane, but still hides what's behind it.
+		const Transform3D close_transform(Basis(), Vector3(0, 0, -9.74));
+		culler->buffer_update(buffer, close_transform, projection, false);
+		CHECK(_is_occluded(culler, buffer, AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2)), close_transform, projection));
+	}
+
+	SUBCASE("Disabled occluder") {
+		culler->scenario_set_instance(scenario, instance, wall, Transform3D(Basis(), Vector3(0, 0, -10)), false);
+		culler->buffer_update(buffer, cam_transform, projection, false);
+		CHECK_FALSE(_is_occluded(culler, buffer, AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2)), cam_transform, projection));
+	}
+
+	SUBCASE("Orthogonal camera") {
+		Projection orthogonal;
+		orthogonal.set_orthogonal(10.0, 16.0 / 9.0, 0.05, 100.0, false);
+		culler->buffer_update(buffer, cam_transform, orthogonal, true);
+		CHECK(_is_occluded(culler, buffer, AABB(Vector3(-1, -1, -21), Vector3(2, 2, 2)), cam_transform, orthogonal));
+		CHECK_FALSE(_is_occluded(culler, buffer, AABB(Vector3(-1, -1, -6), Vector3(2, 2, 2)), cam_transform, orthogonal));
+	}
+
+	culler->remove_buffer(buffer);
+	culler->scenario_remove_instance(scenario, instance);
+	culler->remove_scenario(scenario);
+	culler->free_occluder(wall);
+	memdelete(culler);
+}
+
+TEST_CASE_BENCHMARK("[RasterOcclusionCull][Benchmark] City blocks") {
+	const int block_count = 32;
+	const int instance_count = 100000;
+	const int frame_count = 60;
+	const Size2i buffer_size(320, 180);
+
+	Projection projection;
+	projection.set_perspective(75.0, 16.0 / 9.0, 0.05, 1000.0);
+
+	LocalVector<AABB> instance_aabbs;
+	for (int i = 0; i < instance_count; i++) {
+		instance_aabbs.push_back(AABB(Vector3(Math::random(-320.0, 320.0), 0, Math::random(-320.0, 320.0)), Vector3(1, 2, 1)));
+	}
+
+	// The built-in rasterizer always runs. The Embree raycaster runs too when the raycast module provides it.
+	const int pass_count = RendererSceneOcclusionCull::create_func ? 2 : 1;
+	for (int pass = 0; pass < pass_count; pass++) {
+		RendererSceneOcclusionCull *culler = pass == 0 ? memnew(RasterOcclusionCull) : RendererSceneOcclusionCull::create_func();
+		const RID scenario = RID::from_uint64(1);
+		const RID buffer = RID::from_uint64(2);
+
+		culler->add_scenario(scenario);
+		RID building = _create_box_occluder(culler, Vector3(14, 30, 14));
+		for (int i = 0; i < block_count * block_count; i++) {
+			const Vector3 position((i % block_count) * 20.0 - block_count * 10.0, 15.0, (i / block_count) * 20.0 - block_count * 10.0);
+			culler->scenario_set_instance(scenario, RID::from_uint64(100 + i), building, Transform3D(Basis(), position), true);
+		}
+
+		culler->add_buffer(buffer);
+		culler->buffer_set_scenario(buffer, scenario);
+		culler->buffer_set_size(buffer, buffer_size);
+
+		// The raycaster builds its scene on a thread, wait until it is used.
+		// The camera stands on a crossroad, and the probe is behind the nearest building.
+		const Transform3D start_transform(Basis(), Vector3(10, 1.5, 10));
+		for (int i = 0; i < 100 && !_is_occluded(culler, buffer, AABB(Vector3(-20.5, 0, -20.5), Vector3(1, 2, 1)), start_transform, projection); i++) {
+			culler->buffer_update(buffer, start_transform, projection, false);
+			OS::get_singleton()->delay_usec(1000);
+		}
+
+		uint64_t update_usec = 0;
+		uint64_t occluded = 0;
+		for (int frame = 0; frame < frame_count; frame++) {
+			const Transform3D cam_transform(Basis(Vector3(0, 1, 0), Math::TAU * frame / frame_count), Vector3(10, 1.5, 10));
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			culler->buffer_update(buffer, cam_transform, projection, false);
+			update_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			for (const AABB &aabb : instance_aabbs) {
+				if (_is_occluded(culler, buffer, aabb, cam_transform, projection)) {
+					occluded++;
+				}
+			}
+		}
+
+		print_line(vformat("%s: %d occluder triangles, %dx%d buffer, %.3f ms per update, %d of %d instances occluded per frame.", pass == 0 ? "Software rasterizer" : "Embree raycaster", block_count * block_count * 12, buffer_size.x, buffer_size.y, update_usec / 1000.0 / frame_count, occluded / frame_count, instance_count));
+
+		culler->remove_buffer(buffer);
+		for (int i = 0; i < block_count * block_count; i++) {
+			culler->scenario_remove_instance(scenario, RID::from_uint64(100 + i));
+		}
+		culler->remove_scenario(scenario);
+		culler->free_occluder(building);
+		memdelete(culler);
+	}
+}
+
+} // namespace TestRasterOcclusionCull
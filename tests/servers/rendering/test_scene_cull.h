@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  test_scene_cull.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneCull {
+
+static const Size2 viewport_size = Size2(1920, 1080);
+
+static uint32_t _count_in_frustum(const LocalVector<AABB> &p_aabbs, const LocalVector<bool> &p_alive, const Transform3D &p_camera_transform) {
+	Projection projection;
+	projection.set_perspective(75.0, viewport_size.width / viewport_size.height, 0.05, 4000.0, false);
+	RendererSceneCull::Frustum frustum(projection.get_projection_planes(p_camera_transform));
+
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < p_aabbs.size(); i++) {
+		if (p_alive[i] && RendererSceneCull::InstanceBounds(p_aabbs[i]).in_frustum(frustum)) {
+			count++;
+		}
+	}
+	return count;
+}
+
+TEST_CASE("[SceneTree][SceneCull] Cell culling matches the per instance frustum test") {
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID mesh = rs->mesh_create();
+	RID scenario = rs->scenario_create();
+	RID camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 75.0, 0.05, 4000.0);
+
+	RandomPCG rng(42);
+	LocalVector<AABB> aabbs;
+	LocalVector<bool> alive;
+	LocalVector<RID> instances;
+	for (int i = 0; i < 3000; i++) {
+		AABB aabb(Vector3(rng.random(-300.0, 300.0), rng.random(-50.0, 50.0), rng.random(-300.0, 300.0)), Vector3(1, 1, 1) * rng.random(0.1, 20.0));
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, aabb);
+		aabbs.push_back(aabb);
+		alive.push_back(true);
+		instances.push_back(instance);
+	}
+
+	Transform3D camera_transform;
+	rs->camera_set_transform(camera, camera_transform);
+	CHECK(scene_cull->cull_camera(camera, scenario, viewport_size) == _count_in_frustum(aabbs, alive, camera_transform));
+
+	SUBCASE("Unchanged frustum reuses the cell results") {
+		CHECK(scene_cull->cull_camera(camera, scenario, viewport_size) == _count_in_frustum(aabbs, alive, camera_transform));
+	}
+
+	SUBCASE("Moving camera") {
+		for (int i = 0; i < 16; i++) {
+			camera_transform = Transform3D(Basis(Vector3(0, 1, 0), Math::TAU * i / 16.0), Vector3(0, 0, i * 10.0));
+			rs->camera_set_transform(camera, camera_transform);
+			CHECK(scene_cull->cull_camera(camera, scenario, viewport_size) == _count_in_frustum(aabbs, alive, camera_transform));
+		}
+	}
+
+	SUBCASE("Moved and removed instances") {
+		for (uint32_t i = 0; i < instances.size(); i += 7) {
+			aabbs[i].position = Vector3(0, 0, -100);
+			rs->instance_set_custom_aabb(instances[i], aabbs[i]);
+		}
+		for (uint32_t i = 3; i < instances.size(); i += 11) {
+			rs->free(instances[i]);
+			alive[i] = false;
+		}
+		CHECK(scene_cull->cull_camera(camera, scenario, viewport_size) == _count_in_frustum(aabbs, alive, camera_transform));
+	}
+
+	for (uint32_t i = 0; i < instances.size(); i++) {
+		if (alive[i]) {
+			rs->free(instances[i]);
+		}
+	}
+	rs->free(camera);
+	rs->free(scenario);
+	rs->free(mesh);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][SceneCull][Benchmark] Cull static instances") {
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	RenderingServer *rs = RenderingServer::get_singleton();
+	const int instance_count = 200000;
+	const int frame_count = 60;
+
+	RID mesh = rs->mesh_create();
+	RID scenario = rs->scenario_create();
+	RID camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 75.0, 0.05, 4000.0);
+
+	// Instances are added in spatial order, as scenes usually are, so nearby instances share cells.
+	LocalVector<RID> instances;
+	const int side = Math::ceil(Math::sqrt(double(instance_count)));
+	for (int i = 0; i < instance_count; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3((i % side) * 4.0 - side * 2.0, 0, (i / side) * 4.0 - side * 2.0), Vector3(2, 2, 2)));
+		instances.push_back(instance);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t visible = scene_cull->cull_camera(camera, scenario, viewport_size);
+	print_line(vformat("%d instances, first cull: %.3f ms, %d visible.", instance_count, (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0, visible));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		scene_cull->cull_camera(camera, scenario, viewport_size);
+	}
+	print_line(vformat("%d instances, static camera: %.3f ms per cull.", instance_count, (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0 / frame_count));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		rs->camera_set_transform(camera, Transform3D(Basis(Vector3(0, 1, 0), Math::TAU * frame / frame_count), Vector3()));
+		scene_cull->cull_camera(camera, scenario, viewport_size);
+	}
+	print_line(vformat("%d instances, rotating camera: %.3f ms per cull.", instance_count, (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0 / frame_count));
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(camera);
+	rs->free(scenario);
+	rs->free(mesh);
+}
+
+} // namespace TestSceneCull
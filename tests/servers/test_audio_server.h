@@ -0,0 +1,311 @@
+/**************************************************************************/
+/*  test_audio_server.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/marshalls.h"
+#include "scene/resources/audio_stream_wav.h"
+#include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_filter_sw.h"
+#include "servers/audio/audio_mixer_simd.h"
+#include "servers/audio/audio_server.h"
+#include "servers/audio/effects/audio_effect_amplify.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioServer {
+
+// Mixes on the calling thread instead of the dummy driver's thread.
+class OfflineMixer {
+	AudioDriverDummy *driver = nullptr;
+	LocalVector<int32_t> buffer;
+
+public:
+	// Returns the peak absolute sample value.
+	int32_t mix(int p_frames) {
+		buffer.resize(p_frames * driver->get_channels());
+		driver->mix_audio(p_frames, buffer.ptr());
+
+		int32_t peak = 0;
+		for (int32_t sample : buffer) {
+			peak = MAX(peak, Math::abs(sample));
+		}
+		return peak;
+	}
+
+	const LocalVector<int32_t> &get_buffer() const { return buffer; }
+
+	OfflineMixer() {
+		driver = AudioDriverDummy::get_dummy_singleton();
+		driver->finish();
+		driver->set_use_threads(false);
+		driver->init();
+		driver->start();
+	}
+
+	~OfflineMixer() {
+		driver->finish();
+		driver->set_use_threads(true);
+	}
+};
+
+// One second of a looping stereo sine wave.
+static Ref<AudioStreamWAV> create_looping_stream() {
+	const int mix_rate = 44100;
+	Vector<uint8_t> data;
+	data.resize(mix_rate * 4);
+	uint8_t *write_ptr = data.ptrw();
+	for (int i = 0; i < mix_rate; i++) {
+		int16_t sample = int16_t(Math::sin(Math::TAU * 440.0 * i / mix_rate) * INT16_MAX * 0.5);
+		encode_uint16(sample, write_ptr + i * 4);
+		encode_uint16(sample, write_ptr + i * 4 + 2);
+	}
+
+	Ref<AudioStreamWAV> stream;
+	stream.instantiate();
+	stream->set_format(AudioStreamWAV::FORMAT_16_BITS);
+	stream->set_mix_rate(mix_rate);
+	stream->set_stereo(true);
+	stream->set_data(data);
+	stream->set_loop_mode(AudioStreamWAV::LOOP_FORWARD);
+	stream->set_loop_end(mix_rate);
+	return stream;
+}
+
+static Ref<AudioStreamPlayback> start_voice(const Ref<AudioStream> &p_stream, const StringName &p_bus, float p_volume, float p_highshelf_gain) {
+	Vector<AudioFrame> volumes;
+	volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+	for (AudioFrame &volume : volumes) {
+		volume = AudioFrame(p_volume, p_volume);
+	}
+	HashMap<StringName, Vector<AudioFrame>> bus_volumes;
+	bus_volumes[p_bus] = volumes;
+
+	Ref<AudioStreamPlayback> playback = p_stream->instantiate_playback();
+	AudioServer::get_singleton()->start_playback_stream(playback, bus_volumes, 0, 1, p_highshelf_gain, 5000);
+	return playback;
+}
+
+TEST_CASE("[Audio][AudioServer] Mix voices with and without attenuation filter") {
+	Ref<AudioStreamWAV> stream = create_looping_stream();
+	OfflineMixer mixer;
+
+	CHECK_MESSAGE(mixer.mix(4096) == 0, "Nothing should be heard before playback starts.");
+
+	Ref<AudioStreamPlayback> playback = start_voice(stream, SNAME("Master"), 0.5, 0);
+	Ref<AudioStreamPlayback> filtered_playback = start_voice(stream, SNAME("Master"), 0.5, -0.5);
+	CHECK_MESSAGE(mixer.mix(4096) > 0, "Playing voices should be heard.");
+
+	AudioServer::get_singleton()->stop_playback_stream(playback);
+	AudioServer::get_singleton()->stop_playback_stream(filtered_playback);
+	mixer.mix(4096);
+	CHECK_MESSAGE(mixer.mix(4096) == 0, "Stopped voices should fade out.");
+}
+
+TEST_CASE("[Audio][AudioServer] Threaded bus processing matches serial processing") {
+	Ref<AudioStreamWAV> stream = create_looping_stream();
+	AudioServer *audio_server = AudioServer::get_singleton();
+	const bool used_threads = audio_server->is_using_threads_for_buses();
+
+	// Buses 2 and 3 feed Bus 1 and Master respectively, so they're processed on different levels.
+	audio_server->set_bus_count(4);
+	for (int i = 1; i < 4; i++) {
+		audio_server->set_bus_name(i, vformat("Bus %d", i));
+	}
+	audio_server->set_bus_send(1, SNAME("Master"));
+	audio_server->set_bus_send(2, SNAME("Bus 1"));
+	audio_server->set_bus_send(3, SNAME("Master"));
+	Ref<AudioEffectAmplify> amplify;
+	amplify.instantiate();
+	amplify->set_volume_db(-6.0);
+	audio_server->add_bus_effect(2, amplify);
+
+	OfflineMixer mixer;
+	LocalVector<int32_t> buffers[2];
+
+	for (int use_threads = 0; use_threads < 2; use_threads++) {
+		audio_server->set_use_threads_for_buses(use_threads);
+
+		LocalVector<Ref<AudioStreamPlayback>> playbacks;
+		for (int i = 0; i < 4; i++) {
+			playbacks.push_back(start_voice(stream, audio_server->get_bus_name(i), 0.2, (i % 2) ? -0.5 : 0));
+		}
+		// A multiple of the server's buffer size, so both passes start on a fresh buffer.
+		mixer.mix(4096);
+		buffers[use_threads] = mixer.get_buffer();
+
+		for (const Ref<AudioStreamPlayback> &playback : playbacks) {
+			audio_server->stop_playback_stream(playback);
+		}
+		mixer.mix(4096);
+		CHECK_MESSAGE(mixer.mix(4096) == 0, "Stopped voices should fade out.");
+	}
+
+	REQUIRE(buffers[0].size() == buffers[1].size());
+	bool equal = true;
+	for (uint32_t i = 0; i < buffers[0].size(); i++) {
+		equal = equal && buffers[0][i] == buffers[1][i];
+	}
+	CHECK_MESSAGE(equal, "Processing buses on threads should not change the mix.");
+
+	audio_server->set_use_threads_for_buses(used_threads);
+	audio_server->set_bus_count(1);
+}
+
+TEST_CASE("[Audio][AudioMixerSIMD] Mixing kernels match the scalar reference") {
+	// Odd, so the scalar tail of the SIMD loops is covered too.
+	const uint32_t frames = 515;
+	LocalVector<AudioFrame> source;
+	source.resize(frames);
+	for (uint32_t i = 0; i < frames; i++) {
+		source[i] = AudioFrame(Math::sin(i * 0.1f), Math::cos(i * 0.13f));
+	}
+	const AudioFrame vol_start(0.25, 0.5);
+	const AudioFrame vol_final(1.0, 0.125);
+	const AudioFrame vol_step = (vol_final - vol_start) * (1.0f / frames);
+
+	LocalVector<AudioFrame> mixed;
+	mixed.resize(frames);
+	AudioMixerSIMD::mix_volume_ramp(mixed.ptr(), source.ptr(), vol_start, vol_final, frames);
+	bool ramp_matches = true;
+	for (uint32_t i = 0; i < frames; i++) {
+		const AudioFrame expected = (vol_start + vol_step * float(i)) * source[i];
+		ramp_matches = ramp_matches && Math::is_equal_approx(mixed[i].left, expected.left) && Math::is_equal_approx(mixed[i].right, expected.right);
+	}
+	CHECK_MESSAGE(ramp_matches, "Volume ramp should match the scalar reference.");
+
+	AudioMixerSIMD::mix_volume_ramp_add(mixed.ptr(), source.ptr(), vol_start, vol_final, frames);
+	bool ramp_add_matches = true;
+	for (uint32_t i = 0; i < frames; i++) {
+		const AudioFrame expected = (vol_start + vol_step * float(i)) * source[i] * 2.0f;
+		ramp_add_matches = ramp_add_matches && Math::is_equal_approx(mixed[i].left, expected.left) && Math::is_equal_approx(mixed[i].right, expected.right);
+	}
+	CHECK_MESSAGE(ramp_add_matches, "Accumulated volume ramp should match the scalar reference.");
+
+	LocalVector<AudioFrame> sum = source;
+	AudioMixerSIMD::add(sum.ptr(), source.ptr(), frames);
+	bool add_matches = true;
+	for (uint32_t i = 0; i < frames; i++) {
+		const AudioFrame expected = source[i] * 2.0f;
+		add_matches = add_matches && sum[i].left == expected.left && sum[i].right == expected.right;
+	}
+	CHECK_MESSAGE(add_matches, "Adding buffers should match the scalar reference.");
+
+	LocalVector<AudioFrame> scaled = source;
+	const AudioFrame peak = AudioMixerSIMD::scale_and_get_peak(scaled.ptr(), 0.5, frames);
+	AudioFrame expected_peak(0, 0);
+	bool scale_matches = true;
+	for (uint32_t i = 0; i < frames; i++) {
+		const AudioFrame expected = source[i] * 0.5f;
+		scale_matches = scale_matches && scaled[i].left == expected.left && scaled[i].right == expected.right;
+		expected_peak.left = MAX(expected_peak.left, Math::abs(expected.left));
+		expected_peak.right = MAX(expected_peak.right, Math::abs(expected.right));
+	}
+	CHECK_MESSAGE(scale_matches, "Scaling should match the scalar reference.");
+	CHECK(peak.left == expected_peak.left);
+	CHECK(peak.right == expected_peak.right);
+}
+
+TEST_CASE("[Audio][AudioFilterSW] Stereo filtering matches filtering each side") {
+	const int frames = 515;
+	AudioFilterSW filter;
+	filter.set_mode(AudioFilterSW::HIGHSHELF);
+	filter.set_sampling_rate(44100);
+	filter.set_cutoff(5000);
+	filter.set_resonance(1);
+	filter.set_stages(1);
+	filter.set_gain(-0.5);
+
+	AudioFilterSW::Processor stereo_left;
+	AudioFilterSW::Processor stereo_right;
+	AudioFilterSW::Processor reference_left;
+	AudioFilterSW::Processor reference_right;
+	for (AudioFilterSW::Processor *processor : { &stereo_left, &stereo_right, &reference_left, &reference_right }) {
+		processor->set_filter(&filter);
+		processor->update_coeffs(frames);
+	}
+
+	LocalVector<AudioFrame> stereo;
+	stereo.resize(frames);
+	for (int i = 0; i < frames; i++) {
+		stereo[i] = AudioFrame(Math::sin(i * 0.7f), Math::cos(i * 0.3f));
+	}
+	LocalVector<AudioFrame> reference = stereo;
+
+	AudioFilterSW::Processor::process_stereo_interp(&stereo_left, &stereo_right, &stereo[0].left, frames);
+	bool matches = true;
+	for (int i = 0; i < frames; i++) {
+		reference_left.process_one_interp(reference[i].left);
+		reference_right.process_one_interp(reference[i].right);
+		matches = matches && Math::is_equal_approx(stereo[i].left, reference[i].left) && Math::is_equal_approx(stereo[i].right, reference[i].right);
+	}
+	CHECK_MESSAGE(matches, "Filtering both sides together should match filtering them one at a time.");
+}
+
+TEST_CASE_BENCHMARK("[Audio][AudioServer][Benchmark] Mix many positional voices") {
+	const int bus_count = 4;
+	const float seconds = 10;
+	Ref<AudioStreamWAV> stream = create_looping_stream();
+
+	AudioServer *audio_server = AudioServer::get_singleton();
+	audio_server->set_bus_count(bus_count);
+	for (int i = 1; i < bus_count; i++) {
+		audio_server->set_bus_name(i, vformat("Bus %d", i));
+		audio_server->set_bus_send(i, SNAME("Master"));
+	}
+
+	OfflineMixer mixer;
+	const int frames = audio_server->get_mix_rate() * seconds;
+
+	for (int voice_count : { 32, 64, 128, 256 }) {
+		LocalVector<Ref<AudioStreamPlayback>> playbacks;
+		for (int i = 0; i < voice_count; i++) {
+			// Every other voice goes through the high shelf filter used by AudioStreamPlayer3D attenuation.
+			StringName bus = audio_server->get_bus_name(i % bus_count);
+			playbacks.push_back(start_voice(stream, bus, 1.0 / voice_count, (i % 2) ? -0.5 : 0));
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		mixer.mix(frames);
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("AudioServer: %d voices, %.1f msec per second of audio (%.1fx realtime)", voice_count, elapsed / 1000.0 / seconds, seconds * 1000000.0 / elapsed));
+
+		for (const Ref<AudioStreamPlayback> &playback : playbacks) {
+			audio_server->stop_playback_stream(playback);
+		}
+		mixer.mix(4096);
+		audio_server->update();
+	}
+
+	audio_server->set_bus_count(1);
+}
+
+} // namespace TestAudioServer
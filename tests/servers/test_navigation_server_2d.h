@@ -53,6 +53,30 @@ public:
 	Variant function1_latest_arg0;
 };
 
+// Grid of square cells, from the origin to `p_cells * p_cell_size`.
+static Ref<NavigationPolygon> create_grid_navigation_polygon(int p_cells, real_t p_cell_size) {
+	Ref<NavigationPolygon> navigation_polygon;
+	navigation_polygon.instantiate();
+
+	Vector<Vector2> vertices;
+	vertices.resize((p_cells + 1) * (p_cells + 1));
+	for (int y = 0; y <= p_cells; y++) {
+		for (int x = 0; x <= p_cells; x++) {
+			vertices.write[y * (p_cells + 1) + x] = Vector2(x * p_cell_size, y * p_cell_size);
+		}
+	}
+	navigation_polygon->set_vertices(vertices);
+
+	for (int y = 0; y < p_cells; y++) {
+		for (int x = 0; x < p_cells; x++) {
+			const int vertex = y * (p_cells + 1) + x;
+			navigation_polygon->add_polygon(Vector<int>({ vertex, vertex + 1, vertex + p_cells + 2, vertex + p_cells + 1 }));
+		}
+	}
+
+	return navigation_polygon;
+}
+
 struct GreaterThan {
 	bool operator()(int p_a, int p_b) const { return p_a > p_b; }
 };
@@ -741,6 +765,93 @@ TEST_SUITE("[Navigation2D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer2D] Server should respond to queries against large maps properly") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+		Ref<NavigationPolygon> navigation_polygon = create_grid_navigation_polygon(64, 10.0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_polygon(region, navigation_polygon);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Closest point queries should find the nearest polygon") {
+			CHECK(navigation_server->map_get_closest_point(map, Vector2(105.0, 205.0)).is_equal_approx(Vector2(105.0, 205.0)));
+			CHECK(navigation_server->map_get_closest_point(map, Vector2(-50.0, 105.0)).is_equal_approx(Vector2(0.0, 105.0)));
+			CHECK(navigation_server->map_get_closest_point(map, Vector2(700.0, 700.0)).is_equal_approx(Vector2(640.0, 640.0)));
+			CHECK(navigation_server->region_get_closest_point(region, Vector2(402.5, 660.0)).is_equal_approx(Vector2(402.5, 640.0)));
+			CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector2(325.0, 325.0)), region);
+		}
+
+		SUBCASE("Path queries should start and end on the nearest polygons") {
+			Vector<Vector2> path = navigation_server->map_get_path(map, Vector2(-20.0, -20.0), Vector2(635.0, 635.0), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(Vector2(0.0, 0.0)));
+			CHECK(path[path.size() - 1].is_equal_approx(Vector2(635.0, 635.0)));
+		}
+
+		SUBCASE("Random points should be on the map") {
+			const Rect2 bounds(Vector2(-0.01, -0.01), Vector2(640.02, 640.02));
+			for (int i = 0; i < 100; i++) {
+				CHECK(bounds.has_point(navigation_server->map_get_random_point(map, 1, true)));
+				CHECK(bounds.has_point(navigation_server->region_get_random_point(region, 1, true)));
+			}
+		}
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE_BENCHMARK("[NavigationServer2D][Benchmark] Query large maps") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+		const int query_count = 1000;
+		const real_t cell_size = 10.0;
+
+		for (int cells : { 64, 128, 256 }) {
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->map_set_use_async_iterations(map, false);
+			navigation_server->region_set_use_async_iterations(region, false);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_polygon(region, create_grid_navigation_polygon(cells, cell_size));
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+			const real_t size = cells * cell_size;
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < query_count; i++) {
+				navigation_server->map_get_closest_point(map, Vector2(Math::random(real_t(0.0), size), Math::random(real_t(0.0), size)));
+			}
+			const uint64_t closest_point_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < query_count; i++) {
+				navigation_server->map_get_random_point(map, 1, true);
+			}
+			const uint64_t random_point_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < query_count; i++) {
+				// Short paths, so the start and end lookup dominates.
+				const Vector2 from(Math::random(real_t(0.0), size - 2 * cell_size), Math::random(real_t(0.0), size - 2 * cell_size));
+				navigation_server->map_get_path(map, from, from + Vector2(2 * cell_size, 2 * cell_size), true);
+			}
+			const uint64_t path_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			print_line(vformat("NavigationServer2D: %d polygons, usec per query: closest point %.2f, random point %.2f, short path %.2f", cells * cells,
+					double(closest_point_usec) / query_count, double(random_point_usec) / query_count, double(path_usec) / query_count));
+
+			navigation_server->free_rid(region);
+			navigation_server->free_rid(map);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		}
+	}
+
 	TEST_CASE("[NavigationServer2D] Server should simplify path properly") {
 		real_t simplify_epsilon = 0.2;
 		Vector<Vector2> source_path;
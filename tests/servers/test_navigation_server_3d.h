@@ -50,6 +50,30 @@ public:
 	Variant function1_latest_arg0;
 };
 
+// Flat grid of square cells on the XZ plane, from the origin to `p_cells * p_cell_size`.
+static Ref<NavigationMesh> create_grid_navigation_mesh(int p_cells, real_t p_cell_size) {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+
+	Vector<Vector3> vertices;
+	vertices.resize((p_cells + 1) * (p_cells + 1));
+	for (int z = 0; z <= p_cells; z++) {
+		for (int x = 0; x <= p_cells; x++) {
+			vertices.write[z * (p_cells + 1) + x] = Vector3(x * p_cell_size, 0.0, z * p_cell_size);
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+
+	for (int z = 0; z < p_cells; z++) {
+		for (int x = 0; x < p_cells; x++) {
+			const int vertex = z * (p_cells + 1) + x;
+			navigation_mesh->add_polygon(Vector<int>({ vertex, vertex + 1, vertex + p_cells + 2, vertex + p_cells + 1 }));
+		}
+	}
+
+	return navigation_mesh;
+}
+
 TEST_SUITE("[Navigation3D]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -803,6 +827,103 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should respond to queries against large maps properly") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(64, 1.0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Closest point queries should find the nearest polygon") {
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(10.5, 3.0, 20.5)).is_equal_approx(Vector3(10.5, 0.0, 20.5)));
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(-5.0, 0.0, 10.5)).is_equal_approx(Vector3(0.0, 0.0, 10.5)));
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(70.0, 1.0, 70.0)).is_equal_approx(Vector3(64.0, 0.0, 64.0)));
+			CHECK(navigation_server->region_get_closest_point(region, Vector3(40.25, -2.0, 3.75)).is_equal_approx(Vector3(40.25, 0.0, 3.75)));
+			CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(32.5, 1.0, 32.5)), region);
+		}
+
+		SUBCASE("Closest point to segment queries should find the nearest polygon") {
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(5.5, 1.0, 5.5), Vector3(5.5, -1.0, 5.5), true).is_equal_approx(Vector3(5.5, 0.0, 5.5)));
+			CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(-3.0, 1.0, -3.0), Vector3(-2.0, 1.0, -2.0), false).is_equal_approx(Vector3(0.0, 0.0, 0.0)));
+			CHECK(navigation_server->region_get_closest_point_to_segment(region, Vector3(60.5, 2.0, 30.5), Vector3(60.5, -2.0, 30.5), true).is_equal_approx(Vector3(60.5, 0.0, 30.5)));
+		}
+
+		SUBCASE("Path queries should start and end on the nearest polygons") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-2.0, 0.0, -2.0), Vector3(63.5, 0.0, 63.5), true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(Vector3(0.0, 0.0, 0.0)));
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(63.5, 0.0, 63.5)));
+		}
+
+		SUBCASE("Random points should be on the map") {
+			const AABB bounds(Vector3(0.0, -0.01, 0.0), Vector3(64.0, 0.02, 64.0));
+			for (int i = 0; i < 100; i++) {
+				CHECK(bounds.has_point(navigation_server->map_get_random_point(map, 1, true)));
+				CHECK(bounds.has_point(navigation_server->region_get_random_point(region, 1, true)));
+			}
+		}
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE_BENCHMARK("[NavigationServer3D][Benchmark] Query large maps") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int query_count = 1000;
+
+		for (int cells : { 64, 128, 256 }) {
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->map_set_use_async_iterations(map, false);
+			navigation_server->region_set_use_async_iterations(region, false);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, create_grid_navigation_mesh(cells, 1.0));
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < query_count; i++) {
+				navigation_server->map_get_closest_point(map, Vector3(Math::random(real_t(0.0), real_t(cells)), 1.0, Math::random(real_t(0.0), real_t(cells))));
+			}
+			const uint64_t closest_point_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < query_count; i++) {
+				const Vector3 from(Math::random(real_t(0.0), real_t(cells)), 1.0, Math::random(real_t(0.0), real_t(cells)));
+				navigation_server->map_get_closest_point_to_segment(map, from, from - Vector3(0.0, 2.0, 0.0), false);
+			}
+			const uint64_t segment_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < query_count; i++) {
+				navigation_server->map_get_random_point(map, 1, true);
+			}
+			const uint64_t random_point_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < query_count; i++) {
+				// Short paths, so the start and end lookup dominates.
+				const Vector3 from(Math::random(real_t(0.0), real_t(cells - 2)), 0.0, Math::random(real_t(0.0), real_t(cells - 2)));
+				navigation_server->map_get_path(map, from, from + Vector3(2.0, 0.0, 2.0), true);
+			}
+			const uint64_t path_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			print_line(vformat("NavigationServer3D: %d polygons, usec per query: closest point %.2f, segment %.2f, random point %.2f, short path %.2f", cells * cells,
+					double(closest_point_usec) / query_count, double(segment_usec) / query_count, double(random_point_usec) / query_count, double(path_usec) / query_count));
+
+			navigation_server->free_rid(region);
+			navigation_server->free_rid(map);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		}
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {